@@ -8,6 +8,10 @@ mkdir -p src/shaders/compiled
 glslangValidator -V src/shaders/vertex.vert -o src/shaders/compiled/vertex.vert.spv
 cp src/shaders/compiled/vertex.vert.spv build/shaders/
 
+# Compile vertex shader (vertex pulling, no vertex/index buffers)
+glslangValidator -V src/shaders/vertex_pulled.vert -o src/shaders/compiled/vertex_pulled.vert.spv
+cp src/shaders/compiled/vertex_pulled.vert.spv build/shaders/
+
 # Compile fragment shader  
 glslangValidator -V src/shaders/fragment.frag -o src/shaders/compiled/fragment.frag.spv
 cp src/shaders/compiled/fragment.frag.spv build/shaders/
@@ -20,6 +24,32 @@ cp src/shaders/compiled/movement_random.comp.spv build/shaders/
 glslangValidator -V src/shaders/physics.comp -o src/shaders/compiled/physics.comp.spv
 cp src/shaders/compiled/physics.comp.spv build/shaders/
 
+# Compile compute shader (batched spatial queries)
+glslangValidator -V src/shaders/spatial_query.comp -o src/shaders/compiled/spatial_query.comp.spv
+cp src/shaders/compiled/spatial_query.comp.spv build/shaders/
+
+# Compile compute shader (broadphase/narrowphase collision)
+glslangValidator -V src/shaders/collision.comp -o src/shaders/compiled/collision.comp.spv
+cp src/shaders/compiled/collision.comp.spv build/shaders/
+
+# Compile compute shader (periodic Morton/cell reordering of the entity rows)
+glslangValidator -V src/shaders/spatial_reorder.comp -o src/shaders/compiled/spatial_reorder.comp.spv
+cp src/shaders/compiled/spatial_reorder.comp.spv build/shaders/
+
+# Compile density LOD shaders (entity splat, full-screen tone map)
+glslangValidator -V src/shaders/density_splat.comp -o src/shaders/compiled/density_splat.comp.spv
+cp src/shaders/compiled/density_splat.comp.spv build/shaders/
+glslangValidator -V src/shaders/density_resolve.vert -o src/shaders/compiled/density_resolve.vert.spv
+cp src/shaders/compiled/density_resolve.vert.spv build/shaders/
+glslangValidator -V src/shaders/density_resolve.frag -o src/shaders/compiled/density_resolve.frag.spv
+cp src/shaders/compiled/density_resolve.frag.spv build/shaders/
+
+# Compile compute shaders (GPU parallel primitives: scan, compaction, radix sort)
+for primitive in prefix_scan stream_compact radix_sort; do
+    glslangValidator -V src/shaders/$primitive.comp -o src/shaders/compiled/$primitive.comp.spv
+    cp src/shaders/compiled/$primitive.comp.spv build/shaders/
+done
+
 # Export shaders to Windows build folder
 WINDOWS_DEST="/mnt/f/Projects/Fractalia2/build/shaders"
 if mkdir -p "$WINDOWS_DEST" 2>/dev/null; then
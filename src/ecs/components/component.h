@@ -231,6 +231,7 @@ struct InputResponsive {};      // Entity responds to any input
 struct Static {}; // Non-moving entities
 struct Dynamic {}; // Moving entities  
 struct Pooled {}; // Can be recycled
+struct CPUObserved {}; // GPU positions streamed back into Transform (PositionReadbackRing)
 
 // Application state management component (singleton)
 struct ApplicationState {
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <mutex>
+
+// Camera matrices as the simulation thread sampled them
+struct CameraSnapshot {
+    glm::mat4 view{1.0f};
+    glm::mat4 proj{1.0f};
+    uint64_t sampleTicksNS = 0;    // SDL_GetTicksNS() at the sample, 0 when never sampled
+};
+
+// Newest camera published by the simulation thread. The render thread's late latch reads it while
+// recording, so the draw can use a camera one simulation step newer than its frame packet's
+class CameraFeed {
+public:
+    void publish(const CameraSnapshot& camera) {
+        std::lock_guard<std::mutex> lock(mutex);
+        latest = camera;
+    }
+
+    CameraSnapshot read() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return latest;
+    }
+
+private:
+    mutable std::mutex mutex;
+    CameraSnapshot latest;
+};
@@ -0,0 +1,132 @@
+#include "entity_factory.h"
+#include "../gpu/gpu_entity_manager.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+std::vector<flecs::entity> EntityFactory::createSwarmBulk(size_t count, const glm::vec3& center, float /*radius*/,
+                                                          GPUEntitySoA* gpuStaging, MovementType movementType) {
+    // flecs bulk operations take int32 counts
+    count = std::min<size_t>(count, INT32_MAX);
+    if (count == 0) {
+        return {};
+    }
+    
+    // Same distributions as createSwarmWithType: entities start near the center and disperse
+    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI);
+    std::uniform_real_distribution<float> smallRadiusDist(0.0f, 0.5f);
+    std::uniform_real_distribution<float> phaseDist(0.0f, 6.28318530718f);
+    std::uniform_real_distribution<float> offsetDist(0.0f, 10.0f);
+    std::uniform_real_distribution<float> stateTimerDist(0.0f, GPUEntitySoA::MAX_STATE_TIMER);
+    
+    const glm::vec4 color(0.8f, 0.8f, 0.8f, 1.0f);
+    const float invCount = 1.0f / static_cast<float>(count);
+    
+    std::vector<Transform> transforms(count);
+    std::vector<Renderable> renderables(count);
+    std::vector<MovementPattern> patterns(count);
+    
+    size_t firstRow = gpuStaging ? gpuStaging->appendRows(count) : 0;
+    
+    for (size_t i = 0; i < count; ++i) {
+        float angle = angleDist(rng);
+        float r = smallRadiusDist(rng);
+        
+        // Identity rotation and unit scale, so the cached matrix is a plain translation
+        Transform& transform = transforms[i];
+        transform.position = center + glm::vec3(r * std::cos(angle), r * std::sin(angle), 0.0f);
+        transform.matrix[3] = glm::vec4(transform.position, 1.0f);
+        transform.dirty = false;
+        
+        renderables[i].color = color;
+        
+        // Matches createMovementPattern
+        float t = static_cast<float>(i) * invCount;
+        MovementPattern& pattern = patterns[i];
+        pattern.type = movementType;
+        pattern.center = center;
+        pattern.amplitude = 12.0f + 8.0f * t;
+        pattern.frequency = 0.8f + 1.2f * t;
+        pattern.phase = phaseDist(rng);
+        pattern.timeOffset = offsetDist(rng);
+        
+        if (gpuStaging) {
+            gpuStaging->writeRow(firstRow + i, transform.matrix, color, pattern, stateTimerDist(rng));
+        }
+    }
+    
+    // One table lookup and one column move per component instead of per-entity set<>()
+    ecs_bulk_desc_t desc = {};
+    desc.count = static_cast<int32_t>(count);
+    desc.ids[0] = world.component<Transform>().id();
+    desc.ids[1] = world.component<Renderable>().id();
+    desc.ids[2] = world.component<MovementPattern>().id();
+    desc.ids[3] = world.component<Dynamic>().id();
+    desc.ids[4] = world.component<Pooled>().id();
+    
+    void* columns[] = {transforms.data(), renderables.data(), patterns.data(), nullptr, nullptr};
+    desc.data = columns;
+    
+    const ecs_entity_t* ids = ecs_bulk_init(world.c_ptr(), &desc);
+    
+    std::vector<flecs::entity> entities;
+    entities.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        entities.emplace_back(world, ids[i]);
+    }
+    return entities;
+}
+
+std::vector<flecs::entity> EntityFactory::createFromSnapshot(const std::vector<SimulationSnapshot::RestoredRow>& rows) {
+    size_t count = std::min<size_t>(rows.size(), INT32_MAX);
+    if (count == 0) {
+        return {};
+    }
+    
+    std::vector<Transform> transforms(count);
+    std::vector<Renderable> renderables(count);
+    std::vector<MovementPattern> patterns(count);
+    
+    for (size_t i = 0; i < count; ++i) {
+        const SimulationSnapshot::RestoredRow& row = rows[i];
+        
+        Transform& transform = transforms[i];
+        transform.position = glm::vec3(row.position);
+        transform.matrix[3] = glm::vec4(transform.position, 1.0f);
+        transform.dirty = false;
+        
+        renderables[i].color = row.color;
+        
+        MovementPattern& pattern = patterns[i];
+        pattern.type = static_cast<MovementType>(row.record.movementType);
+        pattern.movementType = pattern.type;
+        pattern.center = row.record.center;
+        pattern.amplitude = row.movementParams.x;
+        pattern.frequency = row.movementParams.y;
+        pattern.phase = row.movementParams.z;
+        pattern.timeOffset = row.movementParams.w;
+    }
+    
+    ecs_bulk_desc_t desc = {};
+    desc.count = static_cast<int32_t>(count);
+    desc.ids[0] = world.component<Transform>().id();
+    desc.ids[1] = world.component<Renderable>().id();
+    desc.ids[2] = world.component<MovementPattern>().id();
+    desc.ids[3] = world.component<Dynamic>().id();
+    desc.ids[4] = world.component<Pooled>().id();
+    
+    void* columns[] = {transforms.data(), renderables.data(), patterns.data(), nullptr, nullptr};
+    desc.data = columns;
+    
+    const ecs_entity_t* ids = ecs_bulk_init(world.c_ptr(), &desc);
+    
+    std::vector<flecs::entity> entities;
+    entities.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        entities.emplace_back(world, ids[i]);
+        if (rows[i].record.flags & SimulationSnapshot::RECORD_OBSERVED) {
+            entities.back().add<CPUObserved>();
+        }
+    }
+    return entities;
+}
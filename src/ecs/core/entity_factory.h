@@ -2,11 +2,14 @@
 
 #include "../components/entity.h"
 #include "../components/component.h"
+#include "../gpu/simulation_snapshot.h"
 #include <memory>
 #include <functional>
 #include <vector>
 #include <random>
 
+struct GPUEntitySoA;
+
 // Entity builder pattern for designer-friendly workflow
 class EntityBuilder {
 private:
@@ -170,6 +173,13 @@ public:
         entityPool.reserve(1000); // Pre-allocate pool
     }
     
+    // Deterministic runs: spawn positions and movement parameters follow the seed (0 keeps random_device)
+    void seedRandom(uint32_t seed) {
+        if (seed != 0) {
+            rng.seed(seed);
+        }
+    }
+    
     // Create new entity or reuse from pool
     EntityBuilder create() {
         flecs::entity entity;
@@ -302,6 +312,18 @@ public:
         });
     }
     
+    // Bulk variant of createSwarmWithType: entities are created in one flecs table operation with their
+    // components already filled, and when gpuStaging is given the matching GPU rows are written in the
+    // same pass. Pooled entities are not reused. Defined in entity_factory.cpp
+    std::vector<flecs::entity> createSwarmBulk(size_t count, const glm::vec3& center, float radius,
+                                               GPUEntitySoA* gpuStaging = nullptr,
+                                               MovementType movementType = MovementType::RandomWalk);
+    
+    // Recreates the entities of a restored snapshot, one per row and in row order, with the same bulk
+    // table operation. GPU rows are already resident; pair the result with the rows' gpuIndex when
+    // registering. Defined in entity_factory.cpp
+    std::vector<flecs::entity> createFromSnapshot(const std::vector<SimulationSnapshot::RestoredRow>& rows);
+    
     // Cleanup pool
     void clearPool() {
         for (auto& entity : entityPool) {
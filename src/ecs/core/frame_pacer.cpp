@@ -0,0 +1,117 @@
+#include "frame_pacer.h"
+#include "../utilities/profiler.h"
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+namespace {
+    constexpr uint64_t NS_PER_MS = 1000000;
+    constexpr uint64_t MIN_SPIN_MARGIN_NS = 250000;
+    constexpr uint64_t MAX_SPIN_MARGIN_NS = 4 * NS_PER_MS;
+    constexpr uint64_t SPIN_MARGIN_PAD_NS = 200000;
+    constexpr float FALLBACK_DISPLAY_HZ = 60.0f;
+}
+
+template<typename T>
+T FramePacer::History<T>::percentile(float fraction) const {
+    if (count == 0) {
+        return T{};
+    }
+    std::array<T, HISTORY> sorted = values;
+    const size_t index = std::min(static_cast<size_t>(fraction * static_cast<float>(count)), count - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.begin() + count);
+    return sorted[index];
+}
+
+void FramePacer::configure(const Config& newConfig, float displayHz) {
+    config = newConfig;
+    config.predictionPercentile = std::clamp(config.predictionPercentile, 0.5f, 1.0f);
+    config.predictionMarginMs = std::max(config.predictionMarginMs, 0.0f);
+
+    float hz = 0.0f;
+    switch (config.mode) {
+        case Mode::Uncapped:
+            break;
+        case Mode::FixedRate:
+            hz = config.targetHz;
+            break;
+        case Mode::DisplaySync:
+            hz = displayHz > 0.0f ? displayHz : FALLBACK_DISPLAY_HZ;
+            break;
+    }
+    if (config.mode != Mode::Uncapped && hz <= 0.0f) {
+        config.mode = Mode::Uncapped;
+    }
+
+    targetIntervalNS = config.mode == Mode::Uncapped ? 0 : static_cast<uint64_t>(1.0e9 / hz);
+    nextDeadlineNS = 0;
+    workHistory = {};
+    oversleepHistory = {};
+    spinMarginNS = NS_PER_MS;
+
+    if (targetIntervalNS == 0) {
+        std::cout << "FramePacer: uncapped" << std::endl;
+    } else {
+        std::cout << "FramePacer: " << hz << " Hz (" << getTargetFrameMs() << "ms)"
+                  << (config.mode == Mode::DisplaySync ? ", display synced" : "") << std::endl;
+    }
+}
+
+uint64_t FramePacer::predictWorkNS() const {
+    return workHistory.percentile(config.predictionPercentile) +
+           static_cast<uint64_t>(config.predictionMarginMs * static_cast<float>(NS_PER_MS));
+}
+
+void FramePacer::waitForFrameStart() {
+    if (targetIntervalNS != 0) {
+        const uint64_t now = SDL_GetTicksNS();
+        if (nextDeadlineNS == 0) {
+            nextDeadlineNS = now + targetIntervalNS;
+        }
+
+        // Start late enough that a typical frame ends right at its deadline
+        const uint64_t predicted = std::min(predictWorkNS(), targetIntervalNS);
+        const uint64_t wakeNS = nextDeadlineNS - predicted;
+        if (wakeNS > now) {
+            sleepUntil(wakeNS);
+        }
+    }
+    frameStartNS = SDL_GetTicksNS();
+}
+
+void FramePacer::sleepUntil(uint64_t wakeNS) {
+    uint64_t now = SDL_GetTicksNS();
+    if (wakeNS > now + spinMarginNS) {
+        const uint64_t requestedNS = wakeNS - spinMarginNS;
+        SDL_DelayNS(requestedNS - now);
+        now = SDL_GetTicksNS();
+
+        // How late the scheduler woke us decides how early the next sleep has to stop
+        oversleepHistory.add(now > requestedNS ? now - requestedNS : 0);
+        spinMarginNS = std::clamp(oversleepHistory.percentile(0.95f) + SPIN_MARGIN_PAD_NS,
+                                  MIN_SPIN_MARGIN_NS, MAX_SPIN_MARGIN_NS);
+    }
+    while (now < wakeNS) {
+        std::this_thread::yield();
+        now = SDL_GetTicksNS();
+    }
+}
+
+void FramePacer::endFrame() {
+    const uint64_t now = SDL_GetTicksNS();
+    workHistory.add(now - frameStartNS);
+
+    if (targetIntervalNS == 0 || nextDeadlineNS == 0) {
+        return;
+    }
+
+    const double errorMs = (static_cast<double>(now) - static_cast<double>(nextDeadlineNS)) / static_cast<double>(NS_PER_MS);
+    Profiler::getInstance().recordSample("Pacing Error", static_cast<float>(errorMs));
+
+    nextDeadlineNS += targetIntervalNS;
+    if (now >= nextDeadlineNS) {
+        // Missed by a whole interval: skip ahead rather than running frames back to back
+        nextDeadlineNS = now + targetIntervalNS;
+    }
+}
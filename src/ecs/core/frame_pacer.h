@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Main loop frame pacing, replacing the fixed SDL_Delay throttle.
+ *
+ * Targets are uncapped, a fixed rate, or the display's refresh rate. Instead of sleeping after a
+ * frame, the pacer starts the next one just in time: waitForFrameStart() waits until the deadline
+ * minus the predicted CPU cost of the frame (a high percentile of recent frames), so the frame
+ * hands over close to its deadline with the freshest input. The wait is a coarse sleep that stops
+ * spinMargin early, then a spin; the margin follows the measured oversleep of recent sleeps.
+ *
+ * Pacing error (frame end minus deadline) goes to Profiler as "Pacing Error"; a frame that ends
+ * more than one interval late resynchronises the deadlines instead of racing to catch up.
+ */
+class FramePacer {
+public:
+    enum class Mode {
+        Uncapped,
+        FixedRate,
+        DisplaySync    // FixedRate at the display refresh rate
+    };
+
+    struct Config {
+        Mode mode = Mode::FixedRate;
+        float targetHz = 90.0f;            // FixedRate only
+        float predictionPercentile = 0.9f; // Of recent frame costs
+        float predictionMarginMs = 0.25f;
+    };
+
+    // displayHz is the window's display refresh rate, 0 if unknown (DisplaySync then uses 60 Hz)
+    void configure(const Config& config, float displayHz);
+    const Config& getConfig() const { return config; }
+    float getTargetFrameMs() const { return static_cast<float>(targetIntervalNS) * 1.0e-6f; }
+
+    // Call at the top of the frame, before input is sampled
+    void waitForFrameStart();
+    // Call once the frame is handed over to rendering
+    void endFrame();
+
+    float getPredictedWorkMs() const { return static_cast<float>(predictWorkNS()) * 1.0e-6f; }
+    float getSpinMarginMs() const { return static_cast<float>(spinMarginNS) * 1.0e-6f; }
+
+private:
+    static constexpr size_t HISTORY = 32;
+
+    template<typename T>
+    struct History {
+        std::array<T, HISTORY> values{};
+        size_t count = 0;
+        size_t next = 0;
+
+        void add(T value) {
+            values[next] = value;
+            next = (next + 1) % HISTORY;
+            count = count < HISTORY ? count + 1 : HISTORY;
+        }
+        T percentile(float fraction) const;
+    };
+
+    uint64_t predictWorkNS() const;
+    void sleepUntil(uint64_t wakeNS);
+
+    Config config;
+    uint64_t targetIntervalNS = 0;         // 0 when uncapped
+    uint64_t nextDeadlineNS = 0;
+    uint64_t frameStartNS = 0;
+    uint64_t spinMarginNS = 1000000;
+
+    History<uint64_t> workHistory;         // CPU cost of recent frames
+    History<uint64_t> oversleepHistory;    // Coarse sleep wake-up minus requested wake-up
+};
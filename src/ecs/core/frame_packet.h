@@ -0,0 +1,23 @@
+#pragma once
+
+#include "camera_feed.h"
+#include "../gpu/gpu_entity_manager.h"
+#include <cstdint>
+
+/**
+ * Everything the render thread needs from one simulation step, built on the simulation thread and
+ * not touched by it again once submitted (see FramePipeline).
+ *
+ * Spawns carry the GPU rows staged during the step; their row indices and ECS mapping are already
+ * registered on the simulation side. Removals have no render-side work: releasing an entity only
+ * unmaps its row, which stays resident on the GPU, so they never enter a packet.
+ */
+struct FramePacket {
+    uint64_t frameNumber = 0;
+    float deltaTime = 0.0f;
+    uint64_t inputTimestampNS = 0;       // Oldest input event handled by the step, 0 for none
+    bool framebufferResized = false;
+    CameraSnapshot camera;
+    GPUEntitySoA spawns;
+    uint32_t spawnEpoch = 0;             // GPUEntityManager row epoch the spawns were staged in
+};
@@ -1,6 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
 #include <unordered_map>
 #include <typeindex>
 #include <string>
@@ -35,6 +40,70 @@ struct ServiceMetadata {
         : typeIndex(type), service(svc), name(serviceName) {}
 };
 
+// Core services get fixed slots so their handles resolve without hashing; any other service
+// type is assigned a slot from the dynamic range the first time it is registered or resolved
+class WorldManager;
+class InputService;
+class CameraService;
+class RenderingService;
+class GameControlService;
+
+inline constexpr uint32_t MAX_SERVICE_SLOTS = 32;
+inline constexpr uint32_t INVALID_SERVICE_SLOT = ~0u;
+
+template<typename T> struct CoreServiceSlot : std::integral_constant<uint32_t, INVALID_SERVICE_SLOT> {};
+template<> struct CoreServiceSlot<WorldManager> : std::integral_constant<uint32_t, 0> {};
+template<> struct CoreServiceSlot<InputService> : std::integral_constant<uint32_t, 1> {};
+template<> struct CoreServiceSlot<CameraService> : std::integral_constant<uint32_t, 2> {};
+template<> struct CoreServiceSlot<RenderingService> : std::integral_constant<uint32_t, 3> {};
+template<> struct CoreServiceSlot<GameControlService> : std::integral_constant<uint32_t, 4> {};
+inline constexpr uint32_t CORE_SERVICE_SLOT_COUNT = 5;
+
+// Registered instance for one slot. The generation changes whenever the slot is (re)registered or
+// cleared, which is what lets a ServiceRef detect that its pointer went stale
+struct ServiceSlotEntry {
+    std::atomic<void*> instance{nullptr};
+    std::atomic<uint32_t> generation{0};
+};
+
+/**
+ * Typed handle to a registered service: a direct pointer plus the slot generation it was resolved at.
+ * Access costs one atomic load and compare, with no lock and no type_index hashing, so per-frame
+ * users resolve once (ServiceLocator::resolveService) and keep the handle.
+ */
+template<typename T>
+class ServiceRef {
+public:
+    ServiceRef() = default;
+    ServiceRef(std::nullptr_t) {}
+    ServiceRef(T* instance, const ServiceSlotEntry* slot, uint32_t generation)
+        : instance(instance), slot(slot), generation(generation) {}
+    
+    // False once the service is unregistered, replaced or the locator is cleared
+    bool isValid() const {
+        return instance && slot && slot->generation.load(std::memory_order_acquire) == generation;
+    }
+    explicit operator bool() const { return isValid(); }
+    
+    T* get() const { return isValid() ? instance : nullptr; }
+    T& operator*() const { return *require(); }
+    T* operator->() const { return require(); }
+    
+    void reset() { *this = ServiceRef{}; }
+
+private:
+    T* require() const {
+        if (!isValid()) {
+            throw std::runtime_error("Stale or empty service handle: " + std::string(typeid(T).name()));
+        }
+        return instance;
+    }
+    
+    T* instance = nullptr;
+    const ServiceSlotEntry* slot = nullptr;
+    uint32_t generation = 0;
+};
+
 class ServiceLocator {
 public:
     static ServiceLocator& instance() {
@@ -53,8 +122,14 @@ public:
         
         services_[typeIndex] = service;
         serviceMetadata_[typeIndex] = std::move(metadata);
+        serviceOrder_.erase(std::remove(serviceOrder_.begin(), serviceOrder_.end(), typeIndex), serviceOrder_.end());
         serviceOrder_.push_back(typeIndex);
         
+        if (ServiceSlotEntry* slot = slotFor<T>()) {
+            publishSlot(*slot, service.get());
+            slotTypes_[typeIndex] = slot;
+        }
+        
         // Sort by priority for proper initialization order
         std::sort(serviceOrder_.begin(), serviceOrder_.end(), 
                  [this](const std::type_index& a, const std::type_index& b) {
@@ -99,6 +174,23 @@ public:
         return *service;
     }
 
+    // Resolve once and keep the handle; an empty handle means the service is not registered (yet)
+    template<typename T>
+    ServiceRef<T> resolveService() {
+        ServiceSlotEntry* slot = slotFor<T>();
+        if (!slot) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = services_.find(std::type_index(typeid(T)));
+            // Out of slots: the handle still works, it just cannot detect unregistration
+            return it != services_.end() ? ServiceRef<T>(static_cast<T*>(it->second.get()), &unslottedEntry_, 0) : ServiceRef<T>{};
+        }
+        
+        // Generation first: a concurrent re-registration then fails the handle's check instead of racing it
+        uint32_t generation = slot->generation.load(std::memory_order_acquire);
+        auto* instance = static_cast<T*>(slot->instance.load(std::memory_order_acquire));
+        return instance ? ServiceRef<T>(instance, slot, generation) : ServiceRef<T>{};
+    }
+
     template<typename T>
     bool hasService() const {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -121,6 +213,12 @@ public:
         
         services_.erase(type);
         serviceMetadata_.erase(type);
+        
+        auto slotIt = slotTypes_.find(type);
+        if (slotIt != slotTypes_.end()) {
+            publishSlot(*slotIt->second, nullptr);
+            slotTypes_.erase(slotIt);
+        }
     }
 
     template<typename T>
@@ -139,9 +237,14 @@ public:
             }
         }
         
+        for (auto& [type, slot] : slotTypes_) {
+            publishSlot(*slot, nullptr);
+        }
+        
         services_.clear();
         serviceMetadata_.clear();
         serviceOrder_.clear();
+        slotTypes_.clear();
     }
 
     // Dependency management
@@ -238,6 +341,29 @@ public:
 private:
     ServiceLocator() = default;
     
+    // Core services map to their fixed slot at compile time; other types take the next dynamic slot once
+    template<typename T>
+    ServiceSlotEntry* slotFor() {
+        if constexpr (CoreServiceSlot<T>::value != INVALID_SERVICE_SLOT) {
+            static_assert(CoreServiceSlot<T>::value < CORE_SERVICE_SLOT_COUNT, "Core service slot out of range");
+            return &slots_[CoreServiceSlot<T>::value];
+        } else {
+            static const uint32_t dynamicSlot = nextDynamicSlot_.fetch_add(1, std::memory_order_relaxed);
+            return dynamicSlot < MAX_SERVICE_SLOTS ? &slots_[dynamicSlot] : nullptr;
+        }
+    }
+    
+    static void publishSlot(ServiceSlotEntry& slot, void* instance) {
+        slot.instance.store(instance, std::memory_order_release);
+        slot.generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+    
+    // Slots outlive registrations so outstanding handles can always read their generation
+    std::array<ServiceSlotEntry, MAX_SERVICE_SLOTS> slots_{};
+    std::atomic<uint32_t> nextDynamicSlot_{CORE_SERVICE_SLOT_COUNT};
+    ServiceSlotEntry unslottedEntry_{};
+    std::unordered_map<std::type_index, ServiceSlotEntry*> slotTypes_;
+    
     mutable std::mutex mutex_;
     std::unordered_map<std::type_index, std::shared_ptr<void>> services_;
     std::unordered_map<std::type_index, std::unique_ptr<ServiceMetadata>> serviceMetadata_;
@@ -0,0 +1,67 @@
+#include "simulation_clock.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+void SimulationClock::configure(const Config& newConfig) {
+    config = newConfig;
+    config.stepDelta = std::max(config.stepDelta, 1.0f / 1000.0f);
+    config.maxSubsteps = std::max(config.maxSubsteps, 1u);
+    accumulator = 0.0;
+
+    if (config.fixedStep) {
+        std::cout << "SimulationClock: Fixed step " << (config.stepDelta * 1000.0f) << "ms, up to "
+                  << config.maxSubsteps << " steps per frame, seed " << config.seed << std::endl;
+    }
+}
+
+SimulationClock::Steps SimulationClock::advance(float frameDelta) {
+    Steps steps;
+    steps.firstStepTime = static_cast<float>(time);
+    steps.firstStepIndex = stepIndex;
+
+    if (!config.fixedStep) {
+        steps.count = 1;
+        steps.stepDelta = frameDelta;
+        time += frameDelta;
+        stepIndex++;
+        return steps;
+    }
+
+    const double stepDelta = config.stepDelta;
+    accumulator += std::max(frameDelta, 0.0f);
+
+    uint32_t count = static_cast<uint32_t>(std::floor(accumulator / stepDelta));
+    if (count > config.maxSubsteps) {
+        // A hitch would otherwise snowball into ever longer frames; drop the backlog instead
+        count = config.maxSubsteps;
+        accumulator = count * stepDelta;
+    }
+    accumulator -= count * stepDelta;
+
+    steps.count = count;
+    steps.stepDelta = config.stepDelta;
+    steps.alpha = static_cast<float>(accumulator / stepDelta);
+    time += count * stepDelta;
+    stepIndex += count;
+    return steps;
+}
+
+void SimulationClock::setTime(float newTime, uint32_t newStepIndex) {
+    time = newTime;
+    stepIndex = newStepIndex;
+    accumulator = 0.0;
+}
+
+uint32_t SimulationClock::getSeed(SeedStream stream) const {
+    return config.seed == 0 ? 0 : deriveSeed(config.seed, static_cast<uint32_t>(stream));
+}
+
+uint32_t SimulationClock::deriveSeed(uint32_t seed, uint32_t stream) {
+    // splitmix32 over (seed, stream) so streams stay uncorrelated for neighbouring seeds
+    uint32_t z = seed + stream * 0x9e3779b9u;
+    z = (z ^ (z >> 16)) * 0x85ebca6bu;
+    z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+    z ^= z >> 16;
+    return z != 0 ? z : 1u;
+}
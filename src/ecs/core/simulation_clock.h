@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Simulation time source for the GPU compute nodes.
+ *
+ * Variable mode reproduces the old behaviour: one simulation step per rendered frame, as long
+ * as the frame's delta. Fixed-step mode decouples the simulation from the render rate: frame
+ * deltas feed an accumulator that is drained in fixedStep increments, so a run advances the same
+ * sequence of steps no matter how fast it renders. Combined with a seed (CPU spawn RNGs and the
+ * compute shaders' hashes) two runs of the same build simulate identical workloads.
+ */
+class SimulationClock {
+public:
+    struct Config {
+        bool fixedStep = false;
+        float stepDelta = 1.0f / 60.0f;    // Fixed mode only
+        uint32_t maxSubsteps = 4;          // Backlog beyond this is dropped rather than caught up
+        uint32_t seed = 0;                 // 0 keeps the unseeded shader hashes
+    };
+
+    // Steps to simulate this frame. count may be 0 in fixed mode when the accumulator is short
+    struct Steps {
+        uint32_t count = 1;
+        float stepDelta = 0.0f;
+        float firstStepTime = 0.0f;
+        uint32_t firstStepIndex = 0;
+        float alpha = 0.0f;                // Leftover accumulator as a fraction of a step
+
+        float lastStepTime() const { return firstStepTime + (static_cast<float>(count) - 1.0f) * stepDelta; }
+    };
+
+    // Independent seed streams derived from Config::seed
+    enum class SeedStream : uint32_t {
+        Spawn = 1,          // EntityFactory placement and movement parameters
+        StateTimer = 2,     // GPUEntitySoA per-entity state timer stagger
+        Shader = 3          // Compute shader hashes (NodePushConstants::seed)
+    };
+
+    void configure(const Config& config);
+    const Config& getConfig() const { return config; }
+    bool isFixedStep() const { return config.fixedStep; }
+
+    Steps advance(float frameDelta);
+
+    // Time and index of the next step; restoring a snapshot resumes from its captured step
+    float getTime() const { return static_cast<float>(time); }
+    uint32_t getStepIndex() const { return stepIndex; }
+    void setTime(float time, uint32_t stepIndex);
+
+    uint32_t getSeed(SeedStream stream) const;
+    static uint32_t deriveSeed(uint32_t seed, uint32_t stream);
+
+private:
+    Config config;
+    double time = 0.0;            // Accumulated in double so long runs do not drift between builds
+    double accumulator = 0.0;
+    uint32_t stepIndex = 0;
+};
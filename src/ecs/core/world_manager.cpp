@@ -27,8 +27,8 @@ WorldManager::~WorldManager() {
 
 bool WorldManager::initialize() {
     try {
-        // Initialize core Flecs systems
-        world_.set_threads(std::thread::hardware_concurrency());
+        // One flecs stage per hardware thread; only systems declared multi_threaded() are split across them
+        world_.set_threads(static_cast<int32_t>(std::max(1u, std::thread::hardware_concurrency())));
         
         // Enable performance monitoring by default
         enablePerformanceMonitoring(true);
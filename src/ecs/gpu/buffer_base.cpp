@@ -5,6 +5,7 @@
 #include "../../vulkan/core/vulkan_utils.h"
 #include "../../vulkan/resources/core/resource_handle.h"
 #include "../../vulkan/core/vulkan_raii.h"
+#include "../../vulkan/monitoring/memory_accounting.h"
 #include <iostream>
 
 BufferBase::BufferBase() {
@@ -22,13 +23,17 @@ bool BufferBase::initialize(const VulkanContext& context, ResourceCoordinator* r
     this->elementSize = elementSize;
     this->bufferSize = maxElements * elementSize;
     
-    // Standard buffer usage for entity data
+    // Standard buffer usage for entity data; TRANSFER_SRC covers debug reads and position readback
     const VkBufferUsageFlags standardUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | 
                                             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | 
+                                            VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
                                             VK_BUFFER_USAGE_TRANSFER_DST_BIT;
     
     // Allow subclasses to add specific usage flags
-    const VkBufferUsageFlags finalUsage = standardUsage | usage | getAdditionalUsageFlags();
+    VkBufferUsageFlags finalUsage = standardUsage | usage | getAdditionalUsageFlags();
+    if (context.hasBufferDeviceAddress()) {
+        finalUsage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
     
     if (!createBuffer(bufferSize, finalUsage)) {
         std::cerr << "BufferBase: Failed to create " << getBufferTypeName() << " buffer" << std::endl;
@@ -115,13 +120,30 @@ bool BufferBase::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage) {
         context->getPhysicalDevice(), vk, memRequirements.memoryTypeBits, 
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
     
+    VkMemoryAllocateFlagsInfo allocFlagsInfo{};
+    allocFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    allocFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+    const bool useDeviceAddress = (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0;
+    if (useDeviceAddress) {
+        allocInfo.pNext = &allocFlagsInfo;
+    }
+    
     if (vk.vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
         vk.vkDestroyBuffer(device, buffer, nullptr);
         buffer = VK_NULL_HANDLE;
         return false;
     }
+    MemoryAccounting::getInstance().trackDeviceAllocation(bufferMemory, allocInfo.allocationSize, allocInfo.memoryTypeIndex,
+                                                          GpuMemoryCategory::EntityBuffers);
     
     vk.vkBindBufferMemory(device, buffer, bufferMemory, 0);
+    
+    if (useDeviceAddress) {
+        VkBufferDeviceAddressInfo addressInfo{};
+        addressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        addressInfo.buffer = buffer;
+        deviceAddress = vk.vkGetBufferDeviceAddress(device, &addressInfo);
+    }
     return true;
 }
 
@@ -135,8 +157,10 @@ void BufferBase::destroyBuffer() {
         vk.vkDestroyBuffer(device, buffer, nullptr);
         buffer = VK_NULL_HANDLE;
     }
+    deviceAddress = 0;
     
     if (bufferMemory != VK_NULL_HANDLE) {
+        MemoryAccounting::getInstance().trackDeviceFree(bufferMemory);
         vk.vkFreeMemory(device, bufferMemory, nullptr);
         bufferMemory = VK_NULL_HANDLE;
     }
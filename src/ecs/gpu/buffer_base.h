@@ -22,6 +22,9 @@ public:
     uint32_t getMaxElements() const override { return maxElements; }
     bool isInitialized() const override { return buffer != VK_NULL_HANDLE; }
     
+    // Shader-visible address when the device supports bufferDeviceAddress, 0 otherwise
+    VkDeviceAddress getDeviceAddress() const { return deviceAddress; }
+    
     // Common buffer operations
     bool copyData(const void* data, VkDeviceSize size, VkDeviceSize offset = 0) override;
     bool readData(void* data, VkDeviceSize size, VkDeviceSize offset = 0) const override;
@@ -38,6 +41,7 @@ protected:
     VkDeviceSize bufferSize = 0;
     VkDeviceSize elementSize = 0;
     uint32_t maxElements = 0;
+    VkDeviceAddress deviceAddress = 0;
     
     // Dependencies
     const VulkanContext* context = nullptr;
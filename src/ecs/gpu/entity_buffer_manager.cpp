@@ -3,10 +3,12 @@
 #include "../../vulkan/resources/core/resource_coordinator.h"
 #include "../../vulkan/resources/core/command_executor.h"
 #include "../../vulkan/core/vulkan_function_loader.h"
+#include "../../vulkan/core/vulkan_constants.h"
 #include <iostream>
 #include <cstring>
 #include <limits>
 #include <algorithm>
+#include <array>
 
 EntityBufferManager::EntityBufferManager() {
 }
@@ -15,9 +17,19 @@ EntityBufferManager::~EntityBufferManager() {
     cleanup();
 }
 
-bool EntityBufferManager::initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
+bool EntityBufferManager::initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                                     const EntitySchema& schema) {
     this->maxEntities = maxEntities;
     this->context = &context;
+    this->schema = schema;
+    
+    // Dropped columns keep a one-element buffer so their descriptor slot stays valid
+    auto columnElements = [&](uint32_t bufferType) {
+        return schema.getStride(bufferType) > 0 ? maxEntities : 1u;
+    };
+    auto columnStride = [&](uint32_t bufferType) {
+        return schema.getStride(bufferType) > 0 ? schema.getStride(bufferType) : VkDeviceSize(sizeof(glm::vec4));
+    };
     
     // Initialize upload service
     if (!uploadService.initialize(resourceCoordinator)) {
@@ -26,41 +38,76 @@ bool EntityBufferManager::initialize(const VulkanContext& context, ResourceCoord
     }
     
     // Initialize specialized buffers
-    if (!velocityBuffer.initialize(context, resourceCoordinator, maxEntities)) {
+    if (!velocityBuffer.initialize(context, resourceCoordinator, columnElements(EntityBufferType::VELOCITY),
+                                   columnStride(EntityBufferType::VELOCITY))) {
         std::cerr << "EntityBufferManager: Failed to initialize velocity buffer" << std::endl;
         return false;
     }
     
-    if (!movementParamsBuffer.initialize(context, resourceCoordinator, maxEntities)) {
+    if (!movementParamsBuffer.initialize(context, resourceCoordinator, columnElements(EntityBufferType::MOVEMENT_PARAMS),
+                                         columnStride(EntityBufferType::MOVEMENT_PARAMS))) {
         std::cerr << "EntityBufferManager: Failed to initialize movement params buffer" << std::endl;
         return false;
     }
     
-    if (!runtimeStateBuffer.initialize(context, resourceCoordinator, maxEntities)) {
+    if (!runtimeStateBuffer.initialize(context, resourceCoordinator, columnElements(EntityBufferType::RUNTIME_STATE),
+                                       columnStride(EntityBufferType::RUNTIME_STATE))) {
         std::cerr << "EntityBufferManager: Failed to initialize runtime state buffer" << std::endl;
         return false;
     }
     
-    if (!rotationStateBuffer.initialize(context, resourceCoordinator, maxEntities)) {
+    if (!rotationStateBuffer.initialize(context, resourceCoordinator, columnElements(EntityBufferType::ROTATION_STATE),
+                                        columnStride(EntityBufferType::ROTATION_STATE))) {
         std::cerr << "EntityBufferManager: Failed to initialize rotation state buffer" << std::endl;
         return false;
     }
     
-    if (!colorBuffer.initialize(context, resourceCoordinator, maxEntities)) {
+    if (!colorBuffer.initialize(context, resourceCoordinator, columnElements(EntityBufferType::COLOR),
+                                columnStride(EntityBufferType::COLOR))) {
         std::cerr << "EntityBufferManager: Failed to initialize color buffer" << std::endl;
         return false;
     }
     
-    if (!modelMatrixBuffer.initialize(context, resourceCoordinator, maxEntities)) {
+    if (!modelMatrixBuffer.initialize(context, resourceCoordinator, columnElements(EntityBufferType::MODEL_MATRIX),
+                                      columnStride(EntityBufferType::MODEL_MATRIX))) {
         std::cerr << "EntityBufferManager: Failed to initialize model matrix buffer" << std::endl;
         return false;
     }
     
-    if (!spatialMapBuffer.initialize(context, resourceCoordinator, 4096)) { // 64x64 grid
+    // Sized for the largest grid a physics variant may select, not just the default 64x64
+    if (!spatialMapBuffer.initialize(context, resourceCoordinator, MAX_SPATIAL_GRID_WIDTH * MAX_SPATIAL_GRID_WIDTH)) {
         std::cerr << "EntityBufferManager: Failed to initialize spatial map buffer" << std::endl;
         return false;
     }
     
+    if (!spatialQueryBuffer.initialize(context, resourceCoordinator, MAX_SPATIAL_QUERIES) ||
+        !spatialQueryResultBuffer.initialize(context, resourceCoordinator, MAX_SPATIAL_QUERIES, MAX_SPATIAL_QUERY_HITS)) {
+        std::cerr << "EntityBufferManager: Failed to initialize spatial query buffers" << std::endl;
+        return false;
+    }
+    
+    if (!collisionLinkBuffer.initialize(context, resourceCoordinator, maxEntities) ||
+        !collisionPairBuffer.initialize(context, resourceCoordinator, MAX_COLLISION_PAIRS)) {
+        std::cerr << "EntityBufferManager: Failed to initialize collision buffers" << std::endl;
+        return false;
+    }
+    
+    // Scratch holds one column at a time, so it is sized for the widest
+    VkDeviceSize largestStride = sizeof(uint32_t);
+    for (uint32_t bufferType : REORDERED_COLUMNS) {
+        largestStride = std::max(largestStride, schema.getStride(bufferType));
+    }
+    if (!spatialReorderBuffer.initialize(context, resourceCoordinator, maxEntities) ||
+        !reorderScratchBuffer.initialize(context, resourceCoordinator, maxEntities, largestStride)) {
+        std::cerr << "EntityBufferManager: Failed to initialize spatial reorder buffers" << std::endl;
+        return false;
+    }
+    
+    if (!densityBuffer.initialize(context, resourceCoordinator)) {
+        std::cerr << "EntityBufferManager: Failed to initialize density buffer" << std::endl;
+        return false;
+    }
+    
     // Initialize spatial map buffer with NULL values (0xFFFFFFFF)
     if (!initializeSpatialMapBuffer()) {
         std::cerr << "EntityBufferManager: Failed to clear spatial map buffer" << std::endl;
@@ -68,18 +115,42 @@ bool EntityBufferManager::initialize(const VulkanContext& context, ResourceCoord
     }
     
     // Initialize position buffer coordinator
-    if (!positionCoordinator.initialize(context, resourceCoordinator, maxEntities)) {
+    if (!positionCoordinator.initialize(context, resourceCoordinator, maxEntities,
+                                        schema.getStride(EntityBufferType::POSITION_OUTPUT))) {
         std::cerr << "EntityBufferManager: Failed to initialize position coordinator" << std::endl;
         return false;
     }
     
+    if (context.hasBufferDeviceAddress()) {
+        columnAddressTable = resourceCoordinator->createMappedBuffer(
+            sizeof(VkDeviceAddress) * EntityBufferType::MAX_ENTITY_BUFFERS, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+        if (!columnAddressTable.buffer.get() || !columnAddressTable.mappedData) {
+            std::cerr << "EntityBufferManager: Failed to create column address table" << std::endl;
+            return false;
+        }
+        publishColumnAddresses();
+    }
+    
     std::cout << "EntityBufferManager: Initialized successfully for " << maxEntities << " entities using SRP-compliant design" << std::endl;
+    std::cout << "EntityBufferManager: '" << schema.getName() << "' schema, " << schema.getBytesPerEntity()
+              << " bytes/entity (" << (schema.getBytesPerEntity() * maxEntities) / (1024 * 1024) << " MB)" << std::endl;
     return true;
 }
 
 void EntityBufferManager::cleanup() {
+    if (auto* resourceCoordinator = uploadService.getResourceCoordinator()) {
+        resourceCoordinator->destroyResource(columnAddressTable);
+    }
+    
     // Cleanup specialized components
     positionCoordinator.cleanup();
+    densityBuffer.cleanup();
+    reorderScratchBuffer.cleanup();
+    spatialReorderBuffer.cleanup();
+    collisionPairBuffer.cleanup();
+    collisionLinkBuffer.cleanup();
+    spatialQueryResultBuffer.cleanup();
+    spatialQueryBuffer.cleanup();
     spatialMapBuffer.cleanup();
     modelMatrixBuffer.cleanup();
     colorBuffer.cleanup();
@@ -93,6 +164,47 @@ void EntityBufferManager::cleanup() {
 }
 
 
+VkBuffer EntityBufferManager::getColumnBuffer(uint32_t bufferType) const {
+    switch (bufferType) {
+        case EntityBufferType::VELOCITY: return getVelocityBuffer();
+        case EntityBufferType::MOVEMENT_PARAMS: return getMovementParamsBuffer();
+        case EntityBufferType::RUNTIME_STATE: return getRuntimeStateBuffer();
+        case EntityBufferType::ROTATION_STATE: return getRotationStateBuffer();
+        case EntityBufferType::COLOR: return getColorBuffer();
+        case EntityBufferType::MODEL_MATRIX: return getModelMatrixBuffer();
+        case EntityBufferType::POSITION_OUTPUT: return getPositionBuffer();
+        case EntityBufferType::CURRENT_POSITION: return getCurrentPositionBuffer();
+        default: return VK_NULL_HANDLE;
+    }
+}
+
+VkDeviceAddress EntityBufferManager::getColumnAddress(uint32_t bufferType) const {
+    switch (bufferType) {
+        case EntityBufferType::VELOCITY: return velocityBuffer.getDeviceAddress();
+        case EntityBufferType::MOVEMENT_PARAMS: return movementParamsBuffer.getDeviceAddress();
+        case EntityBufferType::RUNTIME_STATE: return runtimeStateBuffer.getDeviceAddress();
+        case EntityBufferType::ROTATION_STATE: return rotationStateBuffer.getDeviceAddress();
+        case EntityBufferType::COLOR: return colorBuffer.getDeviceAddress();
+        case EntityBufferType::MODEL_MATRIX: return modelMatrixBuffer.getDeviceAddress();
+        case EntityBufferType::POSITION_OUTPUT: return positionCoordinator.getPrimaryAddress();
+        case EntityBufferType::CURRENT_POSITION: return positionCoordinator.getCurrentAddress();
+        default: return 0;
+    }
+}
+
+void EntityBufferManager::publishColumnAddresses() {
+    if (!columnAddressTable.mappedData) {
+        return;
+    }
+    
+    // std140 uvec4[MAX_ENTITY_BUFFERS / 2] on the shader side: column c is .xy (even) or .zw (odd) of entry c / 2
+    std::array<VkDeviceAddress, EntityBufferType::MAX_ENTITY_BUFFERS> addresses{};
+    for (uint32_t bufferType : REORDERED_COLUMNS) {
+        addresses[bufferType] = getColumnAddress(bufferType);
+    }
+    std::memcpy(columnAddressTable.mappedData, addresses.data(), sizeof(addresses));
+}
+
 bool EntityBufferManager::uploadVelocityData(const void* data, VkDeviceSize size, VkDeviceSize offset) {
     return uploadService.upload(velocityBuffer, data, size, offset);
 }
@@ -184,118 +296,19 @@ bool EntityBufferManager::readGPUBuffer(VkBuffer srcBuffer, void* dstData, VkDev
     return true;
 }
 
-// Debug readback implementations
-bool EntityBufferManager::readbackEntityAtPosition(glm::vec2 worldPos, EntityDebugInfo& info) const {
-    // Calculate clicked spatial cell using same logic as GPU shader
-    const float CELL_SIZE = 2.0f;
-    const uint32_t GRID_WIDTH = 64;
-    const uint32_t GRID_HEIGHT = 64;
-    
-    // Convert world position to grid coordinates (same as GPU)
-    glm::ivec2 gridCoord = glm::ivec2(glm::floor(worldPos / CELL_SIZE));
-    uint32_t clickedX = static_cast<uint32_t>(gridCoord.x) & (GRID_WIDTH - 1);
-    uint32_t clickedY = static_cast<uint32_t>(gridCoord.y) & (GRID_HEIGHT - 1);
-    uint32_t clickedCellIndex = clickedX + clickedY * GRID_WIDTH;
-    
-    std::cout << "=== ENTITY SEARCH DEBUG ===" << std::endl;
-    std::cout << "Click position: (" << worldPos.x << ", " << worldPos.y << ")" << std::endl;
-    std::cout << "CELL_SIZE: " << CELL_SIZE << ", GRID_WIDTH: " << GRID_WIDTH << ", GRID_HEIGHT: " << GRID_HEIGHT << std::endl;
-    std::cout << "Raw grid coord: (" << gridCoord.x << ", " << gridCoord.y << ")" << std::endl;
-    std::cout << "Wrapped grid coord: (" << clickedX << ", " << clickedY << ")" << std::endl;
-    std::cout << "Clicked cell: " << clickedCellIndex << " (formula: " << clickedX << " + " << clickedY << " * " << GRID_WIDTH << ")" << std::endl;
-    
-    // Search nearby spatial cells for entities (much more efficient!)
-    uint32_t closestEntity = 0;
-    float closestDistance = std::numeric_limits<float>::max();
-    glm::vec4 closestPosition;
-    uint32_t cellsChecked = 0;
-    uint32_t entitiesFound = 0;
-    
-    // Search in a 5x5 grid around the clicked cell (25 cells total)
-    const int SEARCH_RADIUS = 2; // cells in each direction
-    
-    for (int dy = -SEARCH_RADIUS; dy <= SEARCH_RADIUS; ++dy) {
-        for (int dx = -SEARCH_RADIUS; dx <= SEARCH_RADIUS; ++dx) {
-            // Calculate neighboring cell coordinates
-            int neighborX = (int)clickedX + dx;
-            int neighborY = (int)clickedY + dy;
-            
-            // Wrap around grid boundaries (handle negative coordinates properly)
-            uint32_t searchX = ((uint32_t)(neighborX % (int)GRID_WIDTH + GRID_WIDTH)) & (GRID_WIDTH - 1);
-            uint32_t searchY = ((uint32_t)(neighborY % (int)GRID_HEIGHT + GRID_HEIGHT)) & (GRID_HEIGHT - 1);
-            uint32_t searchCellIndex = searchX + searchY * GRID_WIDTH;
-            
-            cellsChecked++;
-            
-            // Check entities in this cell
-            std::vector<uint32_t> entitiesInCell;
-            std::cout << "Searching cell " << searchCellIndex << " (grid: " << searchX << ", " << searchY << ")" << std::endl;
-            if (readbackSpatialCell(searchCellIndex, entitiesInCell)) {
-                for (uint32_t entityId : entitiesInCell) {
-                    if (entityId >= maxEntities) continue;
-                    entitiesFound++;
-                    
-                    // Read position for this entity
-                    glm::vec4 entityPosition;
-                    if (readGPUBuffer(positionCoordinator.getPrimaryBuffer(), 
-                                     &entityPosition, sizeof(glm::vec4), 
-                                     entityId * sizeof(glm::vec4))) {
-                        
-                        // Calculate entity's spatial cell using same logic as shader
-                        glm::vec2 entityPos2D = glm::vec2(entityPosition);
-                        glm::ivec2 entityGridCoord = glm::ivec2(glm::floor(entityPos2D / CELL_SIZE));
-                        uint32_t entityCellX = static_cast<uint32_t>(entityGridCoord.x) & (GRID_WIDTH - 1);
-                        uint32_t entityCellY = static_cast<uint32_t>(entityGridCoord.y) & (GRID_HEIGHT - 1);
-                        uint32_t entityActualCell = entityCellX + entityCellY * GRID_WIDTH;
-                        
-                        float distance = glm::distance(worldPos, glm::vec2(entityPosition));
-                        std::cout << "  Entity " << entityId << " at (" << entityPosition.x << ", " << entityPosition.y 
-                                  << ") in search cell " << searchCellIndex << " but actual cell " << entityActualCell 
-                                  << " distance " << distance << std::endl;
-                        
-                        if (distance < closestDistance) {
-                            closestDistance = distance;
-                            closestEntity = entityId;
-                            closestPosition = entityPosition;
-                        }
-                    }
-                }
-            }
-        }
+// Reads one entity's element and decodes it to the logical vec4
+bool EntityBufferManager::readEntityElement(VkBuffer srcBuffer, uint32_t bufferType, uint32_t entityId, glm::vec4& value) const {
+    VkDeviceSize stride = schema.getStride(bufferType);
+    if (stride == 0) {
+        value = glm::vec4(0.0f);
+        return true;
     }
     
-    std::cout << "Cells searched: " << cellsChecked << ", Entities found: " << entitiesFound << std::endl;
-    
-    if (entitiesFound == 0) {
-        std::cout << "No entities found in nearby cells" << std::endl;
+    std::array<uint8_t, sizeof(glm::vec4)> element{};
+    if (!readGPUBuffer(srcBuffer, element.data(), stride, entityId * stride)) {
         return false;
     }
-    
-    // Calculate which cell the closest entity is actually in
-    glm::vec2 entityPos2D = glm::vec2(closestPosition);
-    glm::ivec2 entityGridCoord = glm::ivec2(glm::floor(entityPos2D / CELL_SIZE));
-    uint32_t entityX = static_cast<uint32_t>(entityGridCoord.x) & (GRID_WIDTH - 1);
-    uint32_t entityY = static_cast<uint32_t>(entityGridCoord.y) & (GRID_WIDTH - 1);
-    uint32_t entityCellIndex = entityX + entityY * GRID_WIDTH;
-    
-    // Fill in the debug info
-    info.entityId = closestEntity;
-    info.position = closestPosition;
-    info.spatialCell = entityCellIndex;
-    
-    // Read velocity for the closest entity
-    if (!readGPUBuffer(velocityBuffer.getBuffer(), 
-                      &info.velocity, sizeof(glm::vec4), 
-                      closestEntity * sizeof(glm::vec4))) {
-        info.velocity = glm::vec4(0.0f); // Fallback
-    }
-    
-    std::cout << "Closest entity: " << closestEntity << " at distance " << closestDistance << std::endl;
-    std::cout << "Entity position: (" << closestPosition.x << ", " << closestPosition.y << ")" << std::endl;
-    std::cout << "Entity cell: " << entityCellIndex << " (grid: " << entityX << ", " << entityY << ")" << std::endl;
-    std::cout << "Cell difference: clicked=" << clickedCellIndex << ", entity=" << entityCellIndex 
-              << " (diff=" << (int)entityCellIndex - (int)clickedCellIndex << ")" << std::endl;
-    
+    value = schema.unpackElement(bufferType, element.data());
     return true;
 }
 
@@ -307,16 +320,14 @@ bool EntityBufferManager::readbackEntityById(uint32_t entityId, EntityDebugInfo&
     info.entityId = entityId;
     
     // Read position
-    if (!readGPUBuffer(positionCoordinator.getPrimaryBuffer(), 
-                      &info.position, sizeof(glm::vec4), 
-                      entityId * sizeof(glm::vec4))) {
+    if (!readEntityElement(positionCoordinator.getPrimaryBuffer(), 
+                           EntityBufferType::POSITION_OUTPUT, entityId, info.position)) {
         return false;
     }
     
     // Read velocity
-    if (!readGPUBuffer(velocityBuffer.getBuffer(), 
-                      &info.velocity, sizeof(glm::vec4), 
-                      entityId * sizeof(glm::vec4))) {
+    if (!readEntityElement(velocityBuffer.getBuffer(), 
+                           EntityBufferType::VELOCITY, entityId, info.velocity)) {
         info.velocity = glm::vec4(0.0f);
     }
     
@@ -333,61 +344,8 @@ bool EntityBufferManager::readbackEntityById(uint32_t entityId, EntityDebugInfo&
     return true;
 }
 
-bool EntityBufferManager::readbackSpatialCell(uint32_t cellIndex, std::vector<uint32_t>& entityIds) const {
-    const uint32_t SPATIAL_MAP_SIZE = 4096; // 64x64
-    if (cellIndex >= SPATIAL_MAP_SIZE) {
-        return false;
-    }
-    
-    entityIds.clear();
-    
-    // Read the spatial cell entry (uvec2: entityId, nextIndex)
-    glm::uvec2 cellData;
-    if (!readGPUBuffer(spatialMapBuffer.getBuffer(), 
-                      &cellData, sizeof(glm::uvec2), 
-                      cellIndex * sizeof(glm::uvec2))) {
-        return false;
-    }
-    
-    std::cout << "DEBUG: Cell " << cellIndex << " raw data: entityId=" << cellData.x 
-              << ", next=" << cellData.y << std::endl;
-    
-    // Check if there's an entity in this cell
-    const uint32_t NULL_INDEX = 0xFFFFFFFF;
-    if (cellData.x == NULL_INDEX || cellData.x == 0) {
-        std::cout << "DEBUG: Empty cell (no entities)" << std::endl;
-        return true; // Empty cell
-    }
-    
-    // Looking at the GPU shader more carefully:
-    // atomicExchange(spatialMap.spatialCells[cellIndex].x, entityIndex) 
-    // spatialMap.spatialCells[cellIndex].y = oldHead
-    //
-    // This means:
-    // - .x contains the most recent entity ID added to this cell
-    // - .y contains the previous head (which could be another entity or NULL_INDEX)
-    //
-    // But there's a race condition issue: the .y gets overwritten each time
-    // So we can only reliably get the most recent entity in each cell
-    
-    uint32_t headEntity = cellData.x;
-    if (headEntity != NULL_INDEX && headEntity < maxEntities) {
-        std::cout << "DEBUG: Found head entity " << headEntity << " in cell " << cellIndex << std::endl;
-        entityIds.push_back(headEntity);
-        
-        // Try to follow the chain, but this might not work reliably due to race conditions
-        uint32_t nextEntity = cellData.y;
-        if (nextEntity != NULL_INDEX && nextEntity < maxEntities && nextEntity != headEntity) {
-            std::cout << "DEBUG: Found next entity " << nextEntity << " in cell " << cellIndex << std::endl;
-            entityIds.push_back(nextEntity);
-        }
-    }
-    
-    return true;
-}
-
 bool EntityBufferManager::initializeSpatialMapBuffer() {
-    const uint32_t SPATIAL_MAP_SIZE = 4096; // 64x64 grid
+    const uint32_t SPATIAL_MAP_SIZE = MAX_SPATIAL_GRID_WIDTH * MAX_SPATIAL_GRID_WIDTH;
     const uint32_t NULL_INDEX = 0xFFFFFFFF;
     
     // Create initialization data with NULL values
@@ -408,26 +366,3 @@ bool EntityBufferManager::initializeSpatialMapBuffer() {
     
     return success;
 }
-
-bool EntityBufferManager::readbackEntityAtPositionSafe(glm::vec2 worldPos, EntityDebugInfo& info) const {
-    if (!context) {
-        std::cerr << "EntityBufferManager::readbackEntityAtPositionSafe - No Vulkan context available" << std::endl;
-        return false;
-    }
-    
-    // Wait for GPU to complete all operations to ensure spatial map is consistent
-    const auto& vk = context->getLoader();
-    const VkDevice device = context->getDevice();
-    
-    VkResult result = vk.vkDeviceWaitIdle(device);
-    if (result != VK_SUCCESS) {
-        std::cerr << "EntityBufferManager::readbackEntityAtPositionSafe - Failed to wait for GPU idle: " << result << std::endl;
-        return false;
-    }
-    
-    std::cout << "GPU synchronized - spatial map data should be consistent" << std::endl;
-    
-    // Now perform the readback with guaranteed consistent data
-    return readbackEntityAtPosition(worldPos, info);
-}
-
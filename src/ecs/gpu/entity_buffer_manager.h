@@ -3,6 +3,8 @@
 #include "specialized_buffers.h"
 #include "position_buffer_coordinator.h"
 #include "buffer_upload_service.h"
+#include "entity_schema.h"
+#include "../../vulkan/resources/core/resource_handle.h"
 #include <vulkan/vulkan.h>
 #include <memory>
 
@@ -19,7 +21,8 @@ public:
     EntityBufferManager();
     ~EntityBufferManager();
 
-    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities);
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                    const EntitySchema& schema = EntitySchema::legacy());
     void cleanup();
     
     // SoA buffer access - delegated to specialized buffers
@@ -30,6 +33,29 @@ public:
     VkBuffer getColorBuffer() const { return colorBuffer.getBuffer(); }
     VkBuffer getModelMatrixBuffer() const { return modelMatrixBuffer.getBuffer(); }
     VkBuffer getSpatialMapBuffer() const { return spatialMapBuffer.getBuffer(); }
+    VkBuffer getSpatialQueryBuffer() const { return spatialQueryBuffer.getBuffer(); }
+    VkBuffer getSpatialQueryResultBuffer() const { return spatialQueryResultBuffer.getBuffer(); }
+    VkBuffer getCollisionLinkBuffer() const { return collisionLinkBuffer.getBuffer(); }
+    VkBuffer getCollisionPairBuffer() const { return collisionPairBuffer.getBuffer(); }
+    VkBuffer getSpatialReorderBuffer() const { return spatialReorderBuffer.getBuffer(); }
+    VkBuffer getReorderScratchBuffer() const { return reorderScratchBuffer.getBuffer(); }
+    VkBuffer getDensityBuffer() const { return densityBuffer.getBuffer(); }
+    
+    // Per-entity columns that move with their row when entities are reordered, by EntityBufferType.
+    // The alternate and target position buffers are not read per row by any shader and stay as they are
+    static constexpr uint32_t REORDERED_COLUMNS[] = {
+        EntityBufferType::VELOCITY, EntityBufferType::MOVEMENT_PARAMS, EntityBufferType::RUNTIME_STATE,
+        EntityBufferType::ROTATION_STATE, EntityBufferType::COLOR, EntityBufferType::MODEL_MATRIX,
+        EntityBufferType::POSITION_OUTPUT, EntityBufferType::CURRENT_POSITION
+    };
+    VkBuffer getColumnBuffer(uint32_t bufferType) const;
+    VkDeviceAddress getColumnAddress(uint32_t bufferType) const;
+    
+    // Host-visible UBO of VkDeviceAddress[MAX_ENTITY_BUFFERS], one per REORDERED_COLUMNS entry and 0
+    // elsewhere, read by EntitySchema::ColumnAccess::DeviceAddress shaders. Its descriptor never
+    // changes; call publishColumnAddresses() after reallocating a column, once the GPU is done with the old one
+    VkBuffer getColumnAddressTable() const { return columnAddressTable.buffer.get(); }
+    void publishColumnAddresses();
     
     // Position buffers - delegated to coordinator
     VkBuffer getPositionBuffer() const { return positionCoordinator.getPrimaryBuffer(); }
@@ -52,6 +78,7 @@ public:
     VkDeviceSize getSpatialMapBufferSize() const { return spatialMapBuffer.getSize(); }
     VkDeviceSize getPositionBufferSize() const { return positionCoordinator.getBufferSize(); }
     uint32_t getMaxEntities() const { return maxEntities; }
+    const EntitySchema& getSchema() const { return schema; }
     
     
     // Data upload - using shared upload service
@@ -66,7 +93,8 @@ public:
     bool uploadSpatialMapData(const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
     bool uploadPositionDataToAllBuffers(const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
     
-    // Debug readback methods (expensive - use sparingly)
+    // Debug readback (synchronous - use sparingly). Position-based lookups go through
+    // GPUEntityManager::getSpatialQueries() instead
     struct EntityDebugInfo {
         glm::vec4 position;
         glm::vec4 velocity;
@@ -74,24 +102,23 @@ public:
         uint32_t entityId;
     };
     
-    bool readbackEntityAtPosition(glm::vec2 worldPos, EntityDebugInfo& info) const;
     bool readbackEntityById(uint32_t entityId, EntityDebugInfo& info) const;
-    bool readbackSpatialCell(uint32_t cellIndex, std::vector<uint32_t>& entityIds) const;
-    
-    // GPU-synchronized readback (waits for compute shader completion)
-    bool readbackEntityAtPositionSafe(glm::vec2 worldPos, EntityDebugInfo& info) const;
 
 private:
     // Configuration
     uint32_t maxEntities = 0;
     const VulkanContext* context = nullptr;
+    EntitySchema schema = EntitySchema::legacy();
     
     // Helper method for GPU readback
     bool readGPUBuffer(VkBuffer srcBuffer, void* dstData, VkDeviceSize size, VkDeviceSize offset) const;
+    bool readEntityElement(VkBuffer srcBuffer, uint32_t bufferType, uint32_t entityId, glm::vec4& value) const;
     
     // Initialize spatial map with NULL values
     bool initializeSpatialMapBuffer();
     
+    ResourceHandle columnAddressTable;
+    
     // Specialized buffer components (SRP-compliant)
     VelocityBuffer velocityBuffer;
     MovementParamsBuffer movementParamsBuffer;
@@ -100,6 +127,13 @@ private:
     ColorBuffer colorBuffer;
     ModelMatrixBuffer modelMatrixBuffer;
     SpatialMapBuffer spatialMapBuffer;
+    SpatialQueryBuffer spatialQueryBuffer;
+    SpatialQueryResultBuffer spatialQueryResultBuffer;
+    CollisionLinkBuffer collisionLinkBuffer;
+    CollisionPairBuffer collisionPairBuffer;
+    SpatialReorderBuffer spatialReorderBuffer;
+    ReorderScratchBuffer reorderScratchBuffer;
+    DensityBuffer densityBuffer;
     
     // Position buffer coordination
     PositionBufferCoordinator positionCoordinator;
@@ -108,4 +142,3 @@ private:
     BufferUploadService uploadService;
     
 };
-
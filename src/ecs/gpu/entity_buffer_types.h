@@ -26,14 +26,20 @@ namespace EntityBufferType {
     // Spatial optimization buffer
     constexpr uint32_t SPATIAL_MAP = 8;        // uvec2[]: spatial hash grid for collision detection
     
-    // Reserved slots for future expansion
-    constexpr uint32_t RESERVED_9 = 9;
-    constexpr uint32_t RESERVED_10 = 10;
-    constexpr uint32_t RESERVED_11 = 11;
-    constexpr uint32_t RESERVED_12 = 12;
-    constexpr uint32_t RESERVED_13 = 13;
-    constexpr uint32_t RESERVED_14 = 14;
-    constexpr uint32_t RESERVED_15 = 15;
+    // Batched spatial queries (SpatialQueryNode)
+    constexpr uint32_t SPATIAL_QUERIES = 9;        // {vec4 params, uvec4 info}[]: queries for the current frame
+    constexpr uint32_t SPATIAL_QUERY_RESULTS = 10; // uvec4[]: per-query headers, then hit records
+    
+    // Collision pipeline (CollisionNode)
+    constexpr uint32_t COLLISION_LINKS = 11;       // uvec2[]: next entity in cell, contact partner
+    constexpr uint32_t COLLISION_PAIRS = 12;       // uvec4 indirect header, then uvec2 candidate pairs
+    
+    // Spatial row reordering (SpatialReorderNode)
+    constexpr uint32_t SPATIAL_REORDER = 13;       // uint[]: stats header, then sort keys, permutation, inverse
+    constexpr uint32_t REORDER_SCRATCH = 14;       // uint[]: one column staged for the permutation gather
+    
+    // Zoomed-out density LOD (EntityGraphicsNode)
+    constexpr uint32_t DENSITY = 15;               // uvec4[]: per screen texel summed color.rgb, entity count
     
     // Maximum number of entity buffers supported
     constexpr uint32_t MAX_ENTITY_BUFFERS = 16;
@@ -55,6 +61,13 @@ namespace EntityBufferType {
             case POSITION_OUTPUT: return "PositionOutputBuffer";
             case CURRENT_POSITION: return "CurrentPositionBuffer";
             case SPATIAL_MAP: return "SpatialMapBuffer";
+            case SPATIAL_QUERIES: return "SpatialQueryBuffer";
+            case SPATIAL_QUERY_RESULTS: return "SpatialQueryResultBuffer";
+            case COLLISION_LINKS: return "CollisionLinkBuffer";
+            case COLLISION_PAIRS: return "CollisionPairBuffer";
+            case SPATIAL_REORDER: return "SpatialReorderBuffer";
+            case REORDER_SCRATCH: return "ReorderScratchBuffer";
+            case DENSITY: return "DensityBuffer";
             default: return "ReservedBuffer";
         }
     }
@@ -472,7 +472,7 @@ bool EntityDescriptorManager::createIndexedDescriptorSet() {
 
     // Create descriptor pool for indexed descriptors
     std::vector<VkDescriptorPoolSize> poolSizes;
-    poolSizes.push_back({VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1}); // For camera matrices
+    poolSizes.push_back({VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2}); // Camera matrices, column address table
     poolSizes.push_back({VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, EntityBufferType::MAX_ENTITY_BUFFERS + 1}); // +1 for spatial map
 
     VkDescriptorPoolCreateInfo poolInfo{};
@@ -563,7 +563,14 @@ bool EntityDescriptorManager::updateIndexedDescriptorSet() {
         {EntityBufferType::MODEL_MATRIX, bufferManager->getModelMatrixBuffer(), "ModelMatrixBuffer"},
         {EntityBufferType::POSITION_OUTPUT, bufferManager->getPositionBuffer(), "PositionOutputBuffer"},
         {EntityBufferType::CURRENT_POSITION, bufferManager->getCurrentPositionBuffer(), "CurrentPositionBuffer"},
-        {EntityBufferType::SPATIAL_MAP, bufferManager->getSpatialMapBuffer(), "SpatialMapBuffer"}
+        {EntityBufferType::SPATIAL_MAP, bufferManager->getSpatialMapBuffer(), "SpatialMapBuffer"},
+        {EntityBufferType::SPATIAL_QUERIES, bufferManager->getSpatialQueryBuffer(), "SpatialQueryBuffer"},
+        {EntityBufferType::SPATIAL_QUERY_RESULTS, bufferManager->getSpatialQueryResultBuffer(), "SpatialQueryResultBuffer"},
+        {EntityBufferType::COLLISION_LINKS, bufferManager->getCollisionLinkBuffer(), "CollisionLinkBuffer"},
+        {EntityBufferType::COLLISION_PAIRS, bufferManager->getCollisionPairBuffer(), "CollisionPairBuffer"},
+        {EntityBufferType::SPATIAL_REORDER, bufferManager->getSpatialReorderBuffer(), "SpatialReorderBuffer"},
+        {EntityBufferType::REORDER_SCRATCH, bufferManager->getReorderScratchBuffer(), "ReorderScratchBuffer"},
+        {EntityBufferType::DENSITY, bufferManager->getDensityBuffer(), "DensityBuffer"}
     };
 
     // Update each buffer in the indexed array
@@ -602,6 +609,22 @@ bool EntityDescriptorManager::updateIndexedDescriptorSet() {
         
         writes.push_back(spatialMapWrite);
     }
+    
+    // Column address table (binding 3). Written once: reallocated columns republish their
+    // addresses into the same buffer, so address-mode shaders need no descriptor updates
+    VkDescriptorBufferInfo columnAddressInfo = {bufferManager->getColumnAddressTable(), 0, VK_WHOLE_SIZE};
+    if (columnAddressInfo.buffer != VK_NULL_HANDLE) {
+        VkWriteDescriptorSet columnAddressWrite{};
+        columnAddressWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        columnAddressWrite.dstSet = indexedDescriptorSet;
+        columnAddressWrite.dstBinding = 3;
+        columnAddressWrite.dstArrayElement = 0;
+        columnAddressWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        columnAddressWrite.descriptorCount = 1;
+        columnAddressWrite.pBufferInfo = &columnAddressInfo;
+        
+        writes.push_back(columnAddressWrite);
+    }
 
     if (!writes.empty()) {
         getContext()->getLoader().vkUpdateDescriptorSets(
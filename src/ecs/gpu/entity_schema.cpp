@@ -0,0 +1,468 @@
+#include "entity_schema.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    // Columns reachable through entity_schema.glsl accessors, in buffer index order
+    struct ColumnAccessor {
+        uint32_t bufferType;
+        const char* accessorName;   // loadX / storeX
+        const char* indexName;      // GLSL index constant
+    };
+
+    constexpr ColumnAccessor COLUMN_ACCESSORS[] = {
+        {EntityBufferType::VELOCITY,         "Velocity",        "VELOCITY_BUFFER"},
+        {EntityBufferType::MOVEMENT_PARAMS,  "MovementParams",  "MOVEMENT_PARAMS_BUFFER"},
+        {EntityBufferType::RUNTIME_STATE,    "RuntimeState",    "RUNTIME_STATE_BUFFER"},
+        {EntityBufferType::ROTATION_STATE,   "RotationState",   "ROTATION_STATE_BUFFER"},
+        {EntityBufferType::COLOR,            "Color",           "COLOR_BUFFER"},
+        {EntityBufferType::MODEL_MATRIX,     "ModelMatrix",     "MODEL_MATRIX_BUFFER"},
+        {EntityBufferType::POSITION_OUTPUT,  "Position",        "POSITION_OUTPUT_BUFFER"},
+        {EntityBufferType::CURRENT_POSITION, "CurrentPosition", "CURRENT_POSITION_BUFFER"},
+    };
+
+    // Aliased views of the bindless entity buffer array, one per element type in use
+    const char* getViewName(ColumnFormat format) {
+        switch (format) {
+            case ColumnFormat::VEC4_F32:
+            case ColumnFormat::MAT4_F32: return "entityBuffersVec4";
+            case ColumnFormat::VEC2_F32: return "entityBuffersVec2";
+            case ColumnFormat::VEC4_F16: return "entityBuffersUvec2";
+            case ColumnFormat::VEC2_F16:
+            case ColumnFormat::RGBA8_UNORM: return "entityBuffersUint";
+            case ColumnFormat::DROPPED: return nullptr;
+        }
+        return nullptr;
+    }
+
+    const char* getViewElementType(ColumnFormat format) {
+        switch (format) {
+            case ColumnFormat::VEC4_F32:
+            case ColumnFormat::MAT4_F32: return "vec4";
+            case ColumnFormat::VEC2_F32: return "vec2";
+            case ColumnFormat::VEC4_F16: return "uvec2";
+            case ColumnFormat::VEC2_F16:
+            case ColumnFormat::RGBA8_UNORM: return "uint";
+            case ColumnFormat::DROPPED: return nullptr;
+        }
+        return nullptr;
+    }
+
+    // buffer_reference alignment of one view element
+    uint32_t getViewElementAlign(ColumnFormat format) {
+        switch (format) {
+            case ColumnFormat::VEC4_F32:
+            case ColumnFormat::MAT4_F32: return 16;
+            case ColumnFormat::VEC2_F32:
+            case ColumnFormat::VEC4_F16: return 8;
+            case ColumnFormat::VEC2_F16:
+            case ColumnFormat::RGBA8_UNORM: return 4;
+            case ColumnFormat::DROPPED: return 0;
+        }
+        return 0;
+    }
+
+    // Block name of a view: EntityBuffersVec4 for the descriptor array, EntityColumnVec4 for buffer_reference
+    std::string getViewBlockName(ColumnFormat format, ColumnAccess access) {
+        const std::string view = getViewName(format);
+        const std::string suffix = view.substr(std::strlen("entityBuffers"));
+        return (access == ColumnAccess::DeviceAddress ? "EntityColumn" : "EntityBuffers") + suffix;
+    }
+
+    // GLSL expression for one column's block: an array element, or a reference built from the
+    // address table (column c lives in entityColumnAddresses[c / 2].xy or .zw)
+    std::string getColumnReference(const ColumnAccessor& column, ColumnFormat format, ColumnAccess access) {
+        const char* view = getViewName(format);
+        if (!view) {
+            return "";
+        }
+        if (access == ColumnAccess::DeviceAddress) {
+            return getViewBlockName(format, access) + "(entityColumnAddresses[" + std::to_string(column.bufferType / 2) + "]."
+                   + (column.bufferType % 2 == 0 ? "xy" : "zw") + ")";
+        }
+        return std::string(view) + "[" + column.indexName + "]";
+    }
+
+    uint32_t packUnorm8(float value) {
+        return static_cast<uint32_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+    }
+
+    uint32_t packHalf2(float x, float y) {
+        return uint32_t(EntitySchemaFormats::floatToHalf(x)) | (uint32_t(EntitySchemaFormats::floatToHalf(y)) << 16);
+    }
+
+    void appendWords(std::vector<uint8_t>& packed, const void* words, size_t bytes) {
+        const uint8_t* begin = static_cast<const uint8_t*>(words);
+        packed.insert(packed.end(), begin, begin + bytes);
+    }
+
+    void generateAccessors(std::ostringstream& glsl, const ColumnAccessor& column, ColumnFormat format,
+                           const std::string& columnRef) {
+        const std::string name = column.accessorName;
+
+        if (format == ColumnFormat::MAT4_F32) {
+            glsl << "mat4 load" << name << "(uint i) {\n"
+                 << "    return mat4(" << columnRef << ".data[i * 4u], "
+                 << columnRef << ".data[i * 4u + 1u],\n"
+                 << "                " << columnRef << ".data[i * 4u + 2u], "
+                 << columnRef << ".data[i * 4u + 3u]);\n}\n";
+            glsl << "#ifndef ENTITY_SCHEMA_READONLY\n"
+                 << "void store" << name << "(uint i, mat4 m) {\n"
+                 << "    for (uint c = 0u; c < 4u; c++) " << columnRef << ".data[i * 4u + c] = m[c];\n}\n"
+                 << "#endif\n";
+            return;
+        }
+
+        // Model matrices stay mat4 even when dropped so shader code compiles against every schema
+        if (format == ColumnFormat::DROPPED && column.bufferType == EntityBufferType::MODEL_MATRIX) {
+            glsl << "mat4 load" << name << "(uint i) { return mat4(1.0); }\n"
+                 << "#ifndef ENTITY_SCHEMA_READONLY\n"
+                 << "void store" << name << "(uint i, mat4 m) {}\n"
+                 << "#endif\n";
+            return;
+        }
+
+        std::string element = columnRef + ".data[i]";
+        std::string load;
+        std::string store;
+        switch (format) {
+            case ColumnFormat::VEC4_F32:
+                load = element;
+                store = element + " = v";
+                break;
+            case ColumnFormat::VEC2_F32:
+                load = "vec4(" + element + ", 0.0, 0.0)";
+                store = element + " = v.xy";
+                break;
+            case ColumnFormat::VEC4_F16:
+                load = "vec4(unpackHalf2x16(" + element + ".x), unpackHalf2x16(" + element + ".y))";
+                store = element + " = uvec2(packHalf2x16(v.xy), packHalf2x16(v.zw))";
+                break;
+            case ColumnFormat::VEC2_F16:
+                load = "vec4(unpackHalf2x16(" + element + "), 0.0, 0.0)";
+                store = element + " = packHalf2x16(v.xy)";
+                break;
+            case ColumnFormat::RGBA8_UNORM:
+                load = "unpackUnorm4x8(" + element + ")";
+                store = element + " = packUnorm4x8(v)";
+                break;
+            case ColumnFormat::DROPPED:
+            case ColumnFormat::MAT4_F32:
+                load = "vec4(0.0)";
+                break;
+        }
+
+        glsl << "vec4 load" << name << "(uint i) { return " << load << "; }\n"
+             << "#ifndef ENTITY_SCHEMA_READONLY\n"
+             << "void store" << name << "(uint i, vec4 v) {" << (store.empty() ? "" : " " + store + ";") << " }\n"
+             << "#endif\n";
+    }
+}
+
+EntitySchema::EntitySchema(const char* name, const std::array<ColumnFormat, EntityBufferType::MAX_ENTITY_BUFFERS>& formats)
+    : name(name)
+    , formats(formats) {
+}
+
+EntitySchema EntitySchema::legacy() {
+    std::array<ColumnFormat, EntityBufferType::MAX_ENTITY_BUFFERS> formats;
+    formats.fill(ColumnFormat::DROPPED);
+    formats[EntityBufferType::VELOCITY] = ColumnFormat::VEC4_F32;
+    formats[EntityBufferType::MOVEMENT_PARAMS] = ColumnFormat::VEC4_F32;
+    formats[EntityBufferType::RUNTIME_STATE] = ColumnFormat::VEC4_F32;
+    formats[EntityBufferType::ROTATION_STATE] = ColumnFormat::VEC4_F32;
+    formats[EntityBufferType::COLOR] = ColumnFormat::VEC4_F32;
+    formats[EntityBufferType::MODEL_MATRIX] = ColumnFormat::MAT4_F32;
+    formats[EntityBufferType::POSITION_OUTPUT] = ColumnFormat::VEC4_F32;
+    formats[EntityBufferType::CURRENT_POSITION] = ColumnFormat::VEC4_F32;
+    return EntitySchema("legacy", formats);
+}
+
+EntitySchema EntitySchema::compact() {
+    std::array<ColumnFormat, EntityBufferType::MAX_ENTITY_BUFFERS> formats;
+    formats.fill(ColumnFormat::DROPPED);
+    // Velocity is damped every frame, so it keeps fp32 to avoid drift; damping/reserved lanes are unused
+    formats[EntityBufferType::VELOCITY] = ColumnFormat::VEC2_F32;
+    formats[EntityBufferType::MOVEMENT_PARAMS] = ColumnFormat::VEC4_F16;
+    formats[EntityBufferType::RUNTIME_STATE] = ColumnFormat::VEC4_F16;
+    formats[EntityBufferType::ROTATION_STATE] = ColumnFormat::VEC4_F16;
+    formats[EntityBufferType::COLOR] = ColumnFormat::RGBA8_UNORM;
+    formats[EntityBufferType::MODEL_MATRIX] = ColumnFormat::DROPPED;
+    // Entities live in the z = 0 plane
+    formats[EntityBufferType::POSITION_OUTPUT] = ColumnFormat::VEC2_F32;
+    formats[EntityBufferType::CURRENT_POSITION] = ColumnFormat::VEC2_F32;
+    return EntitySchema("compact", formats);
+}
+
+ColumnFormat EntitySchema::getFormat(uint32_t bufferType) const {
+    return EntityBufferType::isValidBufferType(bufferType) ? formats[bufferType] : ColumnFormat::DROPPED;
+}
+
+VkDeviceSize EntitySchema::getStride(uint32_t bufferType) const {
+    return EntitySchemaFormats::getFormatStride(getFormat(bufferType));
+}
+
+VkDeviceSize EntitySchema::getBytesPerEntity() const {
+    VkDeviceSize total = 0;
+    for (const auto& column : COLUMN_ACCESSORS) {
+        total += getStride(column.bufferType);
+    }
+    return total;
+}
+
+void EntitySchema::packColumn(uint32_t bufferType, const glm::vec4* values, size_t count, std::vector<uint8_t>& packed) const {
+    const ColumnFormat format = getFormat(bufferType);
+    packed.reserve(packed.size() + count * getStride(bufferType));
+
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec4& value = values[i];
+        switch (format) {
+            case ColumnFormat::VEC4_F32: {
+                float words[4] = {value.x, value.y, value.z, value.w};
+                appendWords(packed, words, sizeof(words));
+                break;
+            }
+            case ColumnFormat::VEC2_F32: {
+                float words[2] = {value.x, value.y};
+                appendWords(packed, words, sizeof(words));
+                break;
+            }
+            case ColumnFormat::VEC4_F16: {
+                uint32_t words[2] = {packHalf2(value.x, value.y), packHalf2(value.z, value.w)};
+                appendWords(packed, words, sizeof(words));
+                break;
+            }
+            case ColumnFormat::VEC2_F16: {
+                uint32_t word = packHalf2(value.x, value.y);
+                appendWords(packed, &word, sizeof(word));
+                break;
+            }
+            case ColumnFormat::RGBA8_UNORM: {
+                uint32_t word = packUnorm8(value.x) | (packUnorm8(value.y) << 8) |
+                                (packUnorm8(value.z) << 16) | (packUnorm8(value.w) << 24);
+                appendWords(packed, &word, sizeof(word));
+                break;
+            }
+            case ColumnFormat::DROPPED:
+                return;
+            case ColumnFormat::MAT4_F32:
+                std::cerr << "EntitySchema: " << EntityBufferType::getBufferName(bufferType)
+                          << " stores matrices, cannot pack vec4 values" << std::endl;
+                return;
+        }
+    }
+}
+
+void EntitySchema::packColumn(uint32_t bufferType, const glm::mat4* values, size_t count, std::vector<uint8_t>& packed) const {
+    const ColumnFormat format = getFormat(bufferType);
+    if (format == ColumnFormat::DROPPED) {
+        return;
+    }
+    if (format != ColumnFormat::MAT4_F32) {
+        std::cerr << "EntitySchema: " << EntityBufferType::getBufferName(bufferType)
+                  << " is not a matrix column" << std::endl;
+        return;
+    }
+    appendWords(packed, values, count * sizeof(glm::mat4));
+}
+
+glm::vec4 EntitySchema::unpackElement(uint32_t bufferType, const void* element) const {
+    uint32_t words[4] = {};
+    std::memcpy(words, element, std::min<VkDeviceSize>(getStride(bufferType), sizeof(words)));
+
+    auto asFloat = [](uint32_t word) {
+        float value;
+        std::memcpy(&value, &word, sizeof(value));
+        return value;
+    };
+    auto lowHalf = [](uint32_t word) { return EntitySchemaFormats::halfToFloat(static_cast<uint16_t>(word & 0xFFFFu)); };
+    auto highHalf = [](uint32_t word) { return EntitySchemaFormats::halfToFloat(static_cast<uint16_t>(word >> 16)); };
+    auto unorm = [](uint32_t word, uint32_t lane) { return float((word >> (lane * 8)) & 0xFFu) / 255.0f; };
+
+    switch (getFormat(bufferType)) {
+        case ColumnFormat::VEC4_F32:
+        case ColumnFormat::MAT4_F32:  // First column
+            return glm::vec4(asFloat(words[0]), asFloat(words[1]), asFloat(words[2]), asFloat(words[3]));
+        case ColumnFormat::VEC2_F32:
+            return glm::vec4(asFloat(words[0]), asFloat(words[1]), 0.0f, 0.0f);
+        case ColumnFormat::VEC4_F16:
+            return glm::vec4(lowHalf(words[0]), highHalf(words[0]), lowHalf(words[1]), highHalf(words[1]));
+        case ColumnFormat::VEC2_F16:
+            return glm::vec4(lowHalf(words[0]), highHalf(words[0]), 0.0f, 0.0f);
+        case ColumnFormat::RGBA8_UNORM:
+            return glm::vec4(unorm(words[0], 0), unorm(words[0], 1), unorm(words[0], 2), unorm(words[0], 3));
+        case ColumnFormat::DROPPED:
+            break;
+    }
+    return glm::vec4(0.0f);
+}
+
+std::string EntitySchema::generateGLSL() const {
+    std::ostringstream glsl;
+    glsl << "// Generated by EntitySchema::generateGLSL() for the \"" << name << "\" schema ("
+         << getBytesPerEntity() << " bytes/entity) - do not edit.\n"
+         << "// Requires GL_EXT_nonuniform_qualifier. Define ENTITY_SCHEMA_READONLY for read-only stages.\n"
+         << "#ifndef ENTITY_SCHEMA_GLSL\n"
+         << "#define ENTITY_SCHEMA_GLSL\n\n";
+
+    // Must precede every declaration, so the include goes right after the shader's own #extension lines
+    if (columnAccess == ColumnAccess::DeviceAddress) {
+        glsl << "#extension GL_EXT_buffer_reference : require\n"
+             << "#extension GL_EXT_buffer_reference_uvec2 : require\n\n";
+    }
+
+    // Index constants, matching EntityBufferType in C++
+    for (const auto& column : COLUMN_ACCESSORS) {
+        glsl << "const uint " << column.indexName << " = " << column.bufferType << "u;\n";
+    }
+    glsl << "const uint SPATIAL_MAP_BUFFER = " << EntityBufferType::SPATIAL_MAP << "u;\n"
+         << "const uint SPATIAL_QUERY_BUFFER = " << EntityBufferType::SPATIAL_QUERIES << "u;\n"
+         << "const uint SPATIAL_QUERY_RESULT_BUFFER = " << EntityBufferType::SPATIAL_QUERY_RESULTS << "u;\n"
+         << "const uint COLLISION_LINK_BUFFER = " << EntityBufferType::COLLISION_LINKS << "u;\n"
+         << "const uint COLLISION_PAIR_BUFFER = " << EntityBufferType::COLLISION_PAIRS << "u;\n"
+         << "const uint SPATIAL_REORDER_BUFFER = " << EntityBufferType::SPATIAL_REORDER << "u;\n"
+         << "const uint REORDER_SCRATCH_BUFFER = " << EntityBufferType::REORDER_SCRATCH << "u;\n"
+         << "const uint DENSITY_BUFFER = " << EntityBufferType::DENSITY << "u;\n"
+         << "const uint MAX_ENTITY_BUFFERS = " << EntityBufferType::MAX_ENTITY_BUFFERS << "u;\n\n";
+
+    glsl << "#ifdef ENTITY_SCHEMA_READONLY\n"
+         << "#define ENTITY_SCHEMA_ACCESS readonly\n"
+         << "#else\n"
+         << "#define ENTITY_SCHEMA_ACCESS\n"
+         << "#endif\n\n";
+
+    // One aliased declaration of binding 1 (or one buffer_reference type) per element type in use
+    std::vector<std::string> declaredViews;
+    for (const auto& column : COLUMN_ACCESSORS) {
+        const ColumnFormat format = getFormat(column.bufferType);
+        const char* view = getViewName(format);
+        if (!view || std::find(declaredViews.begin(), declaredViews.end(), view) != declaredViews.end()) {
+            continue;
+        }
+        declaredViews.push_back(view);
+
+        const std::string blockName = getViewBlockName(format, columnAccess);
+        if (columnAccess == ColumnAccess::DeviceAddress) {
+            glsl << "layout(std430, buffer_reference, buffer_reference_align = " << getViewElementAlign(format)
+                 << ") ENTITY_SCHEMA_ACCESS buffer " << blockName << " {\n"
+                 << "    " << getViewElementType(format) << " data[];\n"
+                 << "};\n\n";
+        } else {
+            glsl << "layout(std430, binding = 1) ENTITY_SCHEMA_ACCESS buffer " << blockName << " {\n"
+                 << "    " << getViewElementType(format) << " data[];\n"
+                 << "} " << view << "[];\n\n";
+        }
+    }
+
+    // Filled by EntityBufferManager::publishColumnAddresses(), two VkDeviceAddresses per entry
+    if (columnAccess == ColumnAccess::DeviceAddress) {
+        glsl << "layout(std140, binding = 3) uniform EntityColumnAddresses {\n"
+             << "    uvec4 entityColumnAddresses[" << EntityBufferType::MAX_ENTITY_BUFFERS / 2 << "];\n"
+             << "};\n\n";
+    }
+
+    for (const auto& column : COLUMN_ACCESSORS) {
+        const ColumnFormat format = getFormat(column.bufferType);
+        glsl << "// " << EntityBufferType::getBufferName(column.bufferType) << ": "
+             << EntitySchemaFormats::getFormatName(format) << "\n";
+        generateAccessors(glsl, column, format, getColumnReference(column, format, columnAccess));
+        glsl << "\n";
+    }
+
+    glsl << "#endif // ENTITY_SCHEMA_GLSL\n";
+    return glsl.str();
+}
+
+namespace EntitySchemaFormats {
+
+VkDeviceSize getFormatStride(ColumnFormat format) {
+    switch (format) {
+        case ColumnFormat::VEC4_F32: return 16;
+        case ColumnFormat::VEC2_F32: return 8;
+        case ColumnFormat::VEC4_F16: return 8;
+        case ColumnFormat::VEC2_F16: return 4;
+        case ColumnFormat::RGBA8_UNORM: return 4;
+        case ColumnFormat::MAT4_F32: return 64;
+        case ColumnFormat::DROPPED: return 0;
+    }
+    return 0;
+}
+
+const char* getFormatName(ColumnFormat format) {
+    switch (format) {
+        case ColumnFormat::VEC4_F32: return "vec4 fp32";
+        case ColumnFormat::VEC2_F32: return "vec2 fp32";
+        case ColumnFormat::VEC4_F16: return "vec4 fp16";
+        case ColumnFormat::VEC2_F16: return "vec2 fp16";
+        case ColumnFormat::RGBA8_UNORM: return "rgba8 unorm";
+        case ColumnFormat::MAT4_F32: return "mat4 fp32";
+        case ColumnFormat::DROPPED: return "dropped";
+    }
+    return "unknown";
+}
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (exponent == 0xFFu) {
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));  // Inf / NaN
+    }
+
+    const int32_t halfExponent = static_cast<int32_t>(exponent) - 127 + 15;
+    if (halfExponent >= 0x1F) {
+        return static_cast<uint16_t>(sign | 0x7C00u);  // Overflow to infinity
+    }
+
+    if (halfExponent <= 0) {
+        if (halfExponent < -10) {
+            return static_cast<uint16_t>(sign);  // Underflow to zero
+        }
+        // Subnormal: shift the implicit bit into the 10-bit mantissa
+        mantissa |= 0x800000u;
+        const uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+        uint32_t halfMantissa = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (halfMantissa & 1u))) {
+            halfMantissa++;
+        }
+        return static_cast<uint16_t>(sign | halfMantissa);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        half++;  // A carry into the exponent is the correct rounding, up to infinity
+    }
+    return static_cast<uint16_t>(half);
+}
+
+float halfToFloat(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    const uint32_t mantissa = value & 0x3FFu;
+
+    uint32_t bits;
+    if (exponent == 0) {
+        float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    } else if (exponent == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "entity_buffer_types.h"
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Storage format of one SoA entity column. Shaders and the CPU always see a logical
+ * vec4 (or mat4) per entity; the format only decides how many of those lanes are
+ * stored and at what precision.
+ */
+enum class ColumnFormat : uint32_t {
+    VEC4_F32,       // 16 B - all four lanes, full precision
+    VEC2_F32,       //  8 B - xy only, zw read back as 0
+    VEC4_F16,       //  8 B - four half floats (two packHalf2x16 words)
+    VEC2_F16,       //  4 B - xy as half floats
+    RGBA8_UNORM,    //  4 B - packUnorm4x8, lanes clamped to [0, 1]
+    MAT4_F32,       // 64 B - model matrices only
+    DROPPED         //  0 B - not stored; loads return the default, stores are no-ops
+};
+
+/**
+ * How the generated accessors reach the column buffers. Only the column accessors change;
+ * spatial, query, collision and density buffers stay on the descriptor array either way.
+ */
+enum class ColumnAccess : uint32_t {
+    DescriptorIndexed,  // Aliased views of the binding 1 array, indexed by EntityBufferType
+    DeviceAddress       // buffer_reference through the binding 3 address table (bufferDeviceAddress)
+};
+
+/**
+ * Entity column layout shared by the GPU buffers, the upload path and the shaders.
+ *
+ * Each EntityBufferType column picks a ColumnFormat. EntityBufferManager sizes its
+ * buffers from getStride(), GPUEntityManager packs uploads with packColumn(), and
+ * generateGLSL() emits the load/store accessors the entity shaders include as
+ * "entity_schema.glsl", so the three can never disagree.
+ *
+ * Position output, current, target and alternate position buffers share one format
+ * because they are uploaded and ping-ponged as a group.
+ */
+class EntitySchema {
+public:
+    static constexpr const char* GLSL_INCLUDE_NAME = "entity_schema.glsl";
+
+    // All vec4/mat4 - matches SPIR-V precompiled by compile-shaders.sh
+    static EntitySchema legacy();
+
+    // vec2 fp32 positions and velocity, fp16 params/state/rotation, RGBA8 colour, no model matrix
+    static EntitySchema compact();
+
+    const char* getName() const { return name; }
+    ColumnFormat getFormat(uint32_t bufferType) const;
+
+    // Bytes per entity in the GPU column, 0 when dropped
+    VkDeviceSize getStride(uint32_t bufferType) const;
+    VkDeviceSize getBytesPerEntity() const;
+
+    // Pack logical values into column storage, appending count * getStride() bytes
+    void packColumn(uint32_t bufferType, const glm::vec4* values, size_t count, std::vector<uint8_t>& packed) const;
+    void packColumn(uint32_t bufferType, const glm::mat4* values, size_t count, std::vector<uint8_t>& packed) const;
+
+    // Decode one element read back from the GPU (getStride() bytes)
+    glm::vec4 unpackElement(uint32_t bufferType, const void* element) const;
+
+    // Defaults to DescriptorIndexed, the only mode the precompiled SPIR-V supports
+    void setColumnAccess(ColumnAccess access) { columnAccess = access; }
+    ColumnAccess getColumnAccess() const { return columnAccess; }
+
+    // Buffer views, index constants and accessors for every column. Define ENTITY_SCHEMA_READONLY
+    // before including to get readonly views and no store functions (vertex stage)
+    std::string generateGLSL() const;
+
+private:
+    EntitySchema(const char* name, const std::array<ColumnFormat, EntityBufferType::MAX_ENTITY_BUFFERS>& formats);
+
+    const char* name;
+    std::array<ColumnFormat, EntityBufferType::MAX_ENTITY_BUFFERS> formats;
+    ColumnAccess columnAccess = ColumnAccess::DescriptorIndexed;
+};
+
+// Format helpers shared with tooling
+namespace EntitySchemaFormats {
+    VkDeviceSize getFormatStride(ColumnFormat format);
+    const char* getFormatName(ColumnFormat format);
+
+    // IEEE 754 binary16 conversion, round to nearest even - matches packHalf2x16/unpackHalf2x16
+    uint16_t floatToHalf(float value);
+    float halfToFloat(uint16_t value);
+}
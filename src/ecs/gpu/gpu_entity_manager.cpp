@@ -8,50 +8,21 @@
 #include <cstring>
 #include <random>
 #include <array>
+#include <algorithm>
 
 // Static RNG for performance - initialized once per thread
 thread_local std::mt19937 rng{std::random_device{}()};
-thread_local std::uniform_real_distribution<float> stateTimerDist{0.0f, 600.0f};
+thread_local std::uniform_real_distribution<float> stateTimerDist{0.0f, GPUEntitySoA::MAX_STATE_TIMER};
+
+void GPUEntitySoA::seedStateTimers(uint32_t seed) {
+    if (seed != 0) {
+        rng.seed(seed);
+    }
+}
 
 void GPUEntitySoA::addFromECS(const Transform& transform, const Renderable& renderable, const MovementPattern& pattern) {
-    // Velocity (initialized to zero, set by compute shader)
-    velocities.emplace_back(
-        0.0f,                      // velocity.x
-        0.0f,                      // velocity.y  
-        0.001f,                    // damping factor
-        0.0f                       // reserved
-    );
-    
-    // Movement parameters
-    movementParams.emplace_back(
-        pattern.amplitude,
-        pattern.frequency, 
-        pattern.phase,
-        pattern.timeOffset
-    );
-    
-    // Runtime state
-    runtimeStates.emplace_back(
-        0.0f,                          // totalTime (updated by compute shader)
-        0.0f,                          // reserved 
-        stateTimerDist(rng),           // stateTimer (random staggering)
-        0.0f                           // initialized flag (starts as 0.0)
-    );
-    
-    // Rotation state (initialized to default values)
-    // Start with zero rotation for simplicity
-    rotationStates.emplace_back(
-        0.0f,                          // current rotation angle in radians
-        0.0f,                          // angular velocity (rad/s)
-        0.999f,                        // angular damping factor (lighter damping)
-        0.0f                           // reserved
-    );
-    
-    // Color
-    colors.emplace_back(renderable.color);
-    
-    // Model matrix  
-    modelMatrices.emplace_back(transform.getMatrix());
+    size_t row = appendRows(1);
+    writeRow(row, transform.getMatrix(), renderable.color, pattern, stateTimerDist(rng));
 }
 
 
@@ -62,13 +33,14 @@ GPUEntityManager::~GPUEntityManager() {
     cleanup();
 }
 
-bool GPUEntityManager::initialize(const VulkanContext& context, VulkanSync* sync, ResourceCoordinator* resourceCoordinator) {
+bool GPUEntityManager::initialize(const VulkanContext& context, VulkanSync* sync, ResourceCoordinator* resourceCoordinator,
+                                  const EntitySchema& schema) {
     this->context = &context;
     this->sync = sync;
     this->resourceCoordinator = resourceCoordinator;
     
     // Initialize buffer manager
-    if (!bufferManager.initialize(context, resourceCoordinator, MAX_ENTITIES)) {
+    if (!bufferManager.initialize(context, resourceCoordinator, MAX_ENTITIES, schema)) {
         std::cerr << "GPUEntityManager: Failed to initialize buffer manager" << std::endl;
         return false;
     }
@@ -85,6 +57,26 @@ bool GPUEntityManager::initialize(const VulkanContext& context, VulkanSync* sync
         return false;
     }
     
+    if (!positionReadback.initialize(context, resourceCoordinator, bufferManager.getSchema())) {
+        std::cerr << "GPUEntityManager: Failed to initialize position readback ring" << std::endl;
+        return false;
+    }
+    
+    if (!spatialQueries.initialize(context, resourceCoordinator)) {
+        std::cerr << "GPUEntityManager: Failed to initialize spatial query batch" << std::endl;
+        return false;
+    }
+    
+    if (!snapshot.initialize(context, resourceCoordinator)) {
+        std::cerr << "GPUEntityManager: Failed to initialize simulation snapshot" << std::endl;
+        return false;
+    }
+    
+    if (!spatialReorder.initialize(context, resourceCoordinator, MAX_ENTITIES)) {
+        std::cerr << "GPUEntityManager: Failed to initialize spatial reorder" << std::endl;
+        return false;
+    }
+    
     std::cout << "GPUEntityManager: Initialized successfully with descriptor manager" << std::endl;
     return true;
 }
@@ -92,6 +84,12 @@ bool GPUEntityManager::initialize(const VulkanContext& context, VulkanSync* sync
 void GPUEntityManager::cleanup() {
     if (!context) return;
     
+    // Readback slots reference nothing else, release them first
+    spatialReorder.cleanup();
+    snapshot.cleanup();
+    spatialQueries.cleanup();
+    positionReadback.cleanup();
+    
     // Cleanup descriptor manager first
     descriptorManager.cleanup();
     
@@ -102,7 +100,7 @@ void GPUEntityManager::cleanup() {
 
 void GPUEntityManager::addEntitiesFromECS(const std::vector<flecs::entity>& entities) {
     for (const auto& entity : entities) {
-        if (activeEntityCount + stagingEntities.size() >= MAX_ENTITIES) {
+        if (firstStagedRow() + stagingEntities.size() >= MAX_ENTITIES) {
             std::cerr << "GPUEntityManager: Reached max capacity, stopping entity addition" << std::endl;
             break;
         }
@@ -116,7 +114,7 @@ void GPUEntityManager::addEntitiesFromECS(const std::vector<flecs::entity>& enti
             stagingEntities.addFromECS(*transform, *renderable, *movement);
             
             // Store mapping from GPU buffer index to ECS entity ID for debugging
-            uint32_t gpuIndex = activeEntityCount + stagingEntities.size() - 1;
+            uint32_t gpuIndex = firstStagedRow() + stagingEntities.size() - 1;
             if (gpuIndex >= gpuIndexToECSEntity.size()) {
                 gpuIndexToECSEntity.resize(gpuIndex + 1);
             }
@@ -126,41 +124,57 @@ void GPUEntityManager::addEntitiesFromECS(const std::vector<flecs::entity>& enti
 }
 
 void GPUEntityManager::uploadPendingEntities() {
-    if (stagingEntities.empty()) return;
+    if (stagingEntities.empty() || deferredUploads) return;
+    
+    uploadRows(stagingEntities);
+    stagingEntities.clear();
+}
+
+uint32_t GPUEntityManager::takeStagedEntities(GPUEntitySoA& rows) {
+    rows.clear();
+    std::swap(rows, stagingEntities);
+    queuedRowCount += static_cast<uint32_t>(rows.size());
+    return rowEpoch;
+}
+
+void GPUEntityManager::uploadStagedBatch(const GPUEntitySoA& rows, uint32_t epoch) {
+    // A restore or clear since the rows were taken dropped them along with their entities
+    if (rows.empty() || epoch != rowEpoch) return;
     
+    queuedRowCount -= std::min(queuedRowCount, static_cast<uint32_t>(rows.size()));
+    uploadRows(rows);
+}
+
+void GPUEntityManager::uploadRows(const GPUEntitySoA& rows) {
     std::cout << "GPUEntityManager: WARNING - Uploading entities during runtime! This will overwrite computed positions!" << std::endl;
     
-    size_t entityCount = stagingEntities.size();
-    
-    // Upload each SoA buffer separately
-    VkDeviceSize velocityOffset = activeEntityCount * sizeof(glm::vec4);
-    VkDeviceSize movementParamsOffset = activeEntityCount * sizeof(glm::vec4);
-    VkDeviceSize runtimeStateOffset = activeEntityCount * sizeof(glm::vec4);
-    VkDeviceSize rotationStateOffset = activeEntityCount * sizeof(glm::vec4);
-    VkDeviceSize colorOffset = activeEntityCount * sizeof(glm::vec4);
-    VkDeviceSize modelMatrixOffset = activeEntityCount * sizeof(glm::mat4);
-    
-    VkDeviceSize velocitySize = entityCount * sizeof(glm::vec4);
-    VkDeviceSize movementParamsSize = entityCount * sizeof(glm::vec4);
-    VkDeviceSize runtimeStateSize = entityCount * sizeof(glm::vec4);
-    VkDeviceSize rotationStateSize = entityCount * sizeof(glm::vec4);
-    VkDeviceSize colorSize = entityCount * sizeof(glm::vec4);
-    VkDeviceSize modelMatrixSize = entityCount * sizeof(glm::mat4);
-    
-    // Copy SoA data to GPU buffers using new typed upload methods
-    bufferManager.uploadVelocityData(stagingEntities.velocities.data(), velocitySize, velocityOffset);
-    bufferManager.uploadMovementParamsData(stagingEntities.movementParams.data(), movementParamsSize, movementParamsOffset);
-    bufferManager.uploadRuntimeStateData(stagingEntities.runtimeStates.data(), runtimeStateSize, runtimeStateOffset);
-    bufferManager.uploadRotationStateData(stagingEntities.rotationStates.data(), rotationStateSize, rotationStateOffset);
-    bufferManager.uploadColorData(stagingEntities.colors.data(), colorSize, colorOffset);
-    bufferManager.uploadModelMatrixData(stagingEntities.modelMatrices.data(), modelMatrixSize, modelMatrixOffset);
+    size_t entityCount = rows.size();
+    
+    // Upload each SoA buffer separately, packed into the schema's column format; dropped columns are skipped
+    const EntitySchema& schema = bufferManager.getSchema();
+    std::vector<uint8_t> packed;
+    auto uploadColumn = [&](uint32_t bufferType, const auto& values,
+                            bool (EntityBufferManager::*upload)(const void*, VkDeviceSize, VkDeviceSize)) {
+        VkDeviceSize stride = schema.getStride(bufferType);
+        if (stride == 0) return;
+        packed.clear();
+        schema.packColumn(bufferType, values.data(), values.size(), packed);
+        (bufferManager.*upload)(packed.data(), packed.size(), activeEntityCount * stride);
+    };
+    
+    uploadColumn(EntityBufferType::VELOCITY, rows.velocities, &EntityBufferManager::uploadVelocityData);
+    uploadColumn(EntityBufferType::MOVEMENT_PARAMS, rows.movementParams, &EntityBufferManager::uploadMovementParamsData);
+    uploadColumn(EntityBufferType::RUNTIME_STATE, rows.runtimeStates, &EntityBufferManager::uploadRuntimeStateData);
+    uploadColumn(EntityBufferType::ROTATION_STATE, rows.rotationStates, &EntityBufferManager::uploadRotationStateData);
+    uploadColumn(EntityBufferType::COLOR, rows.colors, &EntityBufferManager::uploadColorData);
+    uploadColumn(EntityBufferType::MODEL_MATRIX, rows.modelMatrices, &EntityBufferManager::uploadModelMatrixData);
     
     // Initialize position buffers with spawn positions
     std::vector<glm::vec4> initialPositions;
     initialPositions.reserve(entityCount);
     
-    for (size_t i = 0; i < stagingEntities.modelMatrices.size(); ++i) {
-        const auto& modelMatrix = stagingEntities.modelMatrices[i];
+    for (size_t i = 0; i < rows.modelMatrices.size(); ++i) {
+        const auto& modelMatrix = rows.modelMatrices[i];
         // Extract position from modelMatrix (4th column contains translation)
         glm::vec3 spawnPosition = glm::vec3(modelMatrix[3]);
         initialPositions.emplace_back(spawnPosition, 1.0f);
@@ -173,13 +187,12 @@ void GPUEntityManager::uploadPendingEntities() {
     }
     
     // Initialize ALL position buffers so graphics and physics can read from any of them
-    VkDeviceSize positionUploadSize = initialPositions.size() * sizeof(glm::vec4);
-    VkDeviceSize positionOffset = activeEntityCount * sizeof(glm::vec4);
-    
-    bufferManager.uploadPositionDataToAllBuffers(initialPositions.data(), positionUploadSize, positionOffset);
+    uploadColumn(EntityBufferType::POSITION_OUTPUT, initialPositions, &EntityBufferManager::uploadPositionDataToAllBuffers);
     
     activeEntityCount += entityCount;
-    stagingEntities.clear();
+    
+    // New rows may already carry CPUObserved
+    positionReadback.markObservedDirty();
     
     std::cout << "GPUEntityManager: Uploaded " << entityCount << " entities to GPU-local memory (SoA), total: " << activeEntityCount << std::endl;
 }
@@ -187,10 +200,154 @@ void GPUEntityManager::uploadPendingEntities() {
 void GPUEntityManager::clearAllEntities() {
     stagingEntities.clear();
     activeEntityCount = 0;
+    queuedRowCount = 0;
+    rowEpoch++;
+    releasedRowCount = 0;
+    spatialReorder.cancel();
+    positionReadback.markObservedDirty();
 }
 
 // Core entity logic now clearly visible - descriptor management delegated to EntityDescriptorManager
 
+void GPUEntityManager::registerStagedEntities(const std::vector<flecs::entity>& entities) {
+    if (entities.size() > stagingEntities.size()) {
+        std::cerr << "GPUEntityManager: More entities than staged rows, ignoring registration" << std::endl;
+        return;
+    }
+    
+    uint32_t firstIndex = firstStagedRow() + static_cast<uint32_t>(stagingEntities.size() - entities.size());
+    if (firstIndex + entities.size() > gpuIndexToECSEntity.size()) {
+        gpuIndexToECSEntity.resize(firstIndex + entities.size());
+    }
+    std::copy(entities.begin(), entities.end(), gpuIndexToECSEntity.begin() + firstIndex);
+}
+
+void GPUEntityManager::releaseEntities(const std::vector<flecs::entity>& entities) {
+    if (entities.empty() || gpuIndexToECSEntity.empty()) return;
+    
+    // One pass over the row mapping for the whole batch rather than a search per entity
+    std::vector<flecs::entity_t> released;
+    released.reserve(entities.size());
+    for (const auto& entity : entities) {
+        released.push_back(entity.id());
+    }
+    std::sort(released.begin(), released.end());
+    
+    uint32_t releasedNow = 0;
+    for (auto& mapped : gpuIndexToECSEntity) {
+        if (mapped.id() != 0 && std::binary_search(released.begin(), released.end(), mapped.id())) {
+            mapped = flecs::entity{};
+            releasedNow++;
+        }
+    }
+    
+    if (releasedNow > 0) {
+        releasedRowCount += releasedNow;
+        positionReadback.markObservedDirty();
+    }
+}
+
+void GPUEntityManager::beginReadbackFrame(uint32_t frameIndex) {
+    if (positionReadback.isObservedDirty()) {
+        refreshObservedEntities();
+    }
+    positionReadback.beginFrame(frameIndex);
+    spatialQueries.beginFrame(frameIndex, gpuIndexToECSEntity);
+    snapshot.beginFrame(frameIndex);
+    
+    // Slots decoded above were recorded against the old row order, so the permutation goes last
+    if (spatialReorder.beginFrame(frameIndex, gpuIndexToECSEntity)) {
+        refreshObservedEntities();
+    }
+    
+    // Records read ECS components, so they are built here rather than while the frame is recorded
+    snapshotRecordsReady = snapshot.wantsCapture() && !spatialReorder.isInFlight();
+    if (snapshotRecordsReady) {
+        prepareSnapshotRecords();
+    }
+}
+
+void GPUEntityManager::prepareSnapshotRecords() {
+    // Staged rows are not on the GPU yet and are left out, like readback
+    uint32_t rowCount = activeEntityCount;
+    snapshotRecords.assign(rowCount, SimulationSnapshot::EntityRecord{});
+    snapshotReleasedRowCount = releasedRowCount;
+    uint32_t mappedRows = std::min(rowCount, static_cast<uint32_t>(gpuIndexToECSEntity.size()));
+    
+    for (uint32_t gpuIndex = 0; gpuIndex < mappedRows; ++gpuIndex) {
+        flecs::entity entity = gpuIndexToECSEntity[gpuIndex];
+        if (!entity.is_alive()) continue;
+        
+        SimulationSnapshot::EntityRecord& record = snapshotRecords[gpuIndex];
+        record.entityId = entity.id();
+        if (const MovementPattern* pattern = entity.get<MovementPattern>()) {
+            record.center = pattern->center;
+            record.movementType = static_cast<uint32_t>(pattern->type);
+        }
+        if (entity.has<CPUObserved>()) {
+            record.flags |= SimulationSnapshot::RECORD_OBSERVED;
+        }
+    }
+}
+
+void GPUEntityManager::recordSnapshotCapture(VkCommandBuffer commandBuffer, float simulationTime, uint32_t simulationStep) {
+    if (!snapshotRecordsReady) return;
+    
+    uint32_t rowCount = static_cast<uint32_t>(snapshotRecords.size());
+    snapshot.recordCapture(commandBuffer, bufferManager, rowCount, snapshotReleasedRowCount, std::move(snapshotRecords),
+                           simulationTime, simulationStep);
+    snapshotRecords.clear();
+    snapshotRecordsReady = false;
+}
+
+bool GPUEntityManager::restoreSnapshot(const std::string& path, SimulationSnapshot::RestoreResult& result) {
+    // Every entity buffer is overwritten, so nothing in flight may still read them
+    const auto& vk = context->getLoader();
+    vk.vkDeviceWaitIdle(context->getDevice());
+    
+    if (!snapshot.restore(path, bufferManager, result)) {
+        return false;
+    }
+    
+    stagingEntities.clear();
+    activeEntityCount = result.rowCount;
+    queuedRowCount = 0;
+    rowEpoch++;
+    snapshotRecordsReady = false;
+    releasedRowCount = result.releasedRowCount;
+    gpuIndexToECSEntity.assign(result.rowCount, flecs::entity{});
+    spatialReorder.cancel();
+    positionReadback.markObservedDirty();
+    return true;
+}
+
+void GPUEntityManager::registerRestoredEntities(const std::vector<uint32_t>& gpuIndices, const std::vector<flecs::entity>& entities) {
+    size_t count = std::min(gpuIndices.size(), entities.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (gpuIndices[i] < gpuIndexToECSEntity.size()) {
+            gpuIndexToECSEntity[gpuIndices[i]] = entities[i];
+        }
+    }
+    positionReadback.markObservedDirty();
+}
+
+void GPUEntityManager::refreshObservedEntities() {
+    // Only uploaded rows are copied; staged rows get picked up after the upload marks the set dirty again
+    std::vector<uint32_t> gpuIndices;
+    std::vector<flecs::entity> entities;
+    uint32_t rowCount = std::min(activeEntityCount, static_cast<uint32_t>(gpuIndexToECSEntity.size()));
+    
+    for (uint32_t gpuIndex = 0; gpuIndex < rowCount; ++gpuIndex) {
+        flecs::entity entity = gpuIndexToECSEntity[gpuIndex];
+        if (entity.is_alive() && entity.has<CPUObserved>()) {
+            gpuIndices.push_back(gpuIndex);
+            entities.push_back(entity);
+        }
+    }
+    
+    positionReadback.setObserved(gpuIndices, entities);
+}
+
 flecs::entity GPUEntityManager::getECSEntityFromGPUIndex(uint32_t gpuIndex) const {
     if (gpuIndex < gpuIndexToECSEntity.size()) {
         return gpuIndexToECSEntity[gpuIndex];
@@ -4,6 +4,11 @@
 #include "../components/entity.h"
 #include "entity_buffer_manager.h"
 #include "entity_descriptor_manager.h"
+#include "position_readback_ring.h"
+#include "spatial_query_batch.h"
+#include "spatial_reorder.h"
+#include "simulation_snapshot.h"
+#include "../../vulkan/monitoring/memory_accounting.h"
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
 #include <vector>
@@ -15,13 +20,17 @@ class VulkanSync;
 class ResourceContext;
 
 // Structure of Arrays (SoA) for GPU entities - better cache locality and vectorization
+// Columns count against CpuMemorySubsystem::GpuStaging in MemoryAccounting
 struct GPUEntitySoA {
-    std::vector<glm::vec4> velocities;        // velocity.xy, damping, reserved
-    std::vector<glm::vec4> movementParams;    // amplitude, frequency, phase, timeOffset
-    std::vector<glm::vec4> runtimeStates;     // totalTime, initialized, stateTimer, entityState
-    std::vector<glm::vec4> rotationStates;    // rotation, angularVelocity, angularDamping, reserved
-    std::vector<glm::vec4> colors;            // RGBA color
-    std::vector<glm::mat4> modelMatrices;     // transform matrices (cold data)
+    template<typename T>
+    using Column = CountedVector<T, CpuMemorySubsystem::GpuStaging>;
+
+    Column<glm::vec4> velocities;        // velocity.xy, damping, reserved
+    Column<glm::vec4> movementParams;    // amplitude, frequency, phase, timeOffset
+    Column<glm::vec4> runtimeStates;     // totalTime, initialized, stateTimer, entityState
+    Column<glm::vec4> rotationStates;    // rotation, angularVelocity, angularDamping, reserved
+    Column<glm::vec4> colors;            // RGBA color
+    Column<glm::mat4> modelMatrices;     // transform matrices (cold data)
     
     void reserve(size_t capacity) {
         velocities.reserve(capacity);
@@ -44,8 +53,37 @@ struct GPUEntitySoA {
     size_t size() const { return velocities.size(); }
     bool empty() const { return velocities.empty(); }
     
+    // Upper bound of the random per-entity state timer stagger
+    static constexpr float MAX_STATE_TIMER = 600.0f;
+    
+    // Seeds the calling thread's state timer RNG for deterministic runs (0 keeps random_device)
+    static void seedStateTimers(uint32_t seed);
+    
     // Add entity from ECS components
     void addFromECS(const Transform& transform, const Renderable& renderable, const MovementPattern& pattern);
+    
+    // Bulk path: grow every column by count rows and return the first new row for writeRow()
+    size_t appendRows(size_t count) {
+        size_t firstRow = size();
+        velocities.resize(firstRow + count);
+        movementParams.resize(firstRow + count);
+        runtimeStates.resize(firstRow + count);
+        rotationStates.resize(firstRow + count);
+        colors.resize(firstRow + count);
+        modelMatrices.resize(firstRow + count);
+        return firstRow;
+    }
+    
+    // Fill one row in place; modelMatrix is passed in so callers can skip Transform::getMatrix()
+    void writeRow(size_t row, const glm::mat4& modelMatrix, const glm::vec4& color,
+                  const MovementPattern& pattern, float stateTimer) {
+        velocities[row] = glm::vec4(0.0f, 0.0f, 0.001f, 0.0f);           // velocity.xy (set by compute), damping, reserved
+        movementParams[row] = glm::vec4(pattern.amplitude, pattern.frequency, pattern.phase, pattern.timeOffset);
+        runtimeStates[row] = glm::vec4(0.0f, 0.0f, stateTimer, 0.0f);    // totalTime, reserved, stateTimer, initialized
+        rotationStates[row] = glm::vec4(0.0f, 0.0f, 0.999f, 0.0f);       // rotation, angular velocity, angular damping, reserved
+        colors[row] = color;
+        modelMatrices[row] = modelMatrix;
+    }
 };
 
 
@@ -55,7 +93,8 @@ public:
     GPUEntityManager();
     ~GPUEntityManager();
 
-    bool initialize(const VulkanContext& context, VulkanSync* sync, ResourceCoordinator* resourceCoordinator);
+    bool initialize(const VulkanContext& context, VulkanSync* sync, ResourceCoordinator* resourceCoordinator,
+                    const EntitySchema& schema = EntitySchema::legacy());
     void cleanup();
     
     // Entity management - SoA approach
@@ -63,6 +102,14 @@ public:
     void uploadPendingEntities(); // Upload staged entities to GPU
     void clearAllEntities();
     
+    // Pipelined rendering: uploadPendingEntities() leaves rows staged, the simulation thread moves them
+    // into its frame packet with takeStagedEntities() and the render thread uploads them with
+    // uploadStagedBatch(). Rows keep the indices they were registered with; a restore or clear in
+    // between bumps the epoch and the batch is dropped
+    void setDeferredUploads(bool deferred) { deferredUploads = deferred; }
+    uint32_t takeStagedEntities(GPUEntitySoA& rows);
+    void uploadStagedBatch(const GPUEntitySoA& rows, uint32_t epoch);
+    
     
     // Direct buffer access for frame graph - SoA buffers
     VkBuffer getVelocityBuffer() const { return bufferManager.getVelocityBuffer(); }
@@ -107,6 +154,46 @@ public:
     
     // Debug: Get ECS entity ID from GPU buffer index
     flecs::entity getECSEntityFromGPUIndex(uint32_t gpuIndex) const;
+    
+    // Bulk spawn: EntityFactory::createSwarmBulk writes rows straight into the staging SoA, then
+    // registerStagedEntities maps those rows (the last entities.size() staged) back to their entities
+    GPUEntitySoA& getStagingEntities() { return stagingEntities; }
+    size_t getRemainingCapacity() const { return MAX_ENTITIES - firstStagedRow() - stagingEntities.size(); }
+    void registerStagedEntities(const std::vector<flecs::entity>& entities);
+    
+    // Batch release for entities about to be deleted: their rows stop mapping to ECS entities and
+    // drop out of readback. Rows stay resident on the GPU; there is no row compaction yet
+    void releaseEntities(const std::vector<flecs::entity>& entities);
+    uint32_t getReleasedRowCount() const { return releasedRowCount; }
+    
+    // GPU -> ECS position streaming for CPUObserved entities. Call beginReadbackFrame() after the
+    // frame fence wait; it refreshes the observed rows when they changed and decodes the completed slot
+    PositionReadbackRing& getPositionReadback() { return positionReadback; }
+    const PositionReadbackRing& getPositionReadback() const { return positionReadback; }
+    void beginReadbackFrame(uint32_t frameIndex);
+    
+    // Batched nearest/radius/rect queries answered on the GPU by SpatialQueryNode. Callbacks run
+    // from beginReadbackFrame() once the frame that answered them has completed
+    SpatialQueryBatch& getSpatialQueries() { return spatialQueries; }
+    
+    // Whole-simulation snapshots. requestSnapshot() arms a capture that PositionReadbackNode records
+    // after the next physics pass; the file is written from beginReadbackFrame() once it completes.
+    // beginReadbackFrame() also builds the per-row records, so recording never reads the ECS
+    bool requestSnapshot(const std::string& path) { return snapshot.requestCapture(path); }
+    bool wantsSnapshotCapture() const { return snapshotRecordsReady && !spatialReorder.isInFlight(); }
+    void recordSnapshotCapture(VkCommandBuffer commandBuffer, float simulationTime, uint32_t simulationStep);
+    
+    // Replaces every GPU row with the snapshot's and drops the row mapping; the caller recreates
+    // entities from result.rows and hands them back through registerRestoredEntities()
+    bool restoreSnapshot(const std::string& path, SimulationSnapshot::RestoreResult& result);
+    void registerRestoredEntities(const std::vector<uint32_t>& gpuIndices, const std::vector<flecs::entity>& entities);
+    const std::vector<flecs::entity>& getMappedEntities() const { return gpuIndexToECSEntity; }
+    
+    // Periodic Morton/cell reordering of the rows, recorded by SpatialReorderNode. While a reorder
+    // is in flight the row mapping is stale, so readback and spatial queries are not recorded
+    SpatialReorder& getSpatialReorder() { return spatialReorder; }
+    const SpatialReorder& getSpatialReorder() const { return spatialReorder; }
+    bool isReorderInFlight() const { return spatialReorder.isInFlight(); }
 
 private:
     static constexpr uint32_t MAX_ENTITIES = 131072; // 128k entities max
@@ -123,7 +210,26 @@ private:
     // Staging data - SoA approach
     GPUEntitySoA stagingEntities;
     uint32_t activeEntityCount = 0;
+    uint32_t releasedRowCount = 0;
+    
+    // Rows taken into frame packets but not uploaded yet; new rows are registered after them
+    uint32_t queuedRowCount = 0;
+    uint32_t rowEpoch = 0;
+    bool deferredUploads = false;
+    uint32_t firstStagedRow() const { return activeEntityCount + queuedRowCount; }
+    void uploadRows(const GPUEntitySoA& rows);
     
     // Debug: Mapping from GPU buffer index to ECS entity ID
     std::vector<flecs::entity> gpuIndexToECSEntity;
+    
+    PositionReadbackRing positionReadback;
+    SpatialQueryBatch spatialQueries;
+    SimulationSnapshot snapshot;
+    SpatialReorder spatialReorder;
+    void refreshObservedEntities();
+    
+    std::vector<SimulationSnapshot::EntityRecord> snapshotRecords;
+    uint32_t snapshotReleasedRowCount = 0;
+    bool snapshotRecordsReady = false;
+    void prepareSnapshotRecords();
 };
\ No newline at end of file
@@ -10,26 +10,27 @@ PositionBufferCoordinator::~PositionBufferCoordinator() {
     cleanup();
 }
 
-bool PositionBufferCoordinator::initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
+bool PositionBufferCoordinator::initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                                           VkDeviceSize elementSize) {
     this->maxEntities = maxEntities;
     
     // Initialize all position buffers
-    if (!primaryBuffer.initialize(context, resourceCoordinator, maxEntities)) {
+    if (!primaryBuffer.initialize(context, resourceCoordinator, maxEntities, elementSize)) {
         std::cerr << "PositionBufferCoordinator: Failed to initialize primary buffer" << std::endl;
         return false;
     }
     
-    if (!alternateBuffer.initialize(context, resourceCoordinator, maxEntities)) {
+    if (!alternateBuffer.initialize(context, resourceCoordinator, maxEntities, elementSize)) {
         std::cerr << "PositionBufferCoordinator: Failed to initialize alternate buffer" << std::endl;
         return false;
     }
     
-    if (!currentBuffer.initialize(context, resourceCoordinator, maxEntities)) {
+    if (!currentBuffer.initialize(context, resourceCoordinator, maxEntities, elementSize)) {
         std::cerr << "PositionBufferCoordinator: Failed to initialize current buffer" << std::endl;
         return false;
     }
     
-    if (!targetBuffer.initialize(context, resourceCoordinator, maxEntities)) {
+    if (!targetBuffer.initialize(context, resourceCoordinator, maxEntities, elementSize)) {
         std::cerr << "PositionBufferCoordinator: Failed to initialize target buffer" << std::endl;
         return false;
     }
@@ -16,7 +16,9 @@ public:
     PositionBufferCoordinator();
     ~PositionBufferCoordinator();
     
-    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities);
+    // All four buffers share one element size so uploads and ping-pong copies stay interchangeable
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                    VkDeviceSize elementSize = sizeof(glm::vec4));
     void cleanup();
     
     // Ping-pong buffer access for async compute
@@ -28,6 +30,8 @@ public:
     VkBuffer getAlternateBuffer() const { return alternateBuffer.getBuffer(); }
     VkBuffer getCurrentBuffer() const { return currentBuffer.getBuffer(); }
     VkBuffer getTargetBuffer() const { return targetBuffer.getBuffer(); }
+    VkDeviceAddress getPrimaryAddress() const { return primaryBuffer.getDeviceAddress(); }
+    VkDeviceAddress getCurrentAddress() const { return currentBuffer.getDeviceAddress(); }
     
     // Buffer properties
     VkDeviceSize getBufferSize() const { return primaryBuffer.getSize(); }
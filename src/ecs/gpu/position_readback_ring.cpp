@@ -0,0 +1,187 @@
+#include "position_readback_ring.h"
+#include "entity_buffer_types.h"
+#include "../../vulkan/core/vulkan_context.h"
+#include "../../vulkan/core/vulkan_function_loader.h"
+#include "../../vulkan/resources/core/resource_coordinator.h"
+#include <algorithm>
+#include <iostream>
+
+PositionReadbackRing::~PositionReadbackRing() {
+    cleanup();
+}
+
+bool PositionReadbackRing::initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator,
+                                      const EntitySchema& schema) {
+    this->context = &context;
+    this->resourceCoordinator = resourceCoordinator;
+    this->schema = &schema;
+
+    // Slot buffers are allocated on first use, so an empty observed set costs nothing
+    std::cout << "PositionReadbackRing: Initialized with " << MAX_FRAMES_IN_FLIGHT << " slots" << std::endl;
+    return true;
+}
+
+void PositionReadbackRing::cleanup() {
+    if (resourceCoordinator) {
+        for (auto& slot : slots) {
+            if (slot.buffer.isValid()) {
+                resourceCoordinator->destroyResource(slot.buffer);
+            }
+            slot = Slot{};
+        }
+    }
+
+    observedIndices.clear();
+    observedEntities.clear();
+    copyRuns.clear();
+    samples.clear();
+    context = nullptr;
+    resourceCoordinator = nullptr;
+    schema = nullptr;
+}
+
+void PositionReadbackRing::setObserved(const std::vector<uint32_t>& gpuIndices, const std::vector<flecs::entity>& entities) {
+    observedIndices = gpuIndices;
+    observedEntities = entities;
+    observedDirty = false;
+
+    // Merge adjacent rows so swarms spawned together copy as one region
+    copyRuns.clear();
+    for (uint32_t i = 0; i < observedIndices.size(); ++i) {
+        uint32_t gpuIndex = observedIndices[i];
+        if (!copyRuns.empty()) {
+            CopyRun& last = copyRuns.back();
+            if (last.firstGpuIndex + last.count == gpuIndex) {
+                last.count++;
+                continue;
+            }
+        }
+        copyRuns.push_back({gpuIndex, i, 1});
+    }
+}
+
+void PositionReadbackRing::beginFrame(uint32_t frameIndex) {
+    frameNumber++;
+    writeSlot = frameIndex % MAX_FRAMES_IN_FLIGHT;
+
+    Slot& slot = slots[writeSlot];
+    if (!slot.pending || !schema) {
+        return;
+    }
+    slot.pending = false;
+
+    // Coherent memory: the fence wait is all the synchronization the host read needs
+    const size_t count = slot.entities.size();
+    const VkDeviceSize positionStride = schema->getStride(EntityBufferType::POSITION_OUTPUT);
+    const VkDeviceSize velocityStride = schema->getStride(EntityBufferType::VELOCITY);
+    const auto* positions = static_cast<const uint8_t*>(slot.buffer.mappedData);
+    const auto* velocities = positions + count * positionStride;
+
+    samples.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        Sample& sample = samples[i];
+        sample.entity = slot.entities[i];
+        sample.position = schema->unpackElement(EntityBufferType::POSITION_OUTPUT, positions + i * positionStride);
+        sample.velocity = slot.hasVelocity
+            ? schema->unpackElement(EntityBufferType::VELOCITY, velocities + i * velocityStride)
+            : glm::vec4(0.0f);
+    }
+
+    snapshotFrame = slot.frame;
+    snapshotVelocity = slot.hasVelocity;
+    snapshotSequence++;
+}
+
+void PositionReadbackRing::recordCopies(VkCommandBuffer commandBuffer, VkBuffer srcPositions, VkBuffer srcVelocities) {
+    if (!context || !schema || observedIndices.empty() || srcPositions == VK_NULL_HANDLE) {
+        return;
+    }
+    if (frameNumber % interval != 0) {
+        return;
+    }
+
+    const VkDeviceSize positionStride = schema->getStride(EntityBufferType::POSITION_OUTPUT);
+    const VkDeviceSize velocityStride = schema->getStride(EntityBufferType::VELOCITY);
+    const bool copyVelocity = velocityEnabled && velocityStride > 0 && srcVelocities != VK_NULL_HANDLE;
+    const VkDeviceSize count = observedIndices.size();
+
+    Slot& slot = slots[writeSlot];
+    VkDeviceSize requiredSize = count * positionStride + (copyVelocity ? count * velocityStride : 0);
+    if (!ensureCapacity(slot, requiredSize)) {
+        return;
+    }
+
+    const auto& vk = context->getLoader();
+    VkBuffer dstBuffer = slot.buffer.buffer.get();
+
+    // Physics writes POSITION_OUTPUT in a compute shader earlier in this command buffer
+    VkMemoryBarrier2 computeToCopy{};
+    computeToCopy.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    computeToCopy.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    computeToCopy.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+    computeToCopy.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    computeToCopy.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &computeToCopy;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    auto copyColumn = [&](VkBuffer srcBuffer, VkDeviceSize stride, VkDeviceSize dstBase) {
+        regions.clear();
+        for (const CopyRun& run : copyRuns) {
+            VkBufferCopy region{};
+            region.srcOffset = run.firstGpuIndex * stride;
+            region.dstOffset = dstBase + run.firstSample * stride;
+            region.size = run.count * stride;
+            regions.push_back(region);
+        }
+        vk.vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, static_cast<uint32_t>(regions.size()), regions.data());
+    };
+
+    copyColumn(srcPositions, positionStride, 0);
+    if (copyVelocity) {
+        copyColumn(srcVelocities, velocityStride, count * positionStride);
+    }
+
+    // Make the copy visible to host reads once the frame fence signals
+    VkMemoryBarrier2 copyToHost{};
+    copyToHost.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    copyToHost.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    copyToHost.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    copyToHost.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+    copyToHost.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+    dependencyInfo.pMemoryBarriers = &copyToHost;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    slot.entities = observedEntities;
+    slot.frame = frameNumber;
+    slot.hasVelocity = copyVelocity;
+    slot.pending = true;
+}
+
+bool PositionReadbackRing::ensureCapacity(Slot& slot, VkDeviceSize requiredSize) {
+    if (slot.buffer.isValid() && slot.buffer.size >= requiredSize) {
+        return true;
+    }
+
+    // The write slot's previous copy has completed (its fence was waited on), so it can be replaced
+    const VkDeviceSize previousSize = slot.buffer.size;
+    if (slot.buffer.isValid()) {
+        resourceCoordinator->destroyResource(slot.buffer);
+    }
+
+    // Grow geometrically so a slowly growing observed set does not reallocate every frame
+    constexpr VkDeviceSize MIN_SLOT_SIZE = 4096;
+    VkDeviceSize newSize = std::max({requiredSize, previousSize * 2, MIN_SLOT_SIZE});
+    slot.buffer = resourceCoordinator->createMappedBuffer(newSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    slot.pending = false;
+
+    if (!slot.buffer.isValid() || !slot.buffer.mappedData) {
+        std::cerr << "PositionReadbackRing: Failed to allocate " << newSize << " byte readback slot" << std::endl;
+        slot.buffer = ResourceHandle{};
+        return false;
+    }
+    return true;
+}
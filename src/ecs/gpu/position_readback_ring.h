@@ -0,0 +1,106 @@
+#pragma once
+
+#include "entity_schema.h"
+#include "../../vulkan/core/vulkan_constants.h"
+#include "../../vulkan/resources/core/resource_handle.h"
+#include <vulkan/vulkan.h>
+#include <flecs.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+class VulkanContext;
+class ResourceCoordinator;
+
+/**
+ * GPU -> ECS position streaming for entities tagged CPUObserved.
+ *
+ * Every frame in flight owns a persistently mapped host-visible slot. PositionReadbackNode
+ * records copies of the observed POSITION_OUTPUT rows (and optionally VELOCITY) into the
+ * current slot right after physics. beginFrame() decodes a slot only after the frame fence
+ * guarding its last use has been waited on, so the CPU never blocks on the GPU.
+ *
+ * Observed rows are sorted and merged into contiguous copy regions, so bandwidth scales with
+ * the observed set rather than the entity count. Snapshots lag the GPU by
+ * MAX_FRAMES_IN_FLIGHT frames; PositionReadbackSystem applies them to Transform.
+ */
+class PositionReadbackRing {
+public:
+    struct Sample {
+        flecs::entity entity;
+        glm::vec4 position{0.0f};
+        glm::vec4 velocity{0.0f};   // Zero unless velocity streaming is enabled
+    };
+
+    PositionReadbackRing() = default;
+    ~PositionReadbackRing();
+
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, const EntitySchema& schema);
+    void cleanup();
+
+    // Observed rows in ascending GPU index order, one entity per index
+    void setObserved(const std::vector<uint32_t>& gpuIndices, const std::vector<flecs::entity>& entities);
+    size_t getObservedCount() const { return observedIndices.size(); }
+    void markObservedDirty() { observedDirty = true; }
+    bool isObservedDirty() const { return observedDirty; }
+
+    // Copy every N frames (1 = every frame) and optionally stream the velocity column too
+    void setInterval(uint32_t frames) { interval = frames > 0 ? frames : 1; }
+    uint32_t getInterval() const { return interval; }
+    void setVelocityEnabled(bool enabled) { velocityEnabled = enabled; }
+    bool isVelocityEnabled() const { return velocityEnabled; }
+
+    // Call after the fence wait for frameIndex: decodes the slot's completed copy, then makes it the write slot
+    void beginFrame(uint32_t frameIndex);
+
+    // Records this frame's copies into the write slot. srcVelocities may be VK_NULL_HANDLE
+    void recordCopies(VkCommandBuffer commandBuffer, VkBuffer srcPositions, VkBuffer srcVelocities);
+
+    // Latest decoded snapshot; the sequence increments whenever a new one lands
+    const std::vector<Sample>& getSamples() const { return samples; }
+    uint64_t getSnapshotSequence() const { return snapshotSequence; }
+    uint64_t getSnapshotFrame() const { return snapshotFrame; }
+    bool snapshotHasVelocity() const { return snapshotVelocity; }
+
+private:
+    // Contiguous run of observed GPU rows, copied with one VkBufferCopy per column
+    struct CopyRun {
+        uint32_t firstGpuIndex;
+        uint32_t firstSample;
+        uint32_t count;
+    };
+
+    struct Slot {
+        ResourceHandle buffer;
+        std::vector<flecs::entity> entities;   // Entities in copy order, captured at record time
+        uint64_t frame = 0;
+        bool hasVelocity = false;
+        bool pending = false;                  // Copy recorded, not yet decoded
+    };
+
+    bool ensureCapacity(Slot& slot, VkDeviceSize requiredSize);
+
+    const VulkanContext* context = nullptr;
+    ResourceCoordinator* resourceCoordinator = nullptr;
+    const EntitySchema* schema = nullptr;
+
+    std::array<Slot, MAX_FRAMES_IN_FLIGHT> slots;
+    uint32_t writeSlot = 0;
+    uint64_t frameNumber = 0;
+
+    std::vector<uint32_t> observedIndices;
+    std::vector<flecs::entity> observedEntities;
+    std::vector<CopyRun> copyRuns;
+    std::vector<VkBufferCopy> regions;
+    bool observedDirty = true;
+
+    uint32_t interval = 1;
+    bool velocityEnabled = false;
+
+    std::vector<Sample> samples;
+    uint64_t snapshotSequence = 0;
+    uint64_t snapshotFrame = 0;
+    bool snapshotVelocity = false;
+};
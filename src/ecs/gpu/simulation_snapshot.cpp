@@ -0,0 +1,399 @@
+#include "simulation_snapshot.h"
+#include "entity_buffer_manager.h"
+#include "entity_buffer_types.h"
+#include "../../vulkan/core/vulkan_context.h"
+#include "../../vulkan/core/vulkan_function_loader.h"
+#include "../../vulkan/resources/core/resource_coordinator.h"
+#include "../../vulkan/resources/core/command_executor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char SNAPSHOT_MAGIC[4] = {'F', 'S', 'N', 'P'};
+
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Read-only view of a whole file, unmapped on destruction
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) return;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return;
+        data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        size = data ? static_cast<size_t>(fileSize.QuadPart) : 0;
+#else
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || info.st_size == 0) return;
+        void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) return;
+        // The column block is read front to back exactly once
+        madvise(mapped, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+        data = static_cast<const uint8_t*>(mapped);
+        size = static_cast<size_t>(info.st_size);
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap(const_cast<uint8_t*>(data), size);
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* getData() const { return data; }
+    size_t getSize() const { return size; }
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+} // namespace
+
+SimulationSnapshot::~SimulationSnapshot() {
+    cleanup();
+}
+
+bool SimulationSnapshot::initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator) {
+    this->context = &context;
+    this->resourceCoordinator = resourceCoordinator;
+    return true;
+}
+
+void SimulationSnapshot::cleanup() {
+    if (resourceCoordinator && captureBuffer.isValid()) {
+        resourceCoordinator->destroyResource(captureBuffer);
+    }
+    captureBuffer = ResourceHandle{};
+    captureRecords.clear();
+    state = CaptureState::Idle;
+    context = nullptr;
+    resourceCoordinator = nullptr;
+}
+
+bool SimulationSnapshot::requestCapture(const std::string& path) {
+    if (!context || state != CaptureState::Idle) {
+        std::cerr << "SimulationSnapshot: Capture already in flight, ignoring request for " << path << std::endl;
+        return false;
+    }
+    capturePath = path;
+    state = CaptureState::Requested;
+    return true;
+}
+
+void SimulationSnapshot::beginFrame(uint32_t frameIndex) {
+    currentFrameIndex = frameIndex;
+
+    // The captured frame's slot comes around again only after its fence has been waited on
+    if (state == CaptureState::Recorded && frameIndex == captureFrameIndex) {
+        writeFile();
+        resourceCoordinator->destroyResource(captureBuffer);
+        captureBuffer = ResourceHandle{};
+        captureRecords.clear();
+        captureRecords.shrink_to_fit();
+        state = CaptureState::Idle;
+    }
+}
+
+std::array<VkBuffer, SimulationSnapshot::COLUMN_COUNT> SimulationSnapshot::columnBuffers(const EntityBufferManager& buffers) {
+    return {
+        buffers.getVelocityBuffer(),
+        buffers.getMovementParamsBuffer(),
+        buffers.getRuntimeStateBuffer(),
+        buffers.getRotationStateBuffer(),
+        buffers.getColorBuffer(),
+        buffers.getModelMatrixBuffer(),
+        buffers.getPositionBuffer(),
+        buffers.getCurrentPositionBuffer(),
+        buffers.getSpatialMapBuffer()
+    };
+}
+
+SimulationSnapshot::Layout SimulationSnapshot::computeLayout(const EntityBufferManager& buffers, uint32_t rowCount) {
+    const EntitySchema& schema = buffers.getSchema();
+    const VkDeviceSize positionStride = schema.getStride(EntityBufferType::POSITION_OUTPUT);
+
+    Layout layout;
+    layout.strides = {
+        schema.getStride(EntityBufferType::VELOCITY),
+        schema.getStride(EntityBufferType::MOVEMENT_PARAMS),
+        schema.getStride(EntityBufferType::RUNTIME_STATE),
+        schema.getStride(EntityBufferType::ROTATION_STATE),
+        schema.getStride(EntityBufferType::COLOR),
+        schema.getStride(EntityBufferType::MODEL_MATRIX),
+        positionStride,
+        positionStride,    // All position buffers share the output stride
+        0                  // Spatial map is copied whole
+    };
+
+    VkDeviceSize offset = 0;
+    for (uint32_t column = 0; column < COLUMN_COUNT; ++column) {
+        // Dropped columns keep a placeholder buffer and contribute nothing
+        layout.sizes[column] = column == SPATIAL_MAP ? buffers.getSpatialMapBufferSize()
+                                                     : layout.strides[column] * rowCount;
+        layout.offsets[column] = offset;
+        offset = alignUp(offset + layout.sizes[column], COLUMN_ALIGNMENT);
+    }
+    layout.totalSize = offset;
+    return layout;
+}
+
+void SimulationSnapshot::recordCapture(VkCommandBuffer commandBuffer, const EntityBufferManager& buffers, uint32_t rowCount,
+                                       uint32_t releasedRowCount, std::vector<EntityRecord> records, float simulationTime,
+                                       uint32_t simulationStep) {
+    if (!context || state != CaptureState::Requested) {
+        return;
+    }
+
+    Layout layout = computeLayout(buffers, rowCount);
+    captureBuffer = resourceCoordinator->createMappedBuffer(layout.totalSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    if (!captureBuffer.isValid() || !captureBuffer.mappedData) {
+        std::cerr << "SimulationSnapshot: Failed to allocate " << layout.totalSize << " byte capture buffer" << std::endl;
+        captureBuffer = ResourceHandle{};
+        state = CaptureState::Idle;
+        return;
+    }
+
+    const auto& vk = context->getLoader();
+
+    // Physics and collision write positions, velocities, runtime state and the spatial map earlier in this command buffer
+    VkMemoryBarrier2 computeToCopy{};
+    computeToCopy.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    computeToCopy.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    computeToCopy.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+    computeToCopy.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    computeToCopy.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &computeToCopy;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    auto sources = columnBuffers(buffers);
+    for (uint32_t column = 0; column < COLUMN_COUNT; ++column) {
+        if (layout.sizes[column] == 0 || sources[column] == VK_NULL_HANDLE) {
+            continue;
+        }
+        VkBufferCopy region{};
+        region.srcOffset = 0;
+        region.dstOffset = layout.offsets[column];
+        region.size = layout.sizes[column];
+        vk.vkCmdCopyBuffer(commandBuffer, sources[column], captureBuffer.buffer.get(), 1, &region);
+    }
+
+    VkMemoryBarrier2 copyToHost{};
+    copyToHost.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    copyToHost.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    copyToHost.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    copyToHost.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+    copyToHost.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+    dependencyInfo.pMemoryBarriers = &copyToHost;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    captureLayout = layout;
+    captureRowCount = rowCount;
+    captureReleasedRowCount = releasedRowCount;
+    captureMaxEntities = buffers.getMaxEntities();
+    captureTime = simulationTime;
+    captureStep = simulationStep;
+    captureRecords = std::move(records);
+    captureRecords.resize(rowCount);
+    captureFrameIndex = currentFrameIndex;
+    state = CaptureState::Recorded;
+}
+
+bool SimulationSnapshot::writeFile() {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Header header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.rowCount = captureRowCount;
+    header.releasedRowCount = captureReleasedRowCount;
+    header.simulationTime = captureTime;
+    header.maxEntities = captureMaxEntities;
+    header.simulationStep = captureStep;
+
+    const VkDeviceSize columnBase = alignUp(sizeof(Header), COLUMN_ALIGNMENT);
+    for (uint32_t column = 0; column < COLUMN_COUNT; ++column) {
+        header.columnOffsets[column] = columnBase + captureLayout.offsets[column];
+        header.columnSizes[column] = captureLayout.sizes[column];
+        header.strides[column] = captureLayout.strides[column];
+    }
+    header.recordOffset = columnBase + captureLayout.totalSize;
+
+    std::ofstream file(capturePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "SimulationSnapshot: Failed to open " << capturePath << " for writing" << std::endl;
+        return false;
+    }
+
+    // Coherent memory: the fence wait is all the synchronization the host read needs
+    std::vector<char> padding(columnBase - sizeof(Header), 0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    file.write(static_cast<const char*>(captureBuffer.mappedData), static_cast<std::streamsize>(captureLayout.totalSize));
+    file.write(reinterpret_cast<const char*>(captureRecords.data()),
+               static_cast<std::streamsize>(captureRecords.size() * sizeof(EntityRecord)));
+
+    if (!file.good()) {
+        std::cerr << "SimulationSnapshot: Failed to write " << capturePath << std::endl;
+        return false;
+    }
+
+    float ms = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << "SimulationSnapshot: Wrote " << captureRowCount << " rows ("
+              << (header.recordOffset + captureRecords.size() * sizeof(EntityRecord)) / 1024 << " KB) to "
+              << capturePath << " in " << ms << "ms" << std::endl;
+    return true;
+}
+
+bool SimulationSnapshot::restore(const std::string& path, EntityBufferManager& buffers, RestoreResult& result) {
+    if (!context || !resourceCoordinator) {
+        return false;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    MappedFile file(path);
+    if (!file.getData() || file.getSize() < sizeof(Header)) {
+        std::cerr << "SimulationSnapshot: Failed to map " << path << std::endl;
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, file.getData(), sizeof(header));
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != FORMAT_VERSION) {
+        std::cerr << "SimulationSnapshot: " << path << " is not a version " << FORMAT_VERSION << " snapshot" << std::endl;
+        return false;
+    }
+    if (header.rowCount > buffers.getMaxEntities()) {
+        std::cerr << "SimulationSnapshot: " << header.rowCount << " rows exceed the " << buffers.getMaxEntities()
+                  << " entity capacity" << std::endl;
+        return false;
+    }
+
+    // Columns are copied verbatim, so the packing must match the live schema exactly
+    Layout layout = computeLayout(buffers, header.rowCount);
+    const VkDeviceSize columnBase = header.columnOffsets[0];
+    for (uint32_t column = 0; column < COLUMN_COUNT; ++column) {
+        if (header.strides[column] != layout.strides[column] || header.columnSizes[column] != layout.sizes[column] ||
+            header.columnOffsets[column] != columnBase + layout.offsets[column]) {
+            std::cerr << "SimulationSnapshot: " << path << " was captured with a different entity schema" << std::endl;
+            return false;
+        }
+    }
+    if (header.recordOffset != columnBase + layout.totalSize ||
+        header.recordOffset + VkDeviceSize(header.rowCount) * sizeof(EntityRecord) > file.getSize()) {
+        std::cerr << "SimulationSnapshot: " << path << " is truncated" << std::endl;
+        return false;
+    }
+
+    // One memcpy from the mapped file into staging, then every column copy in a single submit
+    ResourceHandle staging = resourceCoordinator->createMappedBuffer(layout.totalSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    if (!staging.isValid() || !staging.mappedData) {
+        std::cerr << "SimulationSnapshot: Failed to allocate " << layout.totalSize << " byte staging buffer" << std::endl;
+        return false;
+    }
+    const uint8_t* columns = file.getData() + columnBase;
+    std::memcpy(staging.mappedData, columns, layout.totalSize);
+
+    auto targets = columnBuffers(buffers);
+    std::vector<CommandExecutor::BufferCopy> copies;
+    auto addCopy = [&](uint32_t column, VkBuffer dst) {
+        if (layout.sizes[column] == 0 || dst == VK_NULL_HANDLE) return;
+        CommandExecutor::BufferCopy copy;
+        copy.src = staging.buffer.get();
+        copy.dst = dst;
+        copy.region.srcOffset = layout.offsets[column];
+        copy.region.dstOffset = 0;
+        copy.region.size = layout.sizes[column];
+        copies.push_back(copy);
+    };
+    for (uint32_t column = 0; column < COLUMN_COUNT; ++column) {
+        addCopy(column, targets[column]);
+    }
+    // Ping-pong and interpolation buffers start from the captured positions, as after an upload
+    addCopy(POSITION, buffers.getPositionBufferAlternate());
+    addCopy(POSITION, buffers.getTargetPositionBuffer());
+
+    bool copied = resourceCoordinator->getCommandExecutor()->copyBuffers(copies);
+    resourceCoordinator->destroyResource(staging);
+    if (!copied) {
+        std::cerr << "SimulationSnapshot: Failed to copy columns from " << path << std::endl;
+        return false;
+    }
+
+    // Decode what ECS reconstruction needs straight from the mapping
+    const EntitySchema& schema = buffers.getSchema();
+    const auto* records = reinterpret_cast<const EntityRecord*>(file.getData() + header.recordOffset);
+    auto element = [&](uint32_t column, uint32_t bufferType, uint32_t row, const glm::vec4& fallback) {
+        if (layout.strides[column] == 0) return fallback;
+        return schema.unpackElement(bufferType, columns + layout.offsets[column] + row * layout.strides[column]);
+    };
+
+    result = RestoreResult{};
+    result.rowCount = header.rowCount;
+    result.releasedRowCount = header.releasedRowCount;
+    result.simulationTime = header.simulationTime;
+    result.simulationStep = static_cast<uint32_t>(header.simulationStep);
+    result.rows.reserve(header.rowCount - std::min(header.rowCount, header.releasedRowCount));
+    for (uint32_t row = 0; row < header.rowCount; ++row) {
+        EntityRecord record;
+        std::memcpy(&record, records + row, sizeof(record));
+        if (record.entityId == 0) {
+            continue;
+        }
+        RestoredRow restored;
+        restored.gpuIndex = row;
+        restored.record = record;
+        restored.position = element(POSITION, EntityBufferType::POSITION_OUTPUT, row, glm::vec4(0.0f));
+        restored.color = element(COLOR, EntityBufferType::COLOR, row, glm::vec4(1.0f));
+        restored.movementParams = element(MOVEMENT_PARAMS, EntityBufferType::MOVEMENT_PARAMS, row, glm::vec4(0.0f));
+        result.rows.push_back(restored);
+    }
+
+    float ms = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << "SimulationSnapshot: Restored " << header.rowCount << " rows (" << layout.totalSize / 1024
+              << " KB of columns) from " << path << " in " << ms << "ms" << std::endl;
+    return true;
+}
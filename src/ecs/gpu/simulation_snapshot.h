@@ -0,0 +1,146 @@
+#pragma once
+
+#include "entity_schema.h"
+#include "../../vulkan/resources/core/resource_handle.h"
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class VulkanContext;
+class ResourceCoordinator;
+class EntityBufferManager;
+
+/**
+ * Binary snapshot of the whole simulation: every entity SoA column, both position columns, the
+ * spatial map, and one record per GPU row carrying the ECS data the columns do not hold.
+ *
+ * Capture is asynchronous, like PositionReadbackRing: requestCapture() arms a snapshot,
+ * PositionReadbackNode records copies of every column into one mapped buffer right after
+ * physics, and beginFrame() writes the file once that frame's fence has been waited on.
+ *
+ * Restore maps the file, moves the column block into a staging buffer with a single memcpy
+ * and issues every column copy in one submit. The caller recreates ECS entities from the
+ * returned rows (see GPUEntityManager::restoreSnapshot).
+ */
+class SimulationSnapshot {
+public:
+    // Columns in file order; POSITION is replicated into all four position buffers on restore
+    enum Column : uint32_t {
+        VELOCITY = 0,
+        MOVEMENT_PARAMS,
+        RUNTIME_STATE,
+        ROTATION_STATE,
+        COLOR,
+        MODEL_MATRIX,
+        POSITION,
+        CURRENT_POSITION,
+        SPATIAL_MAP,
+        COLUMN_COUNT
+    };
+
+    // Per-row ECS data; entityId is 0 for rows released before the capture
+    struct EntityRecord {
+        uint64_t entityId = 0;
+        glm::vec3 center{0.0f};       // MovementPattern::center
+        uint32_t movementType = 0;    // MovementPattern::type
+        uint32_t flags = 0;
+        uint32_t reserved[3] = {};
+    };
+    static_assert(sizeof(EntityRecord) == 40, "EntityRecord is written to disk as-is");
+    static constexpr uint32_t RECORD_OBSERVED = 1u << 0;   // Entity carried CPUObserved
+
+    // A restored row, decoded from the file for ECS reconstruction
+    struct RestoredRow {
+        uint32_t gpuIndex = 0;
+        EntityRecord record;
+        glm::vec4 position{0.0f};
+        glm::vec4 color{1.0f};
+        glm::vec4 movementParams{0.0f};   // amplitude, frequency, phase, timeOffset
+    };
+
+    struct RestoreResult {
+        uint32_t rowCount = 0;
+        uint32_t releasedRowCount = 0;
+        float simulationTime = 0.0f;      // Time of the step after the captured one
+        uint32_t simulationStep = 0;      // Index of that step (SimulationClock)
+        std::vector<RestoredRow> rows;    // Live rows only, ascending GPU index
+    };
+
+    SimulationSnapshot() = default;
+    ~SimulationSnapshot();
+
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator);
+    void cleanup();
+
+    // Arms a capture of the next recorded frame; false while another one is in flight
+    bool requestCapture(const std::string& path);
+    bool isCapturePending() const { return state != CaptureState::Idle; }
+    bool wantsCapture() const { return state == CaptureState::Requested; }
+
+    // Call after the fence wait for frameIndex: writes the file once the captured frame has completed
+    void beginFrame(uint32_t frameIndex);
+
+    // Records copies of rowCount rows of every column. records holds one entry per row
+    void recordCapture(VkCommandBuffer commandBuffer, const EntityBufferManager& buffers, uint32_t rowCount,
+                       uint32_t releasedRowCount, std::vector<EntityRecord> records, float simulationTime,
+                       uint32_t simulationStep);
+
+    // Maps the file and copies its columns into the entity buffers. The device must be idle
+    bool restore(const std::string& path, EntityBufferManager& buffers, RestoreResult& result);
+
+private:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr VkDeviceSize COLUMN_ALIGNMENT = 256;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t rowCount;
+        uint32_t releasedRowCount;
+        float simulationTime;
+        uint32_t maxEntities;
+        uint64_t simulationStep;
+        uint64_t recordOffset;                   // From the start of the file
+        uint64_t columnOffsets[COLUMN_COUNT];    // From the start of the file, COLUMN_ALIGNMENT aligned
+        uint64_t columnSizes[COLUMN_COUNT];
+        uint64_t strides[COLUMN_COUNT];          // Must match the live schema on restore
+    };
+
+    enum class CaptureState { Idle, Requested, Recorded };
+
+    // Layout shared by capture and restore: column offsets relative to the first column
+    struct Layout {
+        std::array<VkDeviceSize, COLUMN_COUNT> offsets{};
+        std::array<VkDeviceSize, COLUMN_COUNT> sizes{};
+        std::array<VkDeviceSize, COLUMN_COUNT> strides{};
+        VkDeviceSize totalSize = 0;
+    };
+    static Layout computeLayout(const EntityBufferManager& buffers, uint32_t rowCount);
+    static std::array<VkBuffer, COLUMN_COUNT> columnBuffers(const EntityBufferManager& buffers);
+
+    bool writeFile();
+
+    const VulkanContext* context = nullptr;
+    ResourceCoordinator* resourceCoordinator = nullptr;
+
+    // Requested from the simulation thread, advanced by recording on the render thread
+    std::atomic<CaptureState> state{CaptureState::Idle};
+    std::string capturePath;
+    uint32_t currentFrameIndex = 0;
+    uint32_t captureFrameIndex = 0;
+
+    // Captured frame, written once its fence has passed
+    ResourceHandle captureBuffer;
+    Layout captureLayout;
+    uint32_t captureRowCount = 0;
+    uint32_t captureReleasedRowCount = 0;
+    uint32_t captureMaxEntities = 0;
+    float captureTime = 0.0f;
+    uint32_t captureStep = 0;
+    std::vector<EntityRecord> captureRecords;
+};
@@ -0,0 +1,263 @@
+#include "spatial_query_batch.h"
+#include "../../vulkan/core/vulkan_context.h"
+#include "../../vulkan/core/vulkan_function_loader.h"
+#include "../../vulkan/resources/core/resource_coordinator.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // Nearest queries keep every entity tied at the minimum distance, then pick the lowest row
+    constexpr uint32_t NEAREST_TIE_CAPACITY = 4;
+    constexpr VkDeviceSize RECORD_SIZE = sizeof(glm::uvec4);
+}
+
+SpatialQueryBatch::~SpatialQueryBatch() {
+    cleanup();
+}
+
+bool SpatialQueryBatch::initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator) {
+    this->context = &context;
+    this->resourceCoordinator = resourceCoordinator;
+
+    // Slot buffers are allocated on first use, so a frame without queries costs nothing
+    std::cout << "SpatialQueryBatch: Initialized (" << MAX_SPATIAL_QUERIES << " queries, "
+              << MAX_SPATIAL_QUERY_HITS << " hits per frame)" << std::endl;
+    return true;
+}
+
+void SpatialQueryBatch::cleanup() {
+    if (resourceCoordinator) {
+        for (auto& slot : slots) {
+            if (slot.buffer.isValid()) {
+                resourceCoordinator->destroyResource(slot.buffer);
+            }
+            slot = Slot{};
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending.clear();
+    }
+    recordedQueries.clear();
+    context = nullptr;
+    resourceCoordinator = nullptr;
+}
+
+uint32_t SpatialQueryBatch::queryNearest(glm::vec2 point, float maxDistance, Callback callback) {
+    return submit(SpatialQueryType::Nearest, glm::vec4(point, maxDistance, 0.0f), NEAREST_TIE_CAPACITY, std::move(callback));
+}
+
+uint32_t SpatialQueryBatch::queryRadius(glm::vec2 center, float radius, uint32_t maxResults, Callback callback) {
+    return submit(SpatialQueryType::Radius, glm::vec4(center, radius, 0.0f), maxResults, std::move(callback));
+}
+
+uint32_t SpatialQueryBatch::queryRect(glm::vec2 min, glm::vec2 max, uint32_t maxResults, Callback callback) {
+    return submit(SpatialQueryType::Rect, glm::vec4(glm::min(min, max), glm::max(min, max)), maxResults, std::move(callback));
+}
+
+uint32_t SpatialQueryBatch::submit(SpatialQueryType type, const glm::vec4& params, uint32_t maxResults, Callback callback) {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    PendingQuery query{};
+    query.id = nextQueryId++;
+    query.query.params = params;
+    query.query.info = glm::uvec4(static_cast<uint32_t>(type), 0u, std::clamp(maxResults, 1u, MAX_SPATIAL_QUERY_HITS), 0u);
+    query.callback = std::move(callback);
+    pending.push_back(std::move(query));
+    return pending.back().id;
+}
+
+void SpatialQueryBatch::beginFrame(uint32_t frameIndex, const std::vector<flecs::entity>& gpuIndexToEntity) {
+    frameNumber++;
+    writeSlot = frameIndex % MAX_FRAMES_IN_FLIGHT;
+
+    Slot& slot = slots[writeSlot];
+    if (!slot.pending) {
+        return;
+    }
+    slot.pending = false;
+
+    // Callbacks may submit new queries, so detach the answered set before invoking them
+    QueryList answered = std::move(slot.queries);
+    slot.queries.clear();
+
+    // Coherent memory: the fence wait is all the synchronization the host read needs
+    const auto* headers = static_cast<const glm::uvec4*>(slot.buffer.mappedData);
+    const glm::uvec4* records = headers + answered.size();
+
+    SpatialQueryResult result;
+    for (size_t i = 0; i < answered.size(); ++i) {
+        const PendingQuery& query = answered[i];
+        const uint32_t matched = headers[i].x;
+        const uint32_t capacity = query.query.info.z;
+        const glm::uvec4* queryRecords = records + query.query.info.y;
+
+        result.queryId = query.id;
+        result.type = static_cast<SpatialQueryType>(query.query.info.x);
+        result.frame = slot.frame;
+        result.hits.clear();
+        result.truncated = result.type != SpatialQueryType::Nearest && matched > capacity;
+
+        for (uint32_t k = 0; k < std::min(matched, capacity); ++k) {
+            const glm::uvec4& record = queryRecords[k];
+            SpatialQueryHit hit;
+            hit.gpuIndex = record.x;
+            hit.position = glm::vec2(glm::uintBitsToFloat(record.y), glm::uintBitsToFloat(record.z));
+            hit.distance = glm::uintBitsToFloat(record.w);
+            if (hit.gpuIndex < gpuIndexToEntity.size() && gpuIndexToEntity[hit.gpuIndex].is_alive()) {
+                hit.entity = gpuIndexToEntity[hit.gpuIndex];
+            }
+            result.hits.push_back(hit);
+        }
+
+        // Ties at the minimum distance are appended in arbitrary order; keep the lowest row
+        if (result.type == SpatialQueryType::Nearest && result.hits.size() > 1) {
+            auto nearest = std::min_element(result.hits.begin(), result.hits.end(),
+                [](const SpatialQueryHit& a, const SpatialQueryHit& b) { return a.gpuIndex < b.gpuIndex; });
+            result.hits = {*nearest};
+        }
+
+        if (query.callback) {
+            query.callback(result);
+        }
+    }
+}
+
+bool SpatialQueryBatch::prepareRecording() {
+    recordedQueries.clear();
+    recordedHitCapacity = 0;
+    recordedNearest = false;
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    if (!context || pending.empty()) {
+        return false;
+    }
+
+    // Take queries in submission order while both per-frame budgets hold
+    while (!pending.empty() && recordedQueries.size() < MAX_SPATIAL_QUERIES) {
+        PendingQuery& query = pending.front();
+        const uint32_t capacity = query.query.info.z;
+        if (recordedHitCapacity + capacity > MAX_SPATIAL_QUERY_HITS) {
+            break;
+        }
+        query.query.info.y = recordedHitCapacity;
+        recordedHitCapacity += capacity;
+        recordedNearest |= query.query.info.x == static_cast<uint32_t>(SpatialQueryType::Nearest);
+        recordedQueries.push_back(std::move(query));
+        pending.pop_front();
+    }
+
+    Slot& slot = slots[writeSlot];
+    VkDeviceSize requiredSize = (recordedQueries.size() + recordedHitCapacity) * RECORD_SIZE;
+    if (!ensureCapacity(slot, requiredSize)) {
+        // Put the batch back so it is retried next frame
+        for (auto it = recordedQueries.rbegin(); it != recordedQueries.rend(); ++it) {
+            pending.push_front(std::move(*it));
+        }
+        recordedQueries.clear();
+        return false;
+    }
+    return true;
+}
+
+void SpatialQueryBatch::recordUpload(VkCommandBuffer commandBuffer, VkBuffer queryBuffer, VkBuffer resultBuffer) {
+    const auto& vk = context->getLoader();
+    const VkDeviceSize queryCount = recordedQueries.size();
+
+    uploadScratch.clear();
+    for (const PendingQuery& query : recordedQueries) {
+        uploadScratch.push_back(query.query);
+    }
+
+    // The previous frame's query pass may still be reading these buffers
+    VkMemoryBarrier2 previousToTransfer{};
+    previousToTransfer.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    previousToTransfer.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_COPY_BIT;
+    previousToTransfer.srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_READ_BIT;
+    previousToTransfer.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    previousToTransfer.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &previousToTransfer;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    // At most 2 KB of queries, well inside vkCmdUpdateBuffer's 64 KB limit
+    vk.vkCmdUpdateBuffer(commandBuffer, queryBuffer, 0, queryCount * sizeof(GPUQuery), uploadScratch.data());
+    vk.vkCmdFillBuffer(commandBuffer, resultBuffer, 0, queryCount * RECORD_SIZE, 0);
+
+    // Queries and cleared headers, plus physics' position writes, become visible to the query pass
+    VkMemoryBarrier2 transferToCompute{};
+    transferToCompute.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    transferToCompute.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    transferToCompute.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+    transferToCompute.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    transferToCompute.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+    dependencyInfo.pMemoryBarriers = &transferToCompute;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+
+void SpatialQueryBatch::recordReadback(VkCommandBuffer commandBuffer, VkBuffer resultBuffer) {
+    const auto& vk = context->getLoader();
+    const VkDeviceSize queryCount = recordedQueries.size();
+    Slot& slot = slots[writeSlot];
+
+    VkMemoryBarrier2 computeToCopy{};
+    computeToCopy.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    computeToCopy.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    computeToCopy.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+    computeToCopy.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    computeToCopy.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &computeToCopy;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    // Headers, then only the hit records this frame's queries reserved
+    std::array<VkBufferCopy, 2> regions{};
+    regions[0] = {0, 0, queryCount * RECORD_SIZE};
+    regions[1] = {MAX_SPATIAL_QUERIES * RECORD_SIZE, queryCount * RECORD_SIZE, recordedHitCapacity * RECORD_SIZE};
+    vk.vkCmdCopyBuffer(commandBuffer, resultBuffer, slot.buffer.buffer.get(), static_cast<uint32_t>(regions.size()), regions.data());
+
+    // Make the copy visible to host reads once the frame fence signals
+    VkMemoryBarrier2 copyToHost{};
+    copyToHost.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    copyToHost.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    copyToHost.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    copyToHost.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+    copyToHost.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+    dependencyInfo.pMemoryBarriers = &copyToHost;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    slot.queries = std::move(recordedQueries);
+    slot.frame = frameNumber;
+    slot.pending = true;
+    recordedQueries.clear();
+}
+
+bool SpatialQueryBatch::ensureCapacity(Slot& slot, VkDeviceSize requiredSize) {
+    if (slot.buffer.isValid() && slot.buffer.size >= requiredSize) {
+        return true;
+    }
+
+    // The write slot's previous copy has completed (its fence was waited on), so it can be replaced
+    const VkDeviceSize previousSize = slot.buffer.size;
+    if (slot.buffer.isValid()) {
+        resourceCoordinator->destroyResource(slot.buffer);
+    }
+
+    // Grow geometrically; the worst case is bounded by the per-frame query and hit budgets
+    constexpr VkDeviceSize MIN_SLOT_SIZE = 4096;
+    VkDeviceSize newSize = std::max({requiredSize, previousSize * 2, MIN_SLOT_SIZE});
+    slot.buffer = resourceCoordinator->createMappedBuffer(newSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    slot.pending = false;
+
+    if (!slot.buffer.isValid() || !slot.buffer.mappedData) {
+        std::cerr << "SpatialQueryBatch: Failed to allocate " << newSize << " byte readback slot" << std::endl;
+        slot.buffer = ResourceHandle{};
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "../../vulkan/core/vulkan_constants.h"
+#include "../../vulkan/resources/core/resource_handle.h"
+#include "../../vulkan/monitoring/memory_accounting.h"
+#include <vulkan/vulkan.h>
+#include <flecs.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Forward declarations
+class VulkanContext;
+class ResourceCoordinator;
+
+enum class SpatialQueryType : uint32_t {
+    Nearest = 0,   // Closest entity to a point, within a maximum distance
+    Radius = 1,    // Every entity within a radius of a point
+    Rect = 2       // Every entity inside an axis-aligned rectangle
+};
+
+struct SpatialQueryHit {
+    flecs::entity entity;     // Invalid if the row has been released since the query ran
+    uint32_t gpuIndex = 0;
+    glm::vec2 position{0.0f};
+    float distance = 0.0f;    // From the query point (0 for rect queries)
+};
+
+struct SpatialQueryResult {
+    uint32_t queryId = 0;
+    SpatialQueryType type = SpatialQueryType::Nearest;
+    std::vector<SpatialQueryHit> hits;   // Nearest queries yield at most one hit
+    bool truncated = false;              // More entities matched than maxResults
+    uint64_t frame = 0;                  // Frame the query was answered in
+};
+
+/**
+ * Batched GPU spatial queries (nearest point, radius, rect) answered by SpatialQueryNode.
+ *
+ * Queries submitted during a frame are uploaded with vkCmdUpdateBuffer, answered by one
+ * spatial_query.comp pass over the physics output (a second pass resolves nearest queries),
+ * and copied into a per-frame-in-flight mapped slot. beginFrame() decodes a slot only after
+ * its frame fence has been waited on and invokes each query's callback, so results arrive
+ * MAX_FRAMES_IN_FLIGHT frames later and the CPU never blocks on the GPU.
+ *
+ * Up to MAX_SPATIAL_QUERIES queries and MAX_SPATIAL_QUERY_HITS hit records run per frame;
+ * anything beyond that waits in the pending queue for the next frame.
+ */
+class SpatialQueryBatch {
+public:
+    using Callback = std::function<void(const SpatialQueryResult&)>;
+
+    // GPU layout of one query (std430, must match spatial_query.comp)
+    struct GPUQuery {
+        glm::vec4 params{0.0f};   // Nearest/Radius: center.xy, distance; Rect: min.xy, max.xy
+        glm::uvec4 info{0u};      // type, first hit record, hit capacity, reserved
+    };
+    static_assert(sizeof(GPUQuery) == 32, "GPUQuery must match the std430 layout in spatial_query.comp");
+
+    SpatialQueryBatch() = default;
+    ~SpatialQueryBatch();
+
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator);
+    void cleanup();
+
+    // Submission; the returned id is echoed in the result
+    uint32_t queryNearest(glm::vec2 point, float maxDistance, Callback callback);
+    uint32_t queryRadius(glm::vec2 center, float radius, uint32_t maxResults, Callback callback);
+    uint32_t queryRect(glm::vec2 min, glm::vec2 max, uint32_t maxResults, Callback callback);
+    size_t getPendingCount() const {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        return pending.size();
+    }
+
+    // Call after the fence wait for frameIndex: answers the slot's completed queries, then makes it the write slot.
+    // gpuIndexToEntity resolves hit rows to ECS entities
+    void beginFrame(uint32_t frameIndex, const std::vector<flecs::entity>& gpuIndexToEntity);
+
+    // Recording, in order: prepare -> upload -> dispatch(es) -> readback. prepare returns false when idle
+    bool prepareRecording();
+    uint32_t getRecordedQueryCount() const { return static_cast<uint32_t>(recordedQueries.size()); }
+    bool hasRecordedNearestQueries() const { return recordedNearest; }
+    void recordUpload(VkCommandBuffer commandBuffer, VkBuffer queryBuffer, VkBuffer resultBuffer);
+    void recordReadback(VkCommandBuffer commandBuffer, VkBuffer resultBuffer);
+
+private:
+    struct PendingQuery {
+        uint32_t id;
+        GPUQuery query;
+        Callback callback;
+    };
+    using QueryList = CountedVector<PendingQuery, CpuMemorySubsystem::SpatialQueries>;
+
+    struct Slot {
+        ResourceHandle buffer;
+        QueryList queries;   // In upload order, captured at record time
+        uint64_t frame = 0;
+        bool pending = false;                // Copy recorded, not yet decoded
+    };
+
+    uint32_t submit(SpatialQueryType type, const glm::vec4& params, uint32_t maxResults, Callback callback);
+    bool ensureCapacity(Slot& slot, VkDeviceSize requiredSize);
+
+    const VulkanContext* context = nullptr;
+    ResourceCoordinator* resourceCoordinator = nullptr;
+
+    std::array<Slot, MAX_FRAMES_IN_FLIGHT> slots;
+    uint32_t writeSlot = 0;
+    uint64_t frameNumber = 0;
+
+    // Queries arrive from the simulation thread while the render thread records, see FramePipeline
+    mutable std::mutex pendingMutex;
+    std::deque<PendingQuery, CountingAllocator<PendingQuery, CpuMemorySubsystem::SpatialQueries>> pending;
+    QueryList recordedQueries;
+    CountedVector<GPUQuery, CpuMemorySubsystem::SpatialQueries> uploadScratch;
+    uint32_t recordedHitCapacity = 0;
+    bool recordedNearest = false;
+    uint32_t nextQueryId = 1;
+};
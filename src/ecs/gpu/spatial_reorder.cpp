@@ -0,0 +1,141 @@
+#include "spatial_reorder.h"
+#include "../../vulkan/core/vulkan_context.h"
+#include "../../vulkan/core/vulkan_function_loader.h"
+#include "../../vulkan/resources/core/resource_coordinator.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // std430 header of the reorder buffer, must match spatial_reorder.comp
+    constexpr VkDeviceSize STATS_SIZE = sizeof(uint32_t) * 4;
+
+    float coherence(uint32_t near, uint32_t linked) {
+        return linked > 0 ? static_cast<float>(near) / static_cast<float>(linked) : 1.0f;
+    }
+}
+
+SpatialReorder::~SpatialReorder() {
+    cleanup();
+}
+
+bool SpatialReorder::initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
+    this->context = &context;
+    this->resourceCoordinator = resourceCoordinator;
+
+    readbackBuffer = resourceCoordinator->createMappedBuffer(STATS_SIZE + static_cast<VkDeviceSize>(maxEntities) * sizeof(uint32_t),
+                                                             VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    if (!readbackBuffer.isValid() || !readbackBuffer.mappedData) {
+        std::cerr << "SpatialReorder: Failed to allocate permutation readback buffer" << std::endl;
+        readbackBuffer = ResourceHandle{};
+        return false;
+    }
+
+    reordered.reserve(maxEntities);
+    return true;
+}
+
+void SpatialReorder::cleanup() {
+    if (resourceCoordinator && readbackBuffer.isValid()) {
+        resourceCoordinator->destroyResource(readbackBuffer);
+    }
+    readbackBuffer = ResourceHandle{};
+    inFlight = false;
+    context = nullptr;
+    resourceCoordinator = nullptr;
+}
+
+bool SpatialReorder::beginRecording(uint32_t rowCount) {
+    if (!context || interval == 0) {
+        return false;
+    }
+
+    framesSinceReorder++;
+    if (inFlight || framesSinceReorder < interval || rowCount < 2) {
+        return false;
+    }
+
+    framesSinceReorder = 0;
+    return true;
+}
+
+void SpatialReorder::recordReadback(VkCommandBuffer commandBuffer, VkBuffer reorderBuffer, uint32_t rowCount) {
+    const auto& vk = context->getLoader();
+
+    // The metric and gather passes finished writing the header and permutation
+    VkMemoryBarrier2 computeToCopy{};
+    computeToCopy.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    computeToCopy.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    computeToCopy.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+    computeToCopy.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    computeToCopy.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &computeToCopy;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    const VkDeviceSize sectionSize = readbackBuffer.size - STATS_SIZE;
+    VkBufferCopy regions[2]{};
+    regions[0].srcOffset = 0;
+    regions[0].dstOffset = 0;
+    regions[0].size = STATS_SIZE;
+    regions[1].srcOffset = SPATIAL_REORDER_HEADER_WORDS * sizeof(uint32_t) + sectionSize;   // Permutation section
+    regions[1].dstOffset = STATS_SIZE;
+    regions[1].size = static_cast<VkDeviceSize>(rowCount) * sizeof(uint32_t);
+    vk.vkCmdCopyBuffer(commandBuffer, reorderBuffer, readbackBuffer.buffer.get(), 2, regions);
+
+    VkMemoryBarrier2 copyToHost{};
+    copyToHost.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    copyToHost.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    copyToHost.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    copyToHost.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+    copyToHost.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+    dependencyInfo.pMemoryBarriers = &copyToHost;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    inFlight = true;
+    inFlightSlot = writeSlot;
+    inFlightRows = rowCount;
+}
+
+bool SpatialReorder::beginFrame(uint32_t frameIndex, std::vector<flecs::entity>& gpuIndexToEntity) {
+    writeSlot = frameIndex % MAX_FRAMES_IN_FLIGHT;
+    if (!inFlight || inFlightSlot != writeSlot) {
+        return false;
+    }
+    inFlight = false;
+
+    // Coherent memory: the fence wait is all the synchronization the host read needs
+    const auto* words = static_cast<const uint32_t*>(readbackBuffer.mappedData);
+    const uint32_t* permutation = words + 4;
+
+    if (gpuIndexToEntity.size() < inFlightRows) {
+        gpuIndexToEntity.resize(inFlightRows);
+    }
+
+    reordered.resize(inFlightRows);
+    for (uint32_t row = 0; row < inFlightRows; ++row) {
+        if (permutation[row] >= inFlightRows) {
+            std::cerr << "SpatialReorder: Invalid permutation entry " << permutation[row] << " at row " << row
+                      << ", row mapping left unchanged" << std::endl;
+            return false;
+        }
+        reordered[row] = gpuIndexToEntity[permutation[row]];
+    }
+    std::copy(reordered.begin(), reordered.end(), gpuIndexToEntity.begin());
+
+    stats.reorderCount++;
+    stats.rowCount = inFlightRows;
+    stats.coherenceBefore = coherence(words[0], words[1]);
+    stats.coherenceAfter = coherence(words[2], words[3]);
+
+    std::cout << "SpatialReorder: Reordered " << inFlightRows << " rows, neighbour coherence "
+              << stats.coherenceBefore * 100.0f << "% -> " << stats.coherenceAfter * 100.0f << "%" << std::endl;
+    return true;
+}
+
+void SpatialReorder::cancel() {
+    inFlight = false;
+    framesSinceReorder = 0;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../../vulkan/core/vulkan_constants.h"
+#include "../../vulkan/resources/core/resource_handle.h"
+#include <vulkan/vulkan.h>
+#include <flecs.h>
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+class VulkanContext;
+class ResourceCoordinator;
+
+/**
+ * Periodic spatial reordering of the entity rows, recorded by SpatialReorderNode.
+ *
+ * Rows follow spawn order, so once entities disperse the neighbours a collision step walks
+ * through the spatial map are scattered across every column. Every `interval` frames the node
+ * sorts the rows by Morton code (or row-major grid cell) of their position with
+ * GpuPrimitives::recordRadixSort and gathers every per-entity column into that order.
+ *
+ * The permutation is only known on the GPU, so it is copied into a mapped buffer and applied
+ * to the GPU -> ECS row mapping from beginFrame() once the frame that recorded it has completed.
+ * Until then the mapping is stale: readback, spatial queries and snapshots hold off while
+ * isInFlight(), and at most one reorder is in flight.
+ *
+ * Coherence is the share of spatial map chain links (entity -> next entity in the same cell)
+ * whose two rows lie within SPATIAL_REORDER_COHERENCE_WINDOW rows of each other, measured
+ * before and after each reorder.
+ */
+class SpatialReorder {
+public:
+    enum class KeyMode : uint32_t {
+        Morton = 0,     // Z-order over grid cells; nearby cells stay nearby in memory
+        GridCell = 1    // Row-major cell index; each cell is contiguous, rows of cells are not
+    };
+
+    struct Stats {
+        uint64_t reorderCount = 0;
+        uint32_t rowCount = 0;          // Rows permuted by the last reorder
+        float coherenceBefore = 0.0f;   // 0..1, see class comment
+        float coherenceAfter = 0.0f;
+    };
+
+    SpatialReorder() = default;
+    ~SpatialReorder();
+
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities);
+    void cleanup();
+
+    // Reorder every N frames; 0 disables reordering (the default)
+    void setInterval(uint32_t frames) { interval = frames; }
+    uint32_t getInterval() const { return interval; }
+    void setKeyMode(KeyMode mode) { keyMode = mode; }
+    KeyMode getKeyMode() const { return keyMode; }
+
+    // Called once per frame by SpatialReorderNode; true when a reorder of rowCount rows should be recorded now
+    bool beginRecording(uint32_t rowCount);
+
+    // Records the copy of the permutation and stats out of the reorder buffer and marks the reorder in flight
+    void recordReadback(VkCommandBuffer commandBuffer, VkBuffer reorderBuffer, uint32_t rowCount);
+
+    // Call after the fence wait for frameIndex. Returns true when the reorder recorded in that slot
+    // completed and its permutation has been applied to gpuIndexToEntity
+    bool beginFrame(uint32_t frameIndex, std::vector<flecs::entity>& gpuIndexToEntity);
+
+    // Drops an in-flight reorder whose rows have been replaced (snapshot restore, clear)
+    void cancel();
+
+    bool isInFlight() const { return inFlight; }
+    const Stats& getStats() const { return stats; }
+
+private:
+    const VulkanContext* context = nullptr;
+    ResourceCoordinator* resourceCoordinator = nullptr;
+
+    // Stats uvec4 followed by the permutation (new row -> old row)
+    ResourceHandle readbackBuffer;
+
+    uint32_t interval = 0;
+    KeyMode keyMode = KeyMode::Morton;
+    uint32_t framesSinceReorder = 0;
+
+    uint32_t writeSlot = 0;
+    bool inFlight = false;
+    uint32_t inFlightSlot = 0;
+    uint32_t inFlightRows = 0;
+
+    Stats stats;
+    std::vector<flecs::entity> reordered;
+};
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "buffer_base.h"
+#include "../../vulkan/core/vulkan_constants.h"
 #include <glm/glm.hpp>
 
 /**
  * Specialized buffer classes following Single Responsibility Principle
  * Each class manages exactly one type of entity data
+ * Element sizes default to the legacy layout; EntityBufferManager passes EntitySchema strides
  */
 
 // SINGLE responsibility: velocity data management
@@ -13,8 +15,9 @@ class VelocityBuffer : public BufferBase {
 public:
     using BufferBase::initialize; // Bring base class initialize into scope
     
-    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
-        return BufferBase::initialize(context, resourceCoordinator, maxEntities, sizeof(glm::vec4), 0);
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                    VkDeviceSize elementSize = sizeof(glm::vec4)) {
+        return BufferBase::initialize(context, resourceCoordinator, maxEntities, elementSize, 0);
     }
     
 protected:
@@ -26,8 +29,9 @@ class MovementParamsBuffer : public BufferBase {
 public:
     using BufferBase::initialize; // Bring base class initialize into scope
     
-    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
-        return BufferBase::initialize(context, resourceCoordinator, maxEntities, sizeof(glm::vec4), 0);
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                    VkDeviceSize elementSize = sizeof(glm::vec4)) {
+        return BufferBase::initialize(context, resourceCoordinator, maxEntities, elementSize, 0);
     }
     
 protected:
@@ -39,8 +43,9 @@ class RuntimeStateBuffer : public BufferBase {
 public:
     using BufferBase::initialize; // Bring base class initialize into scope
     
-    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
-        return BufferBase::initialize(context, resourceCoordinator, maxEntities, sizeof(glm::vec4), 0);
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                    VkDeviceSize elementSize = sizeof(glm::vec4)) {
+        return BufferBase::initialize(context, resourceCoordinator, maxEntities, elementSize, 0);
     }
     
 protected:
@@ -52,8 +57,9 @@ class RotationStateBuffer : public BufferBase {
 public:
     using BufferBase::initialize; // Bring base class initialize into scope
     
-    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
-        return BufferBase::initialize(context, resourceCoordinator, maxEntities, sizeof(glm::vec4), 0);
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                    VkDeviceSize elementSize = sizeof(glm::vec4)) {
+        return BufferBase::initialize(context, resourceCoordinator, maxEntities, elementSize, 0);
     }
     
 protected:
@@ -65,8 +71,9 @@ class ColorBuffer : public BufferBase {
 public:
     using BufferBase::initialize; // Bring base class initialize into scope
     
-    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
-        return BufferBase::initialize(context, resourceCoordinator, maxEntities, sizeof(glm::vec4), 0);
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                    VkDeviceSize elementSize = sizeof(glm::vec4)) {
+        return BufferBase::initialize(context, resourceCoordinator, maxEntities, elementSize, 0);
     }
     
 protected:
@@ -78,8 +85,9 @@ class ModelMatrixBuffer : public BufferBase {
 public:
     using BufferBase::initialize; // Bring base class initialize into scope
     
-    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
-        return BufferBase::initialize(context, resourceCoordinator, maxEntities, sizeof(glm::mat4), 0);
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                    VkDeviceSize elementSize = sizeof(glm::mat4)) {
+        return BufferBase::initialize(context, resourceCoordinator, maxEntities, elementSize, 0);
     }
     
 protected:
@@ -91,8 +99,9 @@ class PositionBuffer : public BufferBase {
 public:
     using BufferBase::initialize; // Bring base class initialize into scope
     
-    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
-        return BufferBase::initialize(context, resourceCoordinator, maxEntities, sizeof(glm::vec4), 0);
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                    VkDeviceSize elementSize = sizeof(glm::vec4)) {
+        return BufferBase::initialize(context, resourceCoordinator, maxEntities, elementSize, 0);
     }
     
 protected:
@@ -111,4 +120,104 @@ public:
     
 protected:
     const char* getBufferTypeName() const override { return "SpatialMap"; }
+};
+
+// SINGLE responsibility: one frame's batched spatial queries (recorded with vkCmdUpdateBuffer)
+class SpatialQueryBuffer : public BufferBase {
+public:
+    using BufferBase::initialize; // Bring base class initialize into scope
+    
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxQueries) {
+        // Each query is a vec4 of shape parameters plus a uvec4 of type/capacity info
+        return BufferBase::initialize(context, resourceCoordinator, maxQueries, sizeof(glm::vec4) + sizeof(glm::uvec4), 0);
+    }
+    
+protected:
+    const char* getBufferTypeName() const override { return "SpatialQuery"; }
+};
+
+// SINGLE responsibility: spatial query headers and hit records, copied back for the CPU
+class SpatialQueryResultBuffer : public BufferBase {
+public:
+    using BufferBase::initialize; // Bring base class initialize into scope
+    
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxQueries, uint32_t maxHits) {
+        // One uvec4 header per query followed by uvec4 hit records
+        return BufferBase::initialize(context, resourceCoordinator, maxQueries + maxHits, sizeof(glm::uvec4), 0);
+    }
+    
+protected:
+    const char* getBufferTypeName() const override { return "SpatialQueryResult"; }
+};
+
+// SINGLE responsibility: per-entity spatial map links and narrowphase contacts
+class CollisionLinkBuffer : public BufferBase {
+public:
+    using BufferBase::initialize; // Bring base class initialize into scope
+    
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
+        // uvec2 per entity: next entity in the same cell, lowest-index contact partner
+        return BufferBase::initialize(context, resourceCoordinator, maxEntities, sizeof(glm::uvec2), 0);
+    }
+    
+protected:
+    const char* getBufferTypeName() const override { return "CollisionLink"; }
+};
+
+// SINGLE responsibility: broadphase candidate pairs, consumed by an indirect narrowphase dispatch
+class CollisionPairBuffer : public BufferBase {
+public:
+    using BufferBase::initialize; // Bring base class initialize into scope
+    
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxPairs) {
+        // uvec4 header (VkDispatchIndirectCommand + pair count) takes the first two uvec2 slots
+        return BufferBase::initialize(context, resourceCoordinator, maxPairs + 2, sizeof(glm::uvec2),
+                                      VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+    }
+    
+protected:
+    const char* getBufferTypeName() const override { return "CollisionPair"; }
+};
+
+// SINGLE responsibility: spatial reorder sort keys, permutation and coherence stats
+class SpatialReorderBuffer : public BufferBase {
+public:
+    using BufferBase::initialize; // Bring base class initialize into scope
+    
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities) {
+        // Header, then keys, permutation (new row -> old row) and inverse, maxEntities uints each
+        return BufferBase::initialize(context, resourceCoordinator, SPATIAL_REORDER_HEADER_WORDS + 3 * maxEntities,
+                                      sizeof(uint32_t), 0);
+    }
+    
+protected:
+    const char* getBufferTypeName() const override { return "SpatialReorder"; }
+};
+
+// SINGLE responsibility: copy of one entity column while the reorder gathers it back
+class ReorderScratchBuffer : public BufferBase {
+public:
+    using BufferBase::initialize; // Bring base class initialize into scope
+    
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator, uint32_t maxEntities,
+                    VkDeviceSize largestStride) {
+        return BufferBase::initialize(context, resourceCoordinator, maxEntities, largestStride, 0);
+    }
+    
+protected:
+    const char* getBufferTypeName() const override { return "ReorderScratch"; }
+};
+
+// SINGLE responsibility: screen-space entity density splatted for the zoomed-out LOD
+class DensityBuffer : public BufferBase {
+public:
+    using BufferBase::initialize; // Bring base class initialize into scope
+    
+    bool initialize(const VulkanContext& context, ResourceCoordinator* resourceCoordinator) {
+        // uvec4 per texel: summed color.rgb (0-255 each) and entity count
+        return BufferBase::initialize(context, resourceCoordinator, DENSITY_MAX_TEXELS, sizeof(glm::uvec4), 0);
+    }
+    
+protected:
+    const char* getBufferTypeName() const override { return "Density"; }
 };
\ No newline at end of file
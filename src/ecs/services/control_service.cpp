@@ -3,6 +3,7 @@
 #include "camera_service.h"
 #include "rendering_service.h"
 #include "../../vulkan_renderer.h"
+#include "../../graphicstests.h"
 #include "../core/entity_factory.h"
 #include "../gpu/gpu_entity_manager.h"
 #include "../utilities/debug.h"
@@ -36,9 +37,9 @@ bool GameControlService::initialize(flecs::world& world, VulkanRenderer* rendere
     // Get service dependencies from ServiceLocator
     auto& locator = ServiceLocator::instance();
     
-    inputService = &locator.requireService<InputService>();
-    cameraService = &locator.requireService<CameraService>();
-    renderingService = &locator.requireService<RenderingService>();
+    inputService = locator.resolveService<InputService>();
+    cameraService = locator.resolveService<CameraService>();
+    renderingService = locator.resolveService<RenderingService>();
     
     if (!inputService) {
         std::cerr << "ControlService: InputService not found in ServiceLocator" << std::endl;
@@ -176,6 +177,15 @@ void GameControlService::handleInput() {
         executeAction("camera_focus");
     }
     
+    // Simulation snapshots
+    if (inputService->isActionJustPressed("save_snapshot")) {
+        executeAction("save_snapshot");
+    }
+    
+    if (inputService->isActionJustPressed("load_snapshot")) {
+        executeAction("load_snapshot");
+    }
+    
     // Handle continuous camera movement (analog actions)
     handleCameraControls();
 }
@@ -280,6 +290,22 @@ void GameControlService::initializeDefaultActions() {
         [this]() { actionCameraFocus(); },
         true, 0.5f, 0.0f
     });
+    
+    registerAction({
+        ControlActionType::SNAPSHOT,
+        "save_snapshot",
+        "Save simulation snapshot",
+        [this]() { actionSaveSnapshot(); },
+        true, 1.0f, 0.0f
+    });
+    
+    registerAction({
+        ControlActionType::SNAPSHOT,
+        "load_snapshot",
+        "Load simulation snapshot",
+        [this]() { actionLoadSnapshot(); },
+        true, 1.0f, 0.0f
+    });
 }
 
 void GameControlService::updateActionCooldowns() {
@@ -378,6 +404,20 @@ void GameControlService::integrateWithInputService() {
         {InputBinding(InputBinding::InputType::KEYBOARD_KEY, SDL_SCANCODE_F)}
     });
     
+    inputService->registerAction({
+        "save_snapshot",
+        InputActionType::DIGITAL,
+        "Save simulation snapshot",
+        {InputBinding(InputBinding::InputType::KEYBOARD_KEY, SDL_SCANCODE_F5)}
+    });
+    
+    inputService->registerAction({
+        "load_snapshot",
+        InputActionType::DIGITAL,
+        "Load simulation snapshot",
+        {InputBinding(InputBinding::InputType::KEYBOARD_KEY, SDL_SCANCODE_F9)}
+    });
+    
     // WASD camera movement controls - using DIGITAL for keyboard keys
     inputService->registerAction({
         "camera_move_forward",
@@ -468,6 +508,14 @@ void GameControlService::actionCameraFocus() {
     focusCameraOnEntities();
 }
 
+void GameControlService::actionSaveSnapshot() {
+    saveSnapshot(DEFAULT_SNAPSHOT_PATH);
+}
+
+void GameControlService::actionLoadSnapshot() {
+    loadSnapshot(DEFAULT_SNAPSHOT_PATH);
+}
+
 // Game logic implementations
 void GameControlService::toggleMovementType() {
     controlState.currentMovementType = (controlState.currentMovementType + 1) % 1; // Only RandomWalk for now
@@ -506,17 +554,59 @@ void GameControlService::createEntity(const glm::vec2& position) {
 void GameControlService::createSwarm(size_t count, const glm::vec3& center, float radius) {
     if (!entityFactory || !renderer) return;
     
-    auto entities = entityFactory->createSwarm(count, center, radius);
-    
     auto* gpuEntityManager = renderer->getGPUEntityManager();
     if (gpuEntityManager) {
-        gpuEntityManager->addEntitiesFromECS(entities);
+        // Components and GPU staging rows are written in one pass
+        count = std::min(count, gpuEntityManager->getRemainingCapacity());
+        auto entities = entityFactory->createSwarmBulk(count, center, radius, &gpuEntityManager->getStagingEntities());
+        gpuEntityManager->registerStagedEntities(entities);
         gpuEntityManager->uploadPendingEntities();
+    } else {
+        entityFactory->createSwarmBulk(count, center, radius);
     }
     
     DEBUG_LOG("Created swarm of " << count << " entities");
 }
 
+bool GameControlService::saveSnapshot(const std::string& path) {
+    if (!renderer || !renderer->getGPUEntityManager()) return false;
+    return renderer->getGPUEntityManager()->requestSnapshot(path);
+}
+
+bool GameControlService::loadSnapshot(const std::string& path) {
+    if (!world || !entityFactory || !renderer) return false;
+    
+    auto* gpuEntityManager = renderer->getGPUEntityManager();
+    if (!gpuEntityManager) return false;
+    
+    // Current entities go away with their rows; restoreSnapshot leaves the buffers untouched on failure.
+    // The render thread may be recording against the buffers about to be overwritten
+    renderer->quiesceRenderThread();
+    std::vector<flecs::entity> previous = gpuEntityManager->getMappedEntities();
+    SimulationSnapshot::RestoreResult result;
+    if (!gpuEntityManager->restoreSnapshot(path, result)) {
+        return false;
+    }
+    
+    for (auto& entity : previous) {
+        if (entity.is_alive()) {
+            entity.destruct();
+        }
+    }
+    
+    auto entities = entityFactory->createFromSnapshot(result.rows);
+    std::vector<uint32_t> gpuIndices;
+    gpuIndices.reserve(entities.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+        gpuIndices.push_back(result.rows[i].gpuIndex);
+    }
+    gpuEntityManager->registerRestoredEntities(gpuIndices, entities);
+    renderer->setSimulationTime(result.simulationTime, result.simulationStep);
+    
+    DEBUG_LOG("Loaded snapshot with " << entities.size() << " entities at t=" << result.simulationTime);
+    return true;
+}
+
 void GameControlService::showPerformanceStats() {
     if (!world) return;
     
@@ -545,16 +635,13 @@ void GameControlService::runGraphicsTests() {
     
     // Create additional test entities
     if (entityFactory && renderer) {
-        auto testEntities = entityFactory->createSwarm(5000, glm::vec3(0.0f, 0.0f, 0.0f), 15.0f);
-        
-        auto* gpuEntityManager = renderer->getGPUEntityManager();
-        if (gpuEntityManager) {
-            gpuEntityManager->addEntitiesFromECS(testEntities);
-            gpuEntityManager->uploadPendingEntities();
-        }
-        
+        createSwarm(5000, glm::vec3(0.0f, 0.0f, 0.0f), 15.0f);
         DEBUG_LOG("Created 5000 test entities for graphics testing");
     }
+    
+    GraphicsTests::runSpawnBenchmarks();
+    GraphicsTests::runGpuPrimitiveTests(renderer);
+    GraphicsTests::runDrawPathBenchmark(renderer);
 }
 
 void GameControlService::toggleDebugMode() {
@@ -687,6 +774,8 @@ void GameControlService::printControlInstructions() const {
     std::cout << "F3: Toggle debug mode" << std::endl;
     std::cout << "R: Reset camera" << std::endl;
     std::cout << "F: Focus camera on entities" << std::endl;
+    std::cout << "F5: Save simulation snapshot" << std::endl;
+    std::cout << "F9: Load simulation snapshot" << std::endl;
     std::cout << "WASD: Move camera" << std::endl;
     std::cout << "Right Click: Debug entity info at mouse position" << std::endl;
     std::cout << "Mouse Wheel: Zoom camera" << std::endl;
@@ -705,39 +794,30 @@ void GameControlService::debugEntityAtPosition(const glm::vec2& worldPos) {
         return;
     }
     
-    // Get the entity buffer manager for readback
-    auto& bufferManager = gpuEntityManager->getBufferManager();
-    
-    // Perform GPU readback at the clicked position with synchronization
-    EntityBufferManager::EntityDebugInfo debugInfo;
-    if (bufferManager.readbackEntityAtPositionSafe(worldPos, debugInfo)) {
-        // Get ECS entity ID from GPU index
-        auto ecsEntity = gpuEntityManager->getECSEntityFromGPUIndex(debugInfo.entityId);
-        
-        std::cout << "\n=== ENTITY DEBUG INFO ===" << std::endl;
-        std::cout << "World Position: (" << worldPos.x << ", " << worldPos.y << ")" << std::endl;
-        std::cout << "GPU Buffer Index: " << debugInfo.entityId << std::endl;
-        std::cout << "ECS Entity ID: " << std::hex << ecsEntity.id() << std::dec;
-        if (ecsEntity.is_valid()) {
-            std::cout << " (valid)";
-        } else {
-            std::cout << " (invalid/unmapped)";
-        }
-        std::cout << std::endl;
-        std::cout << "Position: (" << debugInfo.position.x << ", " << debugInfo.position.y 
-                  << ", " << debugInfo.position.z << ")" << std::endl;
-        std::cout << "Velocity: (" << debugInfo.velocity.x << ", " << debugInfo.velocity.y 
-                  << ") | Damping: " << debugInfo.velocity.z << std::endl;
-        std::cout << "Spatial Cell: " << debugInfo.spatialCell << std::endl;
-        
-        // Calculate spatial cell coordinates for readability
-        const uint32_t GRID_WIDTH = 64;
-        uint32_t cellX = debugInfo.spatialCell % GRID_WIDTH;
-        uint32_t cellY = debugInfo.spatialCell / GRID_WIDTH;
-        std::cout << "Spatial Grid: (" << cellX << ", " << cellY << ")" << std::endl;
-        std::cout << "========================\n" << std::endl;
-    } else {
-        std::cout << "No entity found at world position (" << worldPos.x << ", " << worldPos.y << ")" << std::endl;
-    }
+    // Nearest-entity query answered by SpatialQueryNode; the result arrives a couple of frames later
+    // instead of stalling on a synchronous readback of spatial cells
+    constexpr float PICK_RADIUS = 5.0f;
+    gpuEntityManager->getSpatialQueries().queryNearest(worldPos, PICK_RADIUS,
+        [worldPos](const SpatialQueryResult& result) {
+            if (result.hits.empty()) {
+                std::cout << "No entity found at world position (" << worldPos.x << ", " << worldPos.y << ")" << std::endl;
+                return;
+            }
+            
+            const SpatialQueryHit& hit = result.hits.front();
+            std::cout << "\n=== ENTITY DEBUG INFO ===" << std::endl;
+            std::cout << "World Position: (" << worldPos.x << ", " << worldPos.y << ")" << std::endl;
+            std::cout << "GPU Buffer Index: " << hit.gpuIndex << std::endl;
+            std::cout << "ECS Entity ID: " << std::hex << hit.entity.id() << std::dec;
+            if (hit.entity.is_valid()) {
+                std::cout << " (valid)";
+            } else {
+                std::cout << " (invalid/unmapped)";
+            }
+            std::cout << std::endl;
+            std::cout << "Position: (" << hit.position.x << ", " << hit.position.y << ")" << std::endl;
+            std::cout << "Distance: " << hit.distance << " | Answered in frame " << result.frame << std::endl;
+            std::cout << "========================\n" << std::endl;
+        });
 }
 
@@ -24,7 +24,8 @@ enum class ControlActionType {
     PERFORMANCE_STATS,
     GRAPHICS_TESTS,
     CAMERA_CONTROL,
-    RENDERING_DEBUG
+    RENDERING_DEBUG,
+    SNAPSHOT
 };
 
 // Control action definition
@@ -99,6 +100,11 @@ public:
     void toggleDebugMode();
     void toggleWireframeMode();
     
+    // Simulation snapshots: save is written a couple of frames later, load replaces every entity
+    static constexpr const char* DEFAULT_SNAPSHOT_PATH = "fractalia.snapshot";
+    bool saveSnapshot(const std::string& path);
+    bool loadSnapshot(const std::string& path);
+    
     // Camera control integration
     void handleCameraControls();
     void resetCamera();
@@ -123,9 +129,9 @@ private:
     bool initialized = false;
     
     // Service dependencies
-    InputService* inputService = nullptr;
-    CameraService* cameraService = nullptr;
-    RenderingService* renderingService = nullptr;
+    ServiceRef<InputService> inputService;
+    ServiceRef<CameraService> cameraService;
+    ServiceRef<RenderingService> renderingService;
     
     // Control system state
     ControlState controlState;
@@ -157,5 +163,7 @@ private:
     void actionToggleDebug();
     void actionCameraReset();
     void actionCameraFocus();
+    void actionSaveSnapshot();
+    void actionLoadSnapshot();
 };
 
@@ -77,19 +77,23 @@ void InputEventProcessor::processSDLEvents() {
                 
             case SDL_EVENT_KEY_DOWN:
             case SDL_EVENT_KEY_UP:
+                noteInputTimestamp(event);
                 handleKeyboardEvent(event);
                 break;
                 
             case SDL_EVENT_MOUSE_BUTTON_DOWN:
             case SDL_EVENT_MOUSE_BUTTON_UP:
+                noteInputTimestamp(event);
                 handleMouseButtonEvent(event);
                 break;
                 
             case SDL_EVENT_MOUSE_MOTION:
+                noteInputTimestamp(event);
                 handleMouseMotionEvent(event);
                 break;
                 
             case SDL_EVENT_MOUSE_WHEEL:
+                noteInputTimestamp(event);
                 handleMouseWheelEvent(event);
                 break;
                 
@@ -167,6 +171,19 @@ bool InputEventProcessor::shouldQuit() const {
     return quitRequested;
 }
 
+uint64_t InputEventProcessor::takeOldestInputTimestampNS() {
+    uint64_t timestamp = oldestInputTimestampNS;
+    oldestInputTimestampNS = 0;
+    return timestamp;
+}
+
+void InputEventProcessor::noteInputTimestamp(const SDL_Event& event) {
+    // Event timestamps are taken when SDL queued the event, so queueing delay counts toward latency
+    if (oldestInputTimestampNS == 0 || event.common.timestamp < oldestInputTimestampNS) {
+        oldestInputTimestampNS = event.common.timestamp;
+    }
+}
+
 void InputEventProcessor::handleKeyboardEvent(const SDL_Event& event) {
     int scancode = event.key.scancode;
     bool pressed = (event.type == SDL_EVENT_KEY_DOWN);
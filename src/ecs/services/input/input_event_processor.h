@@ -59,6 +59,9 @@ public:
     // Input consumption (for UI systems)
     bool isInputConsumed() const { return inputConsumed; }
     void setInputConsumed(bool consumed) { inputConsumed = consumed; }
+    
+    // SDL timestamp (SDL_GetTicksNS clock) of the oldest keyboard/mouse event since the last call, 0 if none
+    uint64_t takeOldestInputTimestampNS();
 
 private:
     SDL_Window* window = nullptr;
@@ -71,6 +74,9 @@ private:
     int windowResizeHeight = 0;
     bool quitRequested = false;
     
+    // Oldest input event not yet handed to latency tracking
+    uint64_t oldestInputTimestampNS = 0;
+    
     // Input state
     KeyboardState keyboardState;
     MouseState mouseState;
@@ -81,4 +87,5 @@ private:
     void handleMouseMotionEvent(const SDL_Event& event);
     void handleMouseWheelEvent(const SDL_Event& event);
     void handleWindowEvent(const SDL_Event& event);
+    void noteInputTimestamp(const SDL_Event& event);
 };
\ No newline at end of file
@@ -54,10 +54,8 @@ bool InputService::initialize(flecs::world& world, SDL_Window* window) {
     // Setup defaults
     configManager->resetToDefaults();
     
-    // Cache service dependencies
-    if (ServiceLocator::instance().hasService<CameraService>()) {
-        cameraService = &ServiceLocator::instance().requireService<CameraService>();
-    }
+    // Cache service dependencies (empty handle if the camera service is not registered)
+    cameraService = ServiceLocator::instance().resolveService<CameraService>();
     
     initialized = true;
     return true;
@@ -236,7 +234,7 @@ glm::vec2 InputService::getMouseWorldPosition() const {
         return glm::vec2(0.0f);
     }
     
-    return ecsBridge->getMouseWorldPosition(eventProcessor->getMouseState(), cameraService, window);
+    return ecsBridge->getMouseWorldPosition(eventProcessor->getMouseState(), cameraService.get(), window);
 }
 
 glm::vec2 InputService::getMouseDelta() const {
@@ -299,6 +297,10 @@ bool InputService::hasWindowResizeEvent(int& width, int& height) const {
     return eventProcessor ? eventProcessor->hasWindowResizeEvent(width, height) : false;
 }
 
+uint64_t InputService::takeOldestInputTimestampNS() {
+    return eventProcessor ? eventProcessor->takeOldestInputTimestampNS() : 0;
+}
+
 // Debug and introspection
 std::vector<std::string> InputService::getActiveContexts() const {
     return contextManager ? contextManager->getActiveContexts() : std::vector<std::string>();
@@ -87,6 +87,9 @@ public:
     // Window event handling (delegated to InputEventProcessor)
     bool hasWindowResizeEvent(int& width, int& height) const;
     
+    // Input-to-submit latency tracking (delegated to InputEventProcessor)
+    uint64_t takeOldestInputTimestampNS();
+    
     // Debug and introspection
     std::vector<std::string> getActiveContexts() const;
     std::vector<std::string> getRegisteredActions() const;
@@ -105,7 +108,7 @@ private:
     SDL_Window* window = nullptr;
     
     // Service dependencies (cached references)
-    CameraService* cameraService = nullptr;
+    ServiceRef<CameraService> cameraService;
     
     // Modular components
     std::unique_ptr<InputEventProcessor> eventProcessor;
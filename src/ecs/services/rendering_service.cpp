@@ -3,10 +3,10 @@
 #include "../core/service_locator.h"
 #include "../gpu/gpu_entity_manager.h"
 #include "../../vulkan_renderer.h"
+#include "../utilities/radix_sort.h"
 #include <iostream>
 #include <algorithm>
 #include <chrono>
-#include <execution>
 #include <thread>
 #include <stdexcept>
 
@@ -40,10 +40,8 @@ bool RenderingService::initialize(flecs::world& world, VulkanRenderer* renderer)
     renderQueue.reserve(maxRenderableEntities);
     renderBatches.reserve(100); // Reasonable default for batches
     
-    // Cache service dependencies
-    if (ServiceLocator::instance().hasService<CameraService>()) {
-        cameraService = &ServiceLocator::instance().requireService<CameraService>();
-    }
+    // Cache service dependencies (empty handle if the camera service is not registered)
+    cameraService = ServiceLocator::instance().resolveService<CameraService>();
     
     // Setup ECS integration
     try {
@@ -155,8 +153,10 @@ void RenderingService::beginFrame() {
     
     frameInProgress_ = true;
     
-    // Clear previous frame data
-    clearRenderQueue();
+    // Clear previous frame data; the per-entity queue persists and is updated incrementally
+    if (!perEntityQueueEnabled) {
+        clearRenderQueue();
+    }
     
     // Reset frame-specific state
     cullingStats.reset();
@@ -228,35 +228,39 @@ void RenderingService::buildRenderQueue() {
         return;
     }
     
-    clearRenderQueue();
-    collectRenderableEntities();
+    if (perEntityQueueEnabled) {
+        applyQueueChanges();
+    } else {
+        clearRenderQueue();
+        collectRenderableEntities();
+        for (auto& entry : renderQueue) {
+            entry.generateSortKey();
+        }
+    }
     
     cullingStats.totalEntities = renderQueue.size();
 }
 
 void RenderingService::sortRenderQueue() {
-    if (!initialized || renderQueue.empty()) {
+    if (!initialized) {
         return;
     }
     
-    // Generate sort keys for all entries
-    for (auto& entry : renderQueue) {
-        entry.generateSortKey();
+    // Keys are generated when entries change; an unchanged queue keeps last frame's order
+    if (!queueOrderDirty && sortedQueueOrder.size() == renderQueue.size()) {
+        return;
     }
     
-    if (multithreadingEnabled && renderQueue.size() > 1000) {
-        // Use parallel sort for large queues
-        std::sort(std::execution::par_unseq, renderQueue.begin(), renderQueue.end(),
-                 [](const RenderQueueEntry& a, const RenderQueueEntry& b) {
-                     return a.sortKey < b.sortKey;
-                 });
-    } else {
-        // Use sequential sort for smaller queues
-        std::sort(renderQueue.begin(), renderQueue.end(),
-                 [](const RenderQueueEntry& a, const RenderQueueEntry& b) {
-                     return a.sortKey < b.sortKey;
-                 });
+    sortKeys.resize(renderQueue.size());
+    for (size_t i = 0; i < renderQueue.size(); ++i) {
+        sortKeys[i] = renderQueue[i].sortKey;
     }
+    
+    // Sorts 4-byte keys into an index permutation instead of moving whole entries
+    RadixSort::sortIndices(sortKeys, sortedQueueOrder, sortScratch);
+    
+    queueOrderDirty = false;
+    renderBatchesDirty = true;
 }
 
 void RenderingService::submitRenderQueue() {
@@ -287,6 +291,101 @@ void RenderingService::clearRenderQueue() {
     renderQueue.clear();
     renderBatches.clear();
     entityToQueueIndex.clear();
+    sortedQueueOrder.clear();
+    queueOrderDirty = true;
+    renderBatchesDirty = true;
+}
+
+void RenderingService::setPerEntityQueueEnabled(bool enabled) {
+    if (perEntityQueueEnabled == enabled) {
+        return;
+    }
+    
+    perEntityQueueEnabled = enabled;
+    clearRenderQueue();
+    dirtyQueueEntities.clear();
+    removedQueueEntities.clear();
+    
+    // Seed the persistent queue once; observers keep it current from here on
+    if (enabled && world) {
+        world->query<const Transform, const Renderable>().each([this](flecs::entity entity, const Transform&, const Renderable&) {
+            dirtyQueueEntities.push_back(entity);
+        });
+    }
+}
+
+void RenderingService::applyQueueChanges() {
+    // Quantized distances go stale as the camera moves; rekey in place without touching the ECS
+    if (cameraService) {
+        constexpr float REKEY_DISTANCE = 1.0f;
+        glm::vec3 cameraPosition = cameraService->getCameraPosition();
+        if (glm::length(cameraPosition - sortCameraPosition) > REKEY_DISTANCE) {
+            sortCameraPosition = cameraPosition;
+            for (auto& entry : renderQueue) {
+                entry.distanceToCamera = glm::length(entry.transform.position - sortCameraPosition);
+                entry.generateSortKey();
+            }
+            queueOrderDirty = true;
+        }
+    }
+    
+    for (auto entity : removedQueueEntities) {
+        removeQueueEntry(entity);
+    }
+    removedQueueEntities.clear();
+    
+    for (auto entity : dirtyQueueEntities) {
+        refreshQueueEntry(entity);
+    }
+    dirtyQueueEntities.clear();
+}
+
+void RenderingService::refreshQueueEntry(flecs::entity entity) {
+    const Transform* transform = entity.is_alive() ? entity.get<Transform>() : nullptr;
+    const Renderable* renderable = entity.is_alive() ? entity.get<Renderable>() : nullptr;
+    if (!transform || !renderable || !renderable->visible) {
+        removeQueueEntry(entity);
+        return;
+    }
+    
+    auto it = entityToQueueIndex.find(entity);
+    if (it == entityToQueueIndex.end()) {
+        if (renderQueue.size() >= maxRenderableEntities) {
+            return;
+        }
+        entityToQueueIndex[entity] = static_cast<uint32_t>(renderQueue.size());
+        renderQueue.push_back(createQueueEntry(entity, *transform, *renderable));
+        it = entityToQueueIndex.find(entity);
+    } else {
+        RenderQueueEntry& entry = renderQueue[it->second];
+        entry.transform = *transform;
+        entry.renderable = *renderable;
+        entry.priority = static_cast<RenderPriority>(renderable->layer);
+    }
+    
+    RenderQueueEntry& entry = renderQueue[it->second];
+    entry.renderableVersion = renderable->version;
+    entry.distanceToCamera = glm::length(transform->position - sortCameraPosition);
+    entry.generateSortKey();
+    queueOrderDirty = true;
+}
+
+void RenderingService::removeQueueEntry(flecs::entity entity) {
+    auto it = entityToQueueIndex.find(entity);
+    if (it == entityToQueueIndex.end()) {
+        return;
+    }
+    
+    // Swap-remove keeps the queue dense; the sort permutation is rebuilt afterwards anyway
+    uint32_t index = it->second;
+    uint32_t lastIndex = static_cast<uint32_t>(renderQueue.size() - 1);
+    if (index != lastIndex) {
+        renderQueue[index] = renderQueue[lastIndex];
+        entityToQueueIndex[renderQueue[index].entity] = index;
+    }
+    renderQueue.pop_back();
+    entityToQueueIndex.erase(it);
+    queueOrderDirty = true;
 }
 
 
@@ -296,12 +395,20 @@ void RenderingService::createRenderBatches() {
         return;
     }
     
+    // Batches only change when the sorted order does
+    if (!renderBatchesDirty) {
+        cullingStats.renderQueueSize = renderBatches.size();
+        return;
+    }
+    renderBatchesDirty = false;
+    
     renderBatches.clear();
     
     RenderBatch currentBatch;
     currentBatch.priority = RenderPriority::NORMAL;
     
-    for (const auto& entry : renderQueue) {
+    for (uint32_t index : sortedQueueOrder) {
+        const auto& entry = renderQueue[index];
         if (!entry.visible) {
             continue;
         }
@@ -521,22 +628,7 @@ void RenderingService::collectRenderableEntities() {
         // Note: entityCount stored implicitly via GPU entity manager, not in queue entry
     }
     
-    // NOTE: If you need per-entity ECS rendering for debugging, re-enable this:
-    /*
-    world->query<Transform, Renderable>().each([this, cameraPosition](flecs::entity entity, 
-                                                              const Transform& transform, 
-                                                              const Renderable& renderable) {
-        if (!renderable.visible) {
-            return; // Skip invisible entities
-        }
-        
-        RenderQueueEntry entry = createQueueEntry(entity, transform, renderable);
-        entry.distanceToCamera = glm::length(transform.position - cameraPosition);
-        
-        renderQueue.push_back(entry);
-        entityToQueueIndex[entity] = renderQueue.size() - 1;
-    });
-    */
+    // Per-entity ECS rendering (debugging) lives in the incremental queue: setPerEntityQueueEnabled(true)
 }
 
 bool RenderingService::isEntityVisible(const RenderQueueEntry& entry) const {
@@ -590,10 +682,35 @@ void RenderingService::registerRenderingSystems() {
     // GPU-DRIVEN PIPELINE: CPU-side ECS systems removed for performance
     // All entity processing handled by GPU compute shaders
     // This eliminates 320k function calls per frame
+    
+    // Change tracking for the optional per-entity queue; observers only record, so they cost
+    // nothing per frame and nothing at all while the queue is disabled
+    queueObservers.push_back(world->observer<const Transform, const Renderable>("RenderQueueChangeObserver")
+        .event(flecs::OnSet)
+        .each([this](flecs::entity entity, const Transform&, const Renderable&) {
+            if (perEntityQueueEnabled) {
+                dirtyQueueEntities.push_back(entity);
+            }
+        }));
+    
+    queueObservers.push_back(world->observer<const Renderable>("RenderQueueRemoveObserver")
+        .event(flecs::OnRemove)
+        .each([this](flecs::entity entity, const Renderable&) {
+            if (perEntityQueueEnabled) {
+                removedQueueEntities.push_back(entity);
+            }
+        }));
 }
 
 void RenderingService::cleanupSystems() {
-    // GPU-DRIVEN PIPELINE: No CPU-side ECS systems to clean up
+    for (auto& observer : queueObservers) {
+        if (observer.is_alive()) {
+            observer.destruct();
+        }
+    }
+    queueObservers.clear();
+    dirtyQueueEntities.clear();
+    removedQueueEntities.clear();
 }
 
 // beginFrame() and endFrame() already implemented above
@@ -2,6 +2,7 @@
 
 #include "../core/service_locator.h"
 #include "../components/component.h"
+#include "../../vulkan/monitoring/memory_accounting.h"
 #include <flecs.h>
 #include <glm/glm.hpp>
 #include <vulkan/vulkan.h>
@@ -48,6 +49,7 @@ struct RenderQueueEntry {
     float distanceToCamera;
     uint32_t sortKey; // For efficient sorting
     bool visible;
+    uint32_t renderableVersion = 0; // Renderable::version when this entry was last refreshed
     
     // Generate sort key for efficient sorting
     void generateSortKey() {
@@ -174,6 +176,14 @@ public:
     void setPreRenderCallback(PreRenderCallback callback) { preRenderCallback = callback; }
     void setPostRenderCallback(PostRenderCallback callback) { postRenderCallback = callback; }
     
+    // Per-entity queue, kept incrementally from Transform/Renderable observers. Off by default:
+    // GPU entities are drawn as one batch entry and never need per-entity sorting
+    void setPerEntityQueueEnabled(bool enabled);
+    bool isPerEntityQueueEnabled() const { return perEntityQueueEnabled; }
+    
+    // renderQueue indices in ascending sortKey order, valid after sortRenderQueue()
+    const std::vector<uint32_t>& getSortedQueueOrder() const { return sortedQueueOrder; }
+    
     // Multi-threaded rendering support
     void setMultithreadingEnabled(bool enabled) { multithreadingEnabled = enabled; }
     bool isMultithreadingEnabled() const { return multithreadingEnabled; }
@@ -191,7 +201,7 @@ public:
     void renderAllViewports();
     
     // Service access (for convenience namespaces)
-    CameraService* getCameraService() const { return cameraService; }
+    CameraService* getCameraService() const { return cameraService.get(); }
     
     // Frame coordination
     bool shouldRender() const;
@@ -216,12 +226,30 @@ private:
     bool initialized = false;
     
     // Service dependencies (cached references)
-    CameraService* cameraService = nullptr;
+    ServiceRef<CameraService> cameraService;
     
     // Render queue
     std::vector<RenderQueueEntry> renderQueue;
-    std::vector<RenderBatch> renderBatches;
-    std::unordered_map<flecs::entity, uint32_t> entityToQueueIndex;
+    // Batches, queue index and change lists count against CpuMemorySubsystem::RenderQueue
+    template<typename T>
+    using CountedAllocator = CountingAllocator<T, CpuMemorySubsystem::RenderQueue>;
+    std::vector<RenderBatch, CountedAllocator<RenderBatch>> renderBatches;
+    std::unordered_map<flecs::entity, uint32_t, std::hash<flecs::entity>, std::equal_to<flecs::entity>,
+                       CountedAllocator<std::pair<const flecs::entity, uint32_t>>> entityToQueueIndex;
+    
+    // Incremental queue state: observers record changes, buildRenderQueue() applies only those
+    bool perEntityQueueEnabled = false;
+    std::vector<flecs::entity, CountedAllocator<flecs::entity>> dirtyQueueEntities;
+    std::vector<flecs::entity, CountedAllocator<flecs::entity>> removedQueueEntities;
+    std::vector<flecs::entity> queueObservers;
+    glm::vec3 sortCameraPosition{0.0f};
+    
+    // Radix sort output; entries never move, only this permutation does
+    std::vector<uint32_t> sortedQueueOrder;
+    std::vector<uint32_t> sortKeys;
+    std::vector<uint32_t> sortScratch;
+    bool queueOrderDirty = true;
+    bool renderBatchesDirty = true;
     
     bool batchingEnabled = true;
     float maxRenderDistance = 1000.0f;
@@ -261,6 +289,9 @@ private:
     
     // Render queue helpers
     RenderQueueEntry createQueueEntry(flecs::entity entity, const Transform& transform, const Renderable& renderable);
+    void applyQueueChanges();
+    void refreshQueueEntry(flecs::entity entity);
+    void removeQueueEntry(flecs::entity entity);
     void sortQueueByPriority();
     void sortQueueByDistance();
     void sortQueueByState();
@@ -1,14 +1,84 @@
-#include "../components/component.h"
-#include <flecs.h>
+#include "lifetime_system.h"
+#include <algorithm>
 
-void lifetime_system(flecs::entity e, Lifetime& lifetime) {
-    const float deltaTime = e.world().delta_time();
+namespace {
+    // One expiry list per flecs stage so worker threads never share a vector
+    std::vector<std::vector<flecs::entity_t>> expiredPerStage;
+    std::vector<flecs::entity> expiredBatch;
+    LifetimeSystem::ExpiryCallback expiryCallback;
+    size_t lastExpiredCount = 0;
+    
+    void resizeStageLists(const flecs::world& world) {
+        size_t stageCount = static_cast<size_t>(std::max(world.get_stage_count(), 1));
+        if (expiredPerStage.size() != stageCount) {
+            expiredPerStage.resize(stageCount);
+        }
+    }
+    
+    void flushExpired(flecs::world world) {
+        expiredBatch.clear();
+        for (auto& stageList : expiredPerStage) {
+            for (flecs::entity_t id : stageList) {
+                flecs::entity entity(world, id);
+                if (entity.is_alive()) {
+                    expiredBatch.push_back(entity);
+                }
+            }
+            stageList.clear();
+        }
+        lastExpiredCount = expiredBatch.size();
+        
+        // Thread count can change between frames; lists are only resized here, outside the worker phase
+        resizeStageLists(world);
+        
+        if (expiredBatch.empty()) return;
+        
+        // GPU slot release sees the whole batch while the entities are still alive
+        if (expiryCallback) {
+            expiryCallback(expiredBatch);
+        }
+        
+        // Deletes are deferred and applied together at the merge that ends this system
+        for (auto& entity : expiredBatch) {
+            entity.destruct();
+        }
+    }
+}
+
+void lifetime_system(flecs::iter& it, size_t row, Lifetime& lifetime) {
+    const float deltaTime = it.delta_time();
     
     if (lifetime.maxAge > 0.0f) {
         lifetime.currentAge += deltaTime;
         
         if (lifetime.autoDestroy && lifetime.currentAge >= lifetime.maxAge) {
-            e.destruct();
+            size_t stageId = static_cast<size_t>(it.world().get_stage_id());
+            if (stageId < expiredPerStage.size()) {
+                expiredPerStage[stageId].push_back(it.entity(row).id());
+            }
         }
     }
+}
+
+namespace LifetimeSystem {
+    void registerSystems(flecs::world& world, ExpiryCallback onExpired) {
+        expiryCallback = std::move(onExpired);
+        resizeStageLists(world);
+        
+        // Each worker ages its own slice of the Lifetime tables
+        world.system<Lifetime>("LifetimeSystem")
+            .multi_threaded()
+            .each(lifetime_system);
+        
+        // Single-threaded sync point after all OnUpdate work
+        world.system("LifetimeExpirySystem")
+            .kind(flecs::PostUpdate)
+            .run([](flecs::iter& it) {
+                flushExpired(it.world());
+            });
+    }
+    
+    size_t getLastExpiredCount() {
+        return lastExpiredCount;
+    }
 }
\ No newline at end of file
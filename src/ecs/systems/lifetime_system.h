@@ -2,5 +2,18 @@
 
 #include "../components/component.h"
 #include <flecs.h>
+#include <functional>
+#include <vector>
 
-void lifetime_system(flecs::entity e, Lifetime& lifetime);
\ No newline at end of file
+// Ages one entity; expired entities are queued on the calling thread's list instead of destroyed in place
+void lifetime_system(flecs::iter& it, size_t row, Lifetime& lifetime);
+
+namespace LifetimeSystem {
+    // Called once per frame with every entity expiring this frame, before they are deleted
+    using ExpiryCallback = std::function<void(const std::vector<flecs::entity>&)>;
+    
+    // Registers the multithreaded aging system and the PostUpdate sync point that deletes expired entities in one batch
+    void registerSystems(flecs::world& world, ExpiryCallback onExpired = nullptr);
+    
+    size_t getLastExpiredCount();
+}
\ No newline at end of file
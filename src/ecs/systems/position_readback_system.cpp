@@ -0,0 +1,54 @@
+#include "position_readback_system.h"
+#include "../gpu/gpu_entity_manager.h"
+
+namespace PositionReadbackSystem {
+    // Snapshot already written to the ECS
+    static uint64_t appliedSequence_ = 0;
+    
+    size_t applySnapshot(GPUEntityManager& gpuManager) {
+        const PositionReadbackRing& readback = gpuManager.getPositionReadback();
+        if (readback.getSnapshotSequence() == appliedSequence_) {
+            return 0;
+        }
+        appliedSequence_ = readback.getSnapshotSequence();
+        
+        size_t applied = 0;
+        const bool hasVelocity = readback.snapshotHasVelocity();
+        for (const auto& sample : readback.getSamples()) {
+            // Entities destroyed while their copy was in flight are skipped
+            if (!sample.entity.is_alive()) continue;
+            
+            if (Transform* transform = sample.entity.get_mut<Transform>()) {
+                transform->setPosition(glm::vec3(sample.position));
+                sample.entity.modified<Transform>();  // OnSet observers (render queue) see the move
+                applied++;
+            }
+            if (hasVelocity) {
+                if (Velocity* velocity = sample.entity.get_mut<Velocity>()) {
+                    velocity->linear = glm::vec3(sample.velocity.x, sample.velocity.y, 0.0f);
+                }
+            }
+        }
+        return applied;
+    }
+    
+    void registerSystems(flecs::world& world, GPUEntityManager* gpuManager) {
+        if (!gpuManager) return;
+        
+        // Adding or removing the tag (including destruction) changes which rows get copied
+        world.observer("CPUObservedObserver")
+            .with<CPUObserved>()
+            .event(flecs::OnAdd)
+            .event(flecs::OnRemove)
+            .each([gpuManager](flecs::entity) {
+                gpuManager->getPositionReadback().markObservedDirty();
+            });
+        
+        // Runs before gameplay systems so they read this frame's snapshot
+        world.system("PositionReadbackSystem")
+            .kind(flecs::PreUpdate)
+            .run([gpuManager](flecs::iter&) {
+                applySnapshot(*gpuManager);
+            });
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "systems_common.h"
+
+class GPUEntityManager;
+
+/**
+ * @brief Applies streamed GPU positions to Transform for CPUObserved entities
+ * 
+ * Tag an entity with CPUObserved to have its POSITION_OUTPUT row copied back each
+ * readback interval. Observers keep the GPU-side observed set in sync with the tag,
+ * and a PreUpdate system applies each new snapshot in one pass, so gameplay systems
+ * see positions that lag the GPU by MAX_FRAMES_IN_FLIGHT frames.
+ */
+namespace PositionReadbackSystem {
+    /**
+     * @brief Register the CPUObserved observers and the apply system
+     * @param world The Flecs world instance
+     * @param gpuManager Owner of the readback ring; nothing is registered when null
+     */
+    void registerSystems(flecs::world& world, GPUEntityManager* gpuManager);
+    
+    /**
+     * @brief Copy the latest snapshot into Transform (and Velocity when streamed)
+     * @return Number of entities updated, 0 when no new snapshot landed
+     */
+    size_t applySnapshot(GPUEntityManager& gpuManager);
+}
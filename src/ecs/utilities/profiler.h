@@ -12,6 +12,7 @@
 #include <iomanip>
 #include <algorithm>
 #include <limits>
+#include "../../vulkan/monitoring/memory_accounting.h"
 
 // High-resolution timer for performance profiling
 class ProfileTimer {
@@ -100,6 +101,15 @@ private:
             }
             return sum / recentTimes.size();
         }
+        
+        // fraction in [0, 1], nearest rank over the recent samples
+        float getRecentPercentile(float fraction) const {
+            if (recentTimes.empty()) return 0.0f;
+            std::vector<float> sorted = recentTimes;
+            size_t index = std::min(static_cast<size_t>(fraction * sorted.size()), sorted.size() - 1);
+            std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+            return sorted[index];
+        }
     };
     
     std::unordered_map<std::string, std::unique_ptr<ProfileData>> profiles;
@@ -146,6 +156,19 @@ public:
         }
     }
     
+    // Values that are not scope timings (e.g. pacing error, which can be negative)
+    void recordSample(const std::string& name, float value) {
+        if (!enabled) return;
+        
+        std::lock_guard<std::mutex> lock(profileMutex);
+        auto& data = profiles[name];
+        if (!data) {
+            data = std::make_unique<ProfileData>();
+            data->name = name;
+        }
+        data->addSample(value);
+    }
+    
     // Scope-based profiling
     ProfileScope createScope(const std::string& name) {
         return ProfileScope(this, name);
@@ -188,6 +211,9 @@ public:
         float maxTime;
         size_t callCount;
         float percentOfFrame;
+        float p50Time;
+        float p95Time;
+        float p99Time;
     };
     
     std::vector<ProfileReport> generateReport() const {
@@ -211,6 +237,9 @@ public:
                 entry.maxTime = data->maxTime;
                 entry.callCount = data->callCount;
                 entry.percentOfFrame = (entry.recentAverageTime / frameTime) * 100.0f;
+                entry.p50Time = data->getRecentPercentile(0.50f);
+                entry.p95Time = data->getRecentPercentile(0.95f);
+                entry.p99Time = data->getRecentPercentile(0.99f);
                 
                 report.push_back(entry);
             }
@@ -231,9 +260,10 @@ public:
         std::cout << "\n=== Performance Report ===" << std::endl;
         std::cout << "Profile Name" << std::setw(20) << "Avg(ms)" << std::setw(12) 
                   << "Recent(ms)" << std::setw(12) << "Min(ms)" << std::setw(12) 
-                  << "Max(ms)" << std::setw(12) << "Calls" << std::setw(12) 
+                  << "Max(ms)" << std::setw(12) << "P95(ms)" << std::setw(12)
+                  << "P99(ms)" << std::setw(12) << "Calls" << std::setw(12) 
                   << "% Frame" << std::endl;
-        std::cout << std::string(80, '-') << std::endl;
+        std::cout << std::string(104, '-') << std::endl;
         
         for (const auto& entry : report) {
             std::cout << std::left << std::setw(20) << entry.name
@@ -242,6 +272,8 @@ public:
                       << std::setw(12) << entry.recentAverageTime
                       << std::setw(12) << entry.minTime
                       << std::setw(12) << entry.maxTime
+                      << std::setw(12) << entry.p95Time
+                      << std::setw(12) << entry.p99Time
                       << std::setw(12) << entry.callCount
                       << std::setw(11) << entry.percentOfFrame << "%"
                       << std::endl;
@@ -251,6 +283,9 @@ public:
         std::cout << "  Current: " << (currentMemoryUsage / 1024 / 1024) << " MB" << std::endl;
         std::cout << "  Peak: " << (peakMemoryUsage / 1024 / 1024) << " MB" << std::endl;
         std::cout << "  Frames: " << frameCount << std::endl;
+        
+        std::cout << "\nMemory Accounting:" << std::endl;
+        MemoryAccounting::getInstance().printReport(std::cout);
         std::cout << "=========================" << std::endl;
     }
     
@@ -260,7 +295,7 @@ public:
         
         auto report = generateReport();
         
-        file << "Name,AverageTime,RecentAverageTime,MinTime,MaxTime,CallCount,PercentOfFrame" << std::endl;
+        file << "Name,AverageTime,RecentAverageTime,MinTime,MaxTime,P50Time,P95Time,P99Time,CallCount,PercentOfFrame" << std::endl;
         
         for (const auto& entry : report) {
             file << entry.name << ","
@@ -268,6 +303,9 @@ public:
                  << entry.recentAverageTime << ","
                  << entry.minTime << ","
                  << entry.maxTime << ","
+                 << entry.p50Time << ","
+                 << entry.p95Time << ","
+                 << entry.p99Time << ","
                  << entry.callCount << ","
                  << entry.percentOfFrame << std::endl;
         }
@@ -295,6 +333,12 @@ public:
         return targetFrameTime; // Return target frame time as fallback
     }
     
+    float getRecentPercentile(const std::string& name, float fraction) const {
+        std::lock_guard<std::mutex> lock(profileMutex);
+        auto it = profiles.find(name);
+        return it != profiles.end() ? it->second->getRecentPercentile(fraction) : 0.0f;
+    }
+    
     size_t getFrameCount() const { return frameCount; }
     size_t getCurrentMemoryUsage() const { return currentMemoryUsage; }
     size_t getPeakMemoryUsage() const { return peakMemoryUsage; }
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+// LSD radix sort over 32-bit keys that produces an index permutation, so callers can
+// order large records without moving them
+namespace RadixSort {
+    // Fills order with key indices in ascending key order (stable). scratch is reused across calls
+    inline void sortIndices(const std::vector<uint32_t>& keys, std::vector<uint32_t>& order, std::vector<uint32_t>& scratch) {
+        const size_t count = keys.size();
+        order.resize(count);
+        std::iota(order.begin(), order.end(), 0u);
+        if (count < 2) {
+            return;
+        }
+        scratch.resize(count);
+
+        // Histograms for all four byte passes in a single read of the keys
+        std::array<std::array<uint32_t, 256>, 4> histograms{};
+        for (uint32_t key : keys) {
+            for (uint32_t pass = 0; pass < 4; ++pass) {
+                histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+            }
+        }
+
+        for (uint32_t pass = 0; pass < 4; ++pass) {
+            auto& histogram = histograms[pass];
+            const uint32_t shift = pass * 8;
+
+            // Every key has the same byte here, so the pass would not change the order
+            if (histogram[(keys[0] >> shift) & 0xFF] == count) {
+                continue;
+            }
+
+            uint32_t offset = 0;
+            for (auto& bucket : histogram) {
+                uint32_t bucketCount = bucket;
+                bucket = offset;
+                offset += bucketCount;
+            }
+
+            for (uint32_t index : order) {
+                scratch[histogram[(keys[index] >> shift) & 0xFF]++] = index;
+            }
+            order.swap(scratch);
+        }
+    }
+}
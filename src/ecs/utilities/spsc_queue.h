@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Bounded single-producer single-consumer queue. Slots are reused in place and both ends are plain
+// atomics, so neither side takes a lock; push() and pop() block with atomic waits when the queue is
+// full or empty. close() wakes a blocked consumer, which then drains what is left and stops
+template<typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0, "SpscQueue needs at least one slot");
+
+public:
+    // Producer. Blocks while full; false once the queue is closed
+    bool push(T&& value) {
+        for (;;) {
+            const uint64_t tailValue = tail.load(std::memory_order_relaxed);
+            if (tailValue & CLOSED_BIT) {
+                return false;
+            }
+            const uint64_t headValue = head.load(std::memory_order_acquire);
+            if (tailValue - headValue < Capacity) {
+                slots[tailValue % Capacity] = std::move(value);
+                tail.store(tailValue + 1, std::memory_order_release);
+                tail.notify_one();
+                return true;
+            }
+            head.wait(headValue, std::memory_order_acquire);
+        }
+    }
+
+    // Consumer. Blocks while empty; false once the queue is closed and drained
+    bool pop(T& value) {
+        for (;;) {
+            const uint64_t headValue = head.load(std::memory_order_relaxed);
+            const uint64_t tailValue = tail.load(std::memory_order_acquire);
+            if ((tailValue & ~CLOSED_BIT) != headValue) {
+                value = std::move(slots[headValue % Capacity]);
+                head.store(headValue + 1, std::memory_order_release);
+                head.notify_one();
+                return true;
+            }
+            if (tailValue & CLOSED_BIT) {
+                return false;
+            }
+            tail.wait(tailValue, std::memory_order_acquire);
+        }
+    }
+
+    // Producer side only
+    void close() {
+        tail.fetch_or(CLOSED_BIT, std::memory_order_release);
+        tail.notify_all();
+    }
+
+    bool empty() const {
+        return (tail.load(std::memory_order_acquire) & ~CLOSED_BIT) == head.load(std::memory_order_acquire);
+    }
+
+private:
+    // Set in tail so a consumer waiting on tail wakes up when the queue closes
+    static constexpr uint64_t CLOSED_BIT = 1ull << 63;
+
+    std::array<T, Capacity> slots{};
+    alignas(64) std::atomic<uint64_t> head{0};    // Next slot to pop, written by the consumer
+    alignas(64) std::atomic<uint64_t> tail{0};    // Next slot to push, written by the producer
+};
@@ -1,9 +1,226 @@
 #include "graphicstests.h"
 #include "vulkan_renderer.h"
 #include "ecs/gpu/gpu_entity_manager.h"
+#include "ecs/core/entity_factory.h"
+#include "vulkan/core/vulkan_context.h"
+#include "vulkan/core/vulkan_function_loader.h"
+#include "vulkan/core/vulkan_raii.h"
+#include "vulkan/pipelines/gpu_primitives.h"
+#include "vulkan/resources/core/resource_coordinator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
 
 namespace GraphicsTests {
+
+namespace {
+    // Host-visible storage buffer for the primitive checks, written and read back through its mapping
+    ResourceHandle createTestBuffer(ResourceCoordinator* coordinator, const std::vector<uint32_t>& contents) {
+        ResourceHandle handle = coordinator->createMappedBuffer(contents.size() * sizeof(uint32_t),
+                                                                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                                VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+        if (handle.mappedData) {
+            std::memcpy(handle.mappedData, contents.data(), contents.size() * sizeof(uint32_t));
+        }
+        return handle;
+    }
+    
+    std::vector<uint32_t> readTestBuffer(const ResourceHandle& handle, size_t count) {
+        std::vector<uint32_t> contents(count);
+        std::memcpy(contents.data(), handle.mappedData, count * sizeof(uint32_t));
+        return contents;
+    }
+    
+    GpuBufferRange wholeRange(const ResourceHandle& handle) {
+        return {handle.buffer.get(), 0, VK_WHOLE_SIZE};
+    }
+    
+    // The primitives leave their final barrier to the caller; this one covers the mapped readback
+    void recordHostReadBarrier(const VulkanFunctionLoader& vk, VkCommandBuffer commandBuffer) {
+        VkMemoryBarrier2 barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+        
+        VkDependencyInfo dependency{};
+        dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency.memoryBarrierCount = 1;
+        dependency.pMemoryBarriers = &barrier;
+        vk.vkCmdPipelineBarrier2(commandBuffer, &dependency);
+    }
+    
+    void reportCheck(const char* name, bool passed, bool& allPassed) {
+        std::cout << (passed ? "✅ " : "❌ ") << name << std::endl;
+        allPassed = allPassed && passed;
+    }
+    
+    // Median GPU time of a few submissions. restoreInputs runs first in each one, outside the timed span
+    bool timePrimitive(VulkanRenderer* renderer, const VulkanFunctionLoader& vk, VkDevice device,
+                       VkQueryPool queryPool, float timestampPeriodNs,
+                       const std::function<void(VkCommandBuffer)>& restoreInputs,
+                       const std::function<bool(VkCommandBuffer)>& record, double& medianMs) {
+        constexpr uint32_t SAMPLES = 5;
+        std::vector<double> samples;
+        for (uint32_t i = 0; i < SAMPLES; ++i) {
+            bool recorded = false;
+            bool submitted = renderer->submitImmediateCompute([&](VkCommandBuffer commandBuffer) {
+                vk.vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2);
+                restoreInputs(commandBuffer);
+                // ALL_COMMANDS waits for the restore copies, so only the primitive lands between the pair
+                vk.vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, queryPool, 0);
+                recorded = record(commandBuffer);
+                vk.vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, queryPool, 1);
+            });
+            
+            uint64_t timestamps[2] = {};
+            if (!submitted || !recorded ||
+                vk.vkGetQueryPoolResults(device, queryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(uint64_t),
+                                         VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) != VK_SUCCESS ||
+                timestamps[1] < timestamps[0]) {
+                return false;
+            }
+            samples.push_back(static_cast<double>(timestamps[1] - timestamps[0]) * timestampPeriodNs / 1000000.0);
+        }
+        
+        std::nth_element(samples.begin(), samples.begin() + SAMPLES / 2, samples.end());
+        medianMs = samples[SAMPLES / 2];
+        return true;
+    }
+    
+    void reportThroughput(const char* name, uint32_t count, bool timed, double medianMs, bool& allPassed) {
+        if (!timed) {
+            std::cout << "❌ " << name << " x" << count << ": timing failed" << std::endl;
+            allPassed = false;
+            return;
+        }
+        const double elementsPerSecond = medianMs > 0.0 ? count / (medianMs / 1000.0) : 0.0;
+        std::cout << "   " << name << " x" << count << ": " << medianMs << " ms, "
+                  << elementsPerSecond / 1000000.0 << " M elements/s" << std::endl;
+    }
+    
+    // Scan, compaction and sort throughput on device-local buffers at 64K, 1M and the entity capacity
+    bool runGpuPrimitiveThroughput(VulkanRenderer* renderer) {
+        ResourceCoordinator* coordinator = renderer->getResourceCoordinator();
+        const VulkanContext* context = coordinator->getContext();
+        const auto& vk = context->getLoader();
+        const VkDevice device = context->getDevice();
+        
+        VkPhysicalDeviceProperties props;
+        vk.vkGetPhysicalDeviceProperties(context->getPhysicalDevice(), &props);
+        if (props.limits.timestampComputeAndGraphics == VK_FALSE || props.limits.timestampPeriod <= 0.0f) {
+            std::cout << "GPU primitive throughput skipped: no compute queue timestamps" << std::endl;
+            return true;
+        }
+        
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = 2;
+        VkQueryPool queryPoolHandle = VK_NULL_HANDLE;
+        if (vk.vkCreateQueryPool(device, &queryPoolInfo, nullptr, &queryPoolHandle) != VK_SUCCESS) {
+            std::cerr << "ERROR: Cannot time GPU primitives - failed to create timestamp query pool!" << std::endl;
+            return false;
+        }
+        vulkan_raii::QueryPool queryPool = vulkan_raii::make_query_pool(queryPoolHandle, context);
+        
+        auto* gpuEntityManager = renderer->getGPUEntityManager();
+        std::vector<uint32_t> sizes = {1u << 16, 1u << 20};
+        if (gpuEntityManager) {
+            sizes.push_back(gpuEntityManager->getMaxEntities());
+        }
+        std::sort(sizes.begin(), sizes.end());
+        sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+        const uint32_t maxCount = sizes.back();
+        
+        GpuPrimitives primitives;
+        if (!primitives.initialize(*context, renderer->getPipelineSystem()->getComputeManager(), coordinator, maxCount)) {
+            std::cerr << "ERROR: Cannot time GPU primitives - failed to initialize primitives!" << std::endl;
+            return false;
+        }
+        
+        // Random keys and 0/1 flags live in host-visible sources; each sample copies them into device-local
+        // columns first, so every sort starts unsorted and the primitives never touch host memory
+        std::mt19937 rng(67890);
+        std::vector<uint32_t> keys(maxCount);
+        std::vector<uint32_t> flags(maxCount);
+        for (uint32_t i = 0; i < maxCount; ++i) {
+            keys[i] = static_cast<uint32_t>(rng());
+            flags[i] = keys[i] & 1u;
+        }
+        
+        const VkDeviceSize columnSize = static_cast<VkDeviceSize>(maxCount) * sizeof(uint32_t);
+        const VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                                         VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        ResourceHandle keySource = coordinator->createMappedBuffer(columnSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+        ResourceHandle flagSource = coordinator->createMappedBuffer(columnSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+        ResourceHandle keyBuffer = coordinator->createBuffer(columnSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        ResourceHandle valueBuffer = coordinator->createBuffer(columnSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        ResourceHandle flagBuffer = coordinator->createBuffer(columnSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        ResourceHandle outputBuffer = coordinator->createBuffer(columnSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        ResourceHandle countBuffer = coordinator->createBuffer(sizeof(uint32_t), usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        
+        bool allPassed = keySource.mappedData && flagSource.mappedData && keyBuffer.isValid() && valueBuffer.isValid() &&
+                         flagBuffer.isValid() && outputBuffer.isValid() && countBuffer.isValid();
+        if (!allPassed) {
+            std::cerr << "ERROR: Cannot time GPU primitives - failed to create buffers!" << std::endl;
+        } else {
+            std::memcpy(keySource.mappedData, keys.data(), columnSize);
+            std::memcpy(flagSource.mappedData, flags.data(), columnSize);
+            std::cout << "GPU primitive throughput (median of 5, GPU timestamps):" << std::endl;
+        }
+        
+        for (uint32_t count : sizes) {
+            if (!allPassed) {
+                break;
+            }
+            
+            const VkBufferCopy copy{0, 0, static_cast<VkDeviceSize>(count) * sizeof(uint32_t)};
+            auto restoreKeys = [&](VkCommandBuffer commandBuffer) {
+                vk.vkCmdCopyBuffer(commandBuffer, keySource.buffer.get(), keyBuffer.buffer.get(), 1, &copy);
+            };
+            auto restoreFlags = [&](VkCommandBuffer commandBuffer) {
+                vk.vkCmdCopyBuffer(commandBuffer, flagSource.buffer.get(), flagBuffer.buffer.get(), 1, &copy);
+            };
+            
+            double medianMs = 0.0;
+            bool timed = timePrimitive(renderer, vk, device, queryPool.get(), props.limits.timestampPeriod, restoreFlags,
+                [&](VkCommandBuffer commandBuffer) {
+                    return primitives.recordExclusiveScan(commandBuffer, wholeRange(flagBuffer), wholeRange(outputBuffer), count);
+                }, medianMs);
+            reportThroughput("Exclusive scan", count, timed, medianMs, allPassed);
+            
+            timed = timePrimitive(renderer, vk, device, queryPool.get(), props.limits.timestampPeriod, restoreFlags,
+                [&](VkCommandBuffer commandBuffer) {
+                    return primitives.recordCompact(commandBuffer, wholeRange(flagBuffer), wholeRange(keyBuffer),
+                                                    wholeRange(outputBuffer), wholeRange(countBuffer), count);
+                }, medianMs);
+            reportThroughput("Stream compaction", count, timed, medianMs, allPassed);
+            
+            timed = timePrimitive(renderer, vk, device, queryPool.get(), props.limits.timestampPeriod, restoreKeys,
+                [&](VkCommandBuffer commandBuffer) {
+                    return primitives.recordRadixSort(commandBuffer, wholeRange(keyBuffer), wholeRange(valueBuffer), count);
+                }, medianMs);
+            reportThroughput("Radix sort, 32 key bits", count, timed, medianMs, allPassed);
+        }
+        
+        coordinator->destroyResource(keySource);
+        coordinator->destroyResource(flagSource);
+        coordinator->destroyResource(keyBuffer);
+        coordinator->destroyResource(valueBuffer);
+        coordinator->destroyResource(flagBuffer);
+        coordinator->destroyResource(outputBuffer);
+        coordinator->destroyResource(countBuffer);
+        return allPassed;
+    }
+}
     
 void runBufferOverflowTests(VulkanRenderer* renderer) {
     if (!renderer) {
@@ -70,11 +287,198 @@ void runPerformanceTests(VulkanRenderer* renderer) {
     std::cout << "Performance test complete." << std::endl;
 }
 
+void runSpawnBenchmarks() {
+    std::cout << "\n⏱️  ENTITY SPAWN BENCHMARKS" << std::endl;
+    
+    using Clock = std::chrono::high_resolution_clock;
+    const glm::vec3 center(0.0f, 0.0f, 0.0f);
+    
+    // Each run spawns into a scratch world, so the live scene and GPU buffers are untouched
+    for (size_t count : {size_t(10000), size_t(100000), size_t(1000000)}) {
+        double perEntityMs = 0.0;
+        {
+            flecs::world world;
+            EntityFactory factory(world);
+            GPUEntitySoA staging;
+            staging.reserve(count);
+            
+            auto start = Clock::now();
+            auto entities = factory.createSwarm(count, center, 8.0f);
+            for (const auto& entity : entities) {
+                // Same component fetches as GPUEntityManager::addEntitiesFromECS
+                const Transform* transform = entity.get<Transform>();
+                const Renderable* renderable = entity.get<Renderable>();
+                const MovementPattern* movement = entity.get<MovementPattern>();
+                if (transform && renderable && movement) {
+                    staging.addFromECS(*transform, *renderable, *movement);
+                }
+            }
+            perEntityMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+        
+        double bulkMs = 0.0;
+        {
+            flecs::world world;
+            EntityFactory factory(world);
+            GPUEntitySoA staging;
+            staging.reserve(count);
+            
+            auto start = Clock::now();
+            auto entities = factory.createSwarmBulk(count, center, 8.0f, &staging);
+            bulkMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+        
+        auto throughput = [count](double ms) { return ms > 0.0 ? count / (ms * 1000.0) : 0.0; };
+        std::cout << count << " entities: per-entity " << perEntityMs << "ms (" << throughput(perEntityMs)
+                  << " M/s), bulk " << bulkMs << "ms (" << throughput(bulkMs) << " M/s), speedup "
+                  << (bulkMs > 0.0 ? perEntityMs / bulkMs : 0.0) << "x" << std::endl;
+    }
+    
+    std::cout << "Spawn benchmarks complete." << std::endl;
+}
+
+void runDrawPathBenchmark(VulkanRenderer* renderer, uint32_t framesPerPath) {
+    if (!renderer) {
+        std::cerr << "ERROR: Cannot run draw path benchmark - renderer is null!" << std::endl;
+        return;
+    }
+    
+    // Samples come from the next frames' timestamps, so the results print from the render loop
+    std::cout << "\n⏱️  ENTITY DRAW PATH BENCHMARK" << std::endl;
+    if (renderer->benchmarkEntityDrawPaths(framesPerPath)) {
+        std::cout << "Timing " << framesPerPath << " frames per path, results follow when complete" << std::endl;
+    } else {
+        std::cout << "❌ Draw path benchmark unavailable (no frame graph or no graphics timestamps)" << std::endl;
+    }
+}
+
+bool runGpuPrimitiveTests(VulkanRenderer* renderer) {
+    ResourceCoordinator* coordinator = renderer ? renderer->getResourceCoordinator() : nullptr;
+    PipelineSystemManager* pipelineSystem = renderer ? renderer->getPipelineSystem() : nullptr;
+    if (!coordinator || !coordinator->getContext() || !pipelineSystem) {
+        std::cerr << "ERROR: Cannot run GPU primitive tests - renderer not initialized!" << std::endl;
+        return false;
+    }
+    
+    std::cout << "\n🧮 GPU PRIMITIVE TESTS" << std::endl;
+    const auto& vk = coordinator->getContext()->getLoader();
+    
+    // Several blocks, so the block sums take the multi-level path, and not a multiple of the block size
+    const uint32_t count = 10007;
+    std::mt19937 rng(12345);
+    
+    // A private instance, so the test buffers never enter the renderer's descriptor set cache
+    GpuPrimitives primitives;
+    if (!primitives.initialize(*coordinator->getContext(), pipelineSystem->getComputeManager(), coordinator, count)) {
+        std::cerr << "ERROR: Cannot run GPU primitive tests - failed to initialize primitives!" << std::endl;
+        return false;
+    }
+    bool allPassed = true;
+    
+    // Exclusive scan
+    {
+        std::vector<uint32_t> input(count);
+        for (uint32_t& value : input) value = rng() % 16;
+        std::vector<uint32_t> expected(count);
+        std::exclusive_scan(input.begin(), input.end(), expected.begin(), 0u);
+        
+        ResourceHandle inputBuffer = createTestBuffer(coordinator, input);
+        ResourceHandle outputBuffer = createTestBuffer(coordinator, std::vector<uint32_t>(count, 0));
+        bool recorded = false;
+        bool submitted = inputBuffer.mappedData && outputBuffer.mappedData &&
+            renderer->submitImmediateCompute([&](VkCommandBuffer commandBuffer) {
+                recorded = primitives.recordExclusiveScan(commandBuffer, wholeRange(inputBuffer),
+                                                          wholeRange(outputBuffer), count);
+                recordHostReadBarrier(vk, commandBuffer);
+            });
+        reportCheck("Exclusive scan", submitted && recorded && readTestBuffer(outputBuffer, count) == expected, allPassed);
+        coordinator->destroyResource(inputBuffer);
+        coordinator->destroyResource(outputBuffer);
+    }
+    
+    // Stream compaction
+    {
+        std::vector<uint32_t> flags(count);
+        std::vector<uint32_t> values(count);
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < count; ++i) {
+            flags[i] = rng() % 3 == 0 ? 1u : 0u;
+            values[i] = i * 7u + 1u;
+            if (flags[i]) expected.push_back(values[i]);
+        }
+        
+        ResourceHandle flagBuffer = createTestBuffer(coordinator, flags);
+        ResourceHandle valueBuffer = createTestBuffer(coordinator, values);
+        ResourceHandle outputBuffer = createTestBuffer(coordinator, std::vector<uint32_t>(count, 0));
+        ResourceHandle countBuffer = createTestBuffer(coordinator, {0u});
+        bool recorded = false;
+        bool submitted = flagBuffer.mappedData && valueBuffer.mappedData && outputBuffer.mappedData &&
+            countBuffer.mappedData && renderer->submitImmediateCompute([&](VkCommandBuffer commandBuffer) {
+                recorded = primitives.recordCompact(commandBuffer, wholeRange(flagBuffer), wholeRange(valueBuffer),
+                                                    wholeRange(outputBuffer), wholeRange(countBuffer), count);
+                recordHostReadBarrier(vk, commandBuffer);
+            });
+        bool passed = submitted && recorded && readTestBuffer(countBuffer, 1)[0] == expected.size() &&
+                      readTestBuffer(outputBuffer, expected.size()) == expected;
+        reportCheck("Stream compaction", passed, allPassed);
+        coordinator->destroyResource(flagBuffer);
+        coordinator->destroyResource(valueBuffer);
+        coordinator->destroyResource(outputBuffer);
+        coordinator->destroyResource(countBuffer);
+    }
+    
+    // Radix sort: full keys, then 10 key bits over keys with higher bits set. 10 bits needs an odd
+    // number of passes plus the spare one, and its last digit is partial; both must ignore bits >= keyBits
+    for (uint32_t keyBits : {32u, 10u}) {
+        std::vector<uint32_t> keys(count);
+        std::vector<uint32_t> values(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            keys[i] = static_cast<uint32_t>(rng());
+            values[i] = i;
+        }
+        
+        const uint32_t keyMask = keyBits >= 32 ? ~0u : (1u << keyBits) - 1u;
+        std::vector<uint32_t> order(count);
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return (keys[a] & keyMask) < (keys[b] & keyMask);
+        });
+        std::vector<uint32_t> expectedKeys(count);
+        for (uint32_t i = 0; i < count; ++i) expectedKeys[i] = keys[order[i]];
+        
+        ResourceHandle keyBuffer = createTestBuffer(coordinator, keys);
+        ResourceHandle valueBuffer = createTestBuffer(coordinator, values);
+        bool recorded = false;
+        bool submitted = keyBuffer.mappedData && valueBuffer.mappedData &&
+            renderer->submitImmediateCompute([&](VkCommandBuffer commandBuffer) {
+                recorded = primitives.recordRadixSort(commandBuffer, wholeRange(keyBuffer), wholeRange(valueBuffer),
+                                                      count, keyBits);
+                recordHostReadBarrier(vk, commandBuffer);
+            });
+        bool passed = submitted && recorded && readTestBuffer(keyBuffer, count) == expectedKeys &&
+                      readTestBuffer(valueBuffer, count) == order;
+        const std::string name = "Radix sort, " + std::to_string(keyBits) + " key bits (stable)";
+        reportCheck(name.c_str(), passed, allPassed);
+        coordinator->destroyResource(keyBuffer);
+        coordinator->destroyResource(valueBuffer);
+    }
+    
+    if (!runGpuPrimitiveThroughput(renderer)) {
+        allPassed = false;
+    }
+    
+    std::cout << (allPassed ? "GPU primitive tests passed." : "GPU primitive tests FAILED.") << std::endl;
+    return allPassed;
+}
+
 void runAllTests(VulkanRenderer* renderer) {
     std::cout << "\n🚀 RUNNING ALL GRAPHICS TESTS 🚀" << std::endl;
     
     runBufferOverflowTests(renderer);
     runPerformanceTests(renderer);
+    runSpawnBenchmarks();
+    runGpuPrimitiveTests(renderer);
+    runDrawPathBenchmark(renderer);
     
     std::cout << "\n✨ ALL GRAPHICS TESTS COMPLETE ✨\n" << std::endl;
 }
@@ -10,6 +10,16 @@ namespace GraphicsTests {
     // Performance and capacity tests  
     void runPerformanceTests(VulkanRenderer* renderer);
     
+    // CPU spawn throughput, per-entity createSwarm + addEntitiesFromECS vs createSwarmBulk (10k/100k/1M)
+    void runSpawnBenchmarks();
+    
+    // GPU draw time, vertex pulling vs indexed instancing over the live entities; reported once the frames ran
+    void runDrawPathBenchmark(VulkanRenderer* renderer, uint32_t framesPerPath = 300);
+    
+    // GpuPrimitives scan, compaction and radix sort checked against CPU references, then timed at
+    // 64K, 1M and the entity capacity with elements/sec reported; stalls the GPU
+    bool runGpuPrimitiveTests(VulkanRenderer* renderer);
+    
     // Run all graphics tests
     void runAllTests(VulkanRenderer* renderer);
     
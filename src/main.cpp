@@ -2,16 +2,22 @@
 #include <SDL3/SDL_vulkan.h>
 #include <iostream>
 #include <chrono>
+#include <cstdlib>
+#include <string>
 #include <thread>
 
 #include "vulkan_renderer.h"
+#include "vulkan/nodes/entity_graphics_node.h"
 #include "ecs/utilities/debug.h"
 #include <flecs.h>
 #include "ecs/core/entity_factory.h"
 #include "ecs/systems/lifetime_system.h"
+#include "ecs/systems/position_readback_system.h"
 #include "ecs/components/component.h"
 #include "ecs/utilities/profiler.h"
 #include "ecs/gpu/gpu_entity_manager.h"
+#include "ecs/core/frame_packet.h"
+#include "ecs/core/frame_pacer.h"
 
 // New service-based architecture includes
 #include "ecs/core/world_manager.h"
@@ -26,6 +32,67 @@ int main(int argc, char* argv[]) {
     constexpr int TARGET_FPS = 60;
     constexpr float TARGET_FRAME_TIME = 1000.0f / TARGET_FPS; // 16.67ms
     
+    // --snapshot <path>: start from a saved simulation state instead of the default swarm
+    // --deterministic: fixed simulation step and seeded RNGs, --seed <n> picks the seed (default 1)
+    // --reorder <frames>: spatially reorder the entity rows every N frames, by grid cell with --reorder-cells
+    // --lod <auto|triangles|density>: entity level of detail, auto switches to density when zoomed out
+    // --draw-path <pulled|indexed>: entity triangles by vertex pulling (default) or indexed instancing
+    // --render-budget <ms>: entity pass GPU budget for dynamic resolution and MSAA, 0 renders at full quality
+    // --min-render-scale <f>, --max-msaa <n>: bounds of the dynamic resolution controller
+    // --single-thread: record and submit frames on the main thread instead of a render thread
+    // --fps <hz|display|uncapped>: frame pacing target (default 90 Hz)
+    std::string snapshotPath;
+    SimulationClock::Config clockConfig;
+    uint32_t reorderInterval = 0;
+    bool reorderByCell = false;
+    EntityLodMode lodMode = EntityLodMode::Auto;
+    EntityDrawPath drawPath = EntityDrawPath::VertexPulling;
+    RenderScaleController::Config renderScaleConfig;
+    bool renderThread = true;
+    FramePacer::Config pacerConfig;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--snapshot" && i + 1 < argc) {
+            snapshotPath = argv[++i];
+        } else if (arg == "--deterministic") {
+            clockConfig.fixedStep = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            clockConfig.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--reorder" && i + 1 < argc) {
+            reorderInterval = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--reorder-cells") {
+            reorderByCell = true;
+        } else if (arg == "--lod" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            lodMode = mode == "triangles" ? EntityLodMode::Triangles
+                    : mode == "density" ? EntityLodMode::Density
+                    : EntityLodMode::Auto;
+        } else if (arg == "--draw-path" && i + 1 < argc) {
+            drawPath = std::string(argv[++i]) == "indexed" ? EntityDrawPath::Indexed : EntityDrawPath::VertexPulling;
+        } else if (arg == "--render-budget" && i + 1 < argc) {
+            renderScaleConfig.targetMs = std::strtof(argv[++i], nullptr);
+        } else if (arg == "--min-render-scale" && i + 1 < argc) {
+            renderScaleConfig.minScale = std::strtof(argv[++i], nullptr);
+        } else if (arg == "--max-msaa" && i + 1 < argc) {
+            renderScaleConfig.maxSamples = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--single-thread") {
+            renderThread = false;
+        } else if (arg == "--fps" && i + 1 < argc) {
+            std::string target = argv[++i];
+            if (target == "display") {
+                pacerConfig.mode = FramePacer::Mode::DisplaySync;
+            } else if (target == "uncapped" || target == "0") {
+                pacerConfig.mode = FramePacer::Mode::Uncapped;
+            } else {
+                pacerConfig.mode = FramePacer::Mode::FixedRate;
+                pacerConfig.targetHz = std::strtof(target.c_str(), nullptr);
+            }
+        }
+    }
+    if (clockConfig.fixedStep && clockConfig.seed == 0) {
+        clockConfig.seed = 1;
+    }
+    
     // Set SDL vsync hint to 0 for safety (ignored with pure Vulkan, but good practice)
     SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
     
@@ -63,6 +130,14 @@ int main(int argc, char* argv[]) {
         SDL_Quit();
         return -1;
     }
+    
+    // Row order changes collision tie-breaks, so deterministic runs only reproduce with the same interval
+    SpatialReorder& spatialReorder = renderer.getGPUEntityManager()->getSpatialReorder();
+    spatialReorder.setInterval(reorderInterval);
+    spatialReorder.setKeyMode(reorderByCell ? SpatialReorder::KeyMode::GridCell : SpatialReorder::KeyMode::Morton);
+    renderer.setEntityLodMode(lodMode);
+    renderer.setEntityDrawPath(drawPath);
+    renderer.setRenderScaleConfig(renderScaleConfig, renderScaleConfig.targetMs > 0.0f);
 
     // Initialize service-based architecture with proper priorities
     auto& serviceLocator = ServiceLocator::instance();
@@ -84,6 +159,11 @@ int main(int argc, char* argv[]) {
     flecs::world& world = worldManager->getWorld();
     EntityFactory entityFactory(world);
     
+    renderer.configureSimulationClock(clockConfig);
+    const SimulationClock& simulationClock = renderer.getSimulationClock();
+    entityFactory.seedRandom(simulationClock.getSeed(SimulationClock::SeedStream::Spawn));
+    GPUEntitySoA::seedStateTimers(simulationClock.getSeed(SimulationClock::SeedStream::StateTimer));
+    
     // Declare service dependencies
     serviceLocator.declareDependencies<InputService, WorldManager>();
     serviceLocator.declareDependencies<CameraService, WorldManager>();
@@ -141,31 +221,43 @@ int main(int argc, char* argv[]) {
         return -1;
     }
     
-    // Simple system registration - no complex scheduling needed
-    world.system<Lifetime>("LifetimeSystem")
-        .each(lifetime_system);
+    // Lifetime aging runs on the flecs worker threads; expired entities release their GPU rows and are deleted in one batch
+    auto* gpuManagerForExpiry = renderer.getGPUEntityManager();
+    LifetimeSystem::registerSystems(world, [gpuManagerForExpiry](const std::vector<flecs::entity>& expired) {
+        gpuManagerForExpiry->releaseEntities(expired);
+    });
+    PositionReadbackSystem::registerSystems(world, renderer.getGPUEntityManager());
     
     DEBUG_LOG("Camera entities: " << world.count<Camera>());
     
     renderer.setWorld(&world);
     
-    Profiler::getInstance().setTargetFrameTime(TARGET_FRAME_TIME);
+    FramePacer pacer;
+    const SDL_DisplayMode* displayMode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+    pacer.configure(pacerConfig, displayMode ? displayMode->refresh_rate : 0.0f);
+    Profiler::getInstance().setTargetFrameTime(pacer.getTargetFrameMs() > 0.0f ? pacer.getTargetFrameMs() : TARGET_FRAME_TIME);
 
     constexpr size_t ENTITY_COUNT = 10;
     
-    DEBUG_LOG("Creating " << ENTITY_COUNT << " GPU entities for stress testing...");
-    
-    auto swarmEntities = entityFactory.createSwarm(
-        ENTITY_COUNT,
-        glm::vec3(10.0f, 10.0f, 0.0f),
-        8.0f
-    );
-    
-    auto* gpuEntityManager = renderer.getGPUEntityManager();
-    gpuEntityManager->addEntitiesFromECS(swarmEntities);
-    gpuEntityManager->uploadPendingEntities();
-    
-    DEBUG_LOG("Created " << swarmEntities.size() << " GPU entities!");
+    if (snapshotPath.empty() || !controlService->loadSnapshot(snapshotPath)) {
+        if (!snapshotPath.empty()) {
+            std::cerr << "Failed to load snapshot " << snapshotPath << ", spawning the default swarm" << std::endl;
+        }
+        
+        DEBUG_LOG("Creating " << ENTITY_COUNT << " GPU entities for stress testing...");
+        
+        auto* gpuEntityManager = renderer.getGPUEntityManager();
+        auto swarmEntities = entityFactory.createSwarmBulk(
+            ENTITY_COUNT,
+            glm::vec3(10.0f, 10.0f, 0.0f),
+            8.0f,
+            &gpuEntityManager->getStagingEntities()
+        );
+        gpuEntityManager->registerStagedEntities(swarmEntities);
+        gpuEntityManager->uploadPendingEntities();
+        
+        DEBUG_LOG("Created " << swarmEntities.size() << " GPU entities!");
+    }
     DEBUG_LOG("Total services active: " << ServiceLocator::instance().getServiceCount());
     
     bool running = true;
@@ -174,85 +266,115 @@ int main(int argc, char* argv[]) {
     int frameCount = 0;
     auto lastFrameTime = std::chrono::high_resolution_clock::now();
     
+    // From here on the ECS runs on this thread and frames are recorded on the render thread
+    if (renderThread && !renderer.startRenderThread()) {
+        std::cerr << "Failed to start the render thread, rendering on the main thread" << std::endl;
+    }
+    
     while (running) {
+        // Sleeps until just before the deadline, less the predicted cost of this frame
+        pacer.waitForFrameStart();
+        
         auto frameStartTime = std::chrono::high_resolution_clock::now();
         float deltaTime = std::chrono::duration<float>(frameStartTime - lastFrameTime).count();
         lastFrameTime = frameStartTime;
         
         deltaTime = std::min(deltaTime, 1.0f / 30.0f);
         
-        inputService->processSDLEvents();
-        // Frame cleanup for input (clear justPressed flags, etc.)
-        inputService->processFrame(deltaTime);
-        
-        auto* appState = world.get<ApplicationState>();
-        if (appState && (appState->requestQuit || !appState->running)) {
-            running = false;
-        }
+        FramePacket packet;
+        packet.frameNumber = static_cast<uint64_t>(frameCount);
+        packet.deltaTime = deltaTime;
         
-        renderer.setDeltaTime(deltaTime);
-        
-        // RESTORED WITH NEW NAME - DEBUG CHECK
-        if (controlService) {
-            controlService->processFrame(deltaTime);
-        } else {
-            std::cout << "ERROR: controlService is null!" << std::endl;
-        }
-        
-        // Handle window resize for camera aspect ratio
-        int width, height;
-        if (inputService->hasWindowResizeEvent(width, height)) {
-            cameraService->handleWindowResize(width, height);
-            renderer.updateAspectRatio(width, height);
-            renderer.setFramebufferResized(true);
-            DEBUG_LOG("Window resized to " << width << "x" << height);
-        }
-
         PROFILE_BEGIN_FRAME();
         
         {
-            PROFILE_SCOPE("ECS Update");
-            worldManager->executeFrame(deltaTime);
-        }
-        
-        {
-            PROFILE_SCOPE("Input Cleanup");
-            // Input cleanup is handled by services - no manual cleanup needed
-            // Service-based architecture handles frame state management internally
+            // The render thread takes this lock only to apply a packet and to submit, so the step
+            // below overlaps the recording of the previous frame
+            std::unique_lock<std::mutex> exchangeLock = renderer.lockFrameExchange();
+            
+            inputService->processSDLEvents();
+            packet.inputTimestampNS = inputService->takeOldestInputTimestampNS();
+            // Frame cleanup for input (clear justPressed flags, etc.)
+            inputService->processFrame(deltaTime);
+            
+            auto* appState = world.get<ApplicationState>();
+            if (appState && (appState->requestQuit || !appState->running)) {
+                running = false;
+            }
+            
+            // RESTORED WITH NEW NAME - DEBUG CHECK
+            if (controlService) {
+                controlService->processFrame(deltaTime);
+            } else {
+                std::cout << "ERROR: controlService is null!" << std::endl;
+            }
+            
+            // Handle window resize for camera aspect ratio
+            int width, height;
+            if (inputService->hasWindowResizeEvent(width, height)) {
+                cameraService->handleWindowResize(width, height);
+                renderer.updateAspectRatio(width, height);
+                packet.framebufferResized = true;
+                DEBUG_LOG("Window resized to " << width << "x" << height);
+            }
+            
+            packet.camera.view = cameraService->getViewMatrix();
+            packet.camera.proj = cameraService->getProjectionMatrix();
+            packet.camera.sampleTicksNS = SDL_GetTicksNS();
+            renderer.publishCamera(packet.camera);
+            
+            {
+                PROFILE_SCOPE("ECS Update");
+                worldManager->executeFrame(deltaTime);
+            }
+            
+            {
+                PROFILE_SCOPE("Input Cleanup");
+                // Input cleanup is handled by services - no manual cleanup needed
+                // Service-based architecture handles frame state management internally
+            }
+            
+            packet.spawnEpoch = renderer.getGPUEntityManager()->takeStagedEntities(packet.spawns);
         }
 
         {
+            // Blocks while the render thread is a full packet behind
             PROFILE_SCOPE("Vulkan Rendering");
-            renderer.drawFrame();
+            renderer.submitFramePacket(std::move(packet));
         }
+        pacer.endFrame();
 
         frameCount++;
         PROFILE_END_FRAME();
         
         if (frameCount % 300 == 0) {
+            // The render thread updates the latency stats under the exchange lock
+            auto exchangeLock = renderer.lockFrameExchange();
             float avgFrameTime = Profiler::getInstance().getFrameTime();
             size_t activeEntities = static_cast<size_t>(world.count<Transform>());
-            size_t estimatedMemory = activeEntities * (sizeof(Transform) + sizeof(Renderable) + sizeof(MovementPattern));
+            const MemoryAccounting& accounting = MemoryAccounting::getInstance();
+            size_t cpuMemory = static_cast<size_t>(accounting.getTotalCpuBytes());
             
-            Profiler::getInstance().updateMemoryUsage(estimatedMemory);
+            Profiler::getInstance().updateMemoryUsage(cpuMemory);
             
             float fps = avgFrameTime > 0.0f ? (1000.0f / avgFrameTime) : 0.0f;
             std::cout << "Frame " << frameCount 
                       << ": Avg " << avgFrameTime << "ms"
                       << " (" << fps << " FPS)"
                       << " | Entities: " << activeEntities
-                      << " | Est Memory: " << (estimatedMemory / 1024) << "KB"
+                      << " | CPU Memory: " << (cpuMemory / 1024) << "KB"
+                      << " | GPU Memory: " << (accounting.getDeviceLocalUsage() / (1024 * 1024)) << "/"
+                      << (accounting.getDeviceLocalBudget() / (1024 * 1024)) << "MB"
+                      << " | Input->submit: " << renderer.getLatencyStats().averageInputToSubmitMs << "ms"
+                      << " (camera age " << renderer.getLatencyStats().cameraAgeAtSubmitMs << "ms)"
                       << std::endl;
-        }
-        
-        auto frameEndTime = std::chrono::high_resolution_clock::now();
-        float frameTimeMs = std::chrono::duration<float, std::milli>(frameEndTime - frameStartTime).count();
-        
-        constexpr float MIN_FRAME_TIME = 11.0f;
-        if (frameTimeMs < MIN_FRAME_TIME) {
-            float remainingMs = MIN_FRAME_TIME - frameTimeMs;
-            if (remainingMs > 0.5f) {
-                SDL_Delay(static_cast<int>(remainingMs));
+            if (pacer.getTargetFrameMs() > 0.0f) {
+                const Profiler& profiler = Profiler::getInstance();
+                std::cout << "  Pacing error p50/p95/p99: " << profiler.getRecentPercentile("Pacing Error", 0.50f) << "/"
+                          << profiler.getRecentPercentile("Pacing Error", 0.95f) << "/"
+                          << profiler.getRecentPercentile("Pacing Error", 0.99f) << "ms"
+                          << " | Predicted work: " << pacer.getPredictedWorkMs() << "ms"
+                          << " | Spin margin: " << pacer.getSpinMarginMs() << "ms" << std::endl;
             }
         }
     }
@@ -0,0 +1,35 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+#extension GL_GOOGLE_include_directive : require
+
+// Buffer indices only; the density view below is all this pass reads
+#define ENTITY_SCHEMA_READONLY
+#include "entity_schema.glsl"
+
+// Push constants (must match EntityGraphicsNode::ResolvePushConstants)
+layout(push_constant) uniform DensityResolvePushConstants {
+    uint texelSize;
+    uint densityWidth;
+    float exposure;     // DENSITY_EXPOSURE
+    uint reserved;
+} pc;
+
+layout(std430, binding = 1) readonly buffer DensityView {
+    uvec4 texels[];
+} densityViews[];
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    uvec2 texel = uvec2(gl_FragCoord.xy) / pc.texelSize;
+    uvec4 density = densityViews[DENSITY_BUFFER].texels[texel.x + texel.y * pc.densityWidth];
+    if (density.w == 0u) {
+        discard;
+    }
+
+    // Average entity color, blended over the clear color by how crowded the texel is
+    vec3 color = vec3(density.xyz) / (255.0 * float(density.w));
+    float coverage = 1.0 - exp(-float(density.w) * pc.exposure);
+    outColor = vec4(color, coverage);
+}
@@ -0,0 +1,87 @@
+// Generated by EntitySchema::generateGLSL() for the "legacy" schema (176 bytes/entity) - do not edit.
+// Requires GL_EXT_nonuniform_qualifier. Define ENTITY_SCHEMA_READONLY for read-only stages.
+#ifndef ENTITY_SCHEMA_GLSL
+#define ENTITY_SCHEMA_GLSL
+
+const uint VELOCITY_BUFFER = 0u;
+const uint MOVEMENT_PARAMS_BUFFER = 1u;
+const uint RUNTIME_STATE_BUFFER = 2u;
+const uint ROTATION_STATE_BUFFER = 3u;
+const uint COLOR_BUFFER = 4u;
+const uint MODEL_MATRIX_BUFFER = 5u;
+const uint POSITION_OUTPUT_BUFFER = 6u;
+const uint CURRENT_POSITION_BUFFER = 7u;
+const uint SPATIAL_MAP_BUFFER = 8u;
+const uint SPATIAL_QUERY_BUFFER = 9u;
+const uint SPATIAL_QUERY_RESULT_BUFFER = 10u;
+const uint COLLISION_LINK_BUFFER = 11u;
+const uint COLLISION_PAIR_BUFFER = 12u;
+const uint SPATIAL_REORDER_BUFFER = 13u;
+const uint REORDER_SCRATCH_BUFFER = 14u;
+const uint DENSITY_BUFFER = 15u;
+const uint MAX_ENTITY_BUFFERS = 16u;
+
+#ifdef ENTITY_SCHEMA_READONLY
+#define ENTITY_SCHEMA_ACCESS readonly
+#else
+#define ENTITY_SCHEMA_ACCESS
+#endif
+
+layout(std430, binding = 1) ENTITY_SCHEMA_ACCESS buffer EntityBuffersVec4 {
+    vec4 data[];
+} entityBuffersVec4[];
+
+// VelocityBuffer: vec4 fp32
+vec4 loadVelocity(uint i) { return entityBuffersVec4[VELOCITY_BUFFER].data[i]; }
+#ifndef ENTITY_SCHEMA_READONLY
+void storeVelocity(uint i, vec4 v) { entityBuffersVec4[VELOCITY_BUFFER].data[i] = v; }
+#endif
+
+// MovementParamsBuffer: vec4 fp32
+vec4 loadMovementParams(uint i) { return entityBuffersVec4[MOVEMENT_PARAMS_BUFFER].data[i]; }
+#ifndef ENTITY_SCHEMA_READONLY
+void storeMovementParams(uint i, vec4 v) { entityBuffersVec4[MOVEMENT_PARAMS_BUFFER].data[i] = v; }
+#endif
+
+// RuntimeStateBuffer: vec4 fp32
+vec4 loadRuntimeState(uint i) { return entityBuffersVec4[RUNTIME_STATE_BUFFER].data[i]; }
+#ifndef ENTITY_SCHEMA_READONLY
+void storeRuntimeState(uint i, vec4 v) { entityBuffersVec4[RUNTIME_STATE_BUFFER].data[i] = v; }
+#endif
+
+// RotationStateBuffer: vec4 fp32
+vec4 loadRotationState(uint i) { return entityBuffersVec4[ROTATION_STATE_BUFFER].data[i]; }
+#ifndef ENTITY_SCHEMA_READONLY
+void storeRotationState(uint i, vec4 v) { entityBuffersVec4[ROTATION_STATE_BUFFER].data[i] = v; }
+#endif
+
+// ColorBuffer: vec4 fp32
+vec4 loadColor(uint i) { return entityBuffersVec4[COLOR_BUFFER].data[i]; }
+#ifndef ENTITY_SCHEMA_READONLY
+void storeColor(uint i, vec4 v) { entityBuffersVec4[COLOR_BUFFER].data[i] = v; }
+#endif
+
+// ModelMatrixBuffer: mat4 fp32
+mat4 loadModelMatrix(uint i) {
+    return mat4(entityBuffersVec4[MODEL_MATRIX_BUFFER].data[i * 4u], entityBuffersVec4[MODEL_MATRIX_BUFFER].data[i * 4u + 1u],
+                entityBuffersVec4[MODEL_MATRIX_BUFFER].data[i * 4u + 2u], entityBuffersVec4[MODEL_MATRIX_BUFFER].data[i * 4u + 3u]);
+}
+#ifndef ENTITY_SCHEMA_READONLY
+void storeModelMatrix(uint i, mat4 m) {
+    for (uint c = 0u; c < 4u; c++) entityBuffersVec4[MODEL_MATRIX_BUFFER].data[i * 4u + c] = m[c];
+}
+#endif
+
+// PositionOutputBuffer: vec4 fp32
+vec4 loadPosition(uint i) { return entityBuffersVec4[POSITION_OUTPUT_BUFFER].data[i]; }
+#ifndef ENTITY_SCHEMA_READONLY
+void storePosition(uint i, vec4 v) { entityBuffersVec4[POSITION_OUTPUT_BUFFER].data[i] = v; }
+#endif
+
+// CurrentPositionBuffer: vec4 fp32
+vec4 loadCurrentPosition(uint i) { return entityBuffersVec4[CURRENT_POSITION_BUFFER].data[i]; }
+#ifndef ENTITY_SCHEMA_READONLY
+void storeCurrentPosition(uint i, vec4 v) { entityBuffersVec4[CURRENT_POSITION_BUFFER].data[i] = v; }
+#endif
+
+#endif // ENTITY_SCHEMA_GLSL
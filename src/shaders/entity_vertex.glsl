@@ -0,0 +1,104 @@
+// Shared by the entity vertex shaders (vertex.vert, vertex_pulled.vert), which only differ in
+// where the triangle corner and entity index come from. Include after entity_schema.glsl
+
+layout(binding = 0) uniform UBO {
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+// Must match EntityGraphicsNode::VertexPushConstants
+layout(push_constant) uniform PC {
+    mat4  viewProj;         // Late-latched camera, used when cameraLatched != 0
+    float time;
+    float dt;
+    uint  count;
+    uint  cameraLatched;
+} pc;
+
+/* ---------- HSV → RGB ---------- */
+vec3 hsv2rgb(float h, float s, float v) {
+    float c  = v * s;
+    float x  = c * (1.0 - abs(mod(h * 6.0, 2.0) - 1.0));
+    float m  = v - c;
+    vec3  rgb;
+
+    if      (h < 1.0/6.0) rgb = vec3(c, x, 0);
+    else if (h < 2.0/6.0) rgb = vec3(x, c, 0);
+    else if (h < 3.0/6.0) rgb = vec3(0, c, x);
+    else if (h < 4.0/6.0) rgb = vec3(0, x, c);
+    else if (h < 5.0/6.0) rgb = vec3(x, 0, c);
+    else                    rgb = vec3(c, 0, x);
+
+    return rgb + m;
+}
+
+vec3 entityColor(uint entityIndex) {
+    float index = float(entityIndex);
+
+    // Extract movement parameters for color calculation from SoA buffers
+    vec4 entityMovementParams = loadMovementParams(entityIndex);
+    float phase = entityMovementParams.z;
+    float timeOffset = entityMovementParams.w;
+    float entityTime = pc.time + timeOffset;
+
+    // Calculate dynamic color based on movement parameters with strong per-entity individualization
+    // Use the entity index to create much stronger base color variation per entity
+    float entityBaseHue = mod(index * 0.618034, 1.0); // Golden ratio for good distribution
+
+    // Per-entity individualized timing and frequencies - INTENSE VERSION
+    float entityFreqMultiplier = 0.3 + mod(index * 0.7321, 1.0) * 2.7; // Range: 0.3 to 3.0 (much wider)
+    float entityPhaseOffset = mod(index * 2.3941, 6.28318530718); // Unique phase offset
+    float entityTimeOffset = mod(index * 1.4142, 15.0); // Unique time offset (longer spread)
+
+    // INTENSE individualized phase system - shorter, more frequent phases
+    float individualTime = entityTime * entityFreqMultiplier + entityTimeOffset + phase;
+    float phaseLengthVariation = 0.8 + mod(index * 0.8660, 1.0) * 1.7; // Phase length: 0.8-2.5 seconds (much faster)
+    float colorPhaseTime = individualTime * 0.8 + entityPhaseOffset; // 2x faster base rate
+    float colorPhase = floor(colorPhaseTime / phaseLengthVariation);
+    float phaseProgress = mod(colorPhaseTime, phaseLengthVariation) / phaseLengthVariation;
+
+    // More dramatic transition curves for intensity
+    float phaseTransition = smoothstep(0.1, 0.9, phaseProgress); // Steeper transitions
+
+    // INTENSE individualized phase-based hue shifts - much larger jumps
+    float entityHueShiftAmount = 0.2 + mod(index * 0.5257, 1.0) * 0.6; // Shift amount: 20-80% (massive jumps)
+    float phaseHueShift = mod(colorPhase * entityHueShiftAmount, 1.0);
+    float nextPhaseHueShift = mod((colorPhase + 1.0) * entityHueShiftAmount, 1.0);
+    float currentHueShift = mix(phaseHueShift, nextPhaseHueShift, phaseTransition);
+
+    // Combine base hue with INTENSE individualized phase shifting
+    float hue = mod(entityBaseHue + currentHueShift, 1.0);
+
+    // EXTREME brightness variation with intense breathing patterns
+    float entityBrightnessBase = mod(index * 0.381966, 1.0);
+    float brightnessFreq = 0.4 + mod(index * 0.9511, 1.0) * 1.2; // Range: 0.4 to 1.6 (much faster)
+    float brightnessPhase = sin(individualTime * brightnessFreq + entityPhaseOffset * 2.0) * 0.7; // Much stronger amplitude
+    float brightness = 0.2 + entityBrightnessBase * 0.7 + brightnessPhase; // Range: -0.5 to 1.6
+    brightness = clamp(brightness, 0.05, 1.0); // Allow very dim to very bright
+
+    // EXTREME saturation variation with intense cycling patterns
+    float entitySaturationBase = mod(index * 0.236068, 1.0);
+    float saturationFreq = 0.3 + mod(index * 0.4472, 1.0) * 1.0; // Range: 0.3 to 1.3 (much faster)
+    float saturationPhase = cos(individualTime * saturationFreq + entityPhaseOffset * 1.7) * 0.8; // Much stronger amplitude
+    float saturation = 0.1 + entitySaturationBase * 0.8 + saturationPhase; // Range: -0.7 to 1.7
+    saturation = clamp(saturation, 0.0, 1.0); // Allow completely desaturated to fully saturated
+
+    return hsv2rgb(hue, saturation, brightness);
+}
+
+// Rotates a triangle corner by the entity's rotation, places it at the entity position and projects it
+vec4 entityClipPosition(uint entityIndex, vec2 corner) {
+    vec3 worldPos = loadPosition(entityIndex).xyz;
+    float rot = loadRotationState(entityIndex).x;
+
+    float cosRot = cos(rot);
+    float sinRot = sin(rot);
+    vec2 rotatedVertex = vec2(
+        corner.x * cosRot - corner.y * sinRot,
+        corner.x * sinRot + corner.y * cosRot
+    );
+
+    vec3 finalPos = vec3(worldPos.xy + rotatedVertex, 0.0);
+    mat4 viewProj = pc.cameraLatched != 0u ? pc.viewProj : ubo.proj * ubo.view;
+    return viewProj * vec4(finalPos, 1.0);
+}
@@ -0,0 +1,27 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+#extension GL_GOOGLE_include_directive : require
+
+// Entity buffer indices, views and load accessors generated from EntitySchema
+#define ENTITY_SCHEMA_READONLY
+#include "entity_schema.glsl"
+
+// Camera, push constants, per-entity color and placement
+#include "entity_vertex.glsl"
+
+// Vertex pulling: a non-indexed draw of 3 * count vertices with no vertex buffers bound.
+// Corners must match PolygonFactory::createTriangle
+const vec2 TRIANGLE_CORNERS[3] = vec2[](
+    vec2(0.0, -2.0),
+    vec2(2.0, 2.0),
+    vec2(-2.0, 2.0)
+);
+
+layout(location = 0) out vec3 color;
+
+void main() {
+    uint entityIndex = uint(gl_VertexIndex) / 3u;
+    color = entityColor(entityIndex);
+    gl_Position = entityClipPosition(entityIndex, TRIANGLE_CORNERS[uint(gl_VertexIndex) % 3u]);
+}
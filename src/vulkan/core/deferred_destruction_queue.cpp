@@ -0,0 +1,40 @@
+#include "deferred_destruction_queue.h"
+#include "vulkan_constants.h"
+#include <vector>
+
+void DeferredDestructionQueue::push(std::unique_ptr<Entry> entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    retired.push_back({currentFrame, std::move(entry)});
+}
+
+void DeferredDestructionQueue::beginFrame(uint64_t frameNumber) {
+    std::vector<std::unique_ptr<Entry>> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentFrame = frameNumber;
+        while (!retired.empty() && retired.front().frame + MAX_FRAMES_IN_FLIGHT <= frameNumber) {
+            ready.push_back(std::move(retired.front().entry));
+            retired.pop_front();
+        }
+    }
+    // Destroyed outside the lock, in retirement order
+    for (auto& entry : ready) {
+        entry.reset();
+    }
+}
+
+void DeferredDestructionQueue::flush() {
+    std::deque<Retired> all;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        all.swap(retired);
+    }
+    while (!all.empty()) {
+        all.pop_front();
+    }
+}
+
+size_t DeferredDestructionQueue::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return retired.size();
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Frame-indexed deferred destruction. Objects that frames in flight may still reference (pipelines,
+ * render passes, framebuffers, attachments, a retired swapchain) are handed over instead of being
+ * destroyed, tagged with the frame being recorded, and destroyed once that frame has completed on
+ * the GPU. Swapchain resize and pipeline recreation then replace objects without draining the device.
+ *
+ * VulkanRenderer calls beginFrame() after waiting on a frame slot's fences: the frame that last
+ * used the slot, MAX_FRAMES_IN_FLIGHT frames back, and every frame before it have completed.
+ * flush() destroys everything regardless and is only for after vkDeviceWaitIdle.
+ */
+class DeferredDestructionQueue {
+public:
+    ~DeferredDestructionQueue() { flush(); }
+
+    // Takes ownership of anything whose destructor releases GPU objects: vulkan_raii handles,
+    // structs or vectors of them, unique_ptrs to cached pipelines
+    template<typename T>
+    void retire(T&& resource) {
+        push(std::make_unique<Holder<std::decay_t<T>>>(std::forward<T>(resource)));
+    }
+
+    // Raw handles without an RAII wrapper
+    void retireCallback(std::function<void()> destroy) {
+        retire(CallbackOnDestroy{std::move(destroy)});
+    }
+
+    void beginFrame(uint64_t frameNumber);
+    void flush();
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        virtual ~Entry() = default;
+    };
+
+    template<typename T>
+    struct Holder : Entry {
+        explicit Holder(T&& value) : resource(std::move(value)) {}
+        explicit Holder(const T& value) : resource(value) {}
+        T resource;
+    };
+
+    struct CallbackOnDestroy {
+        std::function<void()> destroy;
+        CallbackOnDestroy(std::function<void()> fn) : destroy(std::move(fn)) {}
+        CallbackOnDestroy(CallbackOnDestroy&& other) noexcept : destroy(std::exchange(other.destroy, nullptr)) {}
+        CallbackOnDestroy(const CallbackOnDestroy&) = delete;
+        ~CallbackOnDestroy() {
+            if (destroy) {
+                destroy();
+            }
+        }
+    };
+
+    struct Retired {
+        uint64_t frame;
+        std::unique_ptr<Entry> entry;
+    };
+
+    void push(std::unique_ptr<Entry> entry);
+
+    mutable std::mutex mutex;
+    std::deque<Retired> retired;    // Ordered by frame
+    uint64_t currentFrame = 0;
+};
@@ -43,6 +43,10 @@ void QueueManager::cleanup() {
 }
 
 void QueueManager::cleanupBeforeContextDestruction() {
+    // Secondary pools free their command buffers on destruction
+    graphicsSecondaryPools.clear();
+    computeSecondaryPools.clear();
+    
     // RAII command pools will clean up automatically
     graphicsCommandPool.reset();
     computeCommandPool.reset();
@@ -227,6 +231,81 @@ void QueueManager::resetAllCommandBuffers() {
     }
 }
 
+bool QueueManager::initializeSecondaryCommandPools(uint32_t threadCount) {
+    if (!context) {
+        std::cerr << "QueueManager: Cannot create secondary command pools - not initialized" << std::endl;
+        return false;
+    }
+    
+    graphicsSecondaryPools.clear();
+    computeSecondaryPools.clear();
+    graphicsSecondaryPools.resize(threadCount);
+    computeSecondaryPools.resize(threadCount);
+    
+    for (uint32_t thread = 0; thread < threadCount; ++thread) {
+        if (!createSecondaryPoolRing(graphicsSecondaryPools[thread], CommandPoolType::Graphics) ||
+            !createSecondaryPoolRing(computeSecondaryPools[thread], CommandPoolType::Compute)) {
+            std::cerr << "QueueManager: Failed to create secondary command pools for thread " << thread << std::endl;
+            graphicsSecondaryPools.clear();
+            computeSecondaryPools.clear();
+            return false;
+        }
+    }
+    
+    std::cout << "QueueManager: Created secondary command pools for " << threadCount << " recording threads" << std::endl;
+    return true;
+}
+
+VkCommandBuffer QueueManager::acquireSecondaryCommandBuffer(uint32_t threadIndex, uint32_t frameIndex, CommandPoolType type) {
+    if (!context || frameIndex >= MAX_FRAMES_IN_FLIGHT) {
+        return VK_NULL_HANDLE;
+    }
+    
+    auto& pools = (type == CommandPoolType::Compute) ? computeSecondaryPools : graphicsSecondaryPools;
+    if (type == CommandPoolType::Transfer || threadIndex >= pools.size()) {
+        std::cerr << "QueueManager: Invalid secondary command buffer request (thread " << threadIndex << ")" << std::endl;
+        return VK_NULL_HANDLE;
+    }
+    
+    SecondaryCommandPool& slot = pools[threadIndex][frameIndex];
+    if (slot.nextFree < slot.commandBuffers.size()) {
+        return slot.commandBuffers[slot.nextFree++];
+    }
+    
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = slot.pool.get();
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    allocInfo.commandBufferCount = 1;
+    
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    if (context->getLoader().vkAllocateCommandBuffers(context->getDevice(), &allocInfo, &commandBuffer) != VK_SUCCESS) {
+        std::cerr << "QueueManager: Failed to allocate secondary command buffer" << std::endl;
+        return VK_NULL_HANDLE;
+    }
+    
+    slot.commandBuffers.push_back(commandBuffer);
+    slot.nextFree = static_cast<uint32_t>(slot.commandBuffers.size());
+    return commandBuffer;
+}
+
+void QueueManager::resetSecondaryCommandPools(uint32_t frameIndex) {
+    if (!context || frameIndex >= MAX_FRAMES_IN_FLIGHT) return;
+    
+    const auto& vk = context->getLoader();
+    const VkDevice device = context->getDevice();
+    
+    for (auto* pools : {&graphicsSecondaryPools, &computeSecondaryPools}) {
+        for (auto& ring : *pools) {
+            SecondaryCommandPool& slot = ring[frameIndex];
+            if (slot.nextFree > 0) {
+                vk.vkResetCommandPool(device, slot.pool.get(), 0);
+                slot.nextFree = 0;
+            }
+        }
+    }
+}
+
 void QueueManager::logTelemetry() const {
     std::cout << "QueueManager Telemetry:" << std::endl;
     std::cout << "  Graphics submissions: " << telemetry.graphicsSubmissions << std::endl;
@@ -317,6 +396,24 @@ bool QueueManager::createFrameCommandBuffers() {
     return true;
 }
 
+bool QueueManager::createSecondaryPoolRing(SecondaryPoolRing& ring, CommandPoolType type) {
+    for (auto& slot : ring) {
+        // Whole-pool reset per frame, so individual buffer reset is not needed
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = getQueueFamilyForPool(type);
+        
+        slot.pool = vulkan_raii::create_command_pool(context, &poolInfo);
+        if (!slot.pool) {
+            return false;
+        }
+        slot.commandBuffers.clear();
+        slot.nextFree = 0;
+    }
+    return true;
+}
+
 VkCommandPoolCreateFlags QueueManager::getCommandPoolFlags(CommandPoolType type) const {
     switch (type) {
         case CommandPoolType::Graphics:
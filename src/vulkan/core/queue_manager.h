@@ -5,6 +5,7 @@
 #include "vulkan_raii.h"
 #include "vulkan_constants.h"
 #include <vector>
+#include <array>
 #include <memory>
 #include <unordered_map>
 
@@ -77,6 +78,14 @@ public:
     void resetCommandBuffersForFrame(uint32_t frameIndex);
     void resetAllCommandBuffers();
     
+    // Per-thread secondary command buffers for parallel frame graph recording.
+    // Each recording thread owns one pool per queue type and frame in flight, so
+    // threads never share a pool and pools are reset wholesale once the frame's fence has signaled.
+    bool initializeSecondaryCommandPools(uint32_t threadCount);
+    VkCommandBuffer acquireSecondaryCommandBuffer(uint32_t threadIndex, uint32_t frameIndex, CommandPoolType type);
+    void resetSecondaryCommandPools(uint32_t frameIndex);
+    uint32_t getSecondaryThreadCount() const { return static_cast<uint32_t>(graphicsSecondaryPools.size()); }
+    
     // Queue utilization telemetry
     struct QueueTelemetry {
         uint64_t graphicsSubmissions = 0;
@@ -126,12 +135,23 @@ private:
     std::vector<VkCommandBuffer> graphicsCommandBuffers;
     std::vector<VkCommandBuffer> computeCommandBuffers;
     
+    // Per-thread secondary command pools, indexed [thread][frame]
+    struct SecondaryCommandPool {
+        vulkan_raii::CommandPool pool;
+        std::vector<VkCommandBuffer> commandBuffers; // Grown on demand, reused after pool reset
+        uint32_t nextFree = 0;
+    };
+    using SecondaryPoolRing = std::array<SecondaryCommandPool, MAX_FRAMES_IN_FLIGHT>;
+    std::vector<SecondaryPoolRing> graphicsSecondaryPools;
+    std::vector<SecondaryPoolRing> computeSecondaryPools;
+    
     // Telemetry tracking
     mutable QueueTelemetry telemetry;
     
     // Internal command pool creation
     bool createCommandPools();
     bool createFrameCommandBuffers();
+    bool createSecondaryPoolRing(SecondaryPoolRing& ring, CommandPoolType type);
     
     // Helper methods
     VkCommandPoolCreateFlags getCommandPoolFlags(CommandPoolType type) const;
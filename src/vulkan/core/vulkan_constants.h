@@ -17,12 +17,43 @@ constexpr uint32_t DEFAULT_GRAPHICS_CACHE_SIZE = 1024;
 constexpr uint32_t DEFAULT_COMPUTE_CACHE_SIZE = 512;
 constexpr uint32_t DEFAULT_SHADER_CACHE_SIZE = 512;
 constexpr uint32_t DEFAULT_LAYOUT_CACHE_SIZE = 256;
+constexpr uint32_t SPIRV_DISK_CACHE_MAX_ENTRIES = 1024;
 constexpr uint64_t CACHE_CLEANUP_INTERVAL = 1000;  // frames
 
 // Compute Configuration
 constexpr uint32_t THREADS_PER_WORKGROUP = 64;
 constexpr uint32_t MAX_WORKGROUPS_PER_CHUNK = 512;
 
+// Spatial Grid Defaults (collision.comp specialization constants)
+constexpr float SPATIAL_CELL_SIZE = 1.5f;
+constexpr uint32_t SPATIAL_GRID_WIDTH = 64;  // Must be a power of 2
+constexpr uint32_t MAX_SPATIAL_GRID_WIDTH = 256;  // Spatial map buffer is sized for this
+constexpr uint32_t MAX_ENTITIES_PER_CELL = 64;
+
+// Batched Spatial Queries (spatial_query.comp)
+constexpr uint32_t MAX_SPATIAL_QUERIES = 64;       // Per frame; the rest wait for the next frame
+constexpr uint32_t MAX_SPATIAL_QUERY_HITS = 8192;  // Hit records shared by one frame's queries
+
+// Collision Pipeline (collision.comp)
+constexpr uint32_t MAX_COLLISION_PAIRS = 262144;     // Broadphase candidates per step; overflow is dropped
+constexpr float COLLISION_BOUNDING_RADIUS = 0.5f;    // Bounding circle of the collision triangle
+
+// GPU Parallel Primitives (prefix_scan.comp, stream_compact.comp, radix_sort.comp)
+constexpr uint32_t GPU_PRIMITIVE_BLOCK_SIZE = 128;          // Elements per workgroup; must match the shaders
+constexpr uint32_t GPU_PRIMITIVE_RADIX_BITS = 4;            // Key bits per radix sort pass
+constexpr uint32_t GPU_PRIMITIVE_MAX_DESCRIPTOR_SETS = 64;  // Cached buffer combinations
+
+// Spatial Row Reordering (spatial_reorder.comp)
+constexpr uint32_t SPATIAL_REORDER_HEADER_WORDS = 64;       // Stats header; keeps the sort sections offset-aligned
+constexpr uint32_t SPATIAL_REORDER_COHERENCE_WINDOW = 16;   // Rows apart that still count as coherent
+
+// Density LOD (density_splat.comp, density_resolve.frag)
+constexpr uint32_t DENSITY_MAX_TEXELS = 1u << 20;     // Texels grow past 2x2 pixels when the screen needs more
+constexpr uint32_t DENSITY_MIN_TEXEL_SIZE = 2;        // Pixels per texel side at most resolutions
+constexpr float DENSITY_LOD_ENTER_PIXELS = 1.5f;      // On-screen entity size that switches to density
+constexpr float DENSITY_LOD_EXIT_PIXELS = 2.5f;       // Size that switches back to triangles (hysteresis)
+constexpr float DENSITY_EXPOSURE = 0.35f;             // Tone map: coverage = 1 - exp(-count * exposure)
+
 // Memory Sizes (in bytes)
 constexpr size_t MEGABYTE = 1024 * 1024;
 constexpr size_t STAGING_BUFFER_SIZE = 16 * MEGABYTE;
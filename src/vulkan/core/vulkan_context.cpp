@@ -23,7 +23,7 @@ const bool enableValidationLayers = false;
 const bool enableValidationLayers = true;
 #endif
 
-VulkanContext::VulkanContext() {
+VulkanContext::VulkanContext() : deferredDestruction(std::make_unique<DeferredDestructionQueue>()) {
 }
 
 VulkanContext::~VulkanContext() {
@@ -90,6 +90,9 @@ void VulkanContext::cleanup() {
 }
 
 void VulkanContext::cleanupBeforeContextDestruction() {
+    // Anything still retired goes before the device it was created on
+    deferredDestruction->flush();
+    
     // RAII wrappers handle automatic cleanup
     debugMessenger.reset();
     device.reset();
@@ -211,6 +214,29 @@ bool VulkanContext::createLogicalDevice() {
     vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
     vulkan13Features.dynamicRendering = VK_TRUE;
     vulkan13Features.synchronization2 = VK_TRUE;
+    
+    // Buffer device address for the entity column address table (see EntityBufferManager)
+    VkPhysicalDeviceVulkan12Features supported12Features{};
+    supported12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceFeatures2 supportedFeatures{};
+    supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supportedFeatures.pNext = &supported12Features;
+    if (loader->vkGetPhysicalDeviceFeatures2) {
+        loader->vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures);
+    }
+    bufferDeviceAddressSupported = supported12Features.bufferDeviceAddress == VK_TRUE;
+    if (bufferDeviceAddressSupported) {
+        std::cout << "bufferDeviceAddress supported - enabling address-based entity column access" << std::endl;
+    }
+    
+    // Host query reset lets timestamp pairs be recycled without a reset recorded ahead of the write
+    hostQueryResetSupported = supported12Features.hostQueryReset == VK_TRUE;
+    
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan12Features.bufferDeviceAddress = bufferDeviceAddressSupported ? VK_TRUE : VK_FALSE;
+    vulkan12Features.hostQueryReset = hostQueryResetSupported ? VK_TRUE : VK_FALSE;
+    vulkan13Features.pNext = &vulkan12Features;
 
     // Build list of actually supported extensions
     uint32_t extensionCount;
@@ -243,6 +269,13 @@ bool VulkanContext::createLogicalDevice() {
         enabledExtensions.push_back(VK_EXT_SWAPCHAIN_MAINTENANCE_1_EXTENSION_NAME);
         std::cout << "VK_EXT_swapchain_maintenance1 supported - enabling low-latency optimizations" << std::endl;
     }
+    
+    // Driver-reported heap budgets for memory accounting and eviction
+    memoryBudgetSupported = availableExtensionNames.count(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) > 0;
+    if (memoryBudgetSupported) {
+        enabledExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        std::cout << "VK_EXT_memory_budget supported - enabling per-heap budget tracking" << std::endl;
+    }
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
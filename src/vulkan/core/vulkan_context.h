@@ -8,6 +8,7 @@
 #include <vector>
 #include <memory>
 #include "vulkan_raii.h"
+#include "deferred_destruction_queue.h"
 
 struct QueueFamilyIndices {
     std::optional<uint32_t> graphicsFamily;
@@ -60,10 +61,19 @@ public:
     // Queue capability queries
     bool hasDedicatedTransferQueue() const { return queueFamilyIndices.hasDirectTransfer(); }
     bool hasDedicatedComputeQueue() const { return queueFamilyIndices.hasDedicatedCompute(); }
+    
+    // VK_EXT_memory_budget: per-heap budget/usage through vkGetPhysicalDeviceMemoryProperties2
+    bool hasMemoryBudget() const { return memoryBudgetSupported; }
+    // Vulkan 1.2 bufferDeviceAddress: entity buffers get VkDeviceAddresses shaders can dereference
+    bool hasBufferDeviceAddress() const { return bufferDeviceAddressSupported; }
+    bool hasHostQueryReset() const { return hostQueryResetSupported; }
     const QueueFamilyIndices& getQueueFamilyIndices() const { return queueFamilyIndices; }
     
     class VulkanFunctionLoader& getLoader() const { return *loader; }
     
+    // Objects that frames in flight may still use are retired here instead of destroyed
+    DeferredDestructionQueue& getDeferredDestruction() const { return *deferredDestruction; }
+    
     QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device) const;
     void getDeviceQueues(); // Call this after device functions are loaded
 
@@ -79,8 +89,12 @@ private:
     VkQueue computeQueue = VK_NULL_HANDLE;
     VkQueue transferQueue = VK_NULL_HANDLE;
     QueueFamilyIndices queueFamilyIndices;
+    bool memoryBudgetSupported = false;
+    bool bufferDeviceAddressSupported = false;
+    bool hostQueryResetSupported = false;
 
     std::unique_ptr<class VulkanFunctionLoader> loader;
+    std::unique_ptr<DeferredDestructionQueue> deferredDestruction;
     vulkan_raii::DebugUtilsMessengerEXT debugMessenger;
 
     bool createInstance();
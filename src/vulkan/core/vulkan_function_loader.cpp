@@ -103,6 +103,9 @@ void VulkanFunctionLoader::loadPhysicalDeviceFunctions() {
     LOAD_INSTANCE_FUNCTION(vkGetPhysicalDeviceProperties);
     LOAD_INSTANCE_FUNCTION(vkGetPhysicalDeviceQueueFamilyProperties);
     LOAD_INSTANCE_FUNCTION(vkGetPhysicalDeviceMemoryProperties);
+    LOAD_INSTANCE_FUNCTION(vkGetPhysicalDeviceFormatProperties);
+    LOAD_INSTANCE_FUNCTION(vkGetPhysicalDeviceMemoryProperties2);
+    LOAD_INSTANCE_FUNCTION(vkGetPhysicalDeviceFeatures2);
     LOAD_INSTANCE_FUNCTION(vkGetPhysicalDeviceSurfaceSupportKHR);
     LOAD_INSTANCE_FUNCTION(vkGetPhysicalDeviceSurfaceCapabilitiesKHR);
     LOAD_INSTANCE_FUNCTION(vkGetPhysicalDeviceSurfaceFormatsKHR);
@@ -140,6 +143,7 @@ void VulkanFunctionLoader::loadBufferFunctions() {
     LOAD_DEVICE_FUNCTION(vkDestroyBuffer);
     LOAD_DEVICE_FUNCTION(vkGetBufferMemoryRequirements);
     LOAD_DEVICE_FUNCTION(vkBindBufferMemory);
+    LOAD_DEVICE_FUNCTION(vkGetBufferDeviceAddress);
 }
 
 void VulkanFunctionLoader::loadImageFunctions() {
@@ -198,6 +202,10 @@ void VulkanFunctionLoader::loadSynchronizationFunctions() {
     LOAD_DEVICE_FUNCTION(vkGetFenceStatus);
     LOAD_DEVICE_FUNCTION(vkCreateQueryPool);
     LOAD_DEVICE_FUNCTION(vkDestroyQueryPool);
+    LOAD_DEVICE_FUNCTION(vkGetQueryPoolResults);
+    LOAD_DEVICE_FUNCTION(vkCmdResetQueryPool);
+    LOAD_DEVICE_FUNCTION(vkResetQueryPool);
+    LOAD_DEVICE_FUNCTION(vkCmdWriteTimestamp2);
     
     // Vulkan 1.3 functions
     LOAD_DEVICE_FUNCTION(vkCmdBeginRendering);
@@ -233,7 +241,11 @@ void VulkanFunctionLoader::loadRenderingFunctions() {
     LOAD_DEVICE_FUNCTION(vkCmdPipelineBarrier);
     LOAD_DEVICE_FUNCTION(vkCmdPushConstants);
     LOAD_DEVICE_FUNCTION(vkCmdCopyBuffer);
+    LOAD_DEVICE_FUNCTION(vkCmdUpdateBuffer);
+    LOAD_DEVICE_FUNCTION(vkCmdFillBuffer);
     LOAD_DEVICE_FUNCTION(vkCmdCopyBufferToImage);
+    LOAD_DEVICE_FUNCTION(vkCmdBlitImage);
+    LOAD_DEVICE_FUNCTION(vkCmdExecuteCommands);
 }
 
 void VulkanFunctionLoader::loadQueueFunctions() {
@@ -44,6 +44,9 @@ public:
     PFN_vkGetPhysicalDeviceProperties vkGetPhysicalDeviceProperties = nullptr;
     PFN_vkGetPhysicalDeviceQueueFamilyProperties vkGetPhysicalDeviceQueueFamilyProperties = nullptr;
     PFN_vkGetPhysicalDeviceMemoryProperties vkGetPhysicalDeviceMemoryProperties = nullptr;
+    PFN_vkGetPhysicalDeviceFormatProperties vkGetPhysicalDeviceFormatProperties = nullptr;
+    PFN_vkGetPhysicalDeviceMemoryProperties2 vkGetPhysicalDeviceMemoryProperties2 = nullptr;
+    PFN_vkGetPhysicalDeviceFeatures2 vkGetPhysicalDeviceFeatures2 = nullptr;
     PFN_vkGetPhysicalDeviceSurfaceSupportKHR vkGetPhysicalDeviceSurfaceSupportKHR = nullptr;
     PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR vkGetPhysicalDeviceSurfaceCapabilitiesKHR = nullptr;
     PFN_vkGetPhysicalDeviceSurfaceFormatsKHR vkGetPhysicalDeviceSurfaceFormatsKHR = nullptr;
@@ -75,6 +78,7 @@ public:
     PFN_vkDestroyBuffer vkDestroyBuffer = nullptr;
     PFN_vkGetBufferMemoryRequirements vkGetBufferMemoryRequirements = nullptr;
     PFN_vkBindBufferMemory vkBindBufferMemory = nullptr;
+    PFN_vkGetBufferDeviceAddress vkGetBufferDeviceAddress = nullptr;
     
     // Image management
     PFN_vkCreateImage vkCreateImage = nullptr;
@@ -130,6 +134,10 @@ public:
     // Query pool functions
     PFN_vkCreateQueryPool vkCreateQueryPool = nullptr;
     PFN_vkDestroyQueryPool vkDestroyQueryPool = nullptr;
+    PFN_vkGetQueryPoolResults vkGetQueryPoolResults = nullptr;
+    PFN_vkCmdResetQueryPool vkCmdResetQueryPool = nullptr;
+    PFN_vkResetQueryPool vkResetQueryPool = nullptr;
+    PFN_vkCmdWriteTimestamp2 vkCmdWriteTimestamp2 = nullptr;
     
     // Vulkan 1.3 Dynamic Rendering functions
     PFN_vkCmdBeginRendering vkCmdBeginRendering = nullptr;
@@ -165,7 +173,11 @@ public:
     PFN_vkCmdPipelineBarrier vkCmdPipelineBarrier = nullptr;
     PFN_vkCmdPushConstants vkCmdPushConstants = nullptr;
     PFN_vkCmdCopyBuffer vkCmdCopyBuffer = nullptr;
+    PFN_vkCmdUpdateBuffer vkCmdUpdateBuffer = nullptr;
+    PFN_vkCmdFillBuffer vkCmdFillBuffer = nullptr;
     PFN_vkCmdCopyBufferToImage vkCmdCopyBufferToImage = nullptr;
+    PFN_vkCmdBlitImage vkCmdBlitImage = nullptr;
+    PFN_vkCmdExecuteCommands vkCmdExecuteCommands = nullptr;
     
     // Queue functions
     PFN_vkQueueSubmit vkQueueSubmit = nullptr;
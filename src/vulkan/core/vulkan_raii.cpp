@@ -1,6 +1,7 @@
 #include "vulkan_raii.h"
 #include "vulkan_context.h"
 #include "vulkan_function_loader.h"
+#include "../monitoring/memory_accounting.h"
 
 namespace vulkan_raii {
 
@@ -50,6 +51,7 @@ struct DeviceMemoryDeleterImpl : VulkanDeleter {
     
     void operator()(VkDeviceMemory handle) {
         if (context && handle != VK_NULL_HANDLE) {
+            MemoryAccounting::getInstance().trackDeviceFree(handle);
             context->getLoader().vkFreeMemory(context->getDevice(), handle, nullptr);
         }
     }
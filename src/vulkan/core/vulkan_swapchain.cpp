@@ -2,9 +2,9 @@
 #include "vulkan_function_loader.h"
 #include "vulkan_utils.h"
 #include "vulkan_constants.h"
+#include "../monitoring/memory_accounting.h"
 #include <iostream>
 #include <algorithm>
-#include <array>
 
 VulkanSwapchain::VulkanSwapchain() {
 }
@@ -42,11 +42,13 @@ void VulkanSwapchain::cleanup() {
 
 void VulkanSwapchain::cleanupBeforeContextDestruction() {
     // Clear RAII wrappers before context destruction
-    swapChainFramebuffers.clear();
     swapChainImageViews.clear();
     msaaColorImageView.reset();
     msaaColorImage.reset();
     msaaColorImageMemory.reset();
+    offscreenColorImageView.reset();
+    offscreenColorImage.reset();
+    offscreenColorImageMemory.reset();
     
     // Manual cleanup for non-RAII managed resources
     if (context && swapChain != VK_NULL_HANDLE) {
@@ -66,16 +68,8 @@ std::vector<VkImageView> VulkanSwapchain::getImageViews() const {
     return views;
 }
 
-std::vector<VkFramebuffer> VulkanSwapchain::getFramebuffers() const {
-    std::vector<VkFramebuffer> framebuffers;
-    framebuffers.reserve(swapChainFramebuffers.size());
-    for (const auto& fb : swapChainFramebuffers) {
-        framebuffers.push_back(fb.get());
-    }
-    return framebuffers;
-}
 
-bool VulkanSwapchain::recreate(VkRenderPass renderPass) {
+bool VulkanSwapchain::recreate() {
     int width = 0, height = 0;
     SDL_GetWindowSizeInPixels(window, &width, &height);
     
@@ -87,29 +81,24 @@ bool VulkanSwapchain::recreate(VkRenderPass renderPass) {
     // Store old swapchain for proper recreation
     VkSwapchainKHR oldSwapchain = swapChain;
     
-    // Clean up everything except the old swapchain itself
-    cleanupSwapChainExceptSwapchain();
+    // Frames in flight still render to and present the old images; everything is retired rather
+    // than destroyed, so recreation never waits on the GPU
+    retireSwapChainResources();
 
-    if (!createSwapChain(oldSwapchain)) {
-        std::cerr << "Failed to recreate swap chain!" << std::endl;
-        // Cache loader and device references for performance
-        const auto& vk = context->getLoader();
-        const VkDevice device = context->getDevice();
-        
-        // If creation failed, we still need to clean up the old swapchain
-        if (oldSwapchain != VK_NULL_HANDLE) {
-            vk.vkDestroySwapchainKHR(device, oldSwapchain, nullptr);
-        }
-        return false;
-    }
-    
-    // Cache loader and device references for performance
-    const auto& vk = context->getLoader();
-    const VkDevice device = context->getDevice();
+    const bool created = createSwapChain(oldSwapchain);
     
-    // Now destroy the old swapchain after successful recreation
+    // The old swapchain goes once its last frame completes, whether or not creation succeeded
     if (oldSwapchain != VK_NULL_HANDLE) {
-        vk.vkDestroySwapchainKHR(device, oldSwapchain, nullptr);
+        const VulkanContext* ctx = context;
+        context->getDeferredDestruction().retireCallback([ctx, oldSwapchain]() {
+            ctx->getLoader().vkDestroySwapchainKHR(ctx->getDevice(), oldSwapchain, nullptr);
+        });
+    }
+    
+    if (!created) {
+        std::cerr << "Failed to recreate swap chain!" << std::endl;
+        swapChain = VK_NULL_HANDLE;
+        return false;
     }
     
     if (!createImageViews()) {
@@ -122,11 +111,6 @@ bool VulkanSwapchain::recreate(VkRenderPass renderPass) {
         std::cerr << "Failed to recreate MSAA color resources!" << std::endl;
         return false;
     }
-    
-    if (!createFramebuffers(renderPass)) {
-        std::cerr << "Failed to recreate framebuffers!" << std::endl;
-        return false;
-    }
 
     return true;
 }
@@ -163,6 +147,17 @@ bool VulkanSwapchain::createSwapChain(VkSwapchainKHR oldSwapchainKHR) {
     createInfo.imageExtent = extent;
     createInfo.imageArrayLayers = 1;
     createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    
+    // Scaled rendering blits into the swapchain image, when the surface and format allow it
+    VkFormatProperties formatProperties{};
+    context->getLoader().vkGetPhysicalDeviceFormatProperties(context->getPhysicalDevice(), surfaceFormat.format, &formatProperties);
+    const VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                              VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    upscaleBlitSupported = (swapChainSupport.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT) &&
+                           (formatProperties.optimalTilingFeatures & blitFeatures) == blitFeatures;
+    if (upscaleBlitSupported) {
+        createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    }
 
     // Use cached queue family indices instead of re-querying during swapchain recreation
     const QueueFamilyIndices& indices = context->getQueueFamilyIndices();
@@ -235,6 +230,11 @@ bool VulkanSwapchain::createImageViews() {
 
 
 bool VulkanSwapchain::createMSAAColorResources() {
+    // Single-sample rendering writes the target directly
+    if (msaaSamples == VK_SAMPLE_COUNT_1_BIT) {
+        return true;
+    }
+    
     VkFormat colorFormat = swapChainImageFormat;
     
     VkImage image;
@@ -242,10 +242,16 @@ bool VulkanSwapchain::createMSAAColorResources() {
     if (!VulkanUtils::createImage(context->getDevice(), context->getPhysicalDevice(), context->getLoader(),
                             swapChainExtent.width, swapChainExtent.height, colorFormat, VK_IMAGE_TILING_OPTIMAL,
                             VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
-                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, memory, VK_SAMPLE_COUNT_2_BIT)) {
+                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, memory, msaaSamples)) {
         return false;
     }
     
+    VkMemoryRequirements memRequirements;
+    context->getLoader().vkGetImageMemoryRequirements(context->getDevice(), image, &memRequirements);
+    uint32_t memoryType = VulkanUtils::findMemoryType(context->getPhysicalDevice(), context->getLoader(),
+                                                      memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    MemoryAccounting::getInstance().trackDeviceAllocation(memory, memRequirements.size, memoryType, GpuMemoryCategory::Attachments);
+    
     msaaColorImage = vulkan_raii::make_image(image, context);
     msaaColorImageMemory = vulkan_raii::make_device_memory(memory, context);
     
@@ -259,17 +265,78 @@ bool VulkanSwapchain::createMSAAColorResources() {
     return true;
 }
 
+bool VulkanSwapchain::createOffscreenColorResources() {
+    VkImage image;
+    VkDeviceMemory memory;
+    if (!VulkanUtils::createImage(context->getDevice(), context->getPhysicalDevice(), context->getLoader(),
+                            swapChainExtent.width, swapChainExtent.height, swapChainImageFormat, VK_IMAGE_TILING_OPTIMAL,
+                            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, memory)) {
+        return false;
+    }
+    
+    VkMemoryRequirements memRequirements;
+    context->getLoader().vkGetImageMemoryRequirements(context->getDevice(), image, &memRequirements);
+    uint32_t memoryType = VulkanUtils::findMemoryType(context->getPhysicalDevice(), context->getLoader(),
+                                                      memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    MemoryAccounting::getInstance().trackDeviceAllocation(memory, memRequirements.size, memoryType, GpuMemoryCategory::Attachments);
+    
+    offscreenColorImage = vulkan_raii::make_image(image, context);
+    offscreenColorImageMemory = vulkan_raii::make_device_memory(memory, context);
+    
+    VkImageView imageView = VulkanUtils::createImageView(context->getDevice(), context->getLoader(), offscreenColorImage.get(), swapChainImageFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+    if (imageView == VK_NULL_HANDLE) {
+        return false;
+    }
+    
+    offscreenColorImageView = vulkan_raii::make_image_view(imageView, context);
+    return true;
+}
+
+bool VulkanSwapchain::prepareRenderTargets(VkSampleCountFlagBits samples, bool offscreen) {
+    if (samples != msaaSamples) {
+        retireTarget(msaaColorImage, msaaColorImageMemory, msaaColorImageView);
+        msaaSamples = samples;
+        if (!createMSAAColorResources()) {
+            std::cerr << "VulkanSwapchain: Failed to create " << static_cast<uint32_t>(samples) << "x MSAA color target" << std::endl;
+            return false;
+        }
+    }
+    
+    if (offscreen && !offscreenColorImage) {
+        if (!upscaleBlitSupported || !createOffscreenColorResources()) {
+            std::cerr << "VulkanSwapchain: Offscreen color target unavailable" << std::endl;
+            return false;
+        }
+    } else if (!offscreen && offscreenColorImage) {
+        retireTarget(offscreenColorImage, offscreenColorImageMemory, offscreenColorImageView);
+    }
+    return true;
+}
+
+void VulkanSwapchain::retireTarget(vulkan_raii::Image& image, vulkan_raii::DeviceMemory& memory, vulkan_raii::ImageView& view) {
+    if (!image) {
+        return;
+    }
+    RetiredTarget retired;
+    retired.memory = std::move(memory);
+    retired.image = std::move(image);
+    retired.view = std::move(view);
+    context->getDeferredDestruction().retire(std::move(retired));
+}
+
 void VulkanSwapchain::cleanupSwapChain() {
     // Cache loader and device references for performance
     const auto& vk = context->getLoader();
     const VkDevice device = context->getDevice();
     
     // RAII wrappers handle automatic cleanup
-    swapChainFramebuffers.clear();
-    
     msaaColorImageView.reset();
     msaaColorImage.reset();
     msaaColorImageMemory.reset();
+    offscreenColorImageView.reset();
+    offscreenColorImage.reset();
+    offscreenColorImageMemory.reset();
     
     swapChainImageViews.clear();
     
@@ -279,34 +346,17 @@ void VulkanSwapchain::cleanupSwapChain() {
     }
 }
 
-void VulkanSwapchain::cleanupSwapChainExceptSwapchain() {
-    std::cout << "VulkanSwapchain: Starting cleanup of swapchain resources (except swapchain handle)" << std::endl;
+void VulkanSwapchain::retireSwapChainResources() {
+    DeferredDestructionQueue& deferred = context->getDeferredDestruction();
+    std::cout << "VulkanSwapchain: Retiring " << swapChainImageViews.size() << " image views" << std::endl;
     
-    // Cleanup framebuffers - RAII handles destruction
-    std::cout << "VulkanSwapchain: Destroying " << swapChainFramebuffers.size() << " framebuffers" << std::endl;
-    swapChainFramebuffers.clear();
+    // MSAA target at the new extent is recreated below; the offscreen one on the next scaled frame
+    retireTarget(msaaColorImage, msaaColorImageMemory, msaaColorImageView);
+    retireTarget(offscreenColorImage, offscreenColorImageMemory, offscreenColorImageView);
     
-    // Cleanup MSAA resources - CRITICAL for memory leak detection - RAII handles destruction
-    if (msaaColorImageView) {
-        std::cout << "VulkanSwapchain: Destroying MSAA color image view" << std::endl;
-        msaaColorImageView.reset();
-    }
-    if (msaaColorImage) {
-        std::cout << "VulkanSwapchain: Destroying MSAA color image" << std::endl;
-        msaaColorImage.reset();
-    }
-    if (msaaColorImageMemory) {
-        std::cout << "VulkanSwapchain: CRITICAL - Freeing MSAA color image memory" << std::endl;
-        msaaColorImageMemory.reset();
-        std::cout << "VulkanSwapchain: MSAA memory successfully freed" << std::endl;
-    }
-    
-    // Cleanup swapchain image views - RAII handles destruction
-    std::cout << "VulkanSwapchain: Destroying " << swapChainImageViews.size() << " image views" << std::endl;
+    deferred.retire(std::move(swapChainImageViews));
     swapChainImageViews.clear();
-    
-    std::cout << "VulkanSwapchain: Cleanup completed successfully" << std::endl;
-    // Note: We deliberately do NOT destroy the swapchain here - that's handled separately
+    // Note: We deliberately do NOT retire the swapchain here - that's handled separately
 }
 
 SwapChainSupportDetails VulkanSwapchain::querySwapChainSupport(VkPhysicalDevice device) {
@@ -386,36 +436,4 @@ VkExtent2D VulkanSwapchain::chooseSwapExtent(const VkSurfaceCapabilitiesKHR& cap
 
         return actualExtent;
     }
-}
-
-
-bool VulkanSwapchain::createFramebuffers(VkRenderPass renderPass) {
-    swapChainFramebuffers.clear();
-    swapChainFramebuffers.reserve(swapChainImageViews.size());
-    
-    for (size_t i = 0; i < swapChainImageViews.size(); i++) {
-        std::array<VkImageView, 2> attachments = {
-            msaaColorImageView.get(),      
-            swapChainImageViews[i].get()
-        };
-        
-        VkFramebufferCreateInfo framebufferInfo{};
-        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-        framebufferInfo.renderPass = renderPass;
-        framebufferInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
-        framebufferInfo.pAttachments = attachments.data();
-        framebufferInfo.width = swapChainExtent.width;
-        framebufferInfo.height = swapChainExtent.height;
-        framebufferInfo.layers = 1;
-
-        VkFramebuffer framebuffer;
-        if (context->getLoader().vkCreateFramebuffer(context->getDevice(), &framebufferInfo, nullptr, &framebuffer) != VK_SUCCESS) {
-            std::cerr << "Failed to create framebuffer" << std::endl;
-            return false;
-        }
-        
-        swapChainFramebuffers.emplace_back(vulkan_raii::make_framebuffer(framebuffer, context));
-    }
-
-    return true;
 }
\ No newline at end of file
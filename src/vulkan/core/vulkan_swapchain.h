@@ -21,7 +21,7 @@ public:
 
     bool initialize(const VulkanContext& context, SDL_Window* window);
     void cleanup();
-    bool recreate(VkRenderPass renderPass);
+    bool recreate();
     
     // Explicit cleanup before context destruction
     void cleanupBeforeContextDestruction();
@@ -34,9 +34,18 @@ public:
     
     VkImage getMSAAColorImage() const { return msaaColorImage.get(); }
     VkImageView getMSAAColorImageView() const { return msaaColorImageView.get(); }
-    std::vector<VkFramebuffer> getFramebuffers() const;
+    VkSampleCountFlagBits getMSAASamples() const { return msaaSamples; }
     
-    bool createFramebuffers(VkRenderPass renderPass);
+    // Entity pass targets: MSAA color at the requested sample count (none at 1x) and, when offscreen,
+    // a single-sample color target that scaled frames render into and blit up to the swapchain image.
+    // Both cover the full extent, so render scale changes only move the render area. Replaced targets
+    // go to the context's deferred destruction queue; call once per frame before recording
+    bool prepareRenderTargets(VkSampleCountFlagBits samples, bool offscreen);
+    VkImage getOffscreenColorImage() const { return offscreenColorImage.get(); }
+    VkImageView getOffscreenColorImageView() const { return offscreenColorImageView.get(); }
+    
+    // Swapchain images accept transfer writes and the format supports linear blits
+    bool supportsUpscaleBlit() const { return upscaleBlitSupported; }
 
 private:
     const VulkanContext* context = nullptr;
@@ -52,15 +61,27 @@ private:
     vulkan_raii::Image msaaColorImage;
     vulkan_raii::DeviceMemory msaaColorImageMemory;
     vulkan_raii::ImageView msaaColorImageView;
+    VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_2_BIT;
+    
+    vulkan_raii::Image offscreenColorImage;
+    vulkan_raii::DeviceMemory offscreenColorImageMemory;
+    vulkan_raii::ImageView offscreenColorImageView;
+    bool upscaleBlitSupported = false;
+    
+    // Members destroy in reverse order: view, image, then memory
+    struct RetiredTarget {
+        vulkan_raii::DeviceMemory memory;
+        vulkan_raii::Image image;
+        vulkan_raii::ImageView view;
+    };
     
-    std::vector<vulkan_raii::Framebuffer> swapChainFramebuffers;
-
-
     bool createSwapChain(VkSwapchainKHR oldSwapchainKHR = VK_NULL_HANDLE);
     bool createImageViews();
     bool createMSAAColorResources();
+    bool createOffscreenColorResources();
+    void retireTarget(vulkan_raii::Image& image, vulkan_raii::DeviceMemory& memory, vulkan_raii::ImageView& view);
     void cleanupSwapChain();
-    void cleanupSwapChainExceptSwapchain();
+    void retireSwapChainResources();
     
     SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
     VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats);
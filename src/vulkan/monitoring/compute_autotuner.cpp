@@ -0,0 +1,323 @@
+#include "compute_autotuner.h"
+#include "compute_stress_tester.h"
+#include "../core/vulkan_context.h"
+#include "../core/vulkan_constants.h"
+#include "../pipelines/compute_pipeline_manager.h"
+#include "../pipelines/compute_device_info.h"
+#include "../pipelines/descriptor_layout_manager.h"
+#include "../nodes/collision_node.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    constexpr const char* WORKGROUP_SIZE_KEY = "workgroup_size";
+    constexpr const char* CHUNK_SIZE_KEY = "max_workgroups_per_chunk";
+    constexpr const char* TIME_KEY = "time_ms";
+
+    using TuningSections = std::map<std::string, std::map<std::string, std::string>>;
+
+    std::string trim(const std::string& text) {
+        size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return {};
+        size_t last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+
+    TuningSections readSections(const std::string& path) {
+        TuningSections sections;
+        std::ifstream file(path);
+        std::string section;
+        std::string line;
+        while (std::getline(file, line)) {
+            size_t comment = line.find('#');
+            if (comment != std::string::npos) {
+                line.erase(comment);
+            }
+            line = trim(line);
+            if (line.empty()) continue;
+
+            if (line.front() == '[' && line.back() == ']') {
+                section = trim(line.substr(1, line.size() - 2));
+                continue;
+            }
+
+            size_t equals = line.find('=');
+            if (equals != std::string::npos && !section.empty()) {
+                sections[section][trim(line.substr(0, equals))] = trim(line.substr(equals + 1));
+            }
+        }
+        return sections;
+    }
+
+    uint32_t divideRoundUp(uint32_t value, uint32_t divisor) {
+        return (value + divisor - 1) / divisor;
+    }
+}
+
+ComputeAutotuner::ComputeAutotuner(const VulkanContext* context, ComputePipelineManager* computeManager)
+    : context(context)
+    , computeManager(computeManager) {
+    if (!context) {
+        throw std::invalid_argument("ComputeAutotuner: context cannot be null");
+    }
+    if (!computeManager) {
+        throw std::invalid_argument("ComputeAutotuner: computeManager cannot be null");
+    }
+}
+
+void ComputeAutotuner::setCollisionBuffers(VkBuffer spatialMapBuffer, VkBuffer collisionPairBuffer) {
+    this->spatialMapBuffer = spatialMapBuffer;
+    this->collisionPairBuffer = collisionPairBuffer;
+}
+
+bool ComputeAutotuner::loadOrTune(const std::string& path, VkDescriptorSet descriptorSet, uint32_t maxEntityCount) {
+    const char* autotuneEnv = std::getenv("FRACTALIA_AUTOTUNE");
+    const std::string autotuneMode = autotuneEnv ? autotuneEnv : "";
+
+    if (autotuneMode != "1" && loadResults(path)) {
+        return true;
+    }
+    if (autotuneMode == "0") {
+        std::cout << "ComputeAutotuner: Tuning disabled by FRACTALIA_AUTOTUNE=0, using defaults" << std::endl;
+        return false;
+    }
+
+    if (tune(descriptorSet, maxEntityCount).empty()) {
+        return false;
+    }
+    return saveResults(path);
+}
+
+const std::vector<ComputeAutotuner::Result>& ComputeAutotuner::tune(
+    VkDescriptorSet descriptorSet, uint32_t maxEntityCount, const Config& config) {
+    results.clear();
+    if (descriptorSet == VK_NULL_HANDLE || maxEntityCount == 0) {
+        std::cerr << "ComputeAutotuner: Nothing to tune against" << std::endl;
+        return results;
+    }
+
+    auto layoutSpec = DescriptorLayoutPresets::createEntityIndexedLayout();
+    VkDescriptorSetLayout descriptorLayout = computeManager->getLayoutManager()->getLayout(layoutSpec);
+    if (descriptorLayout == VK_NULL_HANDLE) {
+        std::cerr << "ComputeAutotuner: Failed to get entity descriptor layout" << std::endl;
+        return results;
+    }
+
+    std::vector<uint32_t> entityCounts;
+    for (uint32_t count : config.entityCounts) {
+        entityCounts.push_back(std::min(count, maxEntityCount));
+    }
+    std::sort(entityCounts.begin(), entityCounts.end());
+    entityCounts.erase(std::unique(entityCounts.begin(), entityCounts.end()), entityCounts.end());
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    std::cout << "ComputeAutotuner: Tuning for " << getDeviceKey() << std::endl;
+
+    ComputeStressTester tester(context, computeManager);
+    if (!tester.hasGPUTimestamps()) {
+        std::cout << "ComputeAutotuner: No GPU timestamps, measuring wall-clock time" << std::endl;
+    }
+
+    const ComputeVariantRegistry* variants = computeManager->getVariantRegistry();
+    const ComputeShaderVariant& baseVariant = variants->getActiveVariant();
+
+    for (const TuningTarget& target : getTuningTargets()) {
+        Result best{};
+        best.dispatchName = target.dispatchName;
+        best.timeMs = -1.0f;
+        best.baselineTimeMs = -1.0f;
+
+        for (uint32_t workgroupSize : config.workgroupSizes) {
+            ComputeShaderVariant variant = baseVariant;
+            variant.workgroupSize = workgroupSize;
+
+            std::string errorMessage;
+            if (!variants->validateVariant(variant, errorMessage)) {
+                continue;
+            }
+            ComputeStressTester::DispatchRecorder recorder;
+            if (target.recordPasses) {
+                recorder = [&target, variant](VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t entityCount) {
+                    target.recordPasses(cmd, layout, variant, entityCount);
+                };
+            }
+            if (!tester.setDispatchTarget(target.createState(descriptorLayout, variant), descriptorSet, recorder)) {
+                continue;
+            }
+
+            // Chunk sizes at or above the largest dispatch all mean "one chunk" - measure that once
+            const uint32_t largestDispatch = divideRoundUp(entityCounts.back(), workgroupSize);
+            std::vector<uint32_t> chunkSizes;
+            if (!target.recordPasses) {
+                for (uint32_t chunkSize : config.chunkSizes) {
+                    chunkSizes.push_back(std::min(chunkSize, largestDispatch));
+                }
+            }
+            if (workgroupSize == THREADS_PER_WORKGROUP || target.recordPasses) {
+                chunkSizes.push_back(std::min(MAX_WORKGROUPS_PER_CHUNK, largestDispatch));
+            }
+            std::sort(chunkSizes.begin(), chunkSizes.end());
+            chunkSizes.erase(std::unique(chunkSizes.begin(), chunkSizes.end()), chunkSizes.end());
+
+            for (uint32_t chunkSize : chunkSizes) {
+                float totalTimeMs = 0.0f;
+                bool measured = true;
+                for (uint32_t entityCount : entityCounts) {
+                    const uint32_t workgroupCount = divideRoundUp(entityCount, workgroupSize);
+                    float timeMs = 0.0f;
+                    if (!tester.measureDispatch(workgroupCount, entityCount, chunkSize, config.iterations, timeMs)) {
+                        measured = false;
+                        break;
+                    }
+                    totalTimeMs += timeMs;
+                }
+
+                if (!measured) {
+                    std::cerr << "ComputeAutotuner: " << target.dispatchName << " failed at workgroup size "
+                              << workgroupSize << ", chunk " << chunkSize << std::endl;
+                    continue;
+                }
+
+                if (best.timeMs < 0.0f || totalTimeMs < best.timeMs) {
+                    best.timeMs = totalTimeMs;
+                    best.params = {workgroupSize, chunkSize};
+                }
+                if (workgroupSize == THREADS_PER_WORKGROUP &&
+                    chunkSize == std::min(MAX_WORKGROUPS_PER_CHUNK, largestDispatch)) {
+                    best.baselineTimeMs = totalTimeMs;
+                }
+            }
+        }
+        tester.clearDispatchTarget();
+
+        if (best.timeMs < 0.0f) {
+            std::cerr << "ComputeAutotuner: No valid configuration for " << target.dispatchName << std::endl;
+            continue;
+        }
+
+        // Within noise of the defaults - keep them so results stay stable across runs
+        if (best.baselineTimeMs >= 0.0f && best.timeMs > best.baselineTimeMs * (1.0f - config.minImprovement)) {
+            best.params = TunedDispatchParams{};
+            best.timeMs = best.baselineTimeMs;
+        }
+
+        std::cout << "ComputeAutotuner: " << best.dispatchName << " -> workgroup size " << best.params.workgroupSize
+                  << ", " << best.params.maxWorkgroupsPerChunk << " workgroups/chunk (" << best.timeMs
+                  << "ms vs " << best.baselineTimeMs << "ms default)" << std::endl;
+
+        if (applyResult(best)) {
+            results.push_back(best);
+        }
+    }
+
+    tester.cleanupBeforeContextDestruction();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startTime);
+    std::cout << "ComputeAutotuner: Tuned " << results.size() << " pipeline(s) in " << elapsed.count() << "ms" << std::endl;
+    return results;
+}
+
+bool ComputeAutotuner::loadResults(const std::string& path) {
+    TuningSections sections = readSections(path);
+    auto section = sections.find(getDeviceKey());
+    if (section == sections.end()) {
+        std::cout << "ComputeAutotuner: No tuning for this device in " << path << std::endl;
+        return false;
+    }
+
+    std::map<std::string, Result> parsed;
+    for (const auto& [key, value] : section->second) {
+        size_t dot = key.rfind('.');
+        if (dot == std::string::npos) continue;
+
+        Result& result = parsed[key.substr(0, dot)];
+        result.dispatchName = key.substr(0, dot);
+        const std::string field = key.substr(dot + 1);
+        if (field == WORKGROUP_SIZE_KEY) {
+            result.params.workgroupSize = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (field == CHUNK_SIZE_KEY) {
+            result.params.maxWorkgroupsPerChunk = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (field == TIME_KEY) {
+            result.timeMs = std::strtof(value.c_str(), nullptr);
+        }
+    }
+
+    results.clear();
+    for (const auto& [name, result] : parsed) {
+        if (applyResult(result)) {
+            results.push_back(result);
+        }
+    }
+
+    std::cout << "ComputeAutotuner: Applied " << results.size() << " tuned pipeline(s) from " << path << std::endl;
+    return !results.empty();
+}
+
+bool ComputeAutotuner::saveResults(const std::string& path) const {
+    // Keep other devices' sections so one file can travel between machines
+    TuningSections sections = readSections(path);
+    auto& section = sections[getDeviceKey()];
+    section.clear();
+    for (const Result& result : results) {
+        section[result.dispatchName + "." + WORKGROUP_SIZE_KEY] = std::to_string(result.params.workgroupSize);
+        section[result.dispatchName + "." + CHUNK_SIZE_KEY] = std::to_string(result.params.maxWorkgroupsPerChunk);
+        section[result.dispatchName + "." + TIME_KEY] = std::to_string(result.timeMs);
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "ComputeAutotuner: Failed to write " << path << std::endl;
+        return false;
+    }
+
+    file << "# Compute dispatch tuning, one section per device. Delete a section or run with FRACTALIA_AUTOTUNE=1 to retune\n";
+    for (const auto& [name, values] : sections) {
+        file << "\n[" << name << "]\n";
+        for (const auto& [key, value] : values) {
+            file << key << " = " << value << "\n";
+        }
+    }
+
+    std::cout << "ComputeAutotuner: Saved tuning to " << path << std::endl;
+    return file.good();
+}
+
+std::string ComputeAutotuner::getDeviceKey() const {
+    // Driver updates change codegen, so they invalidate tuning as well
+    const VkPhysicalDeviceProperties& props = computeManager->getDeviceInfo()->getDeviceProperties();
+    std::ostringstream key;
+    key << props.deviceName << " " << std::hex << props.vendorID << ":" << props.deviceID
+        << std::dec << " driver " << props.driverVersion;
+    return key.str();
+}
+
+std::vector<ComputeAutotuner::TuningTarget> ComputeAutotuner::getTuningTargets() const {
+    std::vector<TuningTarget> targets = {
+        {"EntityMovement", [](VkDescriptorSetLayout layout, const ComputeShaderVariant& variant) {
+            return ComputePipelinePresets::createEntityMovementState(layout, variant);
+        }, {}},
+        {"Physics", [](VkDescriptorSetLayout layout, const ComputeShaderVariant& variant) {
+            return ComputePipelinePresets::createPhysicsState(layout, variant);
+        }, {}},
+    };
+
+    if (spatialMapBuffer != VK_NULL_HANDLE && collisionPairBuffer != VK_NULL_HANDLE) {
+        targets.push_back({CollisionNode::DISPATCH_NAME, [](VkDescriptorSetLayout layout, const ComputeShaderVariant& variant) {
+            return ComputePipelinePresets::createCollisionState(layout, variant);
+        }, [this](VkCommandBuffer cmd, VkPipelineLayout layout, const ComputeShaderVariant& variant, uint32_t entityCount) {
+            CollisionNode::recordPasses(cmd, context, layout, variant, spatialMapBuffer, collisionPairBuffer, entityCount);
+        }});
+    }
+    return targets;
+}
+
+bool ComputeAutotuner::applyResult(const Result& result) {
+    return computeManager->getVariantRegistry()->setTunedDispatch(result.dispatchName, result.params);
+}
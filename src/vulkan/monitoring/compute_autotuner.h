@@ -0,0 +1,81 @@
+#pragma once
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include "../pipelines/compute_pipeline_types.h"
+#include "../pipelines/compute_pipeline_variants.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class VulkanContext;
+class ComputePipelineManager;
+
+/**
+ * Compute Autotuner - sweeps workgroup and chunk sizes for the entity compute pipelines
+ * with ComputeStressTester and keeps the fastest shape per device.
+ *
+ * Results persist in an INI-style file with one section per device, so a shared file
+ * can hold tuning for several GPUs:
+ *
+ *     [NVIDIA GeForce RTX 3070 10de:2484 driver 2262106112]
+ *     EntityMovement.workgroup_size = 128
+ *     EntityMovement.max_workgroups_per_chunk = 1024
+ *
+ * Applied results go to ComputeVariantRegistry, where BaseComputeNode and CollisionNode pick
+ * them up by dispatch name. The collision passes are not chunked, so only their workgroup size
+ * is swept. FRACTALIA_AUTOTUNE=1 forces a new sweep, FRACTALIA_AUTOTUNE=0 disables it.
+ */
+class ComputeAutotuner {
+public:
+    struct Config {
+        std::vector<uint32_t> workgroupSizes{32, 64, 128, 256};
+        std::vector<uint32_t> chunkSizes{256, 512, 1024, 4096, 65535};
+        std::vector<uint32_t> entityCounts{16384, 65536, 131072};  // Clamped to buffer capacity
+        uint32_t iterations = 5;
+        float minImprovement = 0.02f;  // Keep defaults unless the winner beats them by this fraction
+    };
+
+    struct Result {
+        std::string dispatchName;
+        TunedDispatchParams params;
+        float timeMs = 0.0f;          // Summed median time over the representative entity counts
+        float baselineTimeMs = 0.0f;  // Same, for THREADS_PER_WORKGROUP / MAX_WORKGROUPS_PER_CHUNK
+    };
+
+    ComputeAutotuner(const VulkanContext* context, ComputePipelineManager* computeManager);
+
+    // Scratch the collision passes reset before each run; collision is only tuned once these are set
+    void setCollisionBuffers(VkBuffer spatialMapBuffer, VkBuffer collisionPairBuffer);
+
+    // Applies stored tuning for this device, sweeping and saving first when there is none
+    bool loadOrTune(const std::string& path, VkDescriptorSet descriptorSet, uint32_t maxEntityCount);
+
+    // Sweeps every target and applies the winners. descriptorSet must use the entity indexed layout;
+    // the sweep overwrites the first maxEntityCount entries of its buffers
+    const std::vector<Result>& tune(VkDescriptorSet descriptorSet, uint32_t maxEntityCount, const Config& config = Config{});
+
+    bool loadResults(const std::string& path);
+    bool saveResults(const std::string& path) const;
+
+    std::string getDeviceKey() const;
+    const std::vector<Result>& getResults() const { return results; }
+
+private:
+    struct TuningTarget {
+        const char* dispatchName;   // Must match the dispatch name the node looks its tuning up by
+        std::function<ComputePipelineState(VkDescriptorSetLayout, const ComputeShaderVariant&)> createState;
+        // Multi-pass targets record themselves and skip the chunk sweep; empty for chunked dispatches
+        std::function<void(VkCommandBuffer, VkPipelineLayout, const ComputeShaderVariant&, uint32_t)> recordPasses;
+    };
+
+    const VulkanContext* context;
+    ComputePipelineManager* computeManager;
+    std::vector<Result> results;
+    VkBuffer spatialMapBuffer = VK_NULL_HANDLE;
+    VkBuffer collisionPairBuffer = VK_NULL_HANDLE;
+
+    std::vector<TuningTarget> getTuningTargets() const;
+    bool applyResult(const Result& result);
+};
@@ -3,13 +3,18 @@
 #include "../core/vulkan_function_loader.h"
 #include "../core/vulkan_constants.h"
 #include "../pipelines/compute_pipeline_manager.h"
+#include "../pipelines/compute_pipeline_types.h"
+#include "../rendering/frame_graph_types.h"
 #include "gpu_timeout_detector.h"
 #include "gpu_memory_monitor.h"
 #include "../pipelines/descriptor_layout_manager.h"
 #include <iostream>
+#include <algorithm>
+#include <numeric>
 #include <chrono>
 #include <random>
 #include <thread>
+#include <utility>
 
 ComputeStressTester::ComputeStressTester(
     const VulkanContext* context,
@@ -145,9 +150,19 @@ bool ComputeStressTester::executeComputeDispatch(uint32_t workgroupCount, float&
         return false;
     }
     
+    const bool useTimestamps = hasGPUTimestamps();
+    if (useTimestamps) {
+        vk.vkCmdResetQueryPool(testCommandBuffer, timestampQueryPool.get(), 0, 2);
+        vk.vkCmdWriteTimestamp2(testCommandBuffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, timestampQueryPool.get(), 0);
+    }
+    
     // Record dispatch
     recordTestDispatch(testCommandBuffer, workgroupCount);
     
+    if (useTimestamps) {
+        vk.vkCmdWriteTimestamp2(testCommandBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, timestampQueryPool.get(), 1);
+    }
+    
     result = vk.vkEndCommandBuffer(testCommandBuffer);
     if (result != VK_SUCCESS) {
         handleTestFailure("vkEndCommandBuffer", result);
@@ -188,6 +203,12 @@ bool ComputeStressTester::executeComputeDispatch(uint32_t workgroupCount, float&
     auto durationUs = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
     executionTimeMs = durationUs.count() / 1000.0f;
     
+    // Prefer GPU time - wall clock includes submission and fence latency
+    float gpuTimeMs = 0.0f;
+    if (useTimestamps && readDispatchTimestamps(gpuTimeMs)) {
+        executionTimeMs = gpuTimeMs;
+    }
+    
     if (timeoutDetector) {
         timeoutDetector->endComputeDispatch();
     }
@@ -197,13 +218,156 @@ bool ComputeStressTester::executeComputeDispatch(uint32_t workgroupCount, float&
 }
 
 void ComputeStressTester::recordTestDispatch(VkCommandBuffer cmd, uint32_t workgroupCount) {
-    // This would record the actual compute dispatch
-    // For now, just record a simple dispatch command
+    if (dispatchTarget.pipeline == VK_NULL_HANDLE) {
+        std::cout << "ComputeStressTester: No dispatch target set, skipping " << workgroupCount << " workgroups" << std::endl;
+        return;
+    }
     
-    // TODO: Implement actual pipeline binding and dispatch recording
-    // This would need access to the entity movement compute pipeline
+    const auto& vk = context->getLoader();
     
-    std::cout << "ComputeStressTester: Recording dispatch for " << workgroupCount << " workgroups" << std::endl;
+    vk.vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, dispatchTarget.pipeline);
+    vk.vkCmdBindDescriptorSets(
+        cmd, VK_PIPELINE_BIND_POINT_COMPUTE, dispatchTarget.layout,
+        0, 1, &dispatchTarget.descriptorSet, 0, nullptr);
+    
+    const uint32_t entityCount = dispatchTarget.entityCount > 0
+        ? dispatchTarget.entityCount
+        : workgroupCount * dispatchTarget.workgroupSize;
+    if (dispatchTarget.recorder) {
+        dispatchTarget.recorder(cmd, dispatchTarget.layout, entityCount);
+        return;
+    }
+    
+    NodePushConstants pushConstants{};
+    pushConstants.time = 0.0f;
+    pushConstants.deltaTime = 1.0f / 60.0f;
+    pushConstants.entityCount = entityCount;
+    
+    // Same chunking scheme as BaseComputeNode so the measurement matches the frame path
+    const uint32_t maxChunk = std::max(1u, dispatchTarget.maxWorkgroupsPerChunk);
+    uint32_t processedWorkgroups = 0;
+    while (processedWorkgroups < workgroupCount) {
+        uint32_t chunkSize = std::min(maxChunk, workgroupCount - processedWorkgroups);
+        pushConstants.param1 = processedWorkgroups * dispatchTarget.workgroupSize;
+        
+        vk.vkCmdPushConstants(
+            cmd, dispatchTarget.layout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(NodePushConstants), &pushConstants);
+        vk.vkCmdDispatch(cmd, chunkSize, 1, 1);
+        
+        processedWorkgroups += chunkSize;
+        if (processedWorkgroups < workgroupCount) {
+            VkMemoryBarrier2 memoryBarrier{};
+            memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+            memoryBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            memoryBarrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+            memoryBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            memoryBarrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+            
+            VkDependencyInfo dependencyInfo{};
+            dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+            dependencyInfo.memoryBarrierCount = 1;
+            dependencyInfo.pMemoryBarriers = &memoryBarrier;
+            
+            vk.vkCmdPipelineBarrier2(cmd, &dependencyInfo);
+        }
+    }
+}
+
+bool ComputeStressTester::setDispatchTarget(const ComputePipelineState& state, VkDescriptorSet descriptorSet,
+                                            DispatchRecorder recorder) {
+    if (!pipelineManager || descriptorSet == VK_NULL_HANDLE) {
+        return false;
+    }
+    
+    VkPipeline pipeline = pipelineManager->getPipeline(state);
+    VkPipelineLayout layout = pipelineManager->getPipelineLayout(state);
+    if (pipeline == VK_NULL_HANDLE || layout == VK_NULL_HANDLE) {
+        std::cerr << "ComputeStressTester: Failed to resolve dispatch target " << state.shaderPath << std::endl;
+        return false;
+    }
+    
+    dispatchTarget = {};
+    dispatchTarget.pipeline = pipeline;
+    dispatchTarget.layout = layout;
+    dispatchTarget.descriptorSet = descriptorSet;
+    dispatchTarget.workgroupSize = state.workgroupSizeX;
+    dispatchTarget.recorder = std::move(recorder);
+    return true;
+}
+
+void ComputeStressTester::clearDispatchTarget() {
+    dispatchTarget = {};
+}
+
+bool ComputeStressTester::measureDispatch(uint32_t workgroupCount, uint32_t entityCount, uint32_t maxWorkgroupsPerChunk,
+                                          uint32_t iterations, float& medianTimeMs) {
+    if (dispatchTarget.pipeline == VK_NULL_HANDLE || workgroupCount == 0 || iterations == 0) {
+        return false;
+    }
+    
+    dispatchTarget.entityCount = entityCount;
+    dispatchTarget.maxWorkgroupsPerChunk = maxWorkgroupsPerChunk;
+    
+    // One untimed dispatch to warm caches and clocks
+    float executionTime = 0.0f;
+    bool success = executeComputeDispatch(workgroupCount, executionTime);
+    
+    std::vector<float> samples;
+    samples.reserve(iterations);
+    for (uint32_t i = 0; success && i < iterations; ++i) {
+        success = executeComputeDispatch(workgroupCount, executionTime);
+        samples.push_back(executionTime);
+    }
+    
+    dispatchTarget.entityCount = 0;
+    if (!success) {
+        return false;
+    }
+    
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    medianTimeMs = samples[samples.size() / 2];
+    return true;
+}
+
+bool ComputeStressTester::createTimestampQueryPool() {
+    VkPhysicalDeviceProperties props;
+    context->getLoader().vkGetPhysicalDeviceProperties(context->getPhysicalDevice(), &props);
+    
+    if (props.limits.timestampComputeAndGraphics == VK_FALSE || props.limits.timestampPeriod <= 0.0f) {
+        return false;
+    }
+    
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount = 2;
+    
+    VkQueryPool queryPoolHandle = VK_NULL_HANDLE;
+    VkResult result = context->getLoader().vkCreateQueryPool(context->getDevice(), &queryPoolInfo, nullptr, &queryPoolHandle);
+    if (result != VK_SUCCESS) {
+        std::cerr << "ComputeStressTester: Failed to create timestamp query pool: " << result << std::endl;
+        return false;
+    }
+    
+    timestampQueryPool = vulkan_raii::make_query_pool(queryPoolHandle, context);
+    timestampPeriodNs = props.limits.timestampPeriod;
+    return true;
+}
+
+bool ComputeStressTester::readDispatchTimestamps(float& gpuTimeMs) {
+    uint64_t timestamps[2] = {};
+    VkResult result = context->getLoader().vkGetQueryPoolResults(
+        context->getDevice(), timestampQueryPool.get(), 0, 2,
+        sizeof(timestamps), timestamps, sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+    
+    if (result != VK_SUCCESS || timestamps[1] < timestamps[0]) {
+        return false;
+    }
+    
+    gpuTimeMs = static_cast<float>(static_cast<double>(timestamps[1] - timestamps[0]) * timestampPeriodNs / 1000000.0);
+    return true;
 }
 
 bool ComputeStressTester::waitForCompletion(float timeoutMs) {
@@ -315,6 +479,9 @@ bool ComputeStressTester::createTestResources() {
     
     testFence = vulkan_raii::make_fence(fenceHandle, context);
     
+    // Optional - executeComputeDispatch() falls back to wall-clock timing
+    createTimestampQueryPool();
+    
     return createTestBuffers() && createTestDescriptors();
 }
 
@@ -340,8 +507,10 @@ void ComputeStressTester::cleanupBeforeContextDestruction() {
     // Command buffer is freed with pool, so reset command pool last
     testCommandBuffer = VK_NULL_HANDLE;
     testDescriptorSet = VK_NULL_HANDLE;
+    dispatchTarget = {};
     
     testFence.reset();
+    timestampQueryPool.reset();
     testDescriptorPool.reset();
     testEntityBuffer.reset();
     testEntityMemory.reset();
@@ -3,6 +3,7 @@
 #define VK_NO_PROTOTYPES
 #include <vulkan/vulkan.h>
 #include "../core/vulkan_raii.h"
+#include "../core/vulkan_constants.h"
 #include <memory>
 #include <vector>
 #include <functional>
@@ -12,6 +13,7 @@ class VulkanContext;
 class ComputePipelineManager;
 class GPUTimeoutDetector;
 class GPUMemoryMonitor;
+struct ComputePipelineState;
 
 /**
  * Compute Stress Tester - Validates compute pipeline stability under various loads
@@ -84,6 +86,19 @@ public:
     bool testMemoryBandwidth(uint32_t bufferSizeMB = 100);
     bool testConcurrentDispatches(uint32_t dispatchCount = 3, uint32_t workgroupsEach = 1000);
     
+    // Records a multi-pass target with its pipeline and descriptor set bound, instead of the chunked dispatch
+    using DispatchRecorder = std::function<void(VkCommandBuffer, VkPipelineLayout, uint32_t entityCount)>;
+    
+    // Dispatch target - test dispatches run this pipeline against the given descriptor set
+    bool setDispatchTarget(const ComputePipelineState& state, VkDescriptorSet descriptorSet,
+                           DispatchRecorder recorder = {});
+    void clearDispatchTarget();
+    
+    // Median time of chunked dispatches of the current target. GPU timestamps when available, wall clock otherwise
+    bool measureDispatch(uint32_t workgroupCount, uint32_t entityCount, uint32_t maxWorkgroupsPerChunk,
+                         uint32_t iterations, float& medianTimeMs);
+    bool hasGPUTimestamps() const { return timestampQueryPool.get() != VK_NULL_HANDLE; }
+    
     // Validation and safety
     bool validateComputeResults(VkBuffer inputBuffer, VkBuffer outputBuffer, uint32_t elementCount);
     uint32_t findSafeMaxWorkgroups(float targetTimeMs = 16.0f);
@@ -119,6 +134,21 @@ private:
     vulkan_raii::DescriptorPool testDescriptorPool;
     VkDescriptorSet testDescriptorSet = VK_NULL_HANDLE;  // Descriptor sets are owned by pool, no RAII wrapper needed
     
+    // Pipeline recorded by recordTestDispatch()
+    struct DispatchTarget {
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        uint32_t workgroupSize = THREADS_PER_WORKGROUP;
+        uint32_t maxWorkgroupsPerChunk = MAX_WORKGROUPS_PER_CHUNK;
+        uint32_t entityCount = 0;  // 0 = one entity per invocation
+        DispatchRecorder recorder;
+    } dispatchTarget;
+    
+    // Begin/end timestamps around each test dispatch
+    vulkan_raii::QueryPool timestampQueryPool;
+    float timestampPeriodNs = 0.0f;
+    
     static constexpr uint32_t MAX_TEST_ENTITIES = 200000; // 200k entities for stress testing
     
     // Internal methods
@@ -127,6 +157,8 @@ private:
     bool createTestBuffers();
     bool createTestDescriptors();
     void populateTestData();
+    bool createTimestampQueryPool();
+    bool readDispatchTimestamps(float& gpuTimeMs);
     
     // Test execution
     bool executeComputeDispatch(uint32_t workgroupCount, float& executionTimeMs);
@@ -2,6 +2,7 @@
 #include "../core/vulkan_context.h"
 #include "../core/vulkan_function_loader.h"
 #include "../core/vulkan_constants.h"
+#include "memory_accounting.h"
 #include <iostream>
 #include <algorithm>
 #include <numeric>
@@ -140,9 +141,16 @@ void GPUMemoryMonitor::trackBufferDeallocation(VkBuffer buffer) {
 }
 
 void GPUMemoryMonitor::updateMemoryStats() {
-    // Update memory utilization
-    currentStats.usedDeviceMemory = currentStats.totalBufferMemory; // Simplified tracking
-    currentStats.availableDeviceMemory = currentStats.totalDeviceMemory - currentStats.usedDeviceMemory;
+    // Update memory utilization: device-local heap budget/usage when published, tracked buffers otherwise
+    const MemoryAccounting& accounting = MemoryAccounting::getInstance();
+    if (accounting.hasHeapBudgets() && accounting.getDeviceLocalBudget() > 0) {
+        currentStats.totalDeviceMemory = accounting.getDeviceLocalBudget();
+        currentStats.usedDeviceMemory = std::min(accounting.getDeviceLocalUsage(), currentStats.totalDeviceMemory);
+    } else {
+        currentStats.usedDeviceMemory = currentStats.totalBufferMemory; // Simplified tracking
+    }
+    currentStats.availableDeviceMemory = currentStats.totalDeviceMemory > currentStats.usedDeviceMemory ?
+        currentStats.totalDeviceMemory - currentStats.usedDeviceMemory : 0;
     
     if (currentStats.totalDeviceMemory > 0) {
         currentStats.memoryUtilizationPercent = 
@@ -0,0 +1,195 @@
+#include "memory_accounting.h"
+#include <algorithm>
+#include <iomanip>
+
+MemoryAccounting& MemoryAccounting::getInstance() {
+    // Never destroyed: counting allocators in other static objects may still free during exit
+    static MemoryAccounting* instance = new MemoryAccounting();
+    return *instance;
+}
+
+void MemoryAccounting::trackDeviceAllocation(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex,
+                                             GpuMemoryCategory category) {
+    if (memory == VK_NULL_HANDLE || memoryTypeIndex >= VK_MAX_MEMORY_TYPES || category >= GpuMemoryCategory::Count) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(deviceMutex);
+    DeviceAllocation allocation{size, memoryTypeIndex, category};
+    auto [it, inserted] = deviceAllocations.try_emplace(memory, allocation);
+    if (!inserted) {
+        // A handle value reused after an untracked free: replace the stale record
+        deviceBytes[static_cast<size_t>(it->second.category)].fetch_sub(it->second.size, std::memory_order_relaxed);
+        memoryTypeBytes[it->second.memoryTypeIndex] -= it->second.size;
+        it->second = allocation;
+    }
+    deviceBytes[static_cast<size_t>(category)].fetch_add(size, std::memory_order_relaxed);
+    memoryTypeBytes[memoryTypeIndex] += size;
+}
+
+void MemoryAccounting::trackDeviceFree(VkDeviceMemory memory) {
+    if (memory == VK_NULL_HANDLE) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(deviceMutex);
+    auto it = deviceAllocations.find(memory);
+    if (it == deviceAllocations.end()) {
+        return;
+    }
+    deviceBytes[static_cast<size_t>(it->second.category)].fetch_sub(it->second.size, std::memory_order_relaxed);
+    memoryTypeBytes[it->second.memoryTypeIndex] -= it->second.size;
+    deviceAllocations.erase(it);
+}
+
+uint64_t MemoryAccounting::getDeviceBytes(GpuMemoryCategory category) const {
+    if (category >= GpuMemoryCategory::Count) {
+        return 0;
+    }
+    return deviceBytes[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+}
+
+uint64_t MemoryAccounting::getDeviceBytesForMemoryType(uint32_t memoryTypeIndex) const {
+    if (memoryTypeIndex >= VK_MAX_MEMORY_TYPES) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(deviceMutex);
+    return memoryTypeBytes[memoryTypeIndex];
+}
+
+uint64_t MemoryAccounting::getTrackedDeviceBytes() const {
+    uint64_t total = 0;
+    for (const auto& bytes : deviceBytes) {
+        total += bytes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void MemoryAccounting::updateHeapBudgets(const std::vector<HeapBudget>& heaps, bool fromDriver) {
+    float pressure = 0.0f;
+    for (const HeapBudget& heap : heaps) {
+        if (heap.deviceLocal && heap.budget > 0) {
+            pressure = std::max(pressure, static_cast<float>(heap.usage) / static_cast<float>(heap.budget));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(heapMutex);
+    heapBudgets = heaps;
+    deviceLocalPressure.store(std::min(pressure, 1.0f), std::memory_order_relaxed);
+    driverBudget.store(fromDriver, std::memory_order_release);
+    heapBudgetsValid.store(!heaps.empty(), std::memory_order_release);
+}
+
+std::vector<MemoryAccounting::HeapBudget> MemoryAccounting::getHeapBudgets() const {
+    std::lock_guard<std::mutex> lock(heapMutex);
+    return heapBudgets;
+}
+
+float MemoryAccounting::getDeviceLocalPressure() const {
+    return deviceLocalPressure.load(std::memory_order_relaxed);
+}
+
+uint64_t MemoryAccounting::getDeviceLocalUsage() const {
+    std::lock_guard<std::mutex> lock(heapMutex);
+    uint64_t usage = 0;
+    for (const HeapBudget& heap : heapBudgets) {
+        usage += heap.deviceLocal ? heap.usage : 0;
+    }
+    return usage;
+}
+
+uint64_t MemoryAccounting::getDeviceLocalBudget() const {
+    std::lock_guard<std::mutex> lock(heapMutex);
+    uint64_t budget = 0;
+    for (const HeapBudget& heap : heapBudgets) {
+        budget += heap.deviceLocal ? heap.budget : 0;
+    }
+    return budget;
+}
+
+void MemoryAccounting::trackCpuAllocation(CpuMemorySubsystem subsystem, size_t bytes) {
+    CpuCounter& counter = cpuCounters[static_cast<size_t>(subsystem)];
+    uint64_t current = counter.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    uint64_t peak = counter.peak.load(std::memory_order_relaxed);
+    while (current > peak && !counter.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryAccounting::trackCpuFree(CpuMemorySubsystem subsystem, size_t bytes) {
+    cpuCounters[static_cast<size_t>(subsystem)].current.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+uint64_t MemoryAccounting::getCpuBytes(CpuMemorySubsystem subsystem) const {
+    return cpuCounters[static_cast<size_t>(subsystem)].current.load(std::memory_order_relaxed);
+}
+
+uint64_t MemoryAccounting::getCpuPeakBytes(CpuMemorySubsystem subsystem) const {
+    return cpuCounters[static_cast<size_t>(subsystem)].peak.load(std::memory_order_relaxed);
+}
+
+uint64_t MemoryAccounting::getTotalCpuBytes() const {
+    uint64_t total = 0;
+    for (const CpuCounter& counter : cpuCounters) {
+        total += counter.current.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+const char* MemoryAccounting::getCategoryName(GpuMemoryCategory category) {
+    switch (category) {
+        case GpuMemoryCategory::EntityBuffers: return "Entity buffers";
+        case GpuMemoryCategory::Staging: return "Staging";
+        case GpuMemoryCategory::FrameGraph: return "Frame graph";
+        case GpuMemoryCategory::RenderResources: return "Render resources";
+        case GpuMemoryCategory::Attachments: return "Attachments";
+        default: return "Unknown";
+    }
+}
+
+const char* MemoryAccounting::getSubsystemName(CpuMemorySubsystem subsystem) {
+    switch (subsystem) {
+        case CpuMemorySubsystem::GpuStaging: return "GPU staging";
+        case CpuMemorySubsystem::RenderQueue: return "Render queue";
+        case CpuMemorySubsystem::SpatialQueries: return "Spatial queries";
+        default: return "Unknown";
+    }
+}
+
+void MemoryAccounting::printReport(std::ostream& out) const {
+    constexpr double MB = 1024.0 * 1024.0;
+    constexpr double KB = 1024.0;
+
+    out << std::fixed << std::setprecision(2);
+    auto heaps = getHeapBudgets();
+    out << "GPU heaps (" << (isDriverBudget() ? "VK_EXT_memory_budget" : "tracked allocations") << "):" << std::endl;
+    for (size_t i = 0; i < heaps.size(); ++i) {
+        const HeapBudget& heap = heaps[i];
+        out << "  Heap " << i << (heap.deviceLocal ? " (device local)" : " (host)")
+            << ": " << (heap.usage / MB) << " / " << (heap.budget / MB) << " MB budget"
+            << ", " << (heap.size / MB) << " MB total" << std::endl;
+    }
+
+    uint64_t tracked = getTrackedDeviceBytes();
+    out << "GPU memory by category:" << std::endl;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(GpuMemoryCategory::Count); ++i) {
+        auto category = static_cast<GpuMemoryCategory>(i);
+        out << "  " << std::left << std::setw(20) << getCategoryName(category) << std::right
+            << (getDeviceBytes(category) / MB) << " MB" << std::endl;
+    }
+    if (isDriverBudget()) {
+        // Driver-reported usage minus what we allocated: pipelines, descriptor pools, swapchain images
+        uint64_t reported = 0;
+        for (const HeapBudget& heap : heaps) {
+            reported += heap.usage;
+        }
+        uint64_t untracked = reported > tracked ? reported - tracked : 0;
+        out << "  " << std::left << std::setw(20) << "Driver / pipelines" << std::right << (untracked / MB) << " MB" << std::endl;
+    }
+
+    out << "CPU heap by subsystem:" << std::endl;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(CpuMemorySubsystem::Count); ++i) {
+        auto subsystem = static_cast<CpuMemorySubsystem>(i);
+        out << "  " << std::left << std::setw(20) << getSubsystemName(subsystem) << std::right
+            << (getCpuBytes(subsystem) / KB) << " KB (peak " << (getCpuPeakBytes(subsystem) / KB) << " KB)" << std::endl;
+    }
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+// Owner of a device memory allocation; every vkAllocateMemory site tags its allocation
+enum class GpuMemoryCategory : uint32_t {
+    EntityBuffers = 0,   // Entity SoA columns, spatial map and query buffers
+    Staging,             // Upload staging ring
+    FrameGraph,          // Frame graph transient buffers and images
+    RenderResources,     // ResourceCoordinator buffers: vertex/index/uniform, readback slots
+    Attachments,         // Swapchain MSAA color target
+    Count
+};
+
+// CPU subsystems whose containers allocate through CountingAllocator
+enum class CpuMemorySubsystem : uint32_t {
+    GpuStaging = 0,      // GPUEntitySoA columns waiting for upload
+    RenderQueue,         // RenderingService queue index, batches and change lists
+    SpatialQueries,      // Pending and recorded GPU spatial queries
+    Count
+};
+
+/**
+ * Process-wide memory accounting.
+ *
+ * Device memory is attributed per category by handle at allocation time, so frees through any
+ * path (RAII deleters included) can be subtracted. Per-heap budget and usage come from
+ * VK_EXT_memory_budget when the device supports it - that usage also covers driver-owned memory
+ * such as pipelines, which no category can see - and fall back to tracked allocations otherwise.
+ * CPU heap usage is counted by CountingAllocator per subsystem.
+ */
+class MemoryAccounting {
+public:
+    static MemoryAccounting& getInstance();
+
+    // Device memory by category
+    void trackDeviceAllocation(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex, GpuMemoryCategory category);
+    void trackDeviceFree(VkDeviceMemory memory);   // Untracked handles are ignored
+    uint64_t getDeviceBytes(GpuMemoryCategory category) const;
+    uint64_t getDeviceBytesForMemoryType(uint32_t memoryTypeIndex) const;   // Per-heap fallback without the extension
+    uint64_t getTrackedDeviceBytes() const;
+
+    // Per-heap budget, refreshed by the renderer
+    struct HeapBudget {
+        uint64_t size = 0;
+        uint64_t budget = 0;         // What the process may use before the driver starts demoting
+        uint64_t usage = 0;          // Process usage, driver-owned memory included when fromDriver
+        bool deviceLocal = false;
+    };
+    void updateHeapBudgets(const std::vector<HeapBudget>& heaps, bool fromDriver);
+    std::vector<HeapBudget> getHeapBudgets() const;
+    bool hasHeapBudgets() const { return heapBudgetsValid.load(std::memory_order_acquire); }
+    bool isDriverBudget() const { return driverBudget.load(std::memory_order_acquire); }
+
+    // Highest usage/budget ratio over device-local heaps (0 when unknown)
+    float getDeviceLocalPressure() const;
+    uint64_t getDeviceLocalUsage() const;
+    uint64_t getDeviceLocalBudget() const;
+
+    // CPU heap usage by subsystem
+    void trackCpuAllocation(CpuMemorySubsystem subsystem, size_t bytes);
+    void trackCpuFree(CpuMemorySubsystem subsystem, size_t bytes);
+    uint64_t getCpuBytes(CpuMemorySubsystem subsystem) const;
+    uint64_t getCpuPeakBytes(CpuMemorySubsystem subsystem) const;
+    uint64_t getTotalCpuBytes() const;
+
+    static const char* getCategoryName(GpuMemoryCategory category);
+    static const char* getSubsystemName(CpuMemorySubsystem subsystem);
+
+    void printReport(std::ostream& out) const;
+
+private:
+    MemoryAccounting() = default;
+
+    struct DeviceAllocation {
+        VkDeviceSize size;
+        uint32_t memoryTypeIndex;
+        GpuMemoryCategory category;
+    };
+
+    struct CpuCounter {
+        std::atomic<uint64_t> current{0};
+        std::atomic<uint64_t> peak{0};
+    };
+
+    mutable std::mutex deviceMutex;
+    std::unordered_map<VkDeviceMemory, DeviceAllocation> deviceAllocations;
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(GpuMemoryCategory::Count)> deviceBytes{};
+    std::array<uint64_t, VK_MAX_MEMORY_TYPES> memoryTypeBytes{};   // Guarded by deviceMutex
+
+    mutable std::mutex heapMutex;
+    std::vector<HeapBudget> heapBudgets;
+    std::atomic<bool> heapBudgetsValid{false};
+    std::atomic<bool> driverBudget{false};
+    std::atomic<float> deviceLocalPressure{0.0f};
+
+    std::array<CpuCounter, static_cast<size_t>(CpuMemorySubsystem::Count)> cpuCounters{};
+};
+
+// std allocator that counts its bytes against a CPU subsystem
+template<typename T, CpuMemorySubsystem Subsystem>
+struct CountingAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = CountingAllocator<U, Subsystem>;
+    };
+
+    CountingAllocator() noexcept = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U, Subsystem>&) noexcept {}
+
+    T* allocate(size_t count) {
+        T* data = std::allocator<T>{}.allocate(count);
+        MemoryAccounting::getInstance().trackCpuAllocation(Subsystem, count * sizeof(T));
+        return data;
+    }
+
+    void deallocate(T* data, size_t count) noexcept {
+        MemoryAccounting::getInstance().trackCpuFree(Subsystem, count * sizeof(T));
+        std::allocator<T>{}.deallocate(data, count);
+    }
+
+    template<typename U>
+    bool operator==(const CountingAllocator<U, Subsystem>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const CountingAllocator<U, Subsystem>&) const noexcept { return false; }
+};
+
+template<typename T, CpuMemorySubsystem Subsystem>
+using CountedVector = std::vector<T, CountingAllocator<T, Subsystem>>;
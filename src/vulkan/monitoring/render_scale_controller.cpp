@@ -0,0 +1,119 @@
+#include "render_scale_controller.h"
+#include <algorithm>
+#include <iostream>
+
+void RenderScaleController::configure(const Config& newConfig, VkSampleCountFlags newSupportedSamples, bool newScalingSupported) {
+    config = newConfig;
+    supportedSamples = newSupportedSamples | VK_SAMPLE_COUNT_1_BIT;
+    scalingSupported = newScalingSupported;
+
+    config.maxScale = std::clamp(config.maxScale, 0.1f, 1.0f);
+    config.minScale = scalingSupported ? std::clamp(config.minScale, 0.1f, config.maxScale) : 1.0f;
+    if (!scalingSupported) {
+        config.maxScale = 1.0f;
+    }
+    config.scaleStep = std::max(config.scaleStep, 0.01f);
+    config.windowFrames = std::max(config.windowFrames, 1u);
+
+    // Bounds snap to counts the device supports, rounding inwards
+    config.minSamples = static_cast<uint32_t>(clampSamples(std::max(config.minSamples, 1u), true));
+    config.maxSamples = std::max(static_cast<uint32_t>(clampSamples(config.maxSamples, false)), config.minSamples);
+
+    // Start at full quality and only degrade when the budget is missed
+    setting.scale = config.maxScale;
+    setting.samples = static_cast<VkSampleCountFlagBits>(config.maxSamples);
+    generation++;
+    windowTotalMs = 0.0;
+    windowCount = 0;
+    headroomFrames = 0;
+    upgradeBackoff = 1;
+    lastStepWasUp = false;
+
+    std::cout << "RenderScaleController: " << config.targetMs << "ms budget, scale " << config.minScale << "-"
+              << config.maxScale << ", MSAA " << config.minSamples << "x-" << config.maxSamples << "x" << std::endl;
+}
+
+bool RenderScaleController::addSample(float gpuMs) {
+    windowTotalMs += gpuMs;
+    if (++windowCount < config.windowFrames) {
+        return false;
+    }
+
+    averageMs = static_cast<float>(windowTotalMs / windowCount);
+    windowTotalMs = 0.0;
+    windowCount = 0;
+
+    bool changed = false;
+    if (averageMs > config.targetMs * config.degradeRatio) {
+        if (lastStepWasUp) {
+            upgradeBackoff = std::min(upgradeBackoff * 2, 8u);
+        }
+        headroomFrames = 0;
+        changed = stepDown();
+        lastStepWasUp = false;
+    } else {
+        // The previous step up held for a whole window
+        lastStepWasUp = false;
+        if (averageMs < config.targetMs * config.upgradeRatio) {
+            headroomFrames += config.windowFrames;
+            if (headroomFrames >= config.upgradeHoldFrames * upgradeBackoff) {
+                headroomFrames = 0;
+                changed = stepUp();
+                lastStepWasUp = changed;
+            }
+        } else {
+            headroomFrames = 0;
+        }
+    }
+
+    if (changed) {
+        generation++;
+        std::cout << "RenderScaleController: " << averageMs << "ms against " << config.targetMs << "ms, rendering at "
+                  << setting.scale << "x scale with " << static_cast<uint32_t>(setting.samples) << "x MSAA" << std::endl;
+    }
+    return changed;
+}
+
+bool RenderScaleController::stepDown() {
+    if (static_cast<uint32_t>(setting.samples) > config.minSamples) {
+        const uint32_t next = static_cast<uint32_t>(clampSamples(static_cast<uint32_t>(setting.samples) / 2, false));
+        setting.samples = static_cast<VkSampleCountFlagBits>(std::max(next, config.minSamples));
+        return true;
+    }
+    if (setting.scale > config.minScale) {
+        setting.scale = std::max(setting.scale - config.scaleStep, config.minScale);
+        return true;
+    }
+    return false;
+}
+
+bool RenderScaleController::stepUp() {
+    if (setting.scale < config.maxScale) {
+        setting.scale = std::min(setting.scale + config.scaleStep, config.maxScale);
+        return true;
+    }
+    if (static_cast<uint32_t>(setting.samples) < config.maxSamples) {
+        const uint32_t next = static_cast<uint32_t>(clampSamples(static_cast<uint32_t>(setting.samples) * 2, true));
+        setting.samples = static_cast<VkSampleCountFlagBits>(std::min(next, config.maxSamples));
+        return true;
+    }
+    return false;
+}
+
+VkSampleCountFlagBits RenderScaleController::clampSamples(uint32_t samples, bool roundUp) const {
+    // Nearest supported power of two at or above (roundUp) or at or below the request, within 1x-64x
+    if (roundUp) {
+        for (uint32_t count = 1; count <= 64; count *= 2) {
+            if (count >= samples && (supportedSamples & count)) {
+                return static_cast<VkSampleCountFlagBits>(count);
+            }
+        }
+    } else {
+        for (uint32_t count = 64; count >= 1; count /= 2) {
+            if (count <= samples && (supportedSamples & count)) {
+                return static_cast<VkSampleCountFlagBits>(count);
+            }
+        }
+    }
+    return VK_SAMPLE_COUNT_1_BIT;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include <cstdint>
+
+/**
+ * Render Scale Controller - keeps the GPU time of the entity rendering pass near a budget by
+ * trading image quality, one step per decision window:
+ *
+ *   over budget    fewer MSAA samples first, then a lower render scale
+ *   headroom       a higher render scale first, then more MSAA samples
+ *
+ * Hysteresis: stepping down needs one window averaging above targetMs * degradeRatio, stepping up
+ * needs upgradeHoldFrames of windows below targetMs * upgradeRatio. A step up that the very next
+ * window undoes doubles the hold (up to 8x), so a budget that sits between two settings settles
+ * on the cheaper one instead of oscillating.
+ *
+ * Pure policy: EntityGraphicsNode feeds it timestamp samples and renders with getSetting().
+ */
+class RenderScaleController {
+public:
+    struct Config {
+        float targetMs = 8.0f;              // GPU time budget of the entity rendering pass
+        float minScale = 0.5f;              // Fraction of the swapchain extent, per axis
+        float maxScale = 1.0f;
+        float scaleStep = 0.125f;
+        uint32_t minSamples = 1;
+        uint32_t maxSamples = 2;
+        float degradeRatio = 1.0f;
+        float upgradeRatio = 0.7f;
+        uint32_t windowFrames = 30;         // Samples averaged per decision
+        uint32_t upgradeHoldFrames = 120;
+    };
+
+    struct Setting {
+        float scale = 1.0f;
+        VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_2_BIT;
+
+        bool operator==(const Setting& other) const { return scale == other.scale && samples == other.samples; }
+        bool operator!=(const Setting& other) const { return !(*this == other); }
+    };
+
+    // supportedSamples is VkPhysicalDeviceLimits::framebufferColorSampleCounts. Without
+    // scalingSupported the scale stays at 1 and only the sample count adapts
+    void configure(const Config& config, VkSampleCountFlags supportedSamples, bool scalingSupported);
+
+    // One pass time; true when the setting changed. Samples measured under an older setting
+    // must be dropped by the caller (see getGeneration())
+    bool addSample(float gpuMs);
+
+    const Setting& getSetting() const { return setting; }
+    uint32_t getGeneration() const { return generation; }
+    float getAverageMs() const { return averageMs; }
+    const Config& getConfig() const { return config; }
+
+private:
+    bool stepDown();
+    bool stepUp();
+    VkSampleCountFlagBits clampSamples(uint32_t samples, bool roundUp) const;
+
+    Config config;
+    Setting setting;
+    VkSampleCountFlags supportedSamples = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT;
+    bool scalingSupported = false;
+
+    uint32_t generation = 0;
+    double windowTotalMs = 0.0;
+    uint32_t windowCount = 0;
+    float averageMs = 0.0f;
+    uint32_t headroomFrames = 0;
+    uint32_t upgradeBackoff = 1;
+    bool lastStepWasUp = false;
+};
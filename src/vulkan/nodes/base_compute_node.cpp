@@ -64,20 +64,12 @@ void BaseComputeNode::executeComputeNode(
         return;
     }
     
-    // Create compute pipeline state using Vulkan 1.3 descriptor indexing
-    auto layoutSpec = DescriptorLayoutPresets::createEntityIndexedLayout();
-    VkDescriptorSetLayout descriptorLayout = computeManager->getLayoutManager()->getLayout(layoutSpec);
-    ComputePipelineState pipelineState = this->createPipelineState(descriptorLayout);
-    
     // Setup push constants using derived class implementation
     setupPushConstants(time, deltaTime, entityCount, frameGraph.getGlobalFrameCounter());
     
     // Create compute dispatch
     ComputeDispatch dispatch{};
-    dispatch.pipeline = computeManager->getPipeline(pipelineState);
-    dispatch.layout = computeManager->getPipelineLayout(pipelineState);
-    
-    if (dispatch.pipeline == VK_NULL_HANDLE || dispatch.layout == VK_NULL_HANDLE) {
+    if (!resolvePipeline(dispatch.pipeline, dispatch.layout)) {
         std::cerr << nodeTypeName << ": Failed to get compute pipeline or layout" << std::endl;
         return;
     }
@@ -94,15 +86,17 @@ void BaseComputeNode::executeComputeNode(
     
     // Configure push constants and dispatch
     pushConstants.entityCount = entityCount;
+    pushConstants.seed = frameGraph.getSimulationSeed();
     dispatch.pushConstantData = &pushConstants;
     dispatch.pushConstantSize = sizeof(NodePushConstants);
     dispatch.pushConstantStages = VK_SHADER_STAGE_COMPUTE_BIT;
-    dispatch.calculateOptimalDispatch(entityCount, glm::uvec3(THREADS_PER_WORKGROUP, 1, 1));
+    dispatch.calculateOptimalDispatch(entityCount, glm::uvec3(activeVariant.workgroupSize, 1, 1));
     
     // Apply adaptive workload management
     uint32_t maxWorkgroupsPerDispatch = adaptiveMaxWorkgroups;
     bool shouldForceChunking = forceChunkedDispatch;
     applyAdaptiveWorkloadManagement(maxWorkgroupsPerDispatch, shouldForceChunking);
+    adaptiveMaxWorkgroups = maxWorkgroupsPerDispatch;
     
     // Calculate dispatch parameters using derived class implementation
     auto dispatchParams = calculateDispatchParams(entityCount, maxWorkgroupsPerDispatch, shouldForceChunking);
@@ -184,7 +178,7 @@ void BaseComputeNode::executeChunkedDispatch(
     
     while (processedWorkgroups < totalWorkgroups) {
         uint32_t currentChunkSize = std::min(maxWorkgroupsPerChunk, totalWorkgroups - processedWorkgroups);
-        uint32_t baseEntityOffset = processedWorkgroups * THREADS_PER_WORKGROUP;
+        uint32_t baseEntityOffset = processedWorkgroups * activeVariant.workgroupSize;
         
         if (entityCount <= baseEntityOffset) break; // No more entities to process
         
@@ -252,6 +246,53 @@ void BaseComputeNode::createMemoryBarrier(VkCommandBuffer commandBuffer, const V
     vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
 }
 
+void BaseComputeNode::prepareRecording(const FrameGraph& frameGraph, float time, float deltaTime) {
+    preparedPipeline = {};
+    if (!validateDependencies()) {
+        return;
+    }
+    
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    if (resolvePipeline(pipeline, layout)) {
+        preparedPipeline = {pipeline, layout, true};
+    }
+}
+
+bool BaseComputeNode::resolvePipeline(VkPipeline& pipeline, VkPipelineLayout& layout) {
+    // Consume the prepared pipeline once so a cache rebuild never leaves a stale handle behind.
+    // Workers only record prepared nodes, so the lookup below always runs on the main thread
+    if (preparedPipeline.valid) {
+        pipeline = preparedPipeline.pipeline;
+        layout = preparedPipeline.layout;
+        preparedPipeline = {};
+        return true;
+    }
+    
+    // Create compute pipeline state using Vulkan 1.3 descriptor indexing
+    auto layoutSpec = DescriptorLayoutPresets::createEntityIndexedLayout();
+    VkDescriptorSetLayout descriptorLayout = computeManager->getLayoutManager()->getLayout(layoutSpec);
+    const ComputeVariantRegistry* variants = computeManager->getVariantRegistry();
+    activeVariant = variants->getActiveVariant();
+    const TunedDispatchParams* tuned = variants->findTunedDispatch(getDispatchBaseName());
+    if (tuned) {
+        activeVariant.workgroupSize = tuned->workgroupSize;
+    }
+    
+    // Take the tuned chunk size only when the tuning changes, so a timeout back-off survives pipeline rebuilds
+    const TunedDispatchParams tuning = tuned ? *tuned : TunedDispatchParams{};
+    if (tuning.workgroupSize != appliedTuning.workgroupSize ||
+        tuning.maxWorkgroupsPerChunk != appliedTuning.maxWorkgroupsPerChunk) {
+        adaptiveMaxWorkgroups = tuning.maxWorkgroupsPerChunk;
+        appliedTuning = tuning;
+    }
+    ComputePipelineState pipelineState = this->createPipelineState(descriptorLayout);
+    
+    pipeline = computeManager->getPipeline(pipelineState);
+    layout = computeManager->getPipelineLayout(pipelineState);
+    return pipeline != VK_NULL_HANDLE && layout != VK_NULL_HANDLE;
+}
+
 bool BaseComputeNode::validateDependencies() const {
     return computeManager != nullptr && gpuEntityManager != nullptr;
 }
@@ -7,6 +7,7 @@
 #include "../rendering/frame_graph_types.h"
 #include "../core/vulkan_constants.h"
 #include "../pipelines/compute_pipeline_types.h"
+#include "../pipelines/compute_pipeline_variants.h"
 #include "../pipelines/descriptor_layout_manager.h"
 #include <memory>
 
@@ -50,6 +51,9 @@ protected:
     // Queue requirements - all compute nodes need compute queue
     bool needsComputeQueue() const override final { return true; }
     bool needsGraphicsQueue() const override final { return false; }
+    
+    // Movement and physics each advance the simulation by one step per execute()
+    bool advancesSimulation() const override final { return true; }
 
     // Shared execution logic - template method pattern
     void executeComputeNode(
@@ -70,6 +74,10 @@ protected:
     // Dependency validation
     void onFirstUse(const FrameGraph& frameGraph) override;
 
+    // Parallel recording - pipeline lookup happens here so execute() stays off the shared caches
+    void prepareRecording(const FrameGraph& frameGraph, float time, float deltaTime) override;
+    bool supportsParallelRecording() const override { return !timeoutDetector && preparedPipeline.valid; }
+
     // Shared resource IDs
     FrameGraphTypes::ResourceId entityBufferId;
     FrameGraphTypes::ResourceId positionBufferId;
@@ -81,13 +89,24 @@ protected:
     GPUEntityManager* gpuEntityManager;
     std::shared_ptr<GPUTimeoutDetector> timeoutDetector;
 
-    // Adaptive dispatch parameters
+    // Adaptive dispatch parameters; the chunk size starts from the tuning and only shrinks on timeouts
     uint32_t adaptiveMaxWorkgroups = MAX_WORKGROUPS_PER_CHUNK;
     bool forceChunkedDispatch = true;
+    TunedDispatchParams appliedTuning{};
 
     // Push constants
     NodePushConstants pushConstants{};
 
+    // Specialization variant the current pipeline was built with; dispatch sizing must follow it
+    ComputeShaderVariant activeVariant{};
+
+    // Pipeline resolved by prepareRecording(), consumed by the next execute()
+    struct PreparedPipeline {
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        bool valid = false;
+    } preparedPipeline;
+
 private:
     // Shared implementation methods
     void executeChunkedDispatch(
@@ -109,6 +128,7 @@ private:
     void createMemoryBarrier(VkCommandBuffer commandBuffer, const VulkanContext* context);
 
     // Shared validation and setup
+    bool resolvePipeline(VkPipeline& pipeline, VkPipelineLayout& layout);
     bool validateDependencies() const;
     bool validateDispatchLimits(uint32_t totalWorkgroups) const;
     void applyAdaptiveWorkloadManagement(uint32_t& maxWorkgroupsPerDispatch, bool& shouldForceChunking) const;
@@ -0,0 +1,161 @@
+#include "collision_node.h"
+#include "../pipelines/compute_pipeline_manager.h"
+#include "../pipelines/compute_pipeline_variants.h"
+#include "../pipelines/descriptor_layout_manager.h"
+#include "../core/vulkan_constants.h"
+#include "../core/vulkan_context.h"
+#include "../core/vulkan_function_loader.h"
+#include "../../ecs/gpu/gpu_entity_manager.h"
+#include <iostream>
+#include <stdexcept>
+
+CollisionNode::CollisionNode(
+    FrameGraphTypes::ResourceId entityBuffer,
+    FrameGraphTypes::ResourceId positionBuffer,
+    FrameGraphTypes::ResourceId currentPositionBuffer,
+    ComputePipelineManager* computeManager,
+    GPUEntityManager* gpuEntityManager
+) : entityBufferId(entityBuffer)
+  , positionBufferId(positionBuffer)
+  , currentPositionBufferId(currentPositionBuffer)
+  , computeManager(computeManager)
+  , gpuEntityManager(gpuEntityManager) {
+
+    if (!computeManager) {
+        throw std::invalid_argument("CollisionNode: computeManager cannot be null");
+    }
+    if (!gpuEntityManager) {
+        throw std::invalid_argument("CollisionNode: gpuEntityManager cannot be null");
+    }
+}
+
+std::vector<ResourceDependency> CollisionNode::getInputs() const {
+    // Velocity is zeroed on contact, but the entity buffer's producer stays the compute nodes
+    return {
+        {entityBufferId, ResourceAccess::ReadWrite, PipelineStage::ComputeShader},
+        {currentPositionBufferId, ResourceAccess::Read, PipelineStage::ComputeShader},
+    };
+}
+
+std::vector<ResourceDependency> CollisionNode::getOutputs() const {
+    // Link and pair buffers are private to the passes, which the frame graph does not track
+    return {
+        {positionBufferId, ResourceAccess::Write, PipelineStage::ComputeShader},
+    };
+}
+
+void CollisionNode::execute(VkCommandBuffer commandBuffer, const FrameGraph& frameGraph, float time, float deltaTime) {
+    const uint32_t entityCount = gpuEntityManager->getEntityCount();
+    if (entityCount == 0) {
+        return;
+    }
+
+    const VulkanContext* context = frameGraph.getContext();
+    if (!context) {
+        std::cerr << "CollisionNode: Cannot get Vulkan context" << std::endl;
+        return;
+    }
+
+    const ComputeVariantRegistry* variants = computeManager->getVariantRegistry();
+    ComputeShaderVariant variant = variants->getActiveVariant();
+    if (const TunedDispatchParams* tuned = variants->findTunedDispatch(DISPATCH_NAME)) {
+        variant.workgroupSize = tuned->workgroupSize;
+    }
+    auto layoutSpec = DescriptorLayoutPresets::createEntityIndexedLayout();
+    VkDescriptorSetLayout descriptorLayout = computeManager->getLayoutManager()->getLayout(layoutSpec);
+    ComputePipelineState pipelineState = ComputePipelinePresets::createCollisionState(descriptorLayout, variant);
+    VkPipeline pipeline = computeManager->getPipeline(pipelineState);
+    VkPipelineLayout pipelineLayout = computeManager->getPipelineLayout(pipelineState);
+    VkDescriptorSet descriptorSet = gpuEntityManager->getDescriptorManager().getIndexedDescriptorSet();
+    if (pipeline == VK_NULL_HANDLE || pipelineLayout == VK_NULL_HANDLE || descriptorSet == VK_NULL_HANDLE) {
+        std::cerr << "CollisionNode: Failed to get collision pipeline or descriptor set" << std::endl;
+        return;
+    }
+
+    const auto& vk = context->getLoader();
+    vk.vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+    vk.vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout,
+                               0, 1, &descriptorSet, 0, nullptr);
+
+    const auto& bufferManager = gpuEntityManager->getBufferManager();
+    recordPasses(commandBuffer, context, pipelineLayout, variant,
+                 bufferManager.getSpatialMapBuffer(), bufferManager.getCollisionPairBuffer(), entityCount);
+}
+
+void CollisionNode::recordPasses(VkCommandBuffer commandBuffer, const VulkanContext* context, VkPipelineLayout pipelineLayout,
+                                 const ComputeShaderVariant& variant, VkBuffer spatialMapBuffer, VkBuffer pairBuffer,
+                                 uint32_t entityCount) {
+    const auto& vk = context->getLoader();
+
+    // Physics output must land, and the previous step's passes must be done with the map and pairs
+    recordComputeBarrier(commandBuffer, context,
+                         VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                         VK_ACCESS_2_SHADER_WRITE_BIT,
+                         VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                         VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT);
+
+    // Empty cells for the active grid, and a zero-group narrowphase with no pairs
+    const VkDeviceSize spatialMapSize = static_cast<VkDeviceSize>(variant.getSpatialMapSize()) * sizeof(uint32_t) * 2;
+    vk.vkCmdFillBuffer(commandBuffer, spatialMapBuffer, 0, spatialMapSize, 0xFFFFFFFFu);
+    const uint32_t pairHeader[4] = {0, 1, 1, 0};
+    vk.vkCmdUpdateBuffer(commandBuffer, pairBuffer, 0, sizeof(pairHeader), pairHeader);
+
+    recordComputeBarrier(commandBuffer, context,
+                         VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                         VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                         VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT);
+
+    PushConstants pushConstants{entityCount, PASS_INSERT, MAX_COLLISION_PAIRS, 0};
+    const uint32_t entityWorkgroups = (entityCount + variant.workgroupSize - 1) / variant.workgroupSize;
+    auto dispatchPass = [&](uint32_t passIndex) {
+        pushConstants.passIndex = passIndex;
+        vk.vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                              0, sizeof(PushConstants), &pushConstants);
+        vk.vkCmdDispatch(commandBuffer, entityWorkgroups, 1, 1);
+    };
+    auto computeToCompute = [&]() {
+        recordComputeBarrier(commandBuffer, context,
+                             VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+                             VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                             VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT);
+    };
+
+    dispatchPass(PASS_INSERT);
+    computeToCompute();
+
+    if (variant.enableCollisions) {
+        dispatchPass(PASS_BROADPHASE);
+
+        // The narrowphase group count was accumulated in the pair header by the broadphase
+        recordComputeBarrier(commandBuffer, context,
+                             VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+                             VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                             VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT |
+                             VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT);
+
+        pushConstants.passIndex = PASS_NARROWPHASE;
+        vk.vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                              0, sizeof(PushConstants), &pushConstants);
+        vk.vkCmdDispatchIndirect(commandBuffer, pairBuffer, 0);
+        computeToCompute();
+    }
+
+    dispatchPass(PASS_RESOLVE);
+}
+
+void CollisionNode::recordComputeBarrier(VkCommandBuffer commandBuffer, const VulkanContext* context,
+                                         VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess,
+                                         VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess) {
+    VkMemoryBarrier2 memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    memoryBarrier.srcStageMask = srcStage;
+    memoryBarrier.srcAccessMask = srcAccess;
+    memoryBarrier.dstStageMask = dstStage;
+    memoryBarrier.dstAccessMask = dstAccess;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &memoryBarrier;
+    context->getLoader().vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
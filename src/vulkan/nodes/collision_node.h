@@ -0,0 +1,84 @@
+#pragma once
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include "../rendering/frame_graph.h"
+
+// Forward declarations
+class ComputePipelineManager;
+class GPUEntityManager;
+class VulkanContext;
+struct ComputeShaderVariant;
+
+/**
+ * Two-phase collision for the physics output, recorded on the compute command buffer after
+ * PhysicsComputeNode. Four passes of collision.comp:
+ *
+ *   insert       rebuild the spatial map as per-cell chains through the collision link buffer
+ *   broadphase   emit every pair whose bounding circles overlap into the compacted pair buffer
+ *   narrowphase  exact rotated-triangle test per candidate, dispatched indirectly from the pair count
+ *   resolve      write the output positions, separating each entity from its contact partner
+ *
+ * The expensive shape test only runs on broadphase candidates, never on every neighbour.
+ */
+class CollisionNode : public FrameGraphNode {
+    DECLARE_FRAME_GRAPH_NODE(CollisionNode)
+
+public:
+    // Tuned dispatch name, see ComputeAutotuner; only the workgroup size applies to the passes
+    static constexpr const char* DISPATCH_NAME = "Collision";
+
+    CollisionNode(
+        FrameGraphTypes::ResourceId entityBuffer,
+        FrameGraphTypes::ResourceId positionBuffer,
+        FrameGraphTypes::ResourceId currentPositionBuffer,
+        ComputePipelineManager* computeManager,
+        GPUEntityManager* gpuEntityManager
+    );
+
+    // FrameGraphNode interface
+    std::vector<ResourceDependency> getInputs() const override;
+    std::vector<ResourceDependency> getOutputs() const override;
+    void execute(VkCommandBuffer commandBuffer, const FrameGraph& frameGraph, float time, float deltaTime) override;
+
+    // Queue requirements - collision follows physics on the compute command buffer
+    bool needsComputeQueue() const override { return true; }
+    bool needsGraphicsQueue() const override { return false; }
+
+    // Part of every simulation step, replayed with physics for fixed-step substeps
+    bool advancesSimulation() const override { return true; }
+
+    // Resets the spatial map and pair header, then records every pass with the collision pipeline
+    // already bound. Shared with ComputeAutotuner so the sweep times the same sequence
+    static void recordPasses(VkCommandBuffer commandBuffer, const VulkanContext* context, VkPipelineLayout pipelineLayout,
+                             const ComputeShaderVariant& variant, VkBuffer spatialMapBuffer, VkBuffer pairBuffer,
+                             uint32_t entityCount);
+
+private:
+    // Must match CollisionPushConstants in collision.comp
+    struct PushConstants {
+        uint32_t entityCount;
+        uint32_t passIndex;
+        uint32_t maxPairs;
+        uint32_t reserved;
+    };
+
+    enum Pass : uint32_t {
+        PASS_INSERT = 0,
+        PASS_BROADPHASE = 1,
+        PASS_NARROWPHASE = 2,
+        PASS_RESOLVE = 3
+    };
+
+    static void recordComputeBarrier(VkCommandBuffer commandBuffer, const VulkanContext* context,
+                                     VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess,
+                                     VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess);
+
+    FrameGraphTypes::ResourceId entityBufferId;
+    FrameGraphTypes::ResourceId positionBufferId;
+    FrameGraphTypes::ResourceId currentPositionBufferId;
+
+    // External dependencies (not owned)
+    ComputePipelineManager* computeManager;
+    GPUEntityManager* gpuEntityManager;
+};
@@ -44,7 +44,8 @@ void EntityComputeNode::execute(VkCommandBuffer commandBuffer, const FrameGraph&
 
 // Virtual method implementations specific to entity movement
 BaseComputeNode::DispatchParams EntityComputeNode::calculateDispatchParams(uint32_t entityCount, uint32_t maxWorkgroups, bool forceChunking) {
-    const uint32_t totalWorkgroups = (entityCount + THREADS_PER_WORKGROUP - 1) / THREADS_PER_WORKGROUP;
+    const uint32_t workgroupSize = activeVariant.workgroupSize;
+    const uint32_t totalWorkgroups = (entityCount + workgroupSize - 1) / workgroupSize;
     return {
         totalWorkgroups,
         maxWorkgroups,
@@ -53,7 +54,7 @@ BaseComputeNode::DispatchParams EntityComputeNode::calculateDispatchParams(uint3
 }
 
 ComputePipelineState EntityComputeNode::createPipelineState(VkDescriptorSetLayout descriptorLayout) {
-    return ComputePipelinePresets::createEntityMovementState(descriptorLayout);
+    return ComputePipelinePresets::createEntityMovementState(descriptorLayout, activeVariant);
 }
 
 void EntityComputeNode::setupPushConstants(float time, float deltaTime, uint32_t entityCount, uint32_t frameCounter) {
@@ -1,5 +1,6 @@
 #include "entity_graphics_node.h"
 #include "../pipelines/graphics_pipeline_manager.h"
+#include "../pipelines/compute_pipeline_manager.h"
 #include "../core/vulkan_swapchain.h"
 #include "../resources/core/resource_coordinator.h"
 #include "../resources/managers/graphics_resource_manager.h"
@@ -9,20 +10,24 @@
 #include "../../ecs/components/camera_component.h"
 #include "../pipelines/descriptor_layout_manager.h"
 #include <iostream>
+#include <SDL3/SDL.h>
 #include "../../ecs/core/service_locator.h"
 #include "../../ecs/services/camera_service.h"
+#include "../../ecs/core/camera_feed.h"
 #include <array>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <flecs.h>
 #include <stdexcept>
 #include <memory>
+#include <algorithm>
 
 EntityGraphicsNode::EntityGraphicsNode(
     FrameGraphTypes::ResourceId entityBuffer, 
     FrameGraphTypes::ResourceId positionBuffer,
     FrameGraphTypes::ResourceId colorTarget,
     GraphicsPipelineManager* graphicsManager,
+    ComputePipelineManager* computeManager,
     VulkanSwapchain* swapchain,
     ResourceCoordinator* resourceCoordinator,
     GPUEntityManager* gpuEntityManager
@@ -30,6 +35,7 @@ EntityGraphicsNode::EntityGraphicsNode(
   , positionBufferId(positionBuffer)
   , colorTargetId(colorTarget)
   , graphicsManager(graphicsManager)
+  , computeManager(computeManager)
   , swapchain(swapchain)
   , resourceCoordinator(resourceCoordinator)
   , gpuEntityManager(gpuEntityManager) {
@@ -38,6 +44,9 @@ EntityGraphicsNode::EntityGraphicsNode(
     if (!graphicsManager) {
         throw std::invalid_argument("EntityGraphicsNode: graphicsManager cannot be null");
     }
+    if (!computeManager) {
+        throw std::invalid_argument("EntityGraphicsNode: computeManager cannot be null");
+    }
     if (!swapchain) {
         throw std::invalid_argument("EntityGraphicsNode: swapchain cannot be null");
     }
@@ -85,30 +94,16 @@ void EntityGraphicsNode::execute(VkCommandBuffer commandBuffer, const FrameGraph
         return;
     }
     
-    // Update uniform buffer with camera matrices (now handled by EntityDescriptorManager)
-    updateUniformBuffer();
-    
-    // Create graphics pipeline state for entity rendering - use Vulkan 1.3 descriptor indexing
-    auto layoutSpec = DescriptorLayoutPresets::createEntityIndexedLayout();
-    VkDescriptorSetLayout descriptorLayout = graphicsManager->getLayoutManager()->getLayout(layoutSpec);
-    
-    // Create graphics pipeline state for dynamic rendering (no render pass needed)
-    GraphicsPipelineState pipelineState = GraphicsPipelinePresets::createEntityRenderingStateDynamic(
-        descriptorLayout, 
-        swapchain->getImageFormat(),  // Color format for dynamic rendering
-        VK_FORMAT_UNDEFINED,          // No depth format
-        VK_SAMPLE_COUNT_2_BIT         // MSAA samples
-    );
-    
-    // Get pipeline and layout
-    VkPipeline pipeline = graphicsManager->getPipeline(pipelineState);
-    
-    VkPipelineLayout pipelineLayout = graphicsManager->getPipelineLayout(pipelineState);
-    
-    if (pipeline == VK_NULL_HANDLE || pipelineLayout == VK_NULL_HANDLE) {
+    // Uniform update, pipeline lookup and render targets - workers only record a prepared frame,
+    // so an unprepared one is being recorded serially on the main thread
+    if (!preparedState.valid && !prepareFrameState()) {
         std::cerr << "EntityGraphicsNode: Failed to get graphics pipeline" << std::endl;
         return;
     }
+    VkPipeline pipeline = preparedState.pipeline;
+    VkPipelineLayout pipelineLayout = preparedState.layout;
+    const PreparedState frameState = preparedState;
+    preparedState = {};
     
     // Validate swapchain state before accessing image views
     const auto& swapchainImageViews = swapchain->getImageViews();
@@ -118,26 +113,34 @@ void EntityGraphicsNode::execute(VkCommandBuffer commandBuffer, const FrameGraph
         return;
     }
     
-    // Begin dynamic rendering - setup color and resolve attachments  
-    VkImageView msaaColorImageView = swapchain->getMSAAColorImageView();
+    // Scaled frames render into the top-left corner of the offscreen target and are blitted up afterwards
+    const VkExtent2D renderExtent = frameState.renderExtent;
+    VkImage swapchainImage = swapchain->getImages()[imageIndex];
+    VkImageView targetView = frameState.offscreen ? swapchain->getOffscreenColorImageView() : swapchainImageViews[imageIndex];
     
     VkRenderingAttachmentInfo colorAttachment{};
     colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
-    colorAttachment.imageView = msaaColorImageView;
     colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
     colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;  // MSAA is resolved, don't store
     colorAttachment.clearValue.color = {{0.1f, 0.1f, 0.2f, 1.0f}};
     
-    // Resolve attachment for MSAA
-    colorAttachment.resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT;
-    colorAttachment.resolveImageView = swapchainImageViews[imageIndex];
-    colorAttachment.resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    if (frameState.samples != VK_SAMPLE_COUNT_1_BIT) {
+        colorAttachment.imageView = swapchain->getMSAAColorImageView();
+        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;  // MSAA is resolved, don't store
+        
+        // Resolve attachment for MSAA
+        colorAttachment.resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT;
+        colorAttachment.resolveImageView = targetView;
+        colorAttachment.resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    } else {
+        colorAttachment.imageView = targetView;
+        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    }
     
     VkRenderingInfo renderingInfo{};
     renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
     renderingInfo.renderArea.offset = {0, 0};
-    renderingInfo.renderArea.extent = swapchain->getExtent();
+    renderingInfo.renderArea.extent = renderExtent;
     renderingInfo.layerCount = 1;
     renderingInfo.colorAttachmentCount = 1;
     renderingInfo.pColorAttachments = &colorAttachment;
@@ -147,21 +150,68 @@ void EntityGraphicsNode::execute(VkCommandBuffer commandBuffer, const FrameGraph
     // Cache loader reference for performance
     const auto& vk = context->getLoader();
     
+    // Late latch: push the newest camera feed sample as of recording this node instead of the uniform
+    // buffer written in prepareRecording(), which is also shared with the frame still in flight. Other
+    // nodes may still be recording, so this is no later than recording, not the last thing before submission
+    VertexPushConstants vertexPushConstants{};
+    vertexPushConstants.time = frameTime;
+    vertexPushConstants.dt = frameDeltaTime;
+    vertexPushConstants.count = entityCount;
+    glm::mat4 viewProj = frameState.camera.proj * frameState.camera.view;
+    if (lateLatchCamera) {
+        CachedUBO latched = getLatchedCameraMatrices(frameState.camera);
+        viewProj = latched.proj * latched.view;
+        vertexPushConstants.viewProj = viewProj;
+        vertexPushConstants.cameraLatched = 1;
+    }
+    
+    // Timing brackets the whole pass, including the density splat and the upscale blit
+    const uint32_t firstQuery = frameState.timestampSlot * 2;
+    if (frameState.timestampSlot != UINT32_MAX) {
+        vk.vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, timestampQueryPool.get(), firstQuery);
+    }
+    
+    // The density texels must be complete before the resolve reads them inside the rendering scope
+    ResolvePushConstants resolvePushConstants{};
+    if (frameState.density) {
+        DensityPushConstants densityPushConstants{};
+        densityPushConstants.viewProj = viewProj;
+        densityPushConstants.entityCount = entityCount;
+        
+        // Texels grow past the minimum only when the screen has more of them than the buffer holds
+        uint32_t texelSize = DENSITY_MIN_TEXEL_SIZE;
+        auto texelCount = [&](uint32_t size) {
+            return static_cast<uint64_t>((renderExtent.width + size - 1) / size) * ((renderExtent.height + size - 1) / size);
+        };
+        while (texelCount(texelSize) > DENSITY_MAX_TEXELS) {
+            texelSize++;
+        }
+        densityPushConstants.texelSize = texelSize;
+        densityPushConstants.densityWidth = (renderExtent.width + texelSize - 1) / texelSize;
+        densityPushConstants.densityHeight = (renderExtent.height + texelSize - 1) / texelSize;
+        densityPushConstants.viewportSize = glm::vec2(renderExtent.width, renderExtent.height);
+        
+        recordDensitySplat(commandBuffer, context, frameState, densityPushConstants);
+        resolvePushConstants.texelSize = texelSize;
+        resolvePushConstants.densityWidth = densityPushConstants.densityWidth;
+    }
+    
+    recordTargetBarriers(commandBuffer, context, frameState);
     vk.vkCmdBeginRendering(commandBuffer, &renderingInfo);
 
     // Set dynamic viewport and scissor
     VkViewport viewport{};
     viewport.x = 0.0f;
     viewport.y = 0.0f;
-    viewport.width = static_cast<float>(swapchain->getExtent().width);
-    viewport.height = static_cast<float>(swapchain->getExtent().height);
+    viewport.width = static_cast<float>(renderExtent.width);
+    viewport.height = static_cast<float>(renderExtent.height);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
     vk.vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
 
     VkRect2D scissor{};
     scissor.offset = {0, 0};
-    scissor.extent = swapchain->getExtent();
+    scissor.extent = renderExtent;
     vk.vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
     // Entity count already retrieved above
@@ -186,55 +236,64 @@ void EntityGraphicsNode::execute(VkCommandBuffer commandBuffer, const FrameGraph
         );
     } else {
         std::cerr << "EntityGraphicsNode: ERROR - Missing graphics descriptor set!" << std::endl;
+        vk.vkCmdEndRendering(commandBuffer);
         return;
     }
 
-    // Push constants for vertex shader
-    struct VertexPushConstants {
-        float time;                 // Current simulation time
-        float dt;                   // Time per frame  
-        uint32_t count;             // Total number of entities
-    } vertexPushConstants = { 
-        frameTime,
-        frameDeltaTime,
-        entityCount
-    };
-    
-    vk.vkCmdPushConstants(
-        commandBuffer, 
-        pipelineLayout,
-        VK_SHADER_STAGE_VERTEX_BIT, 
-        0, sizeof(VertexPushConstants), 
-        &vertexPushConstants
-    );
-
-    // Draw entities
-    if (entityCount > 0) {
-        // Bind vertex buffer: only geometry vertices (SoA uses storage buffers for entity data)
-        VkBuffer vertexBuffers[] = {
-            resourceCoordinator->getGraphicsManager()->getVertexBuffer()      // Vertex positions for triangle geometry
-        };
-        VkDeviceSize offsets[] = {0};
-        vk.vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-        
-        // Bind index buffer for triangle geometry
-        vk.vkCmdBindIndexBuffer(
-            commandBuffer, resourceCoordinator->getGraphicsManager()->getIndexBuffer(), 0, VK_INDEX_TYPE_UINT16);
-        
-        // Draw indexed instances: all entities with triangle geometry
-        vk.vkCmdDrawIndexed(
+    if (frameState.density) {
+        // Zoomed out: one full-screen triangle over the splatted density instead of the entity triangles
+        vk.vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT,
+                              0, sizeof(ResolvePushConstants), &resolvePushConstants);
+        vk.vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+        FRAME_GRAPH_DEBUG_LOG_THROTTLED(drawCounter, 1800, "EntityGraphicsNode: Resolved " << entityCount << " entities as density");
+    } else {
+        vk.vkCmdPushConstants(
             commandBuffer, 
-            resourceCoordinator->getGraphicsManager()->getIndexCount(),  // Number of indices per triangle
-            entityCount,                      // Number of instances (entities)
-            0, 0, 0                          // Index/vertex/instance offsets
+            pipelineLayout,
+            VK_SHADER_STAGE_VERTEX_BIT, 
+            0, sizeof(VertexPushConstants), 
+            &vertexPushConstants
         );
         
-        // Debug: confirm draw call (thread-safe)
-        FRAME_GRAPH_DEBUG_LOG_THROTTLED(drawCounter, 1800, "EntityGraphicsNode: Drew " << entityCount << " entities with " << resourceCoordinator->getGraphicsManager()->getIndexCount() << " indices per triangle");
+        if (frameState.vertexPulling) {
+            // Corners and entity data are pulled in vertex_pulled.vert, so nothing goes through the input assembler
+            vk.vkCmdDraw(commandBuffer, 3 * entityCount, 1, 0, 0);
+            FRAME_GRAPH_DEBUG_LOG_THROTTLED(drawCounter, 1800, "EntityGraphicsNode: Drew " << entityCount << " entities with vertex pulling");
+        } else {
+            // Bind vertex buffer: only geometry vertices (SoA uses storage buffers for entity data)
+            VkBuffer vertexBuffers[] = {
+                resourceCoordinator->getGraphicsManager()->getVertexBuffer()      // Vertex positions for triangle geometry
+            };
+            VkDeviceSize offsets[] = {0};
+            vk.vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+            
+            // Bind index buffer for triangle geometry
+            vk.vkCmdBindIndexBuffer(
+                commandBuffer, resourceCoordinator->getGraphicsManager()->getIndexBuffer(), 0, VK_INDEX_TYPE_UINT16);
+            
+            // Draw indexed instances: all entities with triangle geometry
+            vk.vkCmdDrawIndexed(
+                commandBuffer, 
+                resourceCoordinator->getGraphicsManager()->getIndexCount(),  // Number of indices per triangle
+                entityCount,                      // Number of instances (entities)
+                0, 0, 0                          // Index/vertex/instance offsets
+            );
+            
+            // Debug: confirm draw call (thread-safe)
+            FRAME_GRAPH_DEBUG_LOG_THROTTLED(drawCounter, 1800, "EntityGraphicsNode: Drew " << entityCount << " entities with " << resourceCoordinator->getGraphicsManager()->getIndexCount() << " indices per triangle");
+        }
     }
 
     // End dynamic rendering
     vk.vkCmdEndRendering(commandBuffer);
+    
+    if (frameState.offscreen) {
+        recordUpscale(commandBuffer, context, frameState, swapchainImage);
+    }
+    
+    if (frameState.timestampSlot != UINT32_MAX) {
+        vk.vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, timestampQueryPool.get(), firstQuery + 1);
+    }
 }
 
 void EntityGraphicsNode::updateUniformBuffer() {
@@ -243,77 +302,549 @@ void EntityGraphicsNode::updateUniformBuffer() {
     // Check if uniform buffer needs updating for this frame index
     bool needsUpdate = uniformBufferDirty || (lastUpdatedFrameIndex != currentFrameIndex);
     
-    struct UniformBufferObject {
-        glm::mat4 view;
-        glm::mat4 proj;
-    } newUBO{};
+    CachedUBO newUBO = getCameraMatrices();
+    
+    // Check if matrices actually changed (avoid memcmp by comparing key components)
+    bool matricesChanged = (newUBO.view != cachedUBO.view) || (newUBO.proj != cachedUBO.proj);
+    
+    // Only update if dirty, frame changed, or matrices changed
+    if (needsUpdate || matricesChanged) {
+        if (updateUniformBufferData(newUBO)) {
+            // Debug optimized updates (once every 30 seconds) - thread-safe
+            FRAME_GRAPH_DEBUG_LOG_THROTTLED(updateCounter, 1800, "EntityGraphicsNode: Updated uniform buffer (optimized)");
+        }
+    }
+}
 
-    // Get camera matrices from service
-    auto& cameraService = ServiceLocator::instance().requireService<CameraService>();
-    newUBO.view = cameraService.getViewMatrix();
-    newUBO.proj = cameraService.getProjectionMatrix();
+void EntityGraphicsNode::setFrameCamera(const CameraSnapshot& camera) {
+    frameCamera.view = camera.view;
+    frameCamera.proj = camera.proj;
+    frameCameraTicksNS = camera.sampleTicksNS;
+    hasFrameCamera = camera.sampleTicksNS != 0;
+}
+
+EntityGraphicsNode::CachedUBO EntityGraphicsNode::getLatchedCameraMatrices(const CachedUBO& preparedCamera) {
+    if (cameraFeed) {
+        CameraSnapshot latest = cameraFeed->read();
+        if (latest.sampleTicksNS != 0) {
+            cameraSampleTicksNS.store(latest.sampleTicksNS, std::memory_order_relaxed);
+            return {latest.view, latest.proj};
+        }
+    }
+    
+    // Sample time was already recorded when prepareFrameState() took the snapshot
+    return preparedCamera;
+}
+
+EntityGraphicsNode::CachedUBO EntityGraphicsNode::getCameraMatrices() {
+    CachedUBO matrices{};
+    
+    if (hasFrameCamera) {
+        matrices = frameCamera;
+        cameraSampleTicksNS.store(frameCameraTicksNS, std::memory_order_relaxed);
+    } else {
+        // Get camera matrices from service
+        if (!cameraService) {
+            cameraService = ServiceLocator::instance().resolveService<CameraService>();
+            if (!cameraService) {
+                throw std::runtime_error("Required service not found: CameraService");
+            }
+        }
+        matrices.view = cameraService->getViewMatrix();
+        matrices.proj = cameraService->getProjectionMatrix();
+        cameraSampleTicksNS.store(SDL_GetTicksNS(), std::memory_order_relaxed);
+    }
     
     // Debug camera matrix application (once every 30 seconds) - thread-safe
     if constexpr (FRAME_GRAPH_DEBUG_ENABLED) {
         uint32_t counter = FrameGraphDebug::incrementCounter(debugCounter);
         if (counter % 1800 == 0) {
             std::cout << "[FrameGraph Debug] EntityGraphicsNode: Using camera matrices from service (occurrence #" << counter << ")" << std::endl;
-            std::cout << "  View matrix[3]: " << newUBO.view[3][0] << ", " << newUBO.view[3][1] << ", " << newUBO.view[3][2] << std::endl;
-            std::cout << "  Proj matrix[0][0]: " << newUBO.proj[0][0] << ", [1][1]: " << newUBO.proj[1][1] << std::endl;
+            std::cout << "  View matrix[3]: " << matrices.view[3][0] << ", " << matrices.view[3][1] << ", " << matrices.view[3][2] << std::endl;
+            std::cout << "  Proj matrix[0][0]: " << matrices.proj[0][0] << ", [1][1]: " << matrices.proj[1][1] << std::endl;
         }
     }
     
     // If no valid matrices, use fallback
-    if (newUBO.view == glm::mat4(0.0f) || newUBO.proj == glm::mat4(0.0f)) {
+    if (matrices.view == glm::mat4(0.0f) || matrices.proj == glm::mat4(0.0f)) {
         // Original fallback matrices when no world is set
-        newUBO.view = glm::mat4(1.0f);
-        newUBO.proj = glm::ortho(-4.0f, 4.0f, -3.0f, 3.0f, -5.0f, 5.0f);
-        newUBO.proj[1][1] *= -1; // Flip Y for Vulkan
+        matrices.view = glm::mat4(1.0f);
+        matrices.proj = glm::ortho(-4.0f, 4.0f, -3.0f, 3.0f, -5.0f, 5.0f);
+        matrices.proj[1][1] *= -1; // Flip Y for Vulkan
         
         FRAME_GRAPH_DEBUG_LOG_THROTTLED(debugCounter, 1800, "EntityGraphicsNode: Using fallback matrices - no world reference");
     }
     
-    // Check if matrices actually changed (avoid memcmp by comparing key components)
-    bool matricesChanged = (newUBO.view != cachedUBO.view) || (newUBO.proj != cachedUBO.proj);
+    return matrices;
+}
+
+bool EntityGraphicsNode::updateUniformBufferData(const CachedUBO& ubo) {
+    auto uniformBuffers = resourceCoordinator->getGraphicsManager()->getUniformBuffersMapped();
     
-    // Only update if dirty, frame changed, or matrices changed
-    if (needsUpdate || matricesChanged) {
-        auto uniformBuffers = resourceCoordinator->getGraphicsManager()->getUniformBuffersMapped();
+    // Auto-recreate uniform buffers if they were destroyed (e.g., during resize)
+    if (uniformBuffers.empty()) {
+        std::cout << "EntityGraphicsNode: Uniform buffers missing, attempting to recreate..." << std::endl;
+        if (resourceCoordinator->getGraphicsManager()->createAllGraphicsResources()) {
+            std::cout << "EntityGraphicsNode: Successfully recreated graphics resources" << std::endl;
+            uniformBuffers = resourceCoordinator->getGraphicsManager()->getUniformBuffersMapped();
+        } else {
+            std::cerr << "EntityGraphicsNode: CRITICAL ERROR: Failed to recreate graphics resources!" << std::endl;
+            return false;
+        }
+    }
+    
+    if (uniformBuffers.empty() || currentFrameIndex >= uniformBuffers.size()) {
+        std::cerr << "EntityGraphicsNode: ERROR: invalid currentFrameIndex (" << currentFrameIndex 
+                 << ") or uniformBuffers size (" << uniformBuffers.size() << ")!" << std::endl;
+        return false;
+    }
+    
+    void* data = uniformBuffers[currentFrameIndex];
+    if (!data) {
+        return false;
+    }
+    memcpy(data, &ubo, sizeof(ubo));
+    
+    // Update cache and tracking
+    cachedUBO = ubo;
+    uniformBufferDirty = false;
+    lastUpdatedFrameIndex = currentFrameIndex;
+    return true;
+}
+
+void EntityGraphicsNode::prepareRecording(const FrameGraph& frameGraph, float time, float deltaTime) {
+    preparedState = {};
+    if (!graphicsManager || !swapchain || !resourceCoordinator || !gpuEntityManager) {
+        return;
+    }
+    if (gpuEntityManager->getEntityCount() == 0) {
+        return;
+    }
+    prepareFrameState();
+}
+
+bool EntityGraphicsNode::prepareFrameState() {
+    collectGpuTimings();
+    
+    // Update uniform buffer with camera matrices (now handled by EntityDescriptorManager)
+    updateUniformBuffer();
+    preparedState.camera = cachedUBO;
+    
+    // Render scale and MSAA for this frame; targets replaced here outlive the frames still using them
+    const RenderScaleController::Setting setting = renderScaleEnabled ? renderScale.getSetting() : RenderScaleController::Setting{};
+    const VkExtent2D swapchainExtent = swapchain->getExtent();
+    preparedState.renderExtent = {
+        std::max(1u, static_cast<uint32_t>(swapchainExtent.width * setting.scale)),
+        std::max(1u, static_cast<uint32_t>(swapchainExtent.height * setting.scale))
+    };
+    preparedState.samples = setting.samples;
+    preparedState.offscreen = preparedState.renderExtent.width != swapchainExtent.width ||
+                              preparedState.renderExtent.height != swapchainExtent.height;
+    if (!swapchain->prepareRenderTargets(preparedState.samples, preparedState.offscreen)) {
+        // Full extent at the default sample count is what every device started with
+        std::cerr << "EntityGraphicsNode: Render targets unavailable, disabling dynamic resolution" << std::endl;
+        renderScaleEnabled = false;
+        preparedState.renderExtent = swapchainExtent;
+        preparedState.samples = RenderScaleController::Setting{}.samples;
+        preparedState.offscreen = false;
+        if (!swapchain->prepareRenderTargets(preparedState.samples, false)) {
+            return false;
+        }
+    }
+    
+    // Create graphics pipeline state for entity rendering - use Vulkan 1.3 descriptor indexing
+    auto layoutSpec = DescriptorLayoutPresets::createEntityIndexedLayout();
+    VkDescriptorSetLayout descriptorLayout = graphicsManager->getLayoutManager()->getLayout(layoutSpec);
+    
+    // The LOD follows the uniform buffer camera; a late-latched camera differs by at most one sample
+    preparedState.density = selectDensityLod(cachedUBO.proj * cachedUBO.view);
+    if (preparedState.density) {
+        ComputePipelineState splatState = ComputePipelinePresets::createDensitySplatState(descriptorLayout);
+        preparedState.splatPipeline = computeManager->getPipeline(splatState);
+        preparedState.splatLayout = computeManager->getPipelineLayout(splatState);
         
-        // Auto-recreate uniform buffers if they were destroyed (e.g., during resize)
-        if (uniformBuffers.empty()) {
-            std::cout << "EntityGraphicsNode: Uniform buffers missing, attempting to recreate..." << std::endl;
-            if (resourceCoordinator->getGraphicsManager()->createAllGraphicsResources()) {
-                std::cout << "EntityGraphicsNode: Successfully recreated graphics resources" << std::endl;
-                uniformBuffers = resourceCoordinator->getGraphicsManager()->getUniformBuffersMapped();
-            } else {
-                std::cerr << "EntityGraphicsNode: CRITICAL ERROR: Failed to recreate graphics resources!" << std::endl;
-                return;
-            }
+        GraphicsPipelineState resolveState = GraphicsPipelinePresets::createDensityResolveStateDynamic(
+            descriptorLayout, swapchain->getImageFormat(), preparedState.samples);
+        preparedState.pipeline = graphicsManager->getPipeline(resolveState);
+        preparedState.layout = graphicsManager->getPipelineLayout(resolveState);
+        preparedState.valid = preparedState.pipeline != VK_NULL_HANDLE && preparedState.layout != VK_NULL_HANDLE &&
+                              preparedState.splatPipeline != VK_NULL_HANDLE && preparedState.splatLayout != VK_NULL_HANDLE;
+        if (preparedState.valid) {
+            reserveTimestampSlot();
+            return true;
         }
         
-        if (!uniformBuffers.empty() && currentFrameIndex < uniformBuffers.size()) {
-            void* data = uniformBuffers[currentFrameIndex];
-            if (data) {
-                memcpy(data, &newUBO, sizeof(newUBO));
-                
-                // Update cache and tracking
-                cachedUBO.view = newUBO.view;
-                cachedUBO.proj = newUBO.proj;
-                uniformBufferDirty = false;
-                lastUpdatedFrameIndex = currentFrameIndex;
-                
-                // Debug optimized updates (once every 30 seconds) - thread-safe
-                FRAME_GRAPH_DEBUG_LOG_THROTTLED(updateCounter, 1800, "EntityGraphicsNode: Updated uniform buffer (optimized)");
+        // Fall back to triangles rather than drawing nothing
+        std::cerr << "EntityGraphicsNode: Density LOD pipelines unavailable, drawing triangles" << std::endl;
+        preparedState.density = false;
+        preparedState.splatPipeline = VK_NULL_HANDLE;
+        preparedState.splatLayout = VK_NULL_HANDLE;
+        densityLodUnavailable = true;
+        densityLodActive = false;
+    }
+    
+    const EntityDrawPath path = selectDrawPath();
+    preparedState.vertexPulling = path == EntityDrawPath::VertexPulling;
+    if (preparedState.vertexPulling) {
+        GraphicsPipelineState pulledState = GraphicsPipelinePresets::createEntityRenderingStateVertexPulling(
+            descriptorLayout, swapchain->getImageFormat(), preparedState.samples);
+        preparedState.pipeline = graphicsManager->getPipeline(pulledState);
+        preparedState.layout = graphicsManager->getPipelineLayout(pulledState);
+        preparedState.valid = preparedState.pipeline != VK_NULL_HANDLE && preparedState.layout != VK_NULL_HANDLE;
+        
+        // Fall back to the indexed draw, which only needs the prebuilt vertex.vert
+        if (!preparedState.valid) {
+            std::cerr << "EntityGraphicsNode: Vertex pulling pipeline unavailable, using indexed draw" << std::endl;
+            preparedState.vertexPulling = false;
+            drawPath = EntityDrawPath::Indexed;
+            drawBenchmark = {};
+        }
+    }
+    
+    if (!preparedState.vertexPulling) {
+        // Create graphics pipeline state for dynamic rendering (no render pass needed)
+        GraphicsPipelineState pipelineState = GraphicsPipelinePresets::createEntityRenderingStateDynamic(
+            descriptorLayout, 
+            swapchain->getImageFormat(),  // Color format for dynamic rendering
+            VK_FORMAT_UNDEFINED,          // No depth format
+            preparedState.samples         // MSAA samples
+        );
+        
+        // Get pipeline and layout
+        preparedState.pipeline = graphicsManager->getPipeline(pipelineState);
+        preparedState.layout = graphicsManager->getPipelineLayout(pipelineState);
+        preparedState.valid = preparedState.pipeline != VK_NULL_HANDLE && preparedState.layout != VK_NULL_HANDLE;
+    }
+    
+    if (preparedState.valid) {
+        reserveTimestampSlot();
+    }
+    return preparedState.valid;
+}
+
+void EntityGraphicsNode::reserveTimestampSlot() {
+    // Time this frame if anything consumes the result and the next query pair has been read back
+    const bool benchmarkFrame = isDrawPathBenchmarkRunning() && !preparedState.density;
+    const uint32_t slot = nextTimestampSlot;
+    if (!timestampQueryPool || (!benchmarkFrame && !renderScaleEnabled) || timedFrames[slot].pending) {
+        return;
+    }
+    
+    TimedFrame& timed = timedFrames[slot];
+    timed.pending = true;
+    timed.benchmark = benchmarkFrame;
+    timed.path = preparedState.vertexPulling ? EntityDrawPath::VertexPulling : EntityDrawPath::Indexed;
+    timed.entities = gpuEntityManager->getEntityCount();
+    timed.renderScaleGeneration = renderScale.getGeneration();
+    if (benchmarkFrame) {
+        drawBenchmark.submitted[static_cast<uint32_t>(timed.path)]++;
+    }
+    
+    // Reset on the host so the pair reads as not ready until this frame writes it; a reset recorded
+    // in the command buffer would leave the previous results visible until the GPU reaches it
+    timestampContext->getLoader().vkResetQueryPool(timestampContext->getDevice(), timestampQueryPool.get(), slot * 2, 2);
+    nextTimestampSlot = (slot + 1) % MAX_FRAMES_IN_FLIGHT;
+    preparedState.timestampSlot = slot;
+}
+
+void EntityGraphicsNode::setRenderScaleConfig(const RenderScaleController::Config& config, bool enabled) {
+    renderScaleConfig = config;
+    renderScaleEnabled = enabled;
+    
+    // Before onFirstUse() the device limits are unknown; it configures the controller then
+    if (supportedSampleCounts != 0) {
+        renderScale.configure(renderScaleConfig, supportedSampleCounts, swapchain->supportsUpscaleBlit());
+    }
+}
+
+void EntityGraphicsNode::startDrawPathBenchmark(uint32_t framesPerPath) {
+    if (!timestampQueryPool) {
+        std::cerr << "EntityGraphicsNode: Draw path benchmark needs graphics queue timestamps" << std::endl;
+        return;
+    }
+    if (isDrawPathBenchmarkRunning()) {
+        std::cerr << "EntityGraphicsNode: Draw path benchmark already running" << std::endl;
+        return;
+    }
+    
+    // Pairs still in flight from a previous run stop counting with the fresh totals
+    drawBenchmark = {};
+    for (auto& timed : timedFrames) {
+        timed.benchmark = false;
+    }
+    drawBenchmark.framesPerPath = std::max(framesPerPath, 1u);
+    std::cout << "EntityGraphicsNode: Benchmarking draw paths over " << drawBenchmark.framesPerPath
+              << " frames each" << std::endl;
+}
+
+EntityDrawPath EntityGraphicsNode::selectDrawPath() const {
+    if (!isDrawPathBenchmarkRunning()) {
+        return drawPath;
+    }
+    
+    // Alternate every frame so both paths see the same scene and clocks
+    const auto& submitted = drawBenchmark.submitted;
+    const uint32_t pulled = static_cast<uint32_t>(EntityDrawPath::VertexPulling);
+    const uint32_t indexed = static_cast<uint32_t>(EntityDrawPath::Indexed);
+    if (submitted[pulled] >= drawBenchmark.framesPerPath) {
+        return EntityDrawPath::Indexed;
+    }
+    if (submitted[indexed] >= drawBenchmark.framesPerPath) {
+        return EntityDrawPath::VertexPulling;
+    }
+    return submitted[pulled] <= submitted[indexed] ? EntityDrawPath::VertexPulling : EntityDrawPath::Indexed;
+}
+
+void EntityGraphicsNode::collectGpuTimings() {
+    if (!timestampQueryPool) {
+        return;
+    }
+    
+    // Pairs are reset when reserved, so a pair reads as ready only once its own frame has written both timestamps
+    const auto& vk = timestampContext->getLoader();
+    for (uint32_t slot = 0; slot < MAX_FRAMES_IN_FLIGHT; ++slot) {
+        TimedFrame& timed = timedFrames[slot];
+        if (!timed.pending) {
+            continue;
+        }
+        
+        uint64_t timestamps[2] = {};
+        VkResult result = vk.vkGetQueryPoolResults(
+            timestampContext->getDevice(), timestampQueryPool.get(), slot * 2, 2,
+            sizeof(timestamps), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+        if (result == VK_NOT_READY) {
+            continue;
+        }
+        
+        timed.pending = false;
+        const uint32_t path = static_cast<uint32_t>(timed.path);
+        if (result != VK_SUCCESS || timestamps[1] < timestamps[0]) {
+            if (timed.benchmark && drawBenchmark.submitted[path] > 0) {
+                drawBenchmark.submitted[path]--;
             }
-        } else {
-            std::cerr << "EntityGraphicsNode: ERROR: invalid currentFrameIndex (" << currentFrameIndex 
-                     << ") or uniformBuffers size (" << uniformBuffers.size() << ")!" << std::endl;
+            continue;
+        }
+        
+        const double gpuMs = static_cast<double>(timestamps[1] - timestamps[0]) * timestampPeriodNs / 1000000.0;
+        if (timed.benchmark && isDrawPathBenchmarkRunning()) {
+            drawBenchmark.totalMs[path] += gpuMs;
+            drawBenchmark.totalEntities[path] += timed.entities;
+            drawBenchmark.samples[path]++;
+        }
+        
+        // Frames rendered under an earlier setting would skew the next decision
+        if (renderScaleEnabled && timed.renderScaleGeneration == renderScale.getGeneration()) {
+            renderScale.addSample(static_cast<float>(gpuMs));
         }
     }
+    
+    const auto& samples = drawBenchmark.samples;
+    if (!isDrawPathBenchmarkRunning() || samples[0] < drawBenchmark.framesPerPath || samples[1] < drawBenchmark.framesPerPath) {
+        return;
+    }
+    
+    std::cout << "\n⏱️  ENTITY DRAW PATH BENCHMARK (" << drawBenchmark.framesPerPath << " frames each)" << std::endl;
+    double averageMs[2] = {};
+    for (uint32_t path = 0; path < 2; ++path) {
+        averageMs[path] = drawBenchmark.totalMs[path] / samples[path];
+        const double averageEntities = drawBenchmark.totalEntities[path] / samples[path];
+        std::cout << (path == static_cast<uint32_t>(EntityDrawPath::VertexPulling) ? "Vertex pulling: " : "Indexed instanced: ")
+                  << averageMs[path] << "ms for " << static_cast<uint64_t>(averageEntities) << " entities ("
+                  << (averageMs[path] > 0.0 ? averageEntities / (averageMs[path] * 1000.0) : 0.0) << " M/s)" << std::endl;
+    }
+    std::cout << "Vertex pulling speedup: " << (averageMs[0] > 0.0 ? averageMs[1] / averageMs[0] : 0.0) << "x" << std::endl;
+    drawBenchmark = {};
+}
+
+bool EntityGraphicsNode::selectDensityLod(const glm::mat4& viewProj) {
+    if (densityLodUnavailable) {
+        densityLodActive = false;
+        return false;
+    }
+    if (lodMode != EntityLodMode::Auto) {
+        densityLodActive = lodMode == EntityLodMode::Density;
+        return densityLodActive;
+    }
+    
+    // Clip space spans two units across the viewport, so a world unit covers |column 0| * width / 2 pixels
+    const float pixelsPerUnit = glm::length(glm::vec2(viewProj[0][0], viewProj[0][1])) *
+                                static_cast<float>(swapchain->getExtent().width) * 0.5f;
+    const float entityPixels = 2.0f * COLLISION_BOUNDING_RADIUS * pixelsPerUnit;
+    
+    if (!densityLodActive && entityPixels < DENSITY_LOD_ENTER_PIXELS) {
+        densityLodActive = true;
+        std::cout << "EntityGraphicsNode: Entities cover " << entityPixels << "px, switching to density LOD" << std::endl;
+    } else if (densityLodActive && entityPixels > DENSITY_LOD_EXIT_PIXELS) {
+        densityLodActive = false;
+        std::cout << "EntityGraphicsNode: Entities cover " << entityPixels << "px, switching to triangles" << std::endl;
+    }
+    return densityLodActive;
+}
+
+void EntityGraphicsNode::recordDensitySplat(VkCommandBuffer commandBuffer, const VulkanContext* context,
+                                            const PreparedState& state, const DensityPushConstants& pushConstants) const {
+    const auto& vk = context->getLoader();
+    VkBuffer densityBuffer = gpuEntityManager->getBufferManager().getDensityBuffer();
+    VkDescriptorSet descriptorSet = gpuEntityManager->getDescriptorManager().getIndexedDescriptorSet();
+    
+    VkMemoryBarrier2 memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &memoryBarrier;
+    
+    // The previous frame's splat and resolve on this queue must be done with the texels
+    memoryBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+    memoryBarrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+    memoryBarrier.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+    
+    const VkDeviceSize texelBytes = static_cast<VkDeviceSize>(pushConstants.densityWidth) *
+                                    pushConstants.densityHeight * sizeof(glm::uvec4);
+    vk.vkCmdFillBuffer(commandBuffer, densityBuffer, 0, texelBytes, 0);
+    
+    memoryBarrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    memoryBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    memoryBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+    
+    vk.vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, state.splatPipeline);
+    vk.vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, state.splatLayout,
+                               0, 1, &descriptorSet, 0, nullptr);
+    vk.vkCmdPushConstants(commandBuffer, state.splatLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                          0, sizeof(DensityPushConstants), &pushConstants);
+    vk.vkCmdDispatch(commandBuffer, (pushConstants.entityCount + THREADS_PER_WORKGROUP - 1) / THREADS_PER_WORKGROUP, 1, 1);
+    
+    memoryBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    memoryBarrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+    memoryBarrier.dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+
+static VkImageMemoryBarrier2 colorImageBarrier(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+                                               VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess,
+                                               VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess) {
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = srcStage;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstStageMask = dstStage;
+    barrier.dstAccessMask = dstAccess;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    return barrier;
+}
+
+void EntityGraphicsNode::recordTargetBarriers(VkCommandBuffer commandBuffer, const VulkanContext* context,
+                                              const PreparedState& state) const {
+    // Both targets are cleared or fully resolved each frame, so their previous contents are discarded
+    std::array<VkImageMemoryBarrier2, 2> barriers{};
+    uint32_t barrierCount = 0;
+    if (state.samples != VK_SAMPLE_COUNT_1_BIT) {
+        barriers[barrierCount++] = colorImageBarrier(
+            swapchain->getMSAAColorImage(), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+    }
+    if (state.offscreen) {
+        // The previous frame's upscale blit must be done reading it
+        barriers[barrierCount++] = colorImageBarrier(
+            swapchain->getOffscreenColorImage(), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_NONE,
+            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+    }
+    if (barrierCount == 0) {
+        return;
+    }
+    
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount = barrierCount;
+    dependencyInfo.pImageMemoryBarriers = barriers.data();
+    context->getLoader().vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+
+void EntityGraphicsNode::recordUpscale(VkCommandBuffer commandBuffer, const VulkanContext* context,
+                                       const PreparedState& state, VkImage swapchainImage) const {
+    const auto& vk = context->getLoader();
+    const VkExtent2D swapchainExtent = swapchain->getExtent();
+    VkImage offscreenImage = swapchain->getOffscreenColorImage();
+    
+    // The image-available wait is at color attachment output, so the blit waits on that stage too
+    std::array<VkImageMemoryBarrier2, 2> barriers = {
+        colorImageBarrier(offscreenImage, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                          VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                          VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_READ_BIT),
+        colorImageBarrier(swapchainImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                          VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE,
+                          VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT)
+    };
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(barriers.size());
+    dependencyInfo.pImageMemoryBarriers = barriers.data();
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+    
+    VkImageBlit blit{};
+    blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    blit.srcOffsets[1] = {static_cast<int32_t>(state.renderExtent.width), static_cast<int32_t>(state.renderExtent.height), 1};
+    blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    blit.dstOffsets[1] = {static_cast<int32_t>(swapchainExtent.width), static_cast<int32_t>(swapchainExtent.height), 1};
+    vk.vkCmdBlitImage(commandBuffer, offscreenImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                      swapchainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+    
+    VkImageMemoryBarrier2 presentBarrier = colorImageBarrier(
+        swapchainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+        VK_PIPELINE_STAGE_2_BLIT_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, VK_ACCESS_2_NONE);
+    dependencyInfo.imageMemoryBarrierCount = 1;
+    dependencyInfo.pImageMemoryBarriers = &presentBarrier;
+    vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
 }
 
 // Optional dependency validation
 void EntityGraphicsNode::onFirstUse(const FrameGraph& frameGraph) {
-    // Dependencies validated in constructor
+    // Dependencies validated in constructor; device limits and the pass timestamps are set up here
+    const VulkanContext* context = frameGraph.getContext();
+    if (!context || timestampQueryPool) {
+        return;
+    }
+    
+    VkPhysicalDeviceProperties props;
+    context->getLoader().vkGetPhysicalDeviceProperties(context->getPhysicalDevice(), &props);
+    supportedSampleCounts = props.limits.framebufferColorSampleCounts;
+    renderScale.configure(renderScaleConfig, supportedSampleCounts, swapchain->supportsUpscaleBlit());
+    if (props.limits.timestampComputeAndGraphics == VK_FALSE || props.limits.timestampPeriod <= 0.0f ||
+        !context->hasHostQueryReset()) {
+        if (renderScaleEnabled) {
+            std::cerr << "EntityGraphicsNode: No graphics queue timestamps, dynamic resolution stays at full quality" << std::endl;
+        }
+        return;
+    }
+    
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount = 2 * MAX_FRAMES_IN_FLIGHT;
+    
+    VkQueryPool queryPoolHandle = VK_NULL_HANDLE;
+    VkResult result = context->getLoader().vkCreateQueryPool(context->getDevice(), &queryPoolInfo, nullptr, &queryPoolHandle);
+    if (result != VK_SUCCESS) {
+        std::cerr << "EntityGraphicsNode: Failed to create timestamp query pool: " << result << std::endl;
+        return;
+    }
+    
+    // Queries start out undefined; every pair must be reset before its first read
+    context->getLoader().vkResetQueryPool(context->getDevice(), queryPoolHandle, 0, queryPoolInfo.queryCount);
+    timestampQueryPool = vulkan_raii::make_query_pool(queryPoolHandle, context);
+    timestampPeriodNs = props.limits.timestampPeriod;
+    timestampContext = context;
 }
@@ -4,16 +4,43 @@
 #include <vulkan/vulkan.h>
 #include "../rendering/frame_graph.h"
 #include "../rendering/frame_graph_debug.h"
+#include "../core/vulkan_constants.h"
+#include "../core/vulkan_raii.h"
+#include "../monitoring/render_scale_controller.h"
+#include "../../ecs/core/service_locator.h"
 #include <flecs.h>
 #include <cstdint>
 #include <glm/glm.hpp>
+#include <array>
 #include <memory>
+#include <atomic>
 
 // Forward declarations
 class GraphicsPipelineManager;
+class ComputePipelineManager;
 class VulkanSwapchain;
 class ResourceCoordinator;
 class GPUEntityManager;
+class CameraFeed;
+struct CameraSnapshot;
+
+// Level of detail. Auto switches to the density path once an entity covers fewer than
+// DENSITY_LOD_ENTER_PIXELS on screen, and back above DENSITY_LOD_EXIT_PIXELS. The density path
+// splats every entity into a screen texel buffer with one compute pass and tone-maps it with a
+// single full-screen draw, so its raster cost follows the resolution rather than the entity count
+enum class EntityLodMode : uint32_t {
+    Auto,
+    Triangles,
+    Density
+};
+
+// How the entity triangles reach the rasterizer. VertexPulling builds each corner from gl_VertexIndex
+// and draws 3 * count non-indexed vertices with no vertex input; Indexed is the instanced draw over
+// the shared triangle vertex/index buffers, kept for comparison
+enum class EntityDrawPath : uint32_t {
+    VertexPulling,
+    Indexed
+};
 
 class EntityGraphicsNode : public FrameGraphNode {
     DECLARE_FRAME_GRAPH_NODE(EntityGraphicsNode)
@@ -24,6 +51,7 @@ public:
         FrameGraphTypes::ResourceId positionBuffer,
         FrameGraphTypes::ResourceId colorTarget,
         GraphicsPipelineManager* graphicsManager,
+        ComputePipelineManager* computeManager,
         VulkanSwapchain* swapchain,
         ResourceCoordinator* resourceCoordinator,
         GPUEntityManager* gpuEntityManager
@@ -45,13 +73,78 @@ public:
     void setCurrentSwapchainImageId(FrameGraphTypes::ResourceId currentImageId) { this->currentSwapchainImageId = currentImageId; }
     
     // Node lifecycle - standardized pattern
-    void onFirstUse(const FrameGraph& frameGraph) override;
+    void onFirstUse(const FrameGraph& frameGraph) override;
+    
+    // Parallel recording - uniform upload and pipeline lookup run on the main thread
+    void prepareRecording(const FrameGraph& frameGraph, float time, float deltaTime) override;
+    bool supportsParallelRecording() const override { return preparedState.valid; }
     
     // Set world reference for camera matrix access
     void setWorld(flecs::world* world) { this->world = world; }
     
     // Force uniform buffer update on next frame (call when camera changes)
     void markUniformBufferDirty() { uniformBufferDirty = true; }
+    
+    // Late latch: camera matrices are sampled while recording the draw and delivered as push constants
+    void setLateLatchCamera(bool enabled) { lateLatchCamera = enabled; }
+    bool isLateLatchCamera() const { return lateLatchCamera; }
+    
+    // SDL_GetTicksNS() when the camera was last sampled, 0 if never (recording may run on a worker)
+    uint64_t getCameraSampleTicksNS() const { return cameraSampleTicksNS.load(std::memory_order_relaxed); }
+    
+    // Frame packet camera: once set, the uniform buffer uses it instead of CameraService, which the
+    // render thread must not read. The late latch samples the feed when one is set
+    void setFrameCamera(const CameraSnapshot& camera);
+    void setCameraFeed(const CameraFeed* feed) { cameraFeed = feed; }
+    
+    // Zoomed-out LOD, see EntityLodMode
+    void setLodMode(EntityLodMode mode) { lodMode = mode; }
+    EntityLodMode getLodMode() const { return lodMode; }
+    bool isDensityLodActive() const { return densityLodActive; }
+    
+    // Triangle draw path, see EntityDrawPath
+    void setDrawPath(EntityDrawPath path) { drawPath = path; }
+    EntityDrawPath getDrawPath() const { return drawPath; }
+    
+    // GPU-timed A/B of the draw paths, alternating every frame until each has framesPerPath samples,
+    // then reported on stdout. Needs graphics queue timestamps; density LOD frames are not sampled
+    void startDrawPathBenchmark(uint32_t framesPerPath);
+    bool isDrawPathBenchmarkRunning() const { return drawBenchmark.framesPerPath != 0; }
+    
+    // Dynamic resolution and MSAA: with the controller enabled every frame's pass is timed and the
+    // render scale and sample count follow the budget. Disabled renders at full extent with 2x MSAA
+    void setRenderScaleConfig(const RenderScaleController::Config& config, bool enabled);
+    const RenderScaleController& getRenderScaleController() const { return renderScale; }
+    
+    // Vertex shader push constants (must match vertex.vert)
+    struct VertexPushConstants {
+        glm::mat4 viewProj{1.0f};   // Latched camera, valid when cameraLatched != 0
+        float time = 0.0f;          // Current simulation time
+        float dt = 0.0f;            // Time per frame
+        uint32_t count = 0;         // Total number of entities
+        uint32_t cameraLatched = 0; // Otherwise the shader uses the uniform buffer matrices
+    };
+    static_assert(sizeof(VertexPushConstants) == 80, "VertexPushConstants must match vertex.vert");
+    
+    // Density splat push constants (must match density_splat.comp)
+    struct DensityPushConstants {
+        glm::mat4 viewProj{1.0f};
+        uint32_t entityCount = 0;
+        uint32_t texelSize = DENSITY_MIN_TEXEL_SIZE;
+        uint32_t densityWidth = 0;
+        uint32_t densityHeight = 0;
+        glm::vec2 viewportSize{0.0f};
+        uint32_t reserved[2] = {0, 0};
+    };
+    static_assert(sizeof(DensityPushConstants) == 96, "DensityPushConstants must match density_splat.comp");
+    
+    // Density resolve push constants (must match density_resolve.frag)
+    struct ResolvePushConstants {
+        uint32_t texelSize = DENSITY_MIN_TEXEL_SIZE;
+        uint32_t densityWidth = 0;
+        float exposure = DENSITY_EXPOSURE;
+        uint32_t reserved = 0;
+    };
 
 private:
     // Internal uniform buffer update
@@ -65,8 +158,76 @@ private:
     
     // Helper methods for camera matrix management
     CachedUBO getCameraMatrices();
+    // Newest camera feed sample, or the snapshot prepareFrameState() took; never touches the camera service
+    CachedUBO getLatchedCameraMatrices(const CachedUBO& preparedCamera);
     bool updateUniformBufferData(const CachedUBO& ubo);
     
+    // Uniform update, LOD choice and pipeline lookup; shared by prepareRecording() and serial execute()
+    bool prepareFrameState();
+    
+    // Hysteresis over the on-screen entity size for LodMode::Auto
+    bool selectDensityLod(const glm::mat4& viewProj);
+    
+    // State resolved by prepareFrameState(), consumed by the next execute()
+    struct PreparedState {
+        VkPipeline pipeline = VK_NULL_HANDLE;           // Entity triangles, or the density resolve
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        VkPipeline splatPipeline = VK_NULL_HANDLE;      // Density path only
+        VkPipelineLayout splatLayout = VK_NULL_HANDLE;
+        bool density = false;
+        bool vertexPulling = false;
+        uint32_t timestampSlot = UINT32_MAX;            // Query pair, UINT32_MAX when untimed
+        VkExtent2D renderExtent{};                      // Scaled; the top-left corner of the targets
+        VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_2_BIT;
+        bool offscreen = false;                         // Render scaled, then blit to the swapchain image
+        CachedUBO camera{};                             // Uniform buffer camera, also the late latch fallback
+        bool valid = false;
+    } preparedState;
+    
+    // Clears the density texels and splats every entity, before rendering begins
+    void recordDensitySplat(VkCommandBuffer commandBuffer, const VulkanContext* context, const PreparedState& state,
+                            const DensityPushConstants& pushConstants) const;
+    
+    // Scaled render targets and the upscale blit around the rendering scope
+    void recordTargetBarriers(VkCommandBuffer commandBuffer, const VulkanContext* context, const PreparedState& state) const;
+    void recordUpscale(VkCommandBuffer commandBuffer, const VulkanContext* context, const PreparedState& state,
+                       VkImage swapchainImage) const;
+    
+    // Draw path benchmark: the path for the next frame, and folding finished query pairs into the
+    // benchmark totals and the render scale controller
+    EntityDrawPath selectDrawPath() const;
+    void collectGpuTimings();
+    void reserveTimestampSlot();
+    
+    struct DrawBenchmark {
+        uint32_t framesPerPath = 0;     // 0 when not running
+        std::array<uint32_t, 2> submitted{};
+        std::array<uint32_t, 2> samples{};
+        std::array<double, 2> totalMs{};
+        std::array<double, 2> totalEntities{};
+    } drawBenchmark;
+    
+    // What each in-flight query pair measured
+    struct TimedFrame {
+        bool pending = false;
+        bool benchmark = false;         // Triangle frame counted by the draw path benchmark
+        EntityDrawPath path = EntityDrawPath::VertexPulling;
+        uint32_t entities = 0;
+        uint32_t renderScaleGeneration = 0;
+    };
+    std::array<TimedFrame, MAX_FRAMES_IN_FLIGHT> timedFrames{};
+    uint32_t nextTimestampSlot = 0;
+    
+    // Begin/end timestamp pair per frame in flight, created on first use when the device supports it
+    vulkan_raii::QueryPool timestampQueryPool;
+    float timestampPeriodNs = 0.0f;
+    const VulkanContext* timestampContext = nullptr;
+    
+    RenderScaleController renderScale;
+    RenderScaleController::Config renderScaleConfig;
+    bool renderScaleEnabled = false;
+    VkSampleCountFlags supportedSampleCounts = 0;   // Known after onFirstUse()
+    
     // Resources
     FrameGraphTypes::ResourceId entityBufferId;
     FrameGraphTypes::ResourceId positionBufferId;
@@ -75,6 +236,7 @@ private:
     
     // External dependencies (not owned) - validated during execution
     GraphicsPipelineManager* graphicsManager;
+    ComputePipelineManager* computeManager;
     VulkanSwapchain* swapchain;
     ResourceCoordinator* resourceCoordinator;
     GPUEntityManager* gpuEntityManager;
@@ -88,6 +250,22 @@ private:
     // ECS world reference for camera matrices
     flecs::world* world = nullptr;
     
+    // Resolved on first use and again only if the camera service is replaced
+    ServiceRef<CameraService> cameraService;
+    
+    bool lateLatchCamera = true;
+    std::atomic<uint64_t> cameraSampleTicksNS{0};
+    
+    CachedUBO frameCamera{};
+    uint64_t frameCameraTicksNS = 0;
+    bool hasFrameCamera = false;
+    const CameraFeed* cameraFeed = nullptr;
+    
+    EntityLodMode lodMode = EntityLodMode::Auto;
+    bool densityLodActive = false;
+    bool densityLodUnavailable = false;  // Pipelines failed once; setLodMode does not clear it
+    EntityDrawPath drawPath = EntityDrawPath::VertexPulling;
+    
     bool uniformBufferDirty = true;  // Force update on first frame
     uint32_t lastUpdatedFrameIndex = UINT32_MAX; // Track which frame index was last updated
     
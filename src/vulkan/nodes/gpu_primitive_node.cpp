@@ -0,0 +1,96 @@
+#include "gpu_primitive_node.h"
+#include "../pipelines/gpu_primitives.h"
+#include <iostream>
+#include <stdexcept>
+
+GpuPrimitiveNode::GpuPrimitiveNode(const Config& config, GpuPrimitives* primitives)
+    : config(config)
+    , primitives(primitives) {
+    
+    if (!primitives) {
+        throw std::invalid_argument("GpuPrimitiveNode: primitives cannot be null");
+    }
+    if (!config.elementCount) {
+        throw std::invalid_argument("GpuPrimitiveNode: elementCount cannot be empty");
+    }
+    
+    const bool missingResource =
+        config.input == FrameGraphTypes::INVALID_RESOURCE ||
+        (config.operation == Operation::ExclusiveScan && config.output == FrameGraphTypes::INVALID_RESOURCE) ||
+        (config.operation == Operation::Compact && (config.values == FrameGraphTypes::INVALID_RESOURCE ||
+                                                    config.output == FrameGraphTypes::INVALID_RESOURCE ||
+                                                    config.countOutput == FrameGraphTypes::INVALID_RESOURCE)) ||
+        (config.operation == Operation::RadixSort && config.values == FrameGraphTypes::INVALID_RESOURCE);
+    if (missingResource) {
+        throw std::invalid_argument("GpuPrimitiveNode: missing resource for the configured operation");
+    }
+}
+
+std::vector<ResourceDependency> GpuPrimitiveNode::getInputs() const {
+    switch (config.operation) {
+        case Operation::ExclusiveScan:
+            return {
+                {config.input, ResourceAccess::Read, PipelineStage::ComputeShader},
+            };
+        case Operation::Compact:
+            return {
+                {config.input, ResourceAccess::Read, PipelineStage::ComputeShader},
+                {config.values, ResourceAccess::Read, PipelineStage::ComputeShader},
+            };
+        case Operation::RadixSort:
+            return {
+                {config.input, ResourceAccess::ReadWrite, PipelineStage::ComputeShader},
+                {config.values, ResourceAccess::ReadWrite, PipelineStage::ComputeShader},
+            };
+    }
+    return {};
+}
+
+std::vector<ResourceDependency> GpuPrimitiveNode::getOutputs() const {
+    switch (config.operation) {
+        case Operation::ExclusiveScan:
+            return {
+                {config.output, ResourceAccess::Write, PipelineStage::ComputeShader},
+            };
+        case Operation::Compact:
+            return {
+                {config.output, ResourceAccess::Write, PipelineStage::ComputeShader},
+                {config.countOutput, ResourceAccess::Write, PipelineStage::ComputeShader},
+            };
+        case Operation::RadixSort:
+            return {
+                {config.input, ResourceAccess::Write, PipelineStage::ComputeShader},
+                {config.values, ResourceAccess::Write, PipelineStage::ComputeShader},
+            };
+    }
+    return {};
+}
+
+void GpuPrimitiveNode::execute(VkCommandBuffer commandBuffer, const FrameGraph& frameGraph, float time, float deltaTime) {
+    const uint32_t count = config.elementCount();
+    
+    bool recorded = false;
+    switch (config.operation) {
+        case Operation::ExclusiveScan:
+            recorded = primitives->recordExclusiveScan(commandBuffer, resolve(frameGraph, config.input),
+                                                       resolve(frameGraph, config.output), count);
+            break;
+        case Operation::Compact:
+            recorded = primitives->recordCompact(commandBuffer, resolve(frameGraph, config.input),
+                                                 resolve(frameGraph, config.values), resolve(frameGraph, config.output),
+                                                 resolve(frameGraph, config.countOutput), count);
+            break;
+        case Operation::RadixSort:
+            recorded = primitives->recordRadixSort(commandBuffer, resolve(frameGraph, config.input),
+                                                   resolve(frameGraph, config.values), count, config.keyBits);
+            break;
+    }
+    
+    if (!recorded) {
+        std::cerr << "GpuPrimitiveNode: Failed to record operation " << static_cast<int>(config.operation) << std::endl;
+    }
+}
+
+GpuBufferRange GpuPrimitiveNode::resolve(const FrameGraph& frameGraph, FrameGraphTypes::ResourceId id) const {
+    return {frameGraph.getBuffer(id), 0, VK_WHOLE_SIZE};
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include "../rendering/frame_graph.h"
+#include <functional>
+
+// Forward declarations
+class GpuPrimitives;
+struct GpuBufferRange;
+
+// Runs one GpuPrimitives operation over frame graph buffers, so scans, compactions and sorts take
+// part in dependency ordering like any other compute node. Resources by operation:
+//
+//   ExclusiveScan  input -> output (may be the same resource)
+//   Compact        input (0/1 flags), values -> output, countOutput (first uint)
+//   RadixSort      input (keys), values, sorted in place
+class GpuPrimitiveNode : public FrameGraphNode {
+    DECLARE_FRAME_GRAPH_NODE(GpuPrimitiveNode)
+    
+public:
+    enum class Operation {
+        ExclusiveScan,
+        Compact,
+        RadixSort
+    };
+    
+    struct Config {
+        Operation operation = Operation::ExclusiveScan;
+        FrameGraphTypes::ResourceId input = FrameGraphTypes::INVALID_RESOURCE;
+        FrameGraphTypes::ResourceId values = FrameGraphTypes::INVALID_RESOURCE;
+        FrameGraphTypes::ResourceId output = FrameGraphTypes::INVALID_RESOURCE;
+        FrameGraphTypes::ResourceId countOutput = FrameGraphTypes::INVALID_RESOURCE;
+        std::function<uint32_t()> elementCount;     // Sampled at record time
+        uint32_t keyBits = 32;                      // RadixSort only
+    };
+    
+    GpuPrimitiveNode(const Config& config, GpuPrimitives* primitives);
+    
+    // FrameGraphNode interface
+    std::vector<ResourceDependency> getInputs() const override;
+    std::vector<ResourceDependency> getOutputs() const override;
+    void execute(VkCommandBuffer commandBuffer, const FrameGraph& frameGraph, float time, float deltaTime) override;
+    
+    // Queue requirements - recorded alongside the other compute nodes
+    bool needsComputeQueue() const override { return true; }
+    bool needsGraphicsQueue() const override { return false; }
+
+private:
+    GpuBufferRange resolve(const FrameGraph& frameGraph, FrameGraphTypes::ResourceId id) const;
+    
+    Config config;
+    
+    // External dependencies (not owned)
+    GpuPrimitives* primitives;
+};
@@ -34,8 +34,8 @@ std::vector<ResourceDependency> PhysicsComputeNode::getInputs() const {
 }
 
 std::vector<ResourceDependency> PhysicsComputeNode::getOutputs() const {
+    // The output position buffer is written by CollisionNode once contacts are resolved
     return {
-        {positionBufferId, ResourceAccess::Write, PipelineStage::ComputeShader},
         {currentPositionBufferId, ResourceAccess::Write, PipelineStage::ComputeShader},
     };
 }
@@ -47,13 +47,9 @@ void PhysicsComputeNode::execute(VkCommandBuffer commandBuffer, const FrameGraph
 
 // Virtual method implementations specific to physics computation
 BaseComputeNode::DispatchParams PhysicsComputeNode::calculateDispatchParams(uint32_t entityCount, uint32_t maxWorkgroups, bool forceChunking) {
-    // Calculate workgroups needed for both spatial map clearing and entity processing
-    const uint32_t SPATIAL_MAP_SIZE = 4096;
-    const uint32_t spatialClearWorkgroups = (SPATIAL_MAP_SIZE + THREADS_PER_WORKGROUP - 1) / THREADS_PER_WORKGROUP;
-    const uint32_t entityWorkgroups = (entityCount + THREADS_PER_WORKGROUP - 1) / THREADS_PER_WORKGROUP;
-    
-    // Use maximum of both requirements
-    const uint32_t totalWorkgroups = std::max(spatialClearWorkgroups, entityWorkgroups);
+    // One thread per entity; the spatial map is rebuilt by CollisionNode
+    const uint32_t workgroupSize = activeVariant.workgroupSize;
+    const uint32_t totalWorkgroups = (entityCount + workgroupSize - 1) / workgroupSize;
     
     return {
         totalWorkgroups,
@@ -63,7 +59,7 @@ BaseComputeNode::DispatchParams PhysicsComputeNode::calculateDispatchParams(uint
 }
 
 ComputePipelineState PhysicsComputeNode::createPipelineState(VkDescriptorSetLayout descriptorLayout) {
-    return ComputePipelinePresets::createPhysicsState(descriptorLayout);
+    return ComputePipelinePresets::createPhysicsState(descriptorLayout, activeVariant);
 }
 
 void PhysicsComputeNode::setupPushConstants(float time, float deltaTime, uint32_t entityCount, uint32_t frameCounter) {
@@ -0,0 +1,45 @@
+#include "position_readback_node.h"
+#include "../../ecs/gpu/gpu_entity_manager.h"
+#include <stdexcept>
+
+PositionReadbackNode::PositionReadbackNode(
+    FrameGraphTypes::ResourceId entityBuffer,
+    FrameGraphTypes::ResourceId positionBuffer,
+    GPUEntityManager* gpuEntityManager
+) : entityBufferId(entityBuffer)
+  , positionBufferId(positionBuffer)
+  , gpuEntityManager(gpuEntityManager) {
+    
+    if (!gpuEntityManager) {
+        throw std::invalid_argument("PositionReadbackNode: gpuEntityManager cannot be null");
+    }
+}
+
+std::vector<ResourceDependency> PositionReadbackNode::getInputs() const {
+    return {
+        {entityBufferId, ResourceAccess::Read, PipelineStage::Transfer},
+        {positionBufferId, ResourceAccess::Read, PipelineStage::Transfer},
+    };
+}
+
+std::vector<ResourceDependency> PositionReadbackNode::getOutputs() const {
+    // Only host-visible readback memory is written, which the frame graph does not track
+    return {};
+}
+
+void PositionReadbackNode::execute(VkCommandBuffer commandBuffer, const FrameGraph& frameGraph, float time, float deltaTime) {
+    // The ring records its own compute -> copy -> host barriers. Observed rows are stale while
+    // a spatial reorder is in flight, so the ring keeps its last samples until the mapping catches up
+    if (!gpuEntityManager->isReorderInFlight()) {
+        gpuEntityManager->getPositionReadback().recordCopies(
+            commandBuffer,
+            gpuEntityManager->getPositionBuffer(),
+            gpuEntityManager->getVelocityBuffer()
+        );
+    }
+    
+    // A snapshot resumes at the step after the one just simulated
+    if (gpuEntityManager->wantsSnapshotCapture()) {
+        gpuEntityManager->recordSnapshotCapture(commandBuffer, time + deltaTime, frameGraph.getGlobalFrameCounter() + 1);
+    }
+}
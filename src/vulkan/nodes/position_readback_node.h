@@ -0,0 +1,38 @@
+#pragma once
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include "../rendering/frame_graph.h"
+
+// Forward declarations
+class GPUEntityManager;
+
+// Copies CPUObserved rows of the physics output into GPUEntityManager's readback ring, and every
+// entity column into a pending simulation snapshot. Records on the compute command buffer right
+// after PhysicsComputeNode; a no-op while nothing is observed and no snapshot is requested
+class PositionReadbackNode : public FrameGraphNode {
+    DECLARE_FRAME_GRAPH_NODE(PositionReadbackNode)
+    
+public:
+    PositionReadbackNode(
+        FrameGraphTypes::ResourceId entityBuffer,
+        FrameGraphTypes::ResourceId positionBuffer,
+        GPUEntityManager* gpuEntityManager
+    );
+    
+    // FrameGraphNode interface
+    std::vector<ResourceDependency> getInputs() const override;
+    std::vector<ResourceDependency> getOutputs() const override;
+    void execute(VkCommandBuffer commandBuffer, const FrameGraph& frameGraph, float time, float deltaTime) override;
+    
+    // Queue requirements - copies follow physics on the compute command buffer
+    bool needsComputeQueue() const override { return true; }
+    bool needsGraphicsQueue() const override { return false; }
+
+private:
+    FrameGraphTypes::ResourceId entityBufferId;
+    FrameGraphTypes::ResourceId positionBufferId;
+    
+    // External dependencies (not owned)
+    GPUEntityManager* gpuEntityManager;
+};
@@ -0,0 +1,108 @@
+#include "spatial_query_node.h"
+#include "../pipelines/compute_pipeline_manager.h"
+#include "../pipelines/descriptor_layout_manager.h"
+#include "../core/vulkan_constants.h"
+#include "../core/vulkan_context.h"
+#include "../core/vulkan_function_loader.h"
+#include "../../ecs/gpu/gpu_entity_manager.h"
+#include <iostream>
+#include <stdexcept>
+
+SpatialQueryNode::SpatialQueryNode(
+    FrameGraphTypes::ResourceId positionBuffer,
+    ComputePipelineManager* computeManager,
+    GPUEntityManager* gpuEntityManager
+) : positionBufferId(positionBuffer)
+  , computeManager(computeManager)
+  , gpuEntityManager(gpuEntityManager) {
+    
+    if (!computeManager) {
+        throw std::invalid_argument("SpatialQueryNode: computeManager cannot be null");
+    }
+    if (!gpuEntityManager) {
+        throw std::invalid_argument("SpatialQueryNode: gpuEntityManager cannot be null");
+    }
+}
+
+std::vector<ResourceDependency> SpatialQueryNode::getInputs() const {
+    return {
+        {positionBufferId, ResourceAccess::Read, PipelineStage::ComputeShader},
+    };
+}
+
+std::vector<ResourceDependency> SpatialQueryNode::getOutputs() const {
+    // Query and result buffers are private to the batch, which the frame graph does not track
+    return {};
+}
+
+void SpatialQueryNode::execute(VkCommandBuffer commandBuffer, const FrameGraph& frameGraph, float time, float deltaTime) {
+    // Hits are mapped to entities by row, so queries stay pending while a spatial reorder is in flight
+    SpatialQueryBatch& queries = gpuEntityManager->getSpatialQueries();
+    if (queries.getPendingCount() == 0 || gpuEntityManager->isReorderInFlight()) {
+        return;
+    }
+    
+    const VulkanContext* context = frameGraph.getContext();
+    if (!context) {
+        std::cerr << "SpatialQueryNode: Cannot get Vulkan context" << std::endl;
+        return;
+    }
+    
+    // Resolve everything before taking queries off the pending list, so a failure just retries next frame
+    auto layoutSpec = DescriptorLayoutPresets::createEntityIndexedLayout();
+    VkDescriptorSetLayout descriptorLayout = computeManager->getLayoutManager()->getLayout(layoutSpec);
+    ComputePipelineState pipelineState = ComputePipelinePresets::createSpatialQueryState(descriptorLayout);
+    VkPipeline pipeline = computeManager->getPipeline(pipelineState);
+    VkPipelineLayout pipelineLayout = computeManager->getPipelineLayout(pipelineState);
+    VkDescriptorSet descriptorSet = gpuEntityManager->getDescriptorManager().getIndexedDescriptorSet();
+    if (pipeline == VK_NULL_HANDLE || pipelineLayout == VK_NULL_HANDLE || descriptorSet == VK_NULL_HANDLE) {
+        std::cerr << "SpatialQueryNode: Failed to get spatial query pipeline or descriptor set" << std::endl;
+        return;
+    }
+    
+    if (!queries.prepareRecording()) {
+        return;
+    }
+    
+    const auto& bufferManager = gpuEntityManager->getBufferManager();
+    VkBuffer resultBuffer = bufferManager.getSpatialQueryResultBuffer();
+    queries.recordUpload(commandBuffer, bufferManager.getSpatialQueryBuffer(), resultBuffer);
+    
+    // With no entities the cleared headers already are the answer
+    const uint32_t entityCount = gpuEntityManager->getEntityCount();
+    if (entityCount > 0) {
+        const auto& vk = context->getLoader();
+        vk.vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+        vk.vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout,
+                                   0, 1, &descriptorSet, 0, nullptr);
+        
+        PushConstants pushConstants{entityCount, queries.getRecordedQueryCount(), 0, MAX_SPATIAL_QUERIES};
+        const uint32_t workgroups = (entityCount + THREADS_PER_WORKGROUP - 1) / THREADS_PER_WORKGROUP;
+        vk.vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                              0, sizeof(PushConstants), &pushConstants);
+        vk.vkCmdDispatch(commandBuffer, workgroups, 1, 1);
+        
+        // Nearest queries need every candidate's distance before the winners can be collected
+        if (queries.hasRecordedNearestQueries()) {
+            VkMemoryBarrier2 computeToCompute{};
+            computeToCompute.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+            computeToCompute.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            computeToCompute.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+            computeToCompute.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            computeToCompute.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+            
+            VkDependencyInfo dependencyInfo{};
+            dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+            dependencyInfo.memoryBarrierCount = 1;
+            dependencyInfo.pMemoryBarriers = &computeToCompute;
+            vk.vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+            
+            pushConstants.passIndex = 1;
+            vk.vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                                  0, sizeof(PushConstants), &pushConstants);
+            vk.vkCmdDispatch(commandBuffer, workgroups, 1, 1);
+        }
+    }
+    
+    queries.recordReadback(commandBuffer, resultBuffer);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include "../rendering/frame_graph.h"
+
+// Forward declarations
+class ComputePipelineManager;
+class GPUEntityManager;
+
+// Answers the frame's batched spatial queries (GPUEntityManager::getSpatialQueries) against the
+// physics output. Records on the compute command buffer after PhysicsComputeNode; a no-op without queries
+class SpatialQueryNode : public FrameGraphNode {
+    DECLARE_FRAME_GRAPH_NODE(SpatialQueryNode)
+    
+public:
+    SpatialQueryNode(
+        FrameGraphTypes::ResourceId positionBuffer,
+        ComputePipelineManager* computeManager,
+        GPUEntityManager* gpuEntityManager
+    );
+    
+    // FrameGraphNode interface
+    std::vector<ResourceDependency> getInputs() const override;
+    std::vector<ResourceDependency> getOutputs() const override;
+    void execute(VkCommandBuffer commandBuffer, const FrameGraph& frameGraph, float time, float deltaTime) override;
+    
+    // Queue requirements - the query pass follows physics on the compute command buffer
+    bool needsComputeQueue() const override { return true; }
+    bool needsGraphicsQueue() const override { return false; }
+
+private:
+    // Must match SpatialQueryPushConstants in spatial_query.comp
+    struct PushConstants {
+        uint32_t entityCount;
+        uint32_t queryCount;
+        uint32_t passIndex;
+        uint32_t hitBase;
+    };
+    
+    FrameGraphTypes::ResourceId positionBufferId;
+    
+    // External dependencies (not owned)
+    ComputePipelineManager* computeManager;
+    GPUEntityManager* gpuEntityManager;
+};
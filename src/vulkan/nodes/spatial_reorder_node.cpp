@@ -0,0 +1,177 @@
+#include "spatial_reorder_node.h"
+#include "../pipelines/compute_pipeline_manager.h"
+#include "../pipelines/compute_pipeline_variants.h"
+#include "../pipelines/descriptor_layout_manager.h"
+#include "../pipelines/gpu_primitives.h"
+#include "../core/vulkan_constants.h"
+#include "../core/vulkan_context.h"
+#include "../core/vulkan_function_loader.h"
+#include "../../ecs/gpu/gpu_entity_manager.h"
+#include <iostream>
+#include <stdexcept>
+
+SpatialReorderNode::SpatialReorderNode(
+    FrameGraphTypes::ResourceId entityBuffer,
+    FrameGraphTypes::ResourceId positionBuffer,
+    ComputePipelineManager* computeManager,
+    GpuPrimitives* gpuPrimitives,
+    GPUEntityManager* gpuEntityManager
+) : entityBufferId(entityBuffer)
+  , positionBufferId(positionBuffer)
+  , computeManager(computeManager)
+  , gpuPrimitives(gpuPrimitives)
+  , gpuEntityManager(gpuEntityManager) {
+
+    if (!computeManager) {
+        throw std::invalid_argument("SpatialReorderNode: computeManager cannot be null");
+    }
+    if (!gpuPrimitives) {
+        throw std::invalid_argument("SpatialReorderNode: gpuPrimitives cannot be null");
+    }
+    if (!gpuEntityManager) {
+        throw std::invalid_argument("SpatialReorderNode: gpuEntityManager cannot be null");
+    }
+}
+
+std::vector<ResourceDependency> SpatialReorderNode::getInputs() const {
+    // Every column is permuted in place, but the entity buffer's producer stays the compute nodes
+    return {
+        {entityBufferId, ResourceAccess::ReadWrite, PipelineStage::ComputeShader},
+        {positionBufferId, ResourceAccess::Read, PipelineStage::ComputeShader},
+    };
+}
+
+std::vector<ResourceDependency> SpatialReorderNode::getOutputs() const {
+    // Reorder and scratch buffers are private to the pass, which the frame graph does not track
+    return {};
+}
+
+void SpatialReorderNode::execute(VkCommandBuffer commandBuffer, const FrameGraph& frameGraph, float time, float deltaTime) {
+    SpatialReorder& reorder = gpuEntityManager->getSpatialReorder();
+    const uint32_t rowCount = gpuEntityManager->getEntityCount();
+    if (!reorder.beginRecording(rowCount)) {
+        return;
+    }
+
+    const VulkanContext* context = frameGraph.getContext();
+    if (!context) {
+        std::cerr << "SpatialReorderNode: Cannot get Vulkan context" << std::endl;
+        return;
+    }
+
+    auto layoutSpec = DescriptorLayoutPresets::createEntityIndexedLayout();
+    VkDescriptorSetLayout descriptorLayout = computeManager->getLayoutManager()->getLayout(layoutSpec);
+    ComputePipelineState pipelineState = ComputePipelinePresets::createSpatialReorderState(descriptorLayout);
+    VkPipeline pipeline = computeManager->getPipeline(pipelineState);
+    VkPipelineLayout pipelineLayout = computeManager->getPipelineLayout(pipelineState);
+    VkDescriptorSet descriptorSet = gpuEntityManager->getDescriptorManager().getIndexedDescriptorSet();
+    if (pipeline == VK_NULL_HANDLE || pipelineLayout == VK_NULL_HANDLE || descriptorSet == VK_NULL_HANDLE) {
+        std::cerr << "SpatialReorderNode: Failed to get spatial reorder pipeline or descriptor set" << std::endl;
+        return;
+    }
+
+    // The sort keys cover the same wrapped cells as the collision grid
+    const ComputeShaderVariant& variant = computeManager->getVariantRegistry()->getActiveVariant();
+    uint32_t gridBits = 0;
+    while ((1u << gridBits) < variant.gridWidth) {
+        gridBits++;
+    }
+
+    const auto& vk = context->getLoader();
+    const auto& bufferManager = gpuEntityManager->getBufferManager();
+    const EntitySchema& schema = bufferManager.getSchema();
+    VkBuffer reorderBuffer = bufferManager.getSpatialReorderBuffer();
+    VkBuffer scratchBuffer = bufferManager.getReorderScratchBuffer();
+    const uint32_t sectionWords = gpuEntityManager->getMaxEntities();
+    const VkDeviceSize sectionSize = static_cast<VkDeviceSize>(sectionWords) * sizeof(uint32_t);
+    const VkDeviceSize keysOffset = SPATIAL_REORDER_HEADER_WORDS * sizeof(uint32_t);
+
+    auto computeToCompute = [&]() {
+        recordBarrier(commandBuffer, context,
+                      VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+                      VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                      VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT);
+    };
+
+    // Collision output must land, and the last reorder's readback copy be done with the header
+    recordBarrier(commandBuffer, context,
+                  VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_COPY_BIT,
+                  VK_ACCESS_2_SHADER_WRITE_BIT,
+                  VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                  VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    vk.vkCmdFillBuffer(commandBuffer, reorderBuffer, 0, keysOffset, 0);
+    recordBarrier(commandBuffer, context,
+                  VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                  VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                  VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT);
+
+    PushConstants pushConstants{rowCount, PASS_KEYS, 0, 0, sectionWords, gridBits, variant.cellSize,
+                                static_cast<uint32_t>(reorder.getKeyMode())};
+    auto dispatchPass = [&](uint32_t passIndex, uint32_t threads) {
+        vk.vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+        vk.vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout,
+                                   0, 1, &descriptorSet, 0, nullptr);
+        pushConstants.passIndex = passIndex;
+        vk.vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+                              0, sizeof(PushConstants), &pushConstants);
+        vk.vkCmdDispatch(commandBuffer, (threads + THREADS_PER_WORKGROUP - 1) / THREADS_PER_WORKGROUP, 1, 1);
+    };
+
+    dispatchPass(PASS_KEYS, rowCount);
+
+    // The sort opens with its own barrier and binds its own pipelines, hence the rebind in dispatchPass
+    GpuBufferRange keys{reorderBuffer, keysOffset, sectionSize};
+    GpuBufferRange permutation{reorderBuffer, keysOffset + sectionSize, sectionSize};
+    if (!gpuPrimitives->recordRadixSort(commandBuffer, keys, permutation, rowCount, gridBits * 2)) {
+        std::cerr << "SpatialReorderNode: Failed to record key sort, reorder skipped" << std::endl;
+        reorder.cancel();
+        return;
+    }
+    computeToCompute();
+
+    dispatchPass(PASS_INVERSE, rowCount);
+    computeToCompute();
+    dispatchPass(PASS_METRIC, rowCount);
+
+    // Each column goes to scratch in the old order, then is gathered back through the permutation
+    for (uint32_t column : EntityBufferManager::REORDERED_COLUMNS) {
+        const VkDeviceSize stride = schema.getStride(column);
+        if (stride == 0) {
+            continue;
+        }
+
+        recordBarrier(commandBuffer, context,
+                      VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT,
+                      VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT);
+        VkBufferCopy region{};
+        region.size = stride * rowCount;
+        vk.vkCmdCopyBuffer(commandBuffer, bufferManager.getColumnBuffer(column), scratchBuffer, 1, &region);
+        recordBarrier(commandBuffer, context,
+                      VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                      VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                      VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT);
+
+        pushConstants.column = column;
+        pushConstants.strideWords = static_cast<uint32_t>(stride / sizeof(uint32_t));
+        dispatchPass(PASS_GATHER, rowCount * pushConstants.strideWords);
+    }
+
+    reorder.recordReadback(commandBuffer, reorderBuffer, rowCount);
+}
+
+void SpatialReorderNode::recordBarrier(VkCommandBuffer commandBuffer, const VulkanContext* context,
+                                       VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess,
+                                       VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess) const {
+    VkMemoryBarrier2 memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    memoryBarrier.srcStageMask = srcStage;
+    memoryBarrier.srcAccessMask = srcAccess;
+    memoryBarrier.dstStageMask = dstStage;
+    memoryBarrier.dstAccessMask = dstAccess;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &memoryBarrier;
+    context->getLoader().vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include "../rendering/frame_graph.h"
+
+// Forward declarations
+class ComputePipelineManager;
+class GPUEntityManager;
+class GpuPrimitives;
+class VulkanContext;
+
+/**
+ * Periodic spatial reorder of the entity rows (GPUEntityManager::getSpatialReorder), recorded on
+ * the compute command buffer after CollisionNode. A no-op except on frames the reorder is due:
+ *
+ *   keys     Morton or cell key per row from the output position, identity permutation, coherence before
+ *   sort     GpuPrimitives radix sort of the keys carrying the permutation
+ *   inverse  old row -> new row, then coherence after over the cell chains the collision pass built
+ *   gather   every column in EntityBufferManager::REORDERED_COLUMNS, one copy to scratch + gather each
+ *
+ * The permutation is read back so the ECS row mapping follows once the frame completes.
+ */
+class SpatialReorderNode : public FrameGraphNode {
+    DECLARE_FRAME_GRAPH_NODE(SpatialReorderNode)
+
+public:
+    SpatialReorderNode(
+        FrameGraphTypes::ResourceId entityBuffer,
+        FrameGraphTypes::ResourceId positionBuffer,
+        ComputePipelineManager* computeManager,
+        GpuPrimitives* gpuPrimitives,
+        GPUEntityManager* gpuEntityManager
+    );
+
+    // FrameGraphNode interface
+    std::vector<ResourceDependency> getInputs() const override;
+    std::vector<ResourceDependency> getOutputs() const override;
+    void execute(VkCommandBuffer commandBuffer, const FrameGraph& frameGraph, float time, float deltaTime) override;
+
+    // Queue requirements - the reorder follows collision on the compute command buffer
+    bool needsComputeQueue() const override { return true; }
+    bool needsGraphicsQueue() const override { return false; }
+
+private:
+    // Must match SpatialReorderPushConstants in spatial_reorder.comp
+    struct PushConstants {
+        uint32_t rowCount;
+        uint32_t passIndex;
+        uint32_t column;
+        uint32_t strideWords;
+        uint32_t sectionWords;
+        uint32_t gridBits;
+        float cellSize;
+        uint32_t keyMode;
+    };
+
+    enum Pass : uint32_t {
+        PASS_KEYS = 0,
+        PASS_INVERSE = 1,
+        PASS_METRIC = 2,
+        PASS_GATHER = 3
+    };
+
+    void recordBarrier(VkCommandBuffer commandBuffer, const VulkanContext* context,
+                       VkPipelineStageFlags2 srcStage, VkAccessFlags2 srcAccess,
+                       VkPipelineStageFlags2 dstStage, VkAccessFlags2 dstAccess) const;
+
+    FrameGraphTypes::ResourceId entityBufferId;
+    FrameGraphTypes::ResourceId positionBufferId;
+
+    // External dependencies (not owned)
+    ComputePipelineManager* computeManager;
+    GpuPrimitives* gpuPrimitives;
+    GPUEntityManager* gpuEntityManager;
+};
@@ -1,4 +1,5 @@
 #include "compute_pipeline_cache.h"
+#include "../core/deferred_destruction_queue.h"
 #include <iostream>
 #include <algorithm>
 
@@ -63,7 +64,11 @@ void ComputePipelineCache::insert(const ComputePipelineState& state, std::unique
     pipeline->lastUsedFrame = ++frameCounter_;
     updateStats(false, pipeline->compilationTime);
     
-    cache_[state] = std::move(pipeline);
+    auto& slot = cache_[state];
+    if (slot) {
+        retire(std::move(slot));
+    }
+    slot = std::move(pipeline);
     stats_.totalPipelines++;
     
     if (cache_.size() > maxCacheSize_) {
@@ -74,7 +79,7 @@ void ComputePipelineCache::insert(const ComputePipelineState& state, std::unique
 void ComputePipelineCache::optimizeCache(uint64_t currentFrame) {
     for (auto it = cache_.begin(); it != cache_.end();) {
         if (currentFrame - it->second->lastUsedFrame > CACHE_CLEANUP_INTERVAL) {
-            it = cache_.erase(it);
+            it = erase(it);
             stats_.totalPipelines--;
         } else {
             ++it;
@@ -84,6 +89,9 @@ void ComputePipelineCache::optimizeCache(uint64_t currentFrame) {
 
 void ComputePipelineCache::clear() {
     // Clear cache in dependency order - pipelines first, then layouts
+    for (auto& [state, pipeline] : cache_) {
+        retire(std::move(pipeline));
+    }
     cache_.clear();
     
     // Reset statistics to prevent corruption
@@ -94,6 +102,20 @@ void ComputePipelineCache::clear() {
     stats_.hitRatio = 0.0f;
 }
 
+size_t ComputePipelineCache::invalidateShader(const std::string& shaderPath) {
+    size_t removed = 0;
+    for (auto it = cache_.begin(); it != cache_.end();) {
+        if (it->first.shaderPath == shaderPath) {
+            it = erase(it);
+            stats_.totalPipelines--;
+            removed++;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
 void ComputePipelineCache::resetFrameStats() {
     stats_.hitRatio = static_cast<float>(stats_.cacheHits) / static_cast<float>(stats_.cacheHits + stats_.cacheMisses);
 }
@@ -112,10 +134,21 @@ void ComputePipelineCache::evictLeastRecentlyUsed() {
         }
     }
     
-    cache_.erase(lruIt);
+    erase(lruIt);
     stats_.totalPipelines--;
 }
 
+ComputePipelineCache::CacheMap::iterator ComputePipelineCache::erase(CacheMap::iterator it) {
+    retire(std::move(it->second));
+    return cache_.erase(it);
+}
+
+void ComputePipelineCache::retire(std::unique_ptr<CachedComputePipeline> pipeline) {
+    if (pipeline && deferredDestruction_) {
+        deferredDestruction_->retire(std::move(pipeline));
+    }
+}
+
 void ComputePipelineCache::updateStats(bool isHit, std::chrono::nanoseconds compilationTime) {
     if (isHit) {
         stats_.cacheHits++;
@@ -6,9 +6,12 @@
 #include <memory>
 #include <chrono>
 #include <functional>
+#include <string>
 #include "compute_pipeline_types.h"
 #include "../core/vulkan_constants.h"
 
+class DeferredDestructionQueue;
+
 class ComputePipelineCache {
 public:
     explicit ComputePipelineCache(uint32_t maxCacheSize = DEFAULT_COMPUTE_CACHE_SIZE);
@@ -31,9 +34,15 @@ public:
     void optimizeCache(uint64_t currentFrame);
     void clear();
     
+    // Drop every pipeline built from shaderPath; returns the number removed
+    size_t invalidateShader(const std::string& shaderPath);
+    
     Stats getStats() const { return stats_; }
     void resetFrameStats();
     
+    // Removed and replaced pipelines are retired here instead of destroyed, frames in flight may use them
+    void setDeferredDestruction(DeferredDestructionQueue* queue) { deferredDestruction_ = queue; }
+    
     void setCreatePipelineCallback(std::function<std::unique_ptr<CachedComputePipeline>(const ComputePipelineState&)> callback);
 
 private:
@@ -43,7 +52,11 @@ private:
     uint32_t maxCacheSize_;
     uint64_t frameCounter_ = 0;
     mutable Stats stats_;
+    DeferredDestructionQueue* deferredDestruction_ = nullptr;
     
+    using CacheMap = std::unordered_map<ComputePipelineState, std::unique_ptr<CachedComputePipeline>, ComputePipelineStateHash>;
+    CacheMap::iterator erase(CacheMap::iterator it);
+    void retire(std::unique_ptr<CachedComputePipeline> pipeline);
     void evictLeastRecentlyUsed();
     void updateStats(bool isHit, std::chrono::nanoseconds compilationTime = {});
 };
\ No newline at end of file
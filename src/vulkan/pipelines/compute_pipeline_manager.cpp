@@ -16,6 +16,7 @@
 // ComputePipelineManager implementation
 ComputePipelineManager::ComputePipelineManager(VulkanContext* ctx) 
     : context(ctx), cache_(DEFAULT_COMPUTE_CACHE_SIZE), factory_(ctx), dispatcher_(ctx), deviceInfo_(ctx) {
+    cache_.setDeferredDestruction(&ctx->getDeferredDestruction());
 }
 
 ComputePipelineManager::~ComputePipelineManager() {
@@ -51,6 +52,11 @@ bool ComputePipelineManager::initialize(ShaderManager* shaderManager,
     });
     
     // Device properties are now handled by ComputeDeviceInfo component
+    if (!deviceInfo_.initialize()) {
+        std::cerr << "Failed to initialize compute device info" << std::endl;
+        return false;
+    }
+    variants_.setDeviceInfo(&deviceInfo_);
     
     std::cout << "ComputePipelineManager initialized successfully" << std::endl;
     return true;
@@ -197,11 +203,8 @@ bool ComputePipelineManager::recreatePipelineCache() {
     isRecreating_ = true;
     std::cout << "ComputePipelineManager: Recreating pipeline cache for swapchain resize" << std::endl;
     
-    // Wait for device idle to ensure no pipelines are in use
-    const auto& vk = context->getLoader();
-    const VkDevice device = context->getDevice();
-    vk.vkDeviceWaitIdle(device);
-    
+    // No device wait: cached pipelines are retired to the deferred destruction queue and the
+    // VkPipelineCache itself is never referenced by submitted work
     // Clear async compilations to prevent race conditions
     asyncCompilations.clear();
     
@@ -288,13 +291,59 @@ ComputePipelineState ComputePipelineManager::createBufferProcessingState(const s
     return state;
 }
 
+bool ComputePipelineManager::loadVariantConfig(const std::string& path) {
+    return variants_.loadFromFile(path);
+}
+
+uint32_t ComputePipelineManager::precompileVariants() {
+    if (!layoutManager_) {
+        std::cerr << "ComputePipelineManager: Cannot precompile variants - no layout manager" << std::endl;
+        return 0;
+    }
+    
+    auto layoutSpec = DescriptorLayoutPresets::createEntityIndexedLayout();
+    VkDescriptorSetLayout descriptorLayout = layoutManager_->getLayout(layoutSpec);
+    if (descriptorLayout == VK_NULL_HANDLE) {
+        std::cerr << "ComputePipelineManager: Cannot precompile variants - no entity descriptor layout" << std::endl;
+        return 0;
+    }
+    
+    // Build every variant up front so switching never stalls a frame on pipeline compilation
+    auto startTime = std::chrono::high_resolution_clock::now();
+    uint32_t compiled = 0;
+    for (const auto& name : variants_.getVariantNames()) {
+        const ComputeShaderVariant* variant = variants_.findVariant(name);
+        const ComputePipelineState states[] = {
+            ComputePipelinePresets::createEntityMovementState(descriptorLayout, *variant),
+            ComputePipelinePresets::createPhysicsState(descriptorLayout, *variant),
+            ComputePipelinePresets::createCollisionState(descriptorLayout, *variant)
+        };
+        for (const auto& state : states) {
+            if (getPipeline(state) != VK_NULL_HANDLE) {
+                compiled++;
+            } else {
+                std::cerr << "ComputePipelineManager: Failed to precompile variant '" << name
+                          << "' for " << state.shaderPath << std::endl;
+            }
+        }
+    }
+    
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startTime);
+    std::cout << "ComputePipelineManager: Precompiled " << compiled << " variant pipeline(s) in "
+              << elapsed.count() << "ms" << std::endl;
+    return compiled;
+}
+
 // ComputePipelinePresets namespace implementation
 namespace ComputePipelinePresets {
-    ComputePipelineState createEntityMovementState(VkDescriptorSetLayout descriptorLayout) {
+    ComputePipelineState createEntityMovementState(VkDescriptorSetLayout descriptorLayout,
+                                                   const ComputeShaderVariant& variant) {
         ComputePipelineState state{};
         state.shaderPath = "shaders/movement_random.comp.spv";
         state.descriptorSetLayouts.push_back(descriptorLayout);
-        state.workgroupSizeX = THREADS_PER_WORKGROUP;  // MUST match shader local_size_x
+        state.workgroupSizeX = variant.workgroupSize;  // Drives local_size_x_id
+        state.specializationConstants = variant.toSpecializationConstants(ComputeSpecConstantIds::LOCAL_SIZE_X + 1);
         state.workgroupSizeY = 1;
         state.workgroupSizeZ = 1;
         state.isFrequentlyUsed = true;
@@ -309,11 +358,13 @@ namespace ComputePipelinePresets {
         return state;
     }
     
-    ComputePipelineState createPhysicsState(VkDescriptorSetLayout descriptorLayout) {
+    ComputePipelineState createPhysicsState(VkDescriptorSetLayout descriptorLayout,
+                                            const ComputeShaderVariant& variant) {
         ComputePipelineState state{};
         state.shaderPath = "shaders/physics.comp.spv";
         state.descriptorSetLayouts.push_back(descriptorLayout);
-        state.workgroupSizeX = THREADS_PER_WORKGROUP;  // MUST match shader local_size_x
+        state.workgroupSizeX = variant.workgroupSize;  // Drives local_size_x_id
+        state.specializationConstants = variant.toSpecializationConstants(ComputeSpecConstantIds::LOCAL_SIZE_X + 1);
         state.workgroupSizeY = 1;
         state.workgroupSizeZ = 1;
         state.isFrequentlyUsed = true;
@@ -327,6 +378,116 @@ namespace ComputePipelinePresets {
         
         return state;
     }
+    
+    ComputePipelineState createSpatialQueryState(VkDescriptorSetLayout descriptorLayout) {
+        ComputePipelineState state{};
+        state.shaderPath = "shaders/spatial_query.comp.spv";
+        state.descriptorSetLayouts.push_back(descriptorLayout);
+        state.workgroupSizeX = THREADS_PER_WORKGROUP;
+        state.workgroupSizeY = 1;
+        state.workgroupSizeZ = 1;
+        state.isFrequentlyUsed = false;
+        
+        // Must match SpatialQueryPushConstants in spatial_query.comp
+        VkPushConstantRange pushConstant{};
+        pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstant.offset = 0;
+        pushConstant.size = sizeof(uint32_t) * 4;  // entityCount, queryCount, pass, hitBase
+        state.pushConstantRanges.push_back(pushConstant);
+        
+        return state;
+    }
+    
+    ComputePipelineState createCollisionState(VkDescriptorSetLayout descriptorLayout,
+                                              const ComputeShaderVariant& variant) {
+        ComputePipelineState state{};
+        state.shaderPath = "shaders/collision.comp.spv";
+        state.descriptorSetLayouts.push_back(descriptorLayout);
+        state.workgroupSizeX = variant.workgroupSize;  // Drives local_size_x_id
+        state.specializationConstants = variant.toSpecializationConstants();
+        state.workgroupSizeY = 1;
+        state.workgroupSizeZ = 1;
+        state.isFrequentlyUsed = true;
+        
+        // Must match CollisionPushConstants in collision.comp
+        VkPushConstantRange pushConstant{};
+        pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstant.offset = 0;
+        pushConstant.size = sizeof(uint32_t) * 4;  // entityCount, pass, maxPairs, reserved
+        state.pushConstantRanges.push_back(pushConstant);
+        
+        return state;
+    }
+    
+    ComputePipelineState createSpatialReorderState(VkDescriptorSetLayout descriptorLayout) {
+        ComputePipelineState state{};
+        state.shaderPath = "shaders/spatial_reorder.comp.spv";
+        state.descriptorSetLayouts.push_back(descriptorLayout);
+        state.workgroupSizeX = THREADS_PER_WORKGROUP;
+        state.workgroupSizeY = 1;
+        state.workgroupSizeZ = 1;
+        state.isFrequentlyUsed = false;
+        
+        // Must match SpatialReorderPushConstants in spatial_reorder.comp
+        VkPushConstantRange pushConstant{};
+        pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstant.offset = 0;
+        pushConstant.size = sizeof(uint32_t) * 8;  // rowCount, pass, column, stride, section, gridBits, cellSize, keyMode
+        state.pushConstantRanges.push_back(pushConstant);
+        
+        return state;
+    }
+    
+    ComputePipelineState createDensitySplatState(VkDescriptorSetLayout descriptorLayout) {
+        ComputePipelineState state{};
+        state.shaderPath = "shaders/density_splat.comp.spv";
+        state.descriptorSetLayouts.push_back(descriptorLayout);
+        state.workgroupSizeX = THREADS_PER_WORKGROUP;
+        state.workgroupSizeY = 1;
+        state.workgroupSizeZ = 1;
+        state.isFrequentlyUsed = false;
+        
+        // Must match DensitySplatPushConstants in density_splat.comp
+        VkPushConstantRange pushConstant{};
+        pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstant.offset = 0;
+        pushConstant.size = sizeof(float) * 16 + sizeof(uint32_t) * 8;  // viewProj, count, texel grid, viewport
+        state.pushConstantRanges.push_back(pushConstant);
+        
+        return state;
+    }
+    
+    // GpuPrimitives kernels share one layout and push constant block, only the shader differs
+    static ComputePipelineState createGpuPrimitiveState(const char* shaderPath, VkDescriptorSetLayout descriptorLayout) {
+        ComputePipelineState state{};
+        state.shaderPath = shaderPath;
+        state.descriptorSetLayouts.push_back(descriptorLayout);
+        state.workgroupSizeX = GPU_PRIMITIVE_BLOCK_SIZE;  // Fixed local_size_x, shared memory is sized for it
+        state.workgroupSizeY = 1;
+        state.workgroupSizeZ = 1;
+        state.isFrequentlyUsed = false;
+        
+        // Must match GpuPrimitives::PushConstants
+        VkPushConstantRange pushConstant{};
+        pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstant.offset = 0;
+        pushConstant.size = sizeof(uint32_t) * 5;  // count, pass, blockCount, shift, digitMask
+        state.pushConstantRanges.push_back(pushConstant);
+        
+        return state;
+    }
+    
+    ComputePipelineState createPrefixScanState(VkDescriptorSetLayout descriptorLayout) {
+        return createGpuPrimitiveState("shaders/prefix_scan.comp.spv", descriptorLayout);
+    }
+    
+    ComputePipelineState createStreamCompactState(VkDescriptorSetLayout descriptorLayout) {
+        return createGpuPrimitiveState("shaders/stream_compact.comp.spv", descriptorLayout);
+    }
+    
+    ComputePipelineState createRadixSortState(VkDescriptorSetLayout descriptorLayout) {
+        return createGpuPrimitiveState("shaders/radix_sort.comp.spv", descriptorLayout);
+    }
 }
 
 void ComputePipelineManager::optimizeCache(uint64_t currentFrame) {
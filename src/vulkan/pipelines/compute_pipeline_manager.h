@@ -18,6 +18,7 @@
 #include "compute_pipeline_factory.h"
 #include "compute_dispatcher.h"
 #include "compute_device_info.h"
+#include "compute_pipeline_variants.h"
 
 class ShaderManager;
 class DescriptorLayoutManager;
@@ -56,10 +57,17 @@ public:
     ComputePipelineState createParticleSystemState(const std::string& shaderPath,
                                                   VkDescriptorSetLayout descriptorLayout);
     
+    // Specialization-constant variants of the entity compute pipelines
+    bool loadVariantConfig(const std::string& path);
+    uint32_t precompileVariants();
+    ComputeVariantRegistry* getVariantRegistry() { return &variants_; }
+    const ComputeVariantRegistry* getVariantRegistry() const { return &variants_; }
+    
     // Cache management
     void warmupCache(const std::vector<ComputePipelineState>& commonStates);
     void optimizeCache(uint64_t currentFrame);
     void clearCache();
+    size_t invalidateShader(const std::string& shaderPath) { return cache_.invalidateShader(shaderPath); }
     
     // Pipeline cache recreation for swapchain resize operations
     bool recreatePipelineCache();
@@ -134,6 +142,7 @@ private:
     ComputePipelineFactory factory_;
     ComputeDispatcher dispatcher_;
     ComputeDeviceInfo deviceInfo_;
+    ComputeVariantRegistry variants_;
     
     // Async compilation tracking
     std::unordered_map<ComputePipelineState, std::future<std::unique_ptr<CachedComputePipeline>>, ComputePipelineStateHash> asyncCompilations;
@@ -155,10 +164,30 @@ private:
 // Utility functions for common compute patterns
 namespace ComputePipelinePresets {
     // Entity movement computation (for your use case)
-    ComputePipelineState createEntityMovementState(VkDescriptorSetLayout descriptorLayout);
+    ComputePipelineState createEntityMovementState(VkDescriptorSetLayout descriptorLayout,
+                                                   const ComputeShaderVariant& variant = ComputeShaderVariant{});
     
     // Physics computation (velocity-based position updates)
-    ComputePipelineState createPhysicsState(VkDescriptorSetLayout descriptorLayout);
+    ComputePipelineState createPhysicsState(VkDescriptorSetLayout descriptorLayout,
+                                            const ComputeShaderVariant& variant = ComputeShaderVariant{});
+    
+    // Batched spatial queries over the physics output (fixed 64-thread workgroups)
+    ComputePipelineState createSpatialQueryState(VkDescriptorSetLayout descriptorLayout);
+    
+    // Spatial map, broadphase, narrowphase and resolve passes (CollisionNode)
+    ComputePipelineState createCollisionState(VkDescriptorSetLayout descriptorLayout,
+                                              const ComputeShaderVariant& variant = ComputeShaderVariant{});
+    
+    // Sort keys, coherence metric and column gather of the periodic row reorder (fixed 64-thread workgroups)
+    ComputePipelineState createSpatialReorderState(VkDescriptorSetLayout descriptorLayout);
+    
+    // Screen-space entity density for the zoomed-out LOD (fixed 64-thread workgroups, graphics queue)
+    ComputePipelineState createDensitySplatState(VkDescriptorSetLayout descriptorLayout);
+    
+    // GpuPrimitives kernels (GPU_PRIMITIVE_BLOCK_SIZE-thread workgroups, createGpuPrimitiveLayout)
+    ComputePipelineState createPrefixScanState(VkDescriptorSetLayout descriptorLayout);
+    ComputePipelineState createStreamCompactState(VkDescriptorSetLayout descriptorLayout);
+    ComputePipelineState createRadixSortState(VkDescriptorSetLayout descriptorLayout);
     
     // Particle system update
     ComputePipelineState createParticleUpdateState(VkDescriptorSetLayout descriptorLayout);
@@ -0,0 +1,251 @@
+#include "compute_pipeline_variants.h"
+#include "compute_device_info.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    // The collision broadphase walks up to this many chain links in each of nine cells per entity;
+    // the cap keeps a crowded cell from turning one dispatch into a GPU timeout
+    constexpr uint32_t MAX_ENTITIES_PER_CELL_LIMIT = 256;
+
+    std::string trim(const std::string& text) {
+        size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return {};
+        size_t last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+
+    bool parseUint(const std::string& text, uint32_t& value) {
+        char* end = nullptr;
+        unsigned long parsed = std::strtoul(text.c_str(), &end, 10);
+        if (end == text.c_str() || *end != '\0') return false;
+        value = static_cast<uint32_t>(parsed);
+        return true;
+    }
+
+    bool parseFloat(const std::string& text, float& value) {
+        char* end = nullptr;
+        float parsed = std::strtof(text.c_str(), &end);
+        if (end == text.c_str() || *end != '\0') return false;
+        value = parsed;
+        return true;
+    }
+
+    bool parseBool(const std::string& text, bool& value) {
+        if (text == "true" || text == "1" || text == "on") { value = true; return true; }
+        if (text == "false" || text == "0" || text == "off") { value = false; return true; }
+        return false;
+    }
+}
+
+std::vector<uint32_t> ComputeShaderVariant::toSpecializationConstants(uint32_t constantCount) const {
+    std::vector<uint32_t> constants(ComputeSpecConstantIds::COUNT);
+    constants[ComputeSpecConstantIds::LOCAL_SIZE_X] = workgroupSize;
+    std::memcpy(&constants[ComputeSpecConstantIds::CELL_SIZE], &cellSize, sizeof(float));
+    constants[ComputeSpecConstantIds::GRID_WIDTH] = gridWidth;
+    constants[ComputeSpecConstantIds::MAX_ENTITIES_PER_CELL] = maxEntitiesPerCell;
+    constants[ComputeSpecConstantIds::ENABLE_COLLISIONS] = enableCollisions ? 1u : 0u;
+
+    constants.resize(std::min(constantCount, ComputeSpecConstantIds::COUNT));
+    return constants;
+}
+
+ComputeVariantRegistry::ComputeVariantRegistry() {
+    variants_[DEFAULT_VARIANT] = ComputeShaderVariant{};
+}
+
+bool ComputeVariantRegistry::loadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cout << "ComputeVariantRegistry: No variant config at " << path << ", using defaults" << std::endl;
+        return false;
+    }
+
+    std::string requestedActive;
+    std::string sectionName;
+    std::string deviceFilter;
+    ComputeShaderVariant pending{};
+    uint32_t registered = 0;
+
+    auto commitSection = [&]() {
+        if (sectionName.empty()) return;
+        if (!deviceMatches(deviceFilter)) {
+            std::cout << "ComputeVariantRegistry: Skipping variant '" << sectionName
+                      << "' (device filter '" << deviceFilter << "')" << std::endl;
+        } else if (registerVariant(sectionName, pending)) {
+            registered++;
+        }
+    };
+
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find_first_of("#;");
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        line = trim(line);
+        if (line.empty()) continue;
+
+        if (line.front() == '[' && line.back() == ']') {
+            commitSection();
+            sectionName = trim(line.substr(1, line.size() - 2));
+            deviceFilter.clear();
+            pending = ComputeShaderVariant{};
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            std::cerr << "ComputeVariantRegistry: " << path << ":" << lineNumber << ": expected key = value" << std::endl;
+            continue;
+        }
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+
+        bool parsed = true;
+        if (sectionName.empty()) {
+            if (key == "active") requestedActive = value;
+            else parsed = false;
+        } else if (key == "device") {
+            deviceFilter = value;
+        } else if (key == "workgroup_size") {
+            parsed = parseUint(value, pending.workgroupSize);
+        } else if (key == "cell_size") {
+            parsed = parseFloat(value, pending.cellSize);
+        } else if (key == "grid_width") {
+            parsed = parseUint(value, pending.gridWidth);
+        } else if (key == "max_entities_per_cell") {
+            parsed = parseUint(value, pending.maxEntitiesPerCell);
+        } else if (key == "collisions") {
+            parsed = parseBool(value, pending.enableCollisions);
+        } else {
+            parsed = false;
+        }
+
+        if (!parsed) {
+            std::cerr << "ComputeVariantRegistry: " << path << ":" << lineNumber
+                      << ": ignoring '" << key << " = " << value << "'" << std::endl;
+        }
+    }
+    commitSection();
+
+    std::cout << "ComputeVariantRegistry: Loaded " << registered << " variant(s) from " << path << std::endl;
+
+    if (!requestedActive.empty()) {
+        setActiveVariant(requestedActive);
+    }
+    return true;
+}
+
+bool ComputeVariantRegistry::registerVariant(const std::string& name, const ComputeShaderVariant& variant) {
+    std::string errorMessage;
+    if (!validateVariant(variant, errorMessage)) {
+        std::cerr << "ComputeVariantRegistry: Rejecting variant '" << name << "': " << errorMessage << std::endl;
+        return false;
+    }
+
+    variants_[name] = variant;
+    return true;
+}
+
+bool ComputeVariantRegistry::setActiveVariant(const std::string& name) {
+    if (variants_.find(name) == variants_.end()) {
+        std::cerr << "ComputeVariantRegistry: Unknown variant '" << name << "', keeping '" << activeName_ << "'" << std::endl;
+        return false;
+    }
+
+    activeName_ = name;
+    std::cout << "ComputeVariantRegistry: Active variant '" << activeName_ << "'" << std::endl;
+    return true;
+}
+
+const ComputeShaderVariant& ComputeVariantRegistry::getActiveVariant() const {
+    return variants_.at(activeName_);
+}
+
+const ComputeShaderVariant* ComputeVariantRegistry::findVariant(const std::string& name) const {
+    auto it = variants_.find(name);
+    return it != variants_.end() ? &it->second : nullptr;
+}
+
+std::vector<std::string> ComputeVariantRegistry::getVariantNames() const {
+    std::vector<std::string> names;
+    names.reserve(variants_.size());
+    for (const auto& [name, variant] : variants_) {
+        names.push_back(name);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool ComputeVariantRegistry::validateVariant(const ComputeShaderVariant& variant, std::string& errorMessage) const {
+    if (variant.workgroupSize == 0) {
+        errorMessage = "workgroup_size must be non-zero";
+        return false;
+    }
+    if (deviceInfo_) {
+        const auto& limits = deviceInfo_->getDeviceProperties().limits;
+        if (variant.workgroupSize > limits.maxComputeWorkGroupSize[0] ||
+            variant.workgroupSize > limits.maxComputeWorkGroupInvocations) {
+            errorMessage = "workgroup_size " + std::to_string(variant.workgroupSize) + " exceeds device limit";
+            return false;
+        }
+    }
+    if (variant.gridWidth == 0 || (variant.gridWidth & (variant.gridWidth - 1)) != 0) {
+        errorMessage = "grid_width must be a power of two";
+        return false;
+    }
+    if (variant.gridWidth > MAX_SPATIAL_GRID_WIDTH) {
+        errorMessage = "grid_width exceeds spatial map capacity (" + std::to_string(MAX_SPATIAL_GRID_WIDTH) + ")";
+        return false;
+    }
+    if (!(variant.cellSize > 0.0f)) {
+        errorMessage = "cell_size must be positive";
+        return false;
+    }
+    if (variant.cellSize < COLLISION_BOUNDING_RADIUS * 2.0f) {
+        // The broadphase only searches the 3x3 neighbourhood of a cell
+        errorMessage = "cell_size must be at least the collision bounding diameter (" +
+                       std::to_string(COLLISION_BOUNDING_RADIUS * 2.0f) + ")";
+        return false;
+    }
+    if (variant.maxEntitiesPerCell == 0 || variant.maxEntitiesPerCell > MAX_ENTITIES_PER_CELL_LIMIT) {
+        errorMessage = "max_entities_per_cell must be in [1, " + std::to_string(MAX_ENTITIES_PER_CELL_LIMIT) + "]";
+        return false;
+    }
+    return true;
+}
+
+bool ComputeVariantRegistry::setTunedDispatch(const std::string& dispatchName, const TunedDispatchParams& params) {
+    ComputeShaderVariant tunedVariant = getActiveVariant();
+    tunedVariant.workgroupSize = params.workgroupSize;
+
+    std::string errorMessage;
+    if (!validateVariant(tunedVariant, errorMessage)) {
+        std::cerr << "ComputeVariantRegistry: Rejecting tuning for '" << dispatchName << "': " << errorMessage << std::endl;
+        return false;
+    }
+    if (params.maxWorkgroupsPerChunk == 0) {
+        std::cerr << "ComputeVariantRegistry: Rejecting tuning for '" << dispatchName << "': zero chunk size" << std::endl;
+        return false;
+    }
+
+    tunedDispatch_[dispatchName] = params;
+    return true;
+}
+
+const TunedDispatchParams* ComputeVariantRegistry::findTunedDispatch(const std::string& dispatchName) const {
+    auto it = tunedDispatch_.find(dispatchName);
+    return it != tunedDispatch_.end() ? &it->second : nullptr;
+}
+
+bool ComputeVariantRegistry::deviceMatches(const std::string& filter) const {
+    if (filter.empty()) return true;
+    if (!deviceInfo_) return false;
+    return std::string(deviceInfo_->getDeviceProperties().deviceName).find(filter) != std::string::npos;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "../core/vulkan_constants.h"
+
+class ComputeDeviceInfo;
+
+// Specialization constant IDs - must match layout(constant_id = N) in the compute shaders
+namespace ComputeSpecConstantIds {
+    constexpr uint32_t LOCAL_SIZE_X = 0;            // layout(local_size_x_id = 0)
+    constexpr uint32_t CELL_SIZE = 1;               // float, passed as raw bits
+    constexpr uint32_t GRID_WIDTH = 2;
+    constexpr uint32_t MAX_ENTITIES_PER_CELL = 3;
+    constexpr uint32_t ENABLE_COLLISIONS = 4;       // VkBool32
+    constexpr uint32_t COUNT = 5;
+}
+
+// One compile-time configuration of the entity compute shaders
+struct ComputeShaderVariant {
+    uint32_t workgroupSize = THREADS_PER_WORKGROUP;
+    float cellSize = SPATIAL_CELL_SIZE;
+    uint32_t gridWidth = SPATIAL_GRID_WIDTH;
+    uint32_t maxEntitiesPerCell = MAX_ENTITIES_PER_CELL;
+    bool enableCollisions = true;
+
+    uint32_t getSpatialMapSize() const { return gridWidth * gridWidth; }
+
+    // Dense values indexed by constant ID, as ComputePipelineFactory maps entry i to ID i.
+    // Shaders that only use the low IDs (movement) pass a smaller count.
+    std::vector<uint32_t> toSpecializationConstants(uint32_t constantCount = ComputeSpecConstantIds::COUNT) const;
+};
+
+// Measured dispatch shape for one compute node (keyed by its dispatch name), see ComputeAutotuner
+struct TunedDispatchParams {
+    uint32_t workgroupSize = THREADS_PER_WORKGROUP;
+    uint32_t maxWorkgroupsPerChunk = MAX_WORKGROUPS_PER_CHUNK;
+};
+
+/**
+ * Named specialization-constant variants for the entity compute pipelines.
+ *
+ * Variants come from a small INI-style config so grid and workgroup tuning can change
+ * per scene or per device without touching the shaders:
+ *
+ *     active = default
+ *
+ *     [dense]
+ *     device = NVIDIA            # optional: only register when the device name contains this
+ *     workgroup_size = 128
+ *     cell_size = 1.0
+ *     grid_width = 128
+ *     max_entities_per_cell = 32
+ *     collisions = true
+ *
+ * A built-in "default" variant matching the shader defaults always exists.
+ *
+ * Tuned dispatch params override the active variant's workgroup size for the named node only.
+ */
+class ComputeVariantRegistry {
+public:
+    static constexpr const char* DEFAULT_VARIANT = "default";
+
+    ComputeVariantRegistry();
+
+    void setDeviceInfo(const ComputeDeviceInfo* deviceInfo) { deviceInfo_ = deviceInfo; }
+
+    // Missing file is not an error - the default variant stays active
+    bool loadFromFile(const std::string& path);
+
+    bool registerVariant(const std::string& name, const ComputeShaderVariant& variant);
+    bool setActiveVariant(const std::string& name);
+
+    const std::string& getActiveVariantName() const { return activeName_; }
+    const ComputeShaderVariant& getActiveVariant() const;
+    const ComputeShaderVariant* findVariant(const std::string& name) const;
+    std::vector<std::string> getVariantNames() const;
+
+    // Checks device limits and buffer sizes the variant depends on
+    bool validateVariant(const ComputeShaderVariant& variant, std::string& errorMessage) const;
+
+    // Per-node tuning, applied by BaseComputeNode when it resolves its pipeline
+    bool setTunedDispatch(const std::string& dispatchName, const TunedDispatchParams& params);
+    const TunedDispatchParams* findTunedDispatch(const std::string& dispatchName) const;
+    void clearTunedDispatch() { tunedDispatch_.clear(); }
+
+private:
+    std::unordered_map<std::string, ComputeShaderVariant> variants_;
+    std::unordered_map<std::string, TunedDispatchParams> tunedDispatch_;
+    std::string activeName_ = DEFAULT_VARIANT;
+    const ComputeDeviceInfo* deviceInfo_ = nullptr;
+
+    bool deviceMatches(const std::string& filter) const;
+};
@@ -561,13 +561,31 @@ namespace DescriptorLayoutPresets {
         spatialMapBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
         spatialMapBinding.debugName = "spatialMapBuffer";
         
-        spec.bindings = {uniformBinding, bufferArrayBinding, spatialMapBinding};
+        // Binding 3: Column device addresses for EntitySchema::ColumnAccess::DeviceAddress shaders
+        DescriptorBinding columnAddressBinding{};
+        columnAddressBinding.binding = 3;
+        columnAddressBinding.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        columnAddressBinding.descriptorCount = 1;
+        columnAddressBinding.stageFlags = VK_SHADER_STAGE_ALL;
+        columnAddressBinding.debugName = "entityColumnAddresses";
+        
+        spec.bindings = {uniformBinding, bufferArrayBinding, spatialMapBinding, columnAddressBinding};
         
         // Enable descriptor indexing features
         spec.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
         
         return spec;
     }
+    
+    DescriptorLayoutSpec createGpuPrimitiveLayout() {
+        // Binding meaning is per kernel, see prefix_scan.comp, stream_compact.comp and radix_sort.comp
+        DescriptorLayoutBuilder builder;
+        builder.setName("GpuPrimitiveBuffers");
+        for (uint32_t binding = 0; binding < 6; ++binding) {
+            builder.addStorageBuffer(binding, VK_SHADER_STAGE_COMPUTE_BIT);
+        }
+        return builder.build();
+    }
 }
 
 // DescriptorLayoutBuilder implementation
@@ -247,6 +247,9 @@ namespace DescriptorLayoutPresets {
     // Vulkan 1.3 descriptor indexing layout (replaces individual bindings)
     DescriptorLayoutSpec createEntityIndexedLayout();
     
+    // Six plain storage buffers shared by the GpuPrimitives kernels
+    DescriptorLayoutSpec createGpuPrimitiveLayout();
+    
     // Common rendering layouts
     DescriptorLayoutSpec createMaterialLayout(uint32_t textureCount = 4);
     DescriptorLayoutSpec createLightingLayout();
@@ -0,0 +1,354 @@
+#include "gpu_primitives.h"
+#include "compute_pipeline_manager.h"
+#include "descriptor_layout_manager.h"
+#include "hash_utils.h"
+#include "../core/vulkan_constants.h"
+#include "../core/vulkan_context.h"
+#include "../core/vulkan_function_loader.h"
+#include "../resources/core/resource_coordinator.h"
+#include "../resources/managers/descriptor_pool_manager.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // Pass indices, must match the shaders
+    constexpr uint32_t SCAN_PASS_REDUCE = 0;
+    constexpr uint32_t SCAN_PASS_SCAN_BLOCKS = 1;
+    constexpr uint32_t SCAN_PASS_DOWNSWEEP = 2;
+    constexpr uint32_t SORT_PASS_HISTOGRAM = 0;
+    constexpr uint32_t SORT_PASS_SCATTER = 1;
+
+    constexpr uint32_t RADIX_BUCKETS = 1u << GPU_PRIMITIVE_RADIX_BITS;
+}
+
+GpuPrimitives::~GpuPrimitives() {
+    cleanup();
+}
+
+bool GpuPrimitives::initialize(const VulkanContext& context, ComputePipelineManager* computeManager,
+                               ResourceCoordinator* resourceCoordinator, uint32_t maxElements) {
+    if (!computeManager || !resourceCoordinator || maxElements == 0) {
+        std::cerr << "GpuPrimitives: Missing compute manager, resource coordinator or element budget" << std::endl;
+        return false;
+    }
+
+    this->context = &context;
+    this->computeManager = computeManager;
+    this->resourceCoordinator = resourceCoordinator;
+    this->maxElements = maxElements;
+
+    descriptorLayout = computeManager->getLayoutManager()->getLayout(DescriptorLayoutPresets::createGpuPrimitiveLayout());
+    if (descriptorLayout == VK_NULL_HANDLE) {
+        std::cerr << "GpuPrimitives: Failed to create descriptor set layout" << std::endl;
+        cleanup();
+        return false;
+    }
+
+    DescriptorPoolManager poolManager;
+    poolManager.initialize(context);
+    DescriptorPoolManager::DescriptorPoolConfig config;
+    config.maxSets = GPU_PRIMITIVE_MAX_DESCRIPTOR_SETS;
+    config.uniformBuffers = 0;
+    config.storageBuffers = GPU_PRIMITIVE_MAX_DESCRIPTOR_SETS * MAX_BINDINGS;
+    config.sampledImages = 0;
+    config.storageImages = 0;
+    config.samplers = 0;
+    config.allowFreeDescriptorSets = false;   // Reset as a whole by invalidateDescriptorSets()
+    config.bindlessReady = false;
+    descriptorPool = poolManager.createDescriptorPool(config);
+    if (!descriptorPool) {
+        std::cerr << "GpuPrimitives: Failed to create descriptor pool" << std::endl;
+        cleanup();
+        return false;
+    }
+
+    // The sort histogram holds RADIX_BUCKETS counters per block and is scanned like any other input
+    const uint32_t maxBlocks = blockCountFor(maxElements);
+    const uint32_t maxHistogram = maxBlocks * RADIX_BUCKETS;
+    const VkDeviceSize elementsSize = static_cast<VkDeviceSize>(maxElements) * sizeof(uint32_t);
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                                     VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    blockSumBuffer = resourceCoordinator->createBuffer((blockCountFor(maxHistogram) + 1) * sizeof(uint32_t),
+                                                       usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    scanBuffer = resourceCoordinator->createBuffer(elementsSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    histogramBuffer = resourceCoordinator->createBuffer(maxHistogram * sizeof(uint32_t), usage,
+                                                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    sortKeyBuffer = resourceCoordinator->createBuffer(elementsSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    sortValueBuffer = resourceCoordinator->createBuffer(elementsSize, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (!blockSumBuffer.isValid() || !scanBuffer.isValid() || !histogramBuffer.isValid() ||
+        !sortKeyBuffer.isValid() || !sortValueBuffer.isValid()) {
+        std::cerr << "GpuPrimitives: Failed to create scratch buffers" << std::endl;
+        cleanup();
+        return false;
+    }
+
+    std::cout << "GpuPrimitives: Initialized for " << maxElements << " elements ("
+              << (elementsSize * 3 + maxHistogram * sizeof(uint32_t)) / 1024 << " KB scratch)" << std::endl;
+    return true;
+}
+
+void GpuPrimitives::cleanup() {
+    descriptorSets.clear();
+    descriptorPool.reset();
+
+    if (resourceCoordinator) {
+        for (ResourceHandle* handle : {&blockSumBuffer, &scanBuffer, &histogramBuffer, &sortKeyBuffer, &sortValueBuffer}) {
+            if (handle->isValid()) {
+                resourceCoordinator->destroyResource(*handle);
+            }
+            *handle = ResourceHandle{};
+        }
+    }
+
+    descriptorLayout = VK_NULL_HANDLE;   // Owned by the layout manager
+    resourceCoordinator = nullptr;
+    computeManager = nullptr;
+    context = nullptr;
+    maxElements = 0;
+}
+
+bool GpuPrimitives::recordExclusiveScan(VkCommandBuffer commandBuffer, const GpuBufferRange& input,
+                                        const GpuBufferRange& output, uint32_t count) {
+    if (!validateCount(count, "scan")) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    VkDescriptorSet descriptorSet = getDescriptorSet({input, output, wholeBuffer(blockSumBuffer)});
+    if (descriptorSet == VK_NULL_HANDLE) {
+        return false;
+    }
+
+    recordComputeBarrier(commandBuffer, true);
+    recordScanPasses(commandBuffer, descriptorSet, count);
+    return true;
+}
+
+bool GpuPrimitives::recordCompact(VkCommandBuffer commandBuffer, const GpuBufferRange& flags, const GpuBufferRange& values,
+                                  const GpuBufferRange& output, const GpuBufferRange& countOutput, uint32_t count) {
+    if (!validateCount(count, "compact")) {
+        return false;
+    }
+    if (count == 0) {
+        // Nothing to keep: the count is still written so indirect consumers see zero
+        const auto& vk = context->getLoader();
+        recordComputeBarrier(commandBuffer, true);
+        vk.vkCmdFillBuffer(commandBuffer, countOutput.buffer, countOutput.offset, sizeof(uint32_t), 0);
+        return true;
+    }
+
+    Kernel compact;
+    if (!resolveKernel(ComputePipelinePresets::createStreamCompactState(descriptorLayout), compact)) {
+        return false;
+    }
+
+    const GpuBufferRange scanned = wholeBuffer(scanBuffer);
+    const GpuBufferRange blockSums = wholeBuffer(blockSumBuffer);
+    VkDescriptorSet scanSet = getDescriptorSet({flags, scanned, blockSums});
+    VkDescriptorSet compactSet = getDescriptorSet({flags, scanned, values, output, countOutput, blockSums});
+    if (scanSet == VK_NULL_HANDLE || compactSet == VK_NULL_HANDLE) {
+        return false;
+    }
+
+    // Scatter offsets are the exclusive scan of the flags; the scan's total is the kept count
+    recordComputeBarrier(commandBuffer, true);
+    recordScanPasses(commandBuffer, scanSet, count);
+    recordComputeBarrier(commandBuffer);
+
+    const uint32_t blockCount = blockCountFor(count);
+    recordPass(commandBuffer, compact, compactSet, {count, 0, blockCount, 0}, blockCount);
+    return true;
+}
+
+bool GpuPrimitives::recordRadixSort(VkCommandBuffer commandBuffer, const GpuBufferRange& keys, const GpuBufferRange& values,
+                                    uint32_t count, uint32_t keyBits) {
+    if (!validateCount(count, "radix sort")) {
+        return false;
+    }
+    if (count <= 1) {
+        return true;
+    }
+
+    Kernel sort;
+    if (!resolveKernel(ComputePipelinePresets::createRadixSortState(descriptorLayout), sort)) {
+        return false;
+    }
+
+    const GpuBufferRange histogram = wholeBuffer(histogramBuffer);
+    const GpuBufferRange scratchKeys = wholeBuffer(sortKeyBuffer);
+    const GpuBufferRange scratchValues = wholeBuffer(sortValueBuffer);
+    VkDescriptorSet toScratch = getDescriptorSet({keys, values, scratchKeys, scratchValues, histogram});
+    VkDescriptorSet fromScratch = getDescriptorSet({scratchKeys, scratchValues, keys, values, histogram});
+    VkDescriptorSet histogramScan = getDescriptorSet({histogram, histogram, wholeBuffer(blockSumBuffer)});
+    if (toScratch == VK_NULL_HANDLE || fromScratch == VK_NULL_HANDLE || histogramScan == VK_NULL_HANDLE) {
+        return false;
+    }
+
+    // An even number of passes ends in the caller's buffers. Digits are masked to the low keyBits, so a
+    // partial last digit ignores the bits above it and a spare pass sees all-zero digits, a stable no-op
+    keyBits = std::min(keyBits, 32u);
+    uint32_t passCount = (keyBits + GPU_PRIMITIVE_RADIX_BITS - 1) / GPU_PRIMITIVE_RADIX_BITS;
+    passCount += passCount % 2;
+
+    const uint32_t blockCount = blockCountFor(count);
+    recordComputeBarrier(commandBuffer, true);
+    for (uint32_t pass = 0; pass < passCount; ++pass) {
+        VkDescriptorSet descriptorSet = (pass % 2 == 0) ? toScratch : fromScratch;
+        const uint32_t shift = pass * GPU_PRIMITIVE_RADIX_BITS;
+        const uint32_t digitBits = keyBits > shift ? std::min(keyBits - shift, GPU_PRIMITIVE_RADIX_BITS) : 0u;
+        PushConstants pushConstants{count, SORT_PASS_HISTOGRAM, blockCount, shift, (1u << digitBits) - 1u};
+
+        // Digit-major histogram: scanning it gives every (digit, block) its first output slot
+        recordPass(commandBuffer, sort, descriptorSet, pushConstants, blockCount);
+        recordComputeBarrier(commandBuffer);
+        recordScanPasses(commandBuffer, histogramScan, blockCount * RADIX_BUCKETS);
+        recordComputeBarrier(commandBuffer);
+
+        pushConstants.passIndex = SORT_PASS_SCATTER;
+        recordPass(commandBuffer, sort, descriptorSet, pushConstants, blockCount);
+        if (pass + 1 < passCount) {
+            recordComputeBarrier(commandBuffer);
+        }
+    }
+    return true;
+}
+
+void GpuPrimitives::invalidateDescriptorSets() {
+    if (context && descriptorPool) {
+        context->getLoader().vkResetDescriptorPool(context->getDevice(), descriptorPool.get(), 0);
+    }
+    descriptorSets.clear();
+}
+
+size_t GpuPrimitives::BindingSetHash::operator()(const BindingSet& bindings) const {
+    VulkanHash::HashCombiner hasher;
+    for (const GpuBufferRange& range : bindings) {
+        hasher.combine(reinterpret_cast<uintptr_t>(range.buffer)).combine(range.offset).combine(range.size);
+    }
+    return hasher.get();
+}
+
+bool GpuPrimitives::resolveKernel(const ComputePipelineState& state, Kernel& kernel) const {
+    kernel.pipeline = computeManager->getPipeline(state);
+    kernel.layout = computeManager->getPipelineLayout(state);
+    if (kernel.pipeline == VK_NULL_HANDLE || kernel.layout == VK_NULL_HANDLE) {
+        std::cerr << "GpuPrimitives: Failed to get pipeline for " << state.shaderPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+VkDescriptorSet GpuPrimitives::getDescriptorSet(const BindingSet& bindings) {
+    auto it = descriptorSets.find(bindings);
+    if (it != descriptorSets.end()) {
+        return it->second;
+    }
+
+    if (descriptorSets.size() >= GPU_PRIMITIVE_MAX_DESCRIPTOR_SETS) {
+        std::cerr << "GpuPrimitives: Descriptor set cache full (" << GPU_PRIMITIVE_MAX_DESCRIPTOR_SETS
+                  << " buffer combinations)" << std::endl;
+        return VK_NULL_HANDLE;
+    }
+
+    const auto& vk = context->getLoader();
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool.get();
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &descriptorLayout;
+
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+    if (vk.vkAllocateDescriptorSets(context->getDevice(), &allocInfo, &descriptorSet) != VK_SUCCESS) {
+        std::cerr << "GpuPrimitives: Failed to allocate descriptor set" << std::endl;
+        return VK_NULL_HANDLE;
+    }
+
+    // Unused bindings point at the block sums so every binding of the layout stays valid
+    std::array<VkDescriptorBufferInfo, MAX_BINDINGS> bufferInfos{};
+    std::array<VkWriteDescriptorSet, MAX_BINDINGS> writes{};
+    for (uint32_t binding = 0; binding < MAX_BINDINGS; ++binding) {
+        const GpuBufferRange& range = bindings[binding].buffer != VK_NULL_HANDLE ? bindings[binding] : wholeBuffer(blockSumBuffer);
+        bufferInfos[binding] = {range.buffer, range.offset, range.size};
+
+        writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[binding].dstSet = descriptorSet;
+        writes[binding].dstBinding = binding;
+        writes[binding].descriptorCount = 1;
+        writes[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[binding].pBufferInfo = &bufferInfos[binding];
+    }
+    vk.vkUpdateDescriptorSets(context->getDevice(), MAX_BINDINGS, writes.data(), 0, nullptr);
+
+    descriptorSets.emplace(bindings, descriptorSet);
+    return descriptorSet;
+}
+
+bool GpuPrimitives::validateCount(uint32_t count, const char* operation) const {
+    if (!isInitialized()) {
+        std::cerr << "GpuPrimitives: " << operation << " recorded before initialize()" << std::endl;
+        return false;
+    }
+    if (count > maxElements) {
+        std::cerr << "GpuPrimitives: " << operation << " of " << count << " elements exceeds the "
+                  << maxElements << " element budget" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void GpuPrimitives::recordPass(VkCommandBuffer commandBuffer, const Kernel& kernel, VkDescriptorSet descriptorSet,
+                               const PushConstants& pushConstants, uint32_t workgroups) const {
+    const auto& vk = context->getLoader();
+    vk.vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, kernel.pipeline);
+    vk.vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, kernel.layout,
+                               0, 1, &descriptorSet, 0, nullptr);
+    vk.vkCmdPushConstants(commandBuffer, kernel.layout, VK_SHADER_STAGE_COMPUTE_BIT,
+                          0, sizeof(PushConstants), &pushConstants);
+    vk.vkCmdDispatch(commandBuffer, workgroups, 1, 1);
+}
+
+void GpuPrimitives::recordComputeBarrier(VkCommandBuffer commandBuffer, bool fromTransfer) const {
+    VkMemoryBarrier2 memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    memoryBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    memoryBarrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+    memoryBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+    if (fromTransfer) {
+        memoryBarrier.srcStageMask |= VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        memoryBarrier.srcAccessMask |= VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstStageMask |= VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        memoryBarrier.dstAccessMask |= VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    }
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &memoryBarrier;
+    context->getLoader().vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+
+void GpuPrimitives::recordScanPasses(VkCommandBuffer commandBuffer, VkDescriptorSet descriptorSet, uint32_t count) const {
+    Kernel scan;
+    if (!resolveKernel(ComputePipelinePresets::createPrefixScanState(descriptorLayout), scan)) {
+        return;
+    }
+
+    const uint32_t blockCount = blockCountFor(count);
+    recordPass(commandBuffer, scan, descriptorSet, {count, SCAN_PASS_REDUCE, blockCount, 0}, blockCount);
+    recordComputeBarrier(commandBuffer);
+    recordPass(commandBuffer, scan, descriptorSet, {count, SCAN_PASS_SCAN_BLOCKS, blockCount, 0}, 1);
+    recordComputeBarrier(commandBuffer);
+    recordPass(commandBuffer, scan, descriptorSet, {count, SCAN_PASS_DOWNSWEEP, blockCount, 0}, blockCount);
+}
+
+uint32_t GpuPrimitives::blockCountFor(uint32_t count) {
+    return (count + GPU_PRIMITIVE_BLOCK_SIZE - 1) / GPU_PRIMITIVE_BLOCK_SIZE;
+}
+
+GpuBufferRange GpuPrimitives::wholeBuffer(const ResourceHandle& handle) {
+    return {handle.buffer.get(), 0, VK_WHOLE_SIZE};
+}
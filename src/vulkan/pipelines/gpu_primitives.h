@@ -0,0 +1,120 @@
+#pragma once
+
+#define VK_NO_PROTOTYPES
+#include <vulkan/vulkan.h>
+#include "compute_pipeline_types.h"
+#include "../core/vulkan_raii.h"
+#include "../resources/core/resource_handle.h"
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+// Forward declarations
+class VulkanContext;
+class ComputePipelineManager;
+class ResourceCoordinator;
+
+// A range of 32-bit elements in a storage buffer. offset must respect minStorageBufferOffsetAlignment
+struct GpuBufferRange {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = VK_WHOLE_SIZE;
+
+    bool operator==(const GpuBufferRange& other) const {
+        return buffer == other.buffer && offset == other.offset && size == other.size;
+    }
+};
+
+/**
+ * Reusable GPU parallel primitives over 32-bit elements in arbitrary VkBuffer ranges:
+ *
+ *   exclusive scan   reduce-then-scan: per-block sums, one-workgroup scan of the sums, block scan + offset
+ *   stream compact   scan of the flags, then an order-preserving scatter and a kept-element count
+ *   radix sort       stable LSD sort of uint keys carrying uint values, 4 bits per pass, in place
+ *
+ * All record* calls only record commands. They open with a barrier making earlier compute and
+ * transfer writes visible, separate their own passes, and leave the final barrier to the caller
+ * (or the frame graph, see GpuPrimitiveNode).
+ *
+ * Descriptor sets are cached per combination of ranges, so the ranges should be long-lived
+ * buffers. Call invalidateDescriptorSets() with the device idle after recreating any of them.
+ */
+class GpuPrimitives {
+public:
+    GpuPrimitives() = default;
+    ~GpuPrimitives();
+
+    // maxElements bounds count for every call; scratch buffers are sized for it
+    bool initialize(const VulkanContext& context, ComputePipelineManager* computeManager,
+                    ResourceCoordinator* resourceCoordinator, uint32_t maxElements);
+    void cleanup();
+
+    bool isInitialized() const { return context != nullptr; }
+    uint32_t getMaxElements() const { return maxElements; }
+
+    // Exclusive prefix sum of count elements; input and output may be the same range
+    bool recordExclusiveScan(VkCommandBuffer commandBuffer, const GpuBufferRange& input,
+                             const GpuBufferRange& output, uint32_t count);
+
+    // Copies values[i] with flags[i] == 1 to output, preserving order, and writes the kept count
+    // to countOutput[0]. Flags must be 0 or 1 since they are scanned into output offsets
+    bool recordCompact(VkCommandBuffer commandBuffer, const GpuBufferRange& flags, const GpuBufferRange& values,
+                       const GpuBufferRange& output, const GpuBufferRange& countOutput, uint32_t count);
+
+    // Sorts count keys ascending, moving values with them. Only the low keyBits of each key are sorted
+    bool recordRadixSort(VkCommandBuffer commandBuffer, const GpuBufferRange& keys, const GpuBufferRange& values,
+                         uint32_t count, uint32_t keyBits = 32);
+
+    // Drops every cached descriptor set. The device must be idle
+    void invalidateDescriptorSets();
+
+private:
+    static constexpr uint32_t MAX_BINDINGS = 6;
+    using BindingSet = std::array<GpuBufferRange, MAX_BINDINGS>;
+
+    struct BindingSetHash {
+        size_t operator()(const BindingSet& bindings) const;
+    };
+
+    // Must match the push constant blocks of prefix_scan.comp, stream_compact.comp and radix_sort.comp
+    struct PushConstants {
+        uint32_t count;
+        uint32_t passIndex;
+        uint32_t blockCount;
+        uint32_t shift;         // Radix sort only
+        uint32_t digitMask;     // Radix sort only: bits of this pass's digit that lie below keyBits
+    };
+
+    struct Kernel {
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+    };
+
+    bool resolveKernel(const ComputePipelineState& state, Kernel& kernel) const;
+    VkDescriptorSet getDescriptorSet(const BindingSet& bindings);
+    bool validateCount(uint32_t count, const char* operation) const;
+
+    void recordPass(VkCommandBuffer commandBuffer, const Kernel& kernel, VkDescriptorSet descriptorSet,
+                    const PushConstants& pushConstants, uint32_t workgroups) const;
+    void recordComputeBarrier(VkCommandBuffer commandBuffer, bool fromTransfer = false) const;
+    void recordScanPasses(VkCommandBuffer commandBuffer, VkDescriptorSet descriptorSet, uint32_t count) const;
+
+    static uint32_t blockCountFor(uint32_t count);
+    static GpuBufferRange wholeBuffer(const ResourceHandle& handle);
+
+    const VulkanContext* context = nullptr;
+    ComputePipelineManager* computeManager = nullptr;
+    ResourceCoordinator* resourceCoordinator = nullptr;
+    uint32_t maxElements = 0;
+
+    VkDescriptorSetLayout descriptorLayout = VK_NULL_HANDLE;
+    vulkan_raii::DescriptorPool descriptorPool;
+    std::unordered_map<BindingSet, VkDescriptorSet, BindingSetHash> descriptorSets;
+
+    // Scratch: block sums (+ total), scanned flags, radix histograms and the sort's ping-pong columns
+    ResourceHandle blockSumBuffer;
+    ResourceHandle scanBuffer;
+    ResourceHandle histogramBuffer;
+    ResourceHandle sortKeyBuffer;
+    ResourceHandle sortValueBuffer;
+};
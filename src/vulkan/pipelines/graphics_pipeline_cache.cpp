@@ -1,4 +1,5 @@
 #include "graphics_pipeline_cache.h"
+#include "../core/deferred_destruction_queue.h"
 #include <iostream>
 #include <algorithm>
 
@@ -34,7 +35,11 @@ void GraphicsPipelineCache::storePipeline(const GraphicsPipelineState& state, st
         stats_.totalCompilationTime += pipeline->compilationTime;
     }
     
-    cache_[state] = std::move(pipeline);
+    auto& slot = cache_[state];
+    if (slot) {
+        retire(std::move(slot));
+    }
+    slot = std::move(pipeline);
     
     if (cache_.size() > maxCacheSize_) {
         evictLeastRecentlyUsed();
@@ -43,6 +48,9 @@ void GraphicsPipelineCache::storePipeline(const GraphicsPipelineState& state, st
 
 void GraphicsPipelineCache::clear() {
     // Clear cache in dependency order - pipelines first, then layouts
+    for (auto& [state, pipeline] : cache_) {
+        retire(std::move(pipeline));
+    }
     cache_.clear();
     
     // Reset statistics to prevent corruption
@@ -54,10 +62,25 @@ void GraphicsPipelineCache::clear() {
     stats_.hitRatio = 0.0f;
 }
 
+size_t GraphicsPipelineCache::invalidateShader(const std::string& shaderPath) {
+    size_t removed = 0;
+    for (auto it = cache_.begin(); it != cache_.end();) {
+        const auto& stages = it->first.shaderStages;
+        if (std::find(stages.begin(), stages.end(), shaderPath) != stages.end()) {
+            it = erase(it);
+            stats_.totalPipelines--;
+            removed++;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
 void GraphicsPipelineCache::optimizeCache(uint64_t currentFrame) {
     for (auto it = cache_.begin(); it != cache_.end();) {
         if (shouldEvictPipeline(*it->second, currentFrame)) {
-            it = cache_.erase(it);
+            it = erase(it);
             stats_.totalPipelines--;
         } else {
             ++it;
@@ -75,10 +98,21 @@ void GraphicsPipelineCache::evictLeastRecentlyUsed() {
         }
     }
     
-    cache_.erase(lruIt);
+    erase(lruIt);
     stats_.totalPipelines--;
 }
 
+GraphicsPipelineCache::CacheMap::iterator GraphicsPipelineCache::erase(CacheMap::iterator it) {
+    retire(std::move(it->second));
+    return cache_.erase(it);
+}
+
+void GraphicsPipelineCache::retire(std::unique_ptr<CachedGraphicsPipeline> pipeline) {
+    if (pipeline && deferredDestruction_) {
+        deferredDestruction_->retire(std::move(pipeline));
+    }
+}
+
 bool GraphicsPipelineCache::contains(const GraphicsPipelineState& state) const {
     return cache_.find(state) != cache_.end();
 }
@@ -5,10 +5,13 @@
 #include <unordered_map>
 #include <memory>
 #include <chrono>
+#include <string>
 #include "../core/vulkan_raii.h"
 #include "../core/vulkan_constants.h"
 #include "graphics_pipeline_state_hash.h"
 
+class DeferredDestructionQueue;
+
 struct CachedGraphicsPipeline {
     vulkan_raii::Pipeline pipeline;
     vulkan_raii::PipelineLayout layout;
@@ -39,10 +42,16 @@ public:
     
     void storePipeline(const GraphicsPipelineState& state, std::unique_ptr<CachedGraphicsPipeline> pipeline);
     
+    // Removed and replaced pipelines are retired here instead of destroyed, frames in flight may use them
+    void setDeferredDestruction(DeferredDestructionQueue* queue) { deferredDestruction_ = queue; }
+    
     void clear();
     void optimizeCache(uint64_t currentFrame);
     void evictLeastRecentlyUsed();
     
+    // Drop every pipeline that uses shaderPath in any stage; returns the number removed
+    size_t invalidateShader(const std::string& shaderPath);
+    
     bool contains(const GraphicsPipelineState& state) const;
     size_t size() const { return cache_.size(); }
     
@@ -59,6 +68,10 @@ private:
     uint64_t cacheCleanupInterval_ = CACHE_CLEANUP_INTERVAL;
     
     mutable PipelineStats stats_;
+    DeferredDestructionQueue* deferredDestruction_ = nullptr;
     
+    using CacheMap = std::unordered_map<GraphicsPipelineState, std::unique_ptr<CachedGraphicsPipeline>, GraphicsPipelineStateHash>;
+    CacheMap::iterator erase(CacheMap::iterator it);
+    void retire(std::unique_ptr<CachedGraphicsPipeline> pipeline);
     bool shouldEvictPipeline(const CachedGraphicsPipeline& pipeline, uint64_t currentFrame) const;
 };
\ No newline at end of file
@@ -13,6 +13,7 @@ GraphicsPipelineManager::GraphicsPipelineManager(VulkanContext* ctx)
     , renderPassManager_(ctx)
     , factory_(ctx)
     , layoutBuilder_(ctx) {
+    cache_.setDeferredDestruction(&ctx->getDeferredDestruction());
 }
 
 GraphicsPipelineManager::~GraphicsPipelineManager() {
@@ -176,11 +177,8 @@ bool GraphicsPipelineManager::recreatePipelineCache() {
     isRecreating_ = true;
     std::cout << "GraphicsPipelineManager: Recreating pipeline cache to prevent corruption" << std::endl;
     
-    // Wait for device idle to ensure no pipelines are in use
-    const auto& vk = context->getLoader();
-    const VkDevice device = context->getDevice();
-    vk.vkDeviceWaitIdle(device);
-    
+    // No device wait: cached pipelines and render passes are retired to the deferred destruction
+    // queue and the VkPipelineCache itself is never referenced by submitted work
     // Clear caches in dependency order
     clearCache();
     
@@ -230,12 +228,23 @@ bool GraphicsPipelineManager::reloadPipeline(const GraphicsPipelineState& state)
 }
 
 namespace GraphicsPipelinePresets {
+    // vertex.vert push constants: latched view-projection, time, dt, entity count, latch flag
+    static VkPushConstantRange entityVertexPushConstantRange() {
+        VkPushConstantRange range{};
+        range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        range.offset = 0;
+        range.size = sizeof(glm::mat4) + 4 * sizeof(uint32_t);
+        return range;
+    }
+    
     GraphicsPipelineState createEntityRenderingState(VkRenderPass renderPass, 
                                                     VkDescriptorSetLayout descriptorLayout) {
         GraphicsPipelineState state{};
         state.renderPass = renderPass;
         state.descriptorSetLayouts.push_back(descriptorLayout);
         
+        state.pushConstantRanges.push_back(entityVertexPushConstantRange());
+        
         state.shaderStages = {
             "shaders/vertex.vert.spv",
             "shaders/fragment.frag.spv"
@@ -288,6 +297,8 @@ namespace GraphicsPipelinePresets {
         
         state.descriptorSetLayouts.push_back(descriptorLayout);
         
+        state.pushConstantRanges.push_back(entityVertexPushConstantRange());
+        
         state.shaderStages = {
             "shaders/vertex.vert.spv",
             "shaders/fragment.frag.spv"
@@ -324,4 +335,71 @@ namespace GraphicsPipelinePresets {
         
         return state;
     }
+    
+    GraphicsPipelineState createEntityRenderingStateVertexPulling(VkDescriptorSetLayout descriptorLayout,
+                                                                 VkFormat colorFormat,
+                                                                 VkSampleCountFlagBits samples) {
+        GraphicsPipelineState state{};
+        state.useDynamicRendering = true;
+        state.colorAttachmentFormats.push_back(colorFormat);
+        state.rasterizationSamples = samples;
+        
+        state.descriptorSetLayouts.push_back(descriptorLayout);
+        
+        state.pushConstantRanges.push_back(entityVertexPushConstantRange());
+        
+        state.shaderStages = {
+            "shaders/vertex_pulled.vert.spv",
+            "shaders/fragment.frag.spv"
+        };
+        
+        // Triangle corners come from gl_VertexIndex and entity data from the SoA columns, no vertex input
+        
+        VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | 
+                                             VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        colorBlendAttachment.blendEnable = VK_FALSE;
+        state.colorBlendAttachments.push_back(colorBlendAttachment);
+        
+        return state;
+    }
+    
+    GraphicsPipelineState createDensityResolveStateDynamic(VkDescriptorSetLayout descriptorLayout,
+                                                          VkFormat colorFormat,
+                                                          VkSampleCountFlagBits samples) {
+        GraphicsPipelineState state{};
+        state.useDynamicRendering = true;
+        state.colorAttachmentFormats.push_back(colorFormat);
+        state.rasterizationSamples = samples;
+        
+        state.descriptorSetLayouts.push_back(descriptorLayout);
+        
+        // density_resolve.frag push constants: texel size, density width, exposure, reserved
+        VkPushConstantRange pushConstant{};
+        pushConstant.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstant.offset = 0;
+        pushConstant.size = 4 * sizeof(uint32_t);
+        state.pushConstantRanges.push_back(pushConstant);
+        
+        state.shaderStages = {
+            "shaders/density_resolve.vert.spv",
+            "shaders/density_resolve.frag.spv"
+        };
+        
+        // Full-screen triangle generated from gl_VertexIndex, no vertex input
+        
+        VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | 
+                                             VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        colorBlendAttachment.blendEnable = VK_TRUE;
+        colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+        colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+        colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+        state.colorBlendAttachments.push_back(colorBlendAttachment);
+        
+        return state;
+    }
 }
\ No newline at end of file
@@ -47,6 +47,7 @@ public:
     void warmupCache(const std::vector<GraphicsPipelineState>& commonStates);
     void optimizeCache(uint64_t currentFrame);
     void clearCache();
+    size_t invalidateShader(const std::string& shaderPath) { return cache_.invalidateShader(shaderPath); }
     
     bool recreatePipelineCache();
     
@@ -88,6 +89,16 @@ namespace GraphicsPipelinePresets {
                                                            VkFormat depthFormat = VK_FORMAT_UNDEFINED,
                                                            VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT);
     
+    // Entity triangles built from gl_VertexIndex: a non-indexed draw of 3 vertices per entity, no vertex buffers
+    GraphicsPipelineState createEntityRenderingStateVertexPulling(VkDescriptorSetLayout descriptorLayout,
+                                                                 VkFormat colorFormat,
+                                                                 VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT);
+    
+    // Full-screen tone map of the splatted entity density (zoomed-out LOD), alpha-blended over the clear
+    GraphicsPipelineState createDensityResolveStateDynamic(VkDescriptorSetLayout descriptorLayout,
+                                                          VkFormat colorFormat,
+                                                          VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT);
+    
     GraphicsPipelineState createWireframeOverlayState(VkRenderPass renderPass);
     GraphicsPipelineState createUIRenderingState(VkRenderPass renderPass);
     GraphicsPipelineState createShadowMappingState(VkRenderPass renderPass);
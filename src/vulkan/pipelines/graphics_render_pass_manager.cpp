@@ -119,6 +119,12 @@ VkRenderPass GraphicsRenderPassManager::createRenderPass(VkFormat colorFormat,
 
 void GraphicsRenderPassManager::clearCache() {
     std::cout << "GraphicsRenderPassManager: Clearing render pass cache (" << renderPassCache_.size() << " render passes)" << std::endl;
+    // Framebuffers and command buffers of frames in flight may still reference them
+    if (context) {
+        for (auto& [hash, renderPass] : renderPassCache_) {
+            context->getDeferredDestruction().retire(std::move(renderPass));
+        }
+    }
     renderPassCache_.clear();
     std::cout << "GraphicsRenderPassManager: Render pass cache cleared successfully" << std::endl;
 }
@@ -2,6 +2,8 @@
 
 #include <functional>
 #include <cstddef>
+#include <cstdint>
+#include <string_view>
 #include <vector>
 
 namespace VulkanHash {
@@ -82,4 +84,36 @@ inline size_t hash_shift_combine(size_t h1, size_t h2, size_t h3, size_t h4) {
     return h1 ^ (h2 << 1) ^ (h3 << 2) ^ (h4 << 3);
 }
 
+// FNV-1a 64-bit - stable across runs and builds, unlike std::hash, so safe for on-disk keys
+class StableHasher {
+public:
+    static constexpr uint64_t OFFSET_BASIS = 0xcbf29ce484222325ull;
+    static constexpr uint64_t PRIME = 0x100000001b3ull;
+
+    StableHasher& combineBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash_ ^= bytes[i];
+            hash_ *= PRIME;
+        }
+        return *this;
+    }
+
+    StableHasher& combine(std::string_view text) {
+        combineBytes(text.data(), text.size());
+        // Length terminator keeps ("ab","c") distinct from ("a","bc")
+        uint64_t length = text.size();
+        return combineBytes(&length, sizeof(length));
+    }
+
+    StableHasher& combine(uint64_t value) {
+        return combineBytes(&value, sizeof(value));
+    }
+
+    uint64_t get() const { return hash_; }
+
+private:
+    uint64_t hash_ = OFFSET_BASIS;
+};
+
 }
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "pipeline_system_manager.h"
+#include "../core/vulkan_function_loader.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 PipelineSystemManager::PipelineSystemManager() {
@@ -51,6 +54,21 @@ bool PipelineSystemManager::initializeManagers() {
         return false;
     }
     
+    // Compiled SPIR-V is content-addressed on disk, so unchanged shaders never recompile
+    shaderManager->enableDiskCache("shader_cache");
+    
+    // GLSL sources relative to the build directory (run from build/) or the repo root
+    shaderManager->addShaderSourceRoot("../src/shaders");
+    shaderManager->addShaderSourceRoot("src/shaders");
+    
+    // Development builds only (cmake -DSHADER_HOT_RELOAD=ON)
+#ifdef FRACTALIA_SHADER_HOT_RELOAD
+    shaderManager->enableHotReload(true);
+#endif
+    
+    // Before any entity pipeline compiles, so every shader sees the same column layout
+    selectEntitySchema();
+    
     // Initialize descriptor layout manager (required by pipeline managers)
     layoutManager = std::make_unique<DescriptorLayoutManager>();
     if (!layoutManager->initialize(*context)) {
@@ -72,9 +90,77 @@ bool PipelineSystemManager::initializeManagers() {
         return false;
     }
     
+    // Per-scene/per-device specialization variants, all compiled before the first frame
+    computeManager->loadVariantConfig("compute_variants.cfg");
+    computeManager->precompileVariants();
+    
+    // A reloaded module invalidates every pipeline built from it; nodes look pipelines up
+    // each frame, so the next frame rebuilds them from the new module. Frames in flight keep
+    // the old pipelines until they complete (see DeferredDestructionQueue)
+    shaderManager->addGlobalReloadCallback([this](const std::string& shaderPath, VkShaderModule) {
+        size_t removed = computeManager->invalidateShader(shaderPath) + graphicsManager->invalidateShader(shaderPath);
+        std::cout << "PipelineSystemManager: Invalidated " << removed << " pipeline(s) using " << shaderPath << std::endl;
+    });
+    
     return true;
 }
 
+void PipelineSystemManager::selectEntitySchema() {
+    // The compact layout needs the accessors compiled in; shipped SPIR-V only matches legacy
+    static const char* ENTITY_SHADERS[] = {
+        "shaders/movement_random.comp.spv",
+        "shaders/physics.comp.spv",
+        "shaders/collision.comp.spv",
+        "shaders/spatial_reorder.comp.spv",
+        "shaders/spatial_query.comp.spv",
+        "shaders/density_splat.comp.spv",
+        "shaders/density_resolve.frag.spv",
+        "shaders/vertex.vert.spv",
+        "shaders/vertex_pulled.vert.spv"
+    };
+    
+    bool canGenerate = true;
+    for (const char* shaderPath : ENTITY_SHADERS) {
+        canGenerate = canGenerate && shaderManager->canBuildFromSource(shaderPath);
+    }
+    
+    // FRACTALIA_ENTITY_SCHEMA=legacy keeps full-precision columns for comparison
+    const char* schemaEnv = std::getenv("FRACTALIA_ENTITY_SCHEMA");
+    bool wantCompact = !(schemaEnv && std::strcmp(schemaEnv, "legacy") == 0);
+    
+    // FRACTALIA_ENTITY_COLUMNS=address reads columns through buffer device addresses instead of the
+    // descriptor array; compare the compute and graphics GPU timings against the default to A/B it
+    const char* columnsEnv = std::getenv("FRACTALIA_ENTITY_COLUMNS");
+    bool wantAddress = columnsEnv && std::strcmp(columnsEnv, "address") == 0;
+    
+    if (wantCompact && canGenerate) {
+        entitySchema = EntitySchema::compact();
+    } else {
+        if (wantCompact) {
+            std::cout << "PipelineSystemManager: Entity shader sources unavailable, using prebuilt SPIR-V" << std::endl;
+        }
+        entitySchema = EntitySchema::legacy();
+    }
+    
+    if (wantAddress) {
+        if (canGenerate && context->hasBufferDeviceAddress()) {
+            entitySchema.setColumnAccess(ColumnAccess::DeviceAddress);
+        } else {
+            std::cout << "PipelineSystemManager: Address-based entity columns need shader sources and "
+                      << "bufferDeviceAddress, using descriptor-indexed columns" << std::endl;
+        }
+    }
+    
+    if (canGenerate && (wantCompact || entitySchema.getColumnAccess() == ColumnAccess::DeviceAddress)) {
+        shaderManager->setGeneratedInclude(EntitySchema::GLSL_INCLUDE_NAME, entitySchema.generateGLSL());
+    }
+    
+    std::cout << "PipelineSystemManager: Entity schema '" << entitySchema.getName() << "' ("
+              << entitySchema.getBytesPerEntity() << " bytes/entity, "
+              << (entitySchema.getColumnAccess() == ColumnAccess::DeviceAddress ? "device-address" : "descriptor-indexed")
+              << " columns)" << std::endl;
+}
+
 VkPipeline PipelineSystemManager::createGraphicsPipeline(const PipelineCreationInfo& info) {
     if (!graphicsManager || !shaderManager || !layoutManager) {
         std::cerr << "Pipeline managers not initialized" << std::endl;
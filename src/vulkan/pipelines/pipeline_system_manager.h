@@ -6,6 +6,7 @@
 #include "shader_manager.h"
 #include "graphics_pipeline_cache.h"
 #include "../core/vulkan_context.h"
+#include "../../ecs/gpu/entity_schema.h"
 #include <memory>
 
 // AAA Pipeline System Manager - Unified interface for all pipeline operations
@@ -31,6 +32,9 @@ public:
     const ComputePipelineManager* getComputeManager() const { return computeManager.get(); }
     const DescriptorLayoutManager* getLayoutManager() const { return layoutManager.get(); }
     const ShaderManager* getShaderManager() const { return shaderManager.get(); }
+    
+    // Entity column layout the entity shaders were built against; entity buffers must match it
+    const EntitySchema& getEntitySchema() const { return entitySchema; }
 
     // High-level pipeline creation (convenience methods)
     struct PipelineCreationInfo {
@@ -73,8 +77,11 @@ private:
     std::unique_ptr<DescriptorLayoutManager> layoutManager;
     std::unique_ptr<GraphicsPipelineManager> graphicsManager;
     std::unique_ptr<ComputePipelineManager> computeManager;
+    
+    EntitySchema entitySchema = EntitySchema::legacy();
 
 
     // Internal initialization helpers
     bool initializeManagers();
+    void selectEntitySchema();
 };
\ No newline at end of file
@@ -8,7 +8,14 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
+#include <map>
+
+#ifdef FRACTALIA_HAS_SHADERC
+#include <shaderc/shaderc.h>
+#endif
 
 // ShaderModuleSpec implementation
 bool ShaderModuleSpec::operator==(const ShaderModuleSpec& other) const {
@@ -49,8 +56,10 @@ ShaderManager::~ShaderManager() {
 bool ShaderManager::initialize(const VulkanContext& context) {
     this->context_ = &context;
     
-    // Check for external shader compilers
-    if (ShaderCompiler::isGlslcAvailable()) {
+    // Prefer the embedded compiler, fall back to an external glslc on PATH
+    if (ShaderCompiler::isInProcessCompilerAvailable()) {
+        std::cout << "ShaderManager: In-process GLSL compilation (shaderc) enabled" << std::endl;
+    } else if (ShaderCompiler::isGlslcAvailable()) {
         std::cout << "ShaderManager: glslc compiler found" << std::endl;
     } else {
         std::cout << "ShaderManager: glslc compiler not found - GLSL compilation disabled" << std::endl;
@@ -83,7 +92,7 @@ VkShaderModule ShaderManager::loadShader(const ShaderModuleSpec& spec) {
     if (it != shaderCache_.end()) {
         // Check for hot reload if enabled
         if (hotReloadEnabled && spec.enableHotReload) {
-            if (isFileNewer(spec.filePath, it->second->sourceModified)) {
+            if (isShaderStale(*it->second)) {
                 std::cout << "Hot reloading shader: " << spec.filePath << std::endl;
                 if (reloadShader(spec)) {
                     stats.hotReloadsThisFrame++;
@@ -140,6 +149,17 @@ VkShaderModule ShaderManager::loadShaderFromFile(const std::string& filePath,
         spec.sourceType = ShaderSourceType::GLSL_SOURCE;
     }
     
+    // With hot reload on, build from the GLSL behind a prebuilt .spv so edits can be picked up.
+    // Generated includes force the same path, since the prebuilt binary cannot reflect them
+    if (spec.sourceType == ShaderSourceType::SPIRV_BINARY && (hotReloadEnabled || !generatedIncludes_.empty()) &&
+        canBuildFromSource(filePath)) {
+        std::string sourcePath = findGLSLSource(filePath);
+        spec.filePath = sourcePath;
+        spec.sourceType = ShaderSourceType::GLSL_SOURCE;
+        spec.enableHotReload = hotReloadEnabled;
+        sourceAliases_[sourcePath] = filePath;
+    }
+    
     return loadShader(spec);
 }
 
@@ -171,12 +191,17 @@ std::unique_ptr<CachedShaderModule> ShaderManager::createShaderInternal(const Sh
             break;
             
         case ShaderSourceType::GLSL_SOURCE: {
-            auto compilationResult = compileGLSLFromFile(spec.filePath, spec.defines);
+            auto compilationResult = compileGLSLSpec(spec, cachedShader->sourceDependencies);
             if (!compilationResult.success) {
                 logShaderError(spec.filePath, compilationResult.errorMessage);
                 return nullptr;
             }
             spirvCode = std::move(compilationResult.spirvCode);
+            
+            // Watch includes too: the module is stale once any of them is newer
+            for (const auto& dependency : cachedShader->sourceDependencies) {
+                cachedShader->sourceModified = std::max(cachedShader->sourceModified, getFileModifiedTime(dependency));
+            }
             break;
         }
         
@@ -275,16 +300,53 @@ bool ShaderManager::validateSPIRV(const std::vector<uint32_t>& spirvCode) const
 
 ShaderCompilationResult ShaderManager::compileGLSLFromFile(const std::string& filePath,
                                                           const std::unordered_map<std::string, std::string>& defines) {
-    std::string source = loadShaderSource(filePath);
+    ShaderModuleSpec spec;
+    spec.filePath = filePath;
+    spec.sourceType = ShaderSourceType::GLSL_SOURCE;
+    spec.stageInfo.stage = getShaderStageFromFilename(filePath);
+    spec.defines = defines;
+    
+    std::vector<std::string> dependencies;
+    return compileGLSLSpec(spec, dependencies);
+}
+
+ShaderCompilationResult ShaderManager::compileGLSLSpec(const ShaderModuleSpec& spec, std::vector<std::string>& dependencies) {
+    ShaderCompilationResult result;
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    std::string source = loadShaderSource(spec.filePath);
     if (source.empty()) {
-        ShaderCompilationResult result;
-        result.success = false;
         result.errorMessage = "Failed to load shader source";
         return result;
     }
     
-    VkShaderStageFlagBits stage = getShaderStageFromFilename(filePath);
-    return compileGLSL(source, stage, filePath, defines);
+    // Spec include paths take precedence over global ones
+    std::vector<std::string> includePaths = spec.includePaths;
+    includePaths.insert(includePaths.end(), globalIncludePaths_.begin(), globalIncludePaths_.end());
+    
+    std::string expanded;
+    std::unordered_set<std::string> visited;
+    dependencies.clear();
+    if (!expandIncludes(source, spec.filePath, includePaths, expanded, dependencies, visited, result.errorMessage)) {
+        return result;
+    }
+    
+    // Content-addressed lookup: identical expanded source + defines means identical SPIR-V
+    auto defines = mergeDefines(spec.defines);
+    uint64_t cacheKey = computeSPIRVCacheKey(expanded, spec.stageInfo.stage, spec.entryPoint, defines);
+    
+    if (diskCache_.load(cacheKey, result.spirvCode)) {
+        result.success = true;
+    } else {
+        result = compileGLSL(expanded, spec.stageInfo.stage, spec.filePath, defines);
+        if (result.success) {
+            diskCache_.store(cacheKey, result.spirvCode);
+        }
+    }
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    result.compilationTime = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
+    return result;
 }
 
 ShaderCompilationResult ShaderManager::compileGLSL(const std::string& source,
@@ -294,15 +356,21 @@ ShaderCompilationResult ShaderManager::compileGLSL(const std::string& source,
     ShaderCompilationResult result;
     auto startTime = std::chrono::high_resolution_clock::now();
     
-    // Compile using external glslc compiler
-    std::vector<uint32_t> spirvCode = compileSPIRVWithGlslc(source, stage, fileName, defines);
+    std::vector<uint32_t> spirvCode;
+    if (ShaderCompiler::isInProcessCompilerAvailable()) {
+        spirvCode = compileSPIRVInProcess(source, stage, fileName, defines, result.errorMessage);
+    } else {
+        spirvCode = compileSPIRVWithGlslc(source, stage, fileName, defines, result.errorMessage);
+    }
     
     auto endTime = std::chrono::high_resolution_clock::now();
     result.compilationTime = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
     
     if (spirvCode.empty()) {
         result.success = false;
-        result.errorMessage = "GLSL compilation failed";
+        if (result.errorMessage.empty()) {
+            result.errorMessage = "GLSL compilation failed";
+        }
         return result;
     }
     
@@ -311,19 +379,254 @@ ShaderCompilationResult ShaderManager::compileGLSL(const std::string& source,
     return result;
 }
 
-std::vector<uint32_t> ShaderManager::compileSPIRVWithGlslc(const std::string& source,
+std::vector<uint32_t> ShaderManager::compileSPIRVInProcess(const std::string& source,
                                                           VkShaderStageFlagBits stage,
                                                           const std::string& fileName,
-                                                          const std::unordered_map<std::string, std::string>& defines) const {
-    // For now, return empty vector as external compilation requires process execution
-    // In a full implementation, this would:
-    // 1. Write source to temporary file
-    // 2. Execute glslc with appropriate arguments
-    // 3. Read compiled SPIR-V from output file
-    // 4. Clean up temporary files
-    
-    std::cerr << "GLSL compilation not implemented in this demo version" << std::endl;
+                                                          const std::unordered_map<std::string, std::string>& defines,
+                                                          std::string& errorMessage) const {
+#ifdef FRACTALIA_HAS_SHADERC
+    shaderc_shader_kind kind;
+    switch (stage) {
+        case VK_SHADER_STAGE_VERTEX_BIT: kind = shaderc_vertex_shader; break;
+        case VK_SHADER_STAGE_FRAGMENT_BIT: kind = shaderc_fragment_shader; break;
+        case VK_SHADER_STAGE_COMPUTE_BIT: kind = shaderc_compute_shader; break;
+        case VK_SHADER_STAGE_GEOMETRY_BIT: kind = shaderc_geometry_shader; break;
+        case VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT: kind = shaderc_tess_control_shader; break;
+        case VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT: kind = shaderc_tess_evaluation_shader; break;
+        default:
+            errorMessage = "Unsupported shader stage for in-process compilation";
+            return {};
+    }
+    
+    // The compiler object is thread-safe and expensive to create, so keep one for the process
+    static shaderc_compiler_t compiler = shaderc_compiler_initialize();
+    if (!compiler) {
+        errorMessage = "Failed to initialize shaderc compiler";
+        return {};
+    }
+    
+    shaderc_compile_options_t options = shaderc_compile_options_initialize();
+    shaderc_compile_options_set_target_env(options, shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_3);
+    shaderc_compile_options_set_optimization_level(options, shaderc_optimization_level_performance);
+    for (const auto& [name, value] : defines) {
+        shaderc_compile_options_add_macro_definition(options, name.data(), name.size(), value.data(), value.size());
+    }
+    
+    shaderc_compilation_result_t result = shaderc_compile_into_spv(
+        compiler, source.data(), source.size(), kind, fileName.c_str(), "main", options);
+    
+    std::vector<uint32_t> spirvCode;
+    if (shaderc_result_get_compilation_status(result) == shaderc_compilation_status_success) {
+        const size_t byteCount = shaderc_result_get_length(result);
+        spirvCode.resize(byteCount / sizeof(uint32_t));
+        std::memcpy(spirvCode.data(), shaderc_result_get_bytes(result), spirvCode.size() * sizeof(uint32_t));
+    } else {
+        errorMessage = shaderc_result_get_error_message(result);
+    }
+    
+    shaderc_result_release(result);
+    shaderc_compile_options_release(options);
+    return spirvCode;
+#else
+    errorMessage = "Built without FRACTALIA_HAS_SHADERC";
     return {};
+#endif
+}
+
+std::vector<uint32_t> ShaderManager::compileSPIRVWithGlslc(const std::string& source,
+                                                          VkShaderStageFlagBits stage,
+                                                          const std::string& fileName,
+                                                          const std::unordered_map<std::string, std::string>& defines,
+                                                          std::string& errorMessage) const {
+    if (!ShaderCompiler::isGlslcAvailable()) {
+        errorMessage = "No GLSL compiler available (build with shaderc or put glslc on PATH)";
+        return {};
+    }
+    
+    // Includes are already expanded, so the compiler only ever sees a single translation unit
+    std::error_code ec;
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path(ec);
+    if (ec) {
+        errorMessage = "No temporary directory for glslc: " + ec.message();
+        return {};
+    }
+    
+    static uint32_t invocationCounter = 0;
+    std::string stem = "fractalia_shader_" + std::to_string(std::hash<std::string>{}(fileName)) + "_" + std::to_string(invocationCounter++);
+    std::filesystem::path inputPath = tempDir / (stem + ".glsl");
+    std::filesystem::path outputPath = tempDir / (stem + ".spv");
+    std::filesystem::path logPath = tempDir / (stem + ".log");
+    
+    {
+        std::ofstream input(inputPath, std::ios::trunc);
+        if (!input.is_open()) {
+            errorMessage = "Failed to write temporary shader source";
+            return {};
+        }
+        input << source;
+    }
+    
+    std::string command = "\"" + glslcPath + "\"";
+    for (const auto& argument : buildCompilerArguments(stage, fileName, defines)) {
+        command += " \"" + argument + "\"";
+    }
+    command += " -o \"" + outputPath.string() + "\" \"" + inputPath.string() + "\" 2> \"" + logPath.string() + "\"";
+    
+    std::vector<uint32_t> spirvCode;
+    if (std::system(command.c_str()) == 0) {
+        spirvCode = loadSPIRVBinaryFromFile(outputPath.string());
+    } else {
+        errorMessage = loadShaderSource(logPath.string());
+    }
+    
+    std::filesystem::remove(inputPath, ec);
+    std::filesystem::remove(outputPath, ec);
+    std::filesystem::remove(logPath, ec);
+    return spirvCode;
+}
+
+std::string ShaderManager::getGlslcStageArgument(VkShaderStageFlagBits stage) const {
+    switch (stage) {
+        case VK_SHADER_STAGE_VERTEX_BIT: return "-fshader-stage=vert";
+        case VK_SHADER_STAGE_FRAGMENT_BIT: return "-fshader-stage=frag";
+        case VK_SHADER_STAGE_COMPUTE_BIT: return "-fshader-stage=comp";
+        case VK_SHADER_STAGE_GEOMETRY_BIT: return "-fshader-stage=geom";
+        case VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT: return "-fshader-stage=tesc";
+        case VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT: return "-fshader-stage=tese";
+        default: return "-fshader-stage=vert";
+    }
+}
+
+std::vector<std::string> ShaderManager::buildCompilerArguments(VkShaderStageFlagBits stage,
+                                                              const std::string& fileName,
+                                                              const std::unordered_map<std::string, std::string>& defines) const {
+    std::vector<std::string> arguments = {
+        getGlslcStageArgument(stage),
+        "--target-env=vulkan1.3",
+        "-O"
+    };
+    
+    for (const auto& [name, value] : defines) {
+        arguments.push_back(value.empty() ? "-D" + name : "-D" + name + "=" + value);
+    }
+    
+    return arguments;
+}
+
+bool ShaderManager::expandIncludes(const std::string& source,
+                                   const std::filesystem::path& filePath,
+                                   const std::vector<std::string>& includePaths,
+                                   std::string& expanded,
+                                   std::vector<std::string>& dependencies,
+                                   std::unordered_set<std::string>& visited,
+                                   std::string& errorMessage,
+                                   uint32_t depth) const {
+    constexpr uint32_t MAX_INCLUDE_DEPTH = 16;
+    if (depth > MAX_INCLUDE_DEPTH) {
+        errorMessage = "Include depth limit exceeded in " + filePath.string();
+        return false;
+    }
+    
+    visited.insert(std::filesystem::weakly_canonical(filePath).string());
+    
+    std::istringstream stream(source);
+    std::string line;
+    while (std::getline(stream, line)) {
+        size_t first = line.find_first_not_of(" \t");
+        bool isInclude = first != std::string::npos && line.compare(first, 8, "#include") == 0;
+        if (!isInclude) {
+            // Expanded source has no includes left, so the directive extension is no longer needed
+            if (line.find("GL_GOOGLE_include_directive") == std::string::npos) {
+                expanded += line;
+                expanded += '\n';
+            }
+            continue;
+        }
+        
+        size_t open = line.find_first_of("\"<", first + 8);
+        size_t close = open == std::string::npos ? std::string::npos : line.find_first_of("\">", open + 1);
+        if (close == std::string::npos) {
+            errorMessage = "Malformed #include in " + filePath.string() + ": " + line;
+            return false;
+        }
+        std::string includeName = line.substr(open + 1, close - open - 1);
+        
+        // Generated includes have no file to resolve or watch; the SPIR-V cache key covers their text
+        auto generatedIt = generatedIncludes_.find(includeName);
+        if (generatedIt != generatedIncludes_.end()) {
+            std::filesystem::path generatedPath = std::filesystem::path("<generated>") / includeName;
+            if (visited.count(std::filesystem::weakly_canonical(generatedPath).string())) {
+                continue;
+            }
+            if (!expandIncludes(generatedIt->second, generatedPath, includePaths, expanded, dependencies, visited, errorMessage, depth + 1)) {
+                return false;
+            }
+            continue;
+        }
+        
+        // Resolve relative to the including file first, then the include paths
+        std::filesystem::path resolved;
+        std::vector<std::filesystem::path> candidates = {filePath.parent_path() / includeName};
+        for (const auto& includePath : includePaths) {
+            candidates.push_back(std::filesystem::path(includePath) / includeName);
+        }
+        for (const auto& candidate : candidates) {
+            if (fileExists(candidate.string())) {
+                resolved = candidate;
+                break;
+            }
+        }
+        if (resolved.empty()) {
+            errorMessage = "Cannot resolve #include \"" + includeName + "\" from " + filePath.string();
+            return false;
+        }
+        
+        // Include-once semantics, which is what every header in this tree expects
+        std::string canonical = std::filesystem::weakly_canonical(resolved).string();
+        if (visited.count(canonical)) {
+            continue;
+        }
+        
+        dependencies.push_back(resolved.string());
+        std::string includeSource = loadShaderSource(resolved.string());
+        if (!expandIncludes(includeSource, resolved, includePaths, expanded, dependencies, visited, errorMessage, depth + 1)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+std::unordered_map<std::string, std::string> ShaderManager::mergeDefines(const std::unordered_map<std::string, std::string>& defines) const {
+    // Per-shader defines override global ones
+    std::unordered_map<std::string, std::string> merged = globalDefines_;
+    for (const auto& [name, value] : defines) {
+        merged[name] = value;
+    }
+    return merged;
+}
+
+uint64_t ShaderManager::computeSPIRVCacheKey(const std::string& expandedSource,
+                                             VkShaderStageFlagBits stage,
+                                             const std::string& entryPoint,
+                                             const std::unordered_map<std::string, std::string>& defines) const {
+    // shaderc and glslc can emit different SPIR-V for the same options, so keep their entries apart
+    const std::string_view backend = ShaderCompiler::isInProcessCompilerAvailable() ? "shaderc" : "glslc";
+    
+    VulkanHash::StableHasher hasher;
+    hasher.combine(expandedSource)
+          .combine(static_cast<uint64_t>(stage))
+          .combine(entryPoint)
+          .combine(backend)
+          .combine(std::string_view("vulkan1.3 -O"));  // Bump when compile options change
+    
+    // Sorted so map iteration order never changes the key
+    std::map<std::string, std::string> sortedDefines(defines.begin(), defines.end());
+    for (const auto& [name, value] : sortedDefines) {
+        hasher.combine(name).combine(value);
+    }
+    
+    return hasher.get();
 }
 
 VkPipelineShaderStageCreateInfo ShaderManager::createShaderStage(VkShaderModule module,
@@ -407,23 +710,161 @@ bool ShaderManager::reloadShader(const ShaderModuleSpec& spec) {
         return false;
     }
     
-    // RAII wrapper automatically destroys old shader module
-    // Remove from cache
-    shaderCache_.erase(it);
-    stats.totalShaders--;
+    // Build the replacement first so a broken edit keeps the last good module running
+    auto replacement = createShaderInternal(spec);
+    if (!replacement) {
+        std::cerr << "ShaderManager: Reload of " << spec.filePath << " failed, keeping previous module" << std::endl;
+        
+        // Don't retry until the file changes again
+        it->second->sourceModified = getFileModifiedTime(spec.filePath);
+        for (const auto& dependency : it->second->sourceDependencies) {
+            it->second->sourceModified = std::max(it->second->sourceModified, getFileModifiedTime(dependency));
+        }
+        return false;
+    }
+    
+    replacement->lastUsedFrame = it->second->lastUsedFrame;
+    replacement->useCount = it->second->useCount;
+    VkShaderModule newModule = replacement->module.get();
     
-    // Reload shader
-    VkShaderModule newModule = loadShader(spec);
+    // RAII wrapper destroys the old module; pipelines built from it do not reference it
+    it->second = std::move(replacement);
     
-    // Trigger reload callbacks
-    auto callbackIt = reloadCallbacks_.find(spec.filePath);
-    if (callbackIt != reloadCallbacks_.end()) {
-        for (const auto& callback : callbackIt->second) {
-            callback(newModule);
+    notifyShaderReloaded(spec.filePath, newModule);
+    return true;
+}
+
+void ShaderManager::checkForShaderReloads() {
+    if (!hotReloadEnabled) return;
+    
+    std::vector<ShaderModuleSpec> staleSpecs;
+    for (const auto& [spec, shader] : shaderCache_) {
+        if (shader->isHotReloadable && isShaderStale(*shader)) {
+            staleSpecs.push_back(spec);
         }
     }
     
-    return newModule != VK_NULL_HANDLE;
+    for (const auto& spec : staleSpecs) {
+        std::cout << "Hot reloading shader: " << spec.filePath << std::endl;
+        if (reloadShader(spec)) {
+            stats.hotReloadsThisFrame++;
+        }
+    }
+}
+
+void ShaderManager::registerReloadCallback(const std::string& shaderPath,
+                                          std::function<void(VkShaderModule)> callback) {
+    reloadCallbacks_[shaderPath].push_back(std::move(callback));
+}
+
+void ShaderManager::addGlobalReloadCallback(std::function<void(const std::string&, VkShaderModule)> callback) {
+    globalReloadCallbacks_.push_back(std::move(callback));
+}
+
+void ShaderManager::notifyShaderReloaded(const std::string& shaderPath, VkShaderModule module) {
+    // Listeners know shaders by the path they requested, which may be the .spv alias
+    auto aliasIt = sourceAliases_.find(shaderPath);
+    const std::string& requestedPath = aliasIt != sourceAliases_.end() ? aliasIt->second : shaderPath;
+    
+    for (const std::string* path : {&shaderPath, &requestedPath}) {
+        auto callbackIt = reloadCallbacks_.find(*path);
+        if (callbackIt != reloadCallbacks_.end()) {
+            for (const auto& callback : callbackIt->second) {
+                callback(module);
+            }
+        }
+        if (requestedPath == shaderPath) break;
+    }
+    
+    for (const auto& callback : globalReloadCallbacks_) {
+        callback(requestedPath, module);
+    }
+}
+
+bool ShaderManager::isShaderStale(const CachedShaderModule& shader) const {
+    if (isFileNewer(shader.spec.filePath, shader.sourceModified)) {
+        return true;
+    }
+    for (const auto& dependency : shader.sourceDependencies) {
+        if (isFileNewer(dependency, shader.sourceModified)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ShaderManager::addShaderSourceRoot(const std::string& path) {
+    if (std::find(shaderSourceRoots_.begin(), shaderSourceRoots_.end(), path) == shaderSourceRoots_.end()) {
+        shaderSourceRoots_.push_back(path);
+    }
+}
+
+void ShaderManager::setGeneratedInclude(const std::string& name, const std::string& source) {
+    generatedIncludes_[name] = source;
+}
+
+bool ShaderManager::canBuildFromSource(const std::string& spirvPath) const {
+    return (ShaderCompiler::isInProcessCompilerAvailable() || ShaderCompiler::isGlslcAvailable()) &&
+           !findGLSLSource(spirvPath).empty();
+}
+
+std::string ShaderManager::findGLSLSource(const std::string& spirvPath) const {
+    // "physics.comp.spv" -> "physics.comp"; "vertex.spv" -> "vertex.vert" via the stage heuristic
+    std::filesystem::path stem = std::filesystem::path(spirvPath).stem();
+    std::vector<std::string> names = {stem.string()};
+    if (!stem.has_extension()) {
+        switch (getShaderStageFromFilename(spirvPath)) {
+            case VK_SHADER_STAGE_VERTEX_BIT: names.push_back(stem.string() + ".vert"); break;
+            case VK_SHADER_STAGE_FRAGMENT_BIT: names.push_back(stem.string() + ".frag"); break;
+            case VK_SHADER_STAGE_COMPUTE_BIT: names.push_back(stem.string() + ".comp"); break;
+            default: break;
+        }
+    }
+    
+    for (const auto& root : shaderSourceRoots_) {
+        for (const auto& name : names) {
+            std::filesystem::path candidate = std::filesystem::path(root) / name;
+            if (candidate.has_extension() && fileExists(candidate.string())) {
+                return candidate.string();
+            }
+        }
+    }
+    return {};
+}
+
+bool ShaderManager::enableDiskCache(const std::string& directory) {
+    if (!diskCache_.initialize(directory)) {
+        return false;
+    }
+    diskCache_.pruneOldEntries(SPIRV_DISK_CACHE_MAX_ENTRIES);
+    return true;
+}
+
+void ShaderManager::addIncludePath(const std::string& path) {
+    if (std::find(globalIncludePaths_.begin(), globalIncludePaths_.end(), path) == globalIncludePaths_.end()) {
+        globalIncludePaths_.push_back(path);
+    }
+}
+
+void ShaderManager::removeIncludePath(const std::string& path) {
+    globalIncludePaths_.erase(std::remove(globalIncludePaths_.begin(), globalIncludePaths_.end(), path),
+                              globalIncludePaths_.end());
+}
+
+void ShaderManager::clearIncludePaths() {
+    globalIncludePaths_.clear();
+}
+
+void ShaderManager::addGlobalDefine(const std::string& name, const std::string& value) {
+    globalDefines_[name] = value;
+}
+
+void ShaderManager::removeGlobalDefine(const std::string& name) {
+    globalDefines_.erase(name);
+}
+
+void ShaderManager::clearGlobalDefines() {
+    globalDefines_.clear();
 }
 
 std::string ShaderManager::loadShaderSource(const std::string& filePath) const {
@@ -561,9 +1002,24 @@ namespace ShaderPresets {
 }
 
 // ShaderCompiler static class implementation
+bool ShaderCompiler::isInProcessCompilerAvailable() {
+#ifdef FRACTALIA_HAS_SHADERC
+    return true;
+#else
+    return false;
+#endif
+}
+
 bool ShaderCompiler::isGlslcAvailable() {
-    // Simple check - in a real implementation, this would try to execute glslc --version
-    return false;  // Disabled for this demo
+    // Probe once; spawning a process per query would be far too slow
+    static const bool available = [] {
+#ifdef _WIN32
+        return std::system("glslc --version > NUL 2>&1") == 0;
+#else
+        return std::system("glslc --version > /dev/null 2>&1") == 0;
+#endif
+    }();
+    return available;
 }
 
 bool ShaderCompiler::isSpirvOptAvailable() {
@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <chrono>
 #include <functional>
@@ -13,6 +14,7 @@
 #include "../core/vulkan_context.h"
 #include "../core/vulkan_raii.h"
 #include "../core/vulkan_constants.h"
+#include "spirv_disk_cache.h"
 
 // Shader compilation types
 enum class ShaderSourceType {
@@ -76,7 +78,8 @@ struct CachedShaderModule {
     
     // Compilation metadata
     std::chrono::nanoseconds compilationTime{0};
-    std::filesystem::file_time_type sourceModified{};
+    std::filesystem::file_time_type sourceModified{};  // Newest of the source and its includes
+    std::vector<std::string> sourceDependencies;        // Included files, watched for hot reload
     bool isHotReloadable = false;
     
     // Reflection data (for descriptor set layout generation)
@@ -120,7 +123,7 @@ public:
     // Batch shader compilation for reduced overhead
     std::vector<VkShaderModule> loadShadersBatch(const std::vector<ShaderModuleSpec>& specs);
     
-    // GLSL compilation (requires external compiler like glslc or shaderc)
+    // GLSL compilation - in-process via shaderc when built with FRACTALIA_HAS_SHADERC, else external glslc
     ShaderCompilationResult compileGLSL(const std::string& source,
                                        VkShaderStageFlagBits stage,
                                        const std::string& fileName = "shader.glsl",
@@ -152,6 +155,21 @@ public:
     void registerReloadCallback(const std::string& shaderPath, 
                                std::function<void(VkShaderModule)> callback);
     
+    // Notified for every successful reload with the path pipelines were created from
+    void addGlobalReloadCallback(std::function<void(const std::string&, VkShaderModule)> callback);
+    
+    // Directories searched for the GLSL source of a requested .spv, enabling hot reload of shipped shaders
+    void addShaderSourceRoot(const std::string& path);
+    
+    // In-memory #include target that shadows files of the same name. Set before loading the shaders that
+    // include it; while any is registered, shipped .spv requests are built from source like hot reload does
+    void setGeneratedInclude(const std::string& name, const std::string& source);
+    bool canBuildFromSource(const std::string& spirvPath) const;
+    
+    // Content-addressed SPIR-V cache; warm starts load compiled GLSL without invoking the compiler
+    bool enableDiskCache(const std::string& directory);
+    SPIRVDiskCache::Stats getDiskCacheStats() const { return diskCache_.getStats(); }
+    
     // Shader reflection and analysis
     struct ShaderReflection {
         std::vector<VkDescriptorSetLayoutBinding> descriptorBindings;
@@ -230,6 +248,15 @@ private:
     std::vector<std::string> globalIncludePaths_;
     std::unordered_map<std::string, std::string> globalDefines_;
     
+    // Hot reload of shaders requested as .spv: GLSL source path -> requested SPIR-V path
+    std::vector<std::string> shaderSourceRoots_;
+    std::unordered_map<std::string, std::string> sourceAliases_;
+    std::unordered_map<std::string, std::string> generatedIncludes_;
+    std::vector<std::function<void(const std::string&, VkShaderModule)>> globalReloadCallbacks_;
+    
+    // Compiled SPIR-V persisted across runs
+    SPIRVDiskCache diskCache_;
+    
     // Statistics
     mutable ShaderStats stats;
     
@@ -251,10 +278,39 @@ private:
     bool validateSPIRV(const std::vector<uint32_t>& spirvCode) const;
     
     // Compilation helpers
+    ShaderCompilationResult compileGLSLSpec(const ShaderModuleSpec& spec, std::vector<std::string>& dependencies);
+    
     std::vector<uint32_t> compileSPIRVWithGlslc(const std::string& source,
                                                VkShaderStageFlagBits stage,
                                                const std::string& fileName,
-                                               const std::unordered_map<std::string, std::string>& defines) const;
+                                               const std::unordered_map<std::string, std::string>& defines,
+                                               std::string& errorMessage) const;
+    
+    std::vector<uint32_t> compileSPIRVInProcess(const std::string& source,
+                                               VkShaderStageFlagBits stage,
+                                               const std::string& fileName,
+                                               const std::unordered_map<std::string, std::string>& defines,
+                                               std::string& errorMessage) const;
+    
+    // Resolves #include directives recursively; each file is included once
+    bool expandIncludes(const std::string& source,
+                        const std::filesystem::path& filePath,
+                        const std::vector<std::string>& includePaths,
+                        std::string& expanded,
+                        std::vector<std::string>& dependencies,
+                        std::unordered_set<std::string>& visited,
+                        std::string& errorMessage,
+                        uint32_t depth = 0) const;
+    
+    std::unordered_map<std::string, std::string> mergeDefines(const std::unordered_map<std::string, std::string>& defines) const;
+    uint64_t computeSPIRVCacheKey(const std::string& expandedSource,
+                                  VkShaderStageFlagBits stage,
+                                  const std::string& entryPoint,
+                                  const std::unordered_map<std::string, std::string>& defines) const;
+    
+    std::string findGLSLSource(const std::string& spirvPath) const;
+    bool isShaderStale(const CachedShaderModule& shader) const;
+    void notifyShaderReloaded(const std::string& shaderPath, VkShaderModule module);
     
     std::string getGlslcStageArgument(VkShaderStageFlagBits stage) const;
     std::vector<std::string> buildCompilerArguments(VkShaderStageFlagBits stage,
@@ -305,6 +361,7 @@ namespace ShaderPresets {
 // Helper class for shader compilation with external tools
 class ShaderCompiler {
 public:
+    static bool isInProcessCompilerAvailable();
     static bool isGlslcAvailable();
     static bool isSpirvOptAvailable();
     
@@ -0,0 +1,127 @@
+#include "spirv_disk_cache.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+namespace {
+    // Entry layout: header followed by the raw SPIR-V words
+    struct EntryHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint64_t wordCount;
+    };
+
+    constexpr uint32_t ENTRY_MAGIC = 0x56505346;   // "FSPV"
+    constexpr uint32_t ENTRY_VERSION = 1;
+    constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+}
+
+bool SPIRVDiskCache::initialize(const std::filesystem::path& cacheDirectory) {
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDirectory, ec);
+    if (ec) {
+        std::cerr << "SPIRVDiskCache: Failed to create cache directory " << cacheDirectory.string()
+                  << ": " << ec.message() << std::endl;
+        enabled_ = false;
+        return false;
+    }
+
+    directory_ = cacheDirectory;
+    enabled_ = true;
+    std::cout << "SPIRVDiskCache: Using " << directory_.string() << std::endl;
+    return true;
+}
+
+bool SPIRVDiskCache::load(uint64_t key, std::vector<uint32_t>& spirvCode) const {
+    if (!enabled_) return false;
+
+    std::ifstream file(entryPath(key), std::ios::binary);
+    if (!file.is_open()) {
+        stats_.misses++;
+        return false;
+    }
+
+    EntryHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != ENTRY_MAGIC || header.version != ENTRY_VERSION ||
+        header.key != key || header.wordCount == 0) {
+        stats_.misses++;
+        return false;
+    }
+
+    std::vector<uint32_t> words(header.wordCount);
+    file.read(reinterpret_cast<char*>(words.data()), words.size() * sizeof(uint32_t));
+    if (!file || words[0] != SPIRV_MAGIC) {
+        // Truncated or corrupt entry - treat as a miss, the recompile overwrites it
+        stats_.misses++;
+        return false;
+    }
+
+    spirvCode = std::move(words);
+    stats_.hits++;
+    return true;
+}
+
+bool SPIRVDiskCache::store(uint64_t key, const std::vector<uint32_t>& spirvCode) const {
+    if (!enabled_ || spirvCode.empty()) return false;
+
+    // Write to a temporary name and rename so a crash never leaves a half-written entry
+    std::filesystem::path finalPath = entryPath(key);
+    std::filesystem::path tempPath = finalPath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "SPIRVDiskCache: Failed to write " << tempPath.string() << std::endl;
+            return false;
+        }
+
+        EntryHeader header{ENTRY_MAGIC, ENTRY_VERSION, key, spirvCode.size()};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(spirvCode.data()), spirvCode.size() * sizeof(uint32_t));
+        if (!file) {
+            std::cerr << "SPIRVDiskCache: Short write to " << tempPath.string() << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    stats_.writes++;
+    return true;
+}
+
+void SPIRVDiskCache::pruneOldEntries(size_t maxEntries) const {
+    if (!enabled_) return;
+
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".spv") {
+            entries.emplace_back(entry.last_write_time(ec), entry.path());
+        }
+    }
+
+    if (entries.size() <= maxEntries) return;
+
+    std::sort(entries.begin(), entries.end());
+    size_t removeCount = entries.size() - maxEntries;
+    for (size_t i = 0; i < removeCount; ++i) {
+        std::filesystem::remove(entries[i].second, ec);
+    }
+}
+
+std::filesystem::path SPIRVDiskCache::entryPath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.spv", static_cast<unsigned long long>(key));
+    return directory_ / name;
+}
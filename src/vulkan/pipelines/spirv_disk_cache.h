@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+/**
+ * Content-addressed on-disk store for compiled SPIR-V.
+ *
+ * Entries are named by a stable 64-bit key computed from the include-expanded GLSL
+ * source, the stage, entry point, compiler backend, preprocessor defines and compile options. Any edit
+ * to a shader or one of its includes yields a new key, so stale entries are never
+ * returned and never need invalidating; old files are simply left for pruneOldEntries().
+ */
+class SPIRVDiskCache {
+public:
+    SPIRVDiskCache() = default;
+    ~SPIRVDiskCache() = default;
+
+    bool initialize(const std::filesystem::path& cacheDirectory);
+    bool isEnabled() const { return enabled_; }
+
+    bool load(uint64_t key, std::vector<uint32_t>& spirvCode) const;
+    bool store(uint64_t key, const std::vector<uint32_t>& spirvCode) const;
+
+    // Keep the directory bounded; removes the oldest entries beyond maxEntries
+    void pruneOldEntries(size_t maxEntries) const;
+
+    struct Stats {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t writes = 0;
+    };
+    Stats getStats() const { return stats_; }
+
+    const std::filesystem::path& getDirectory() const { return directory_; }
+
+private:
+    std::filesystem::path entryPath(uint64_t key) const;
+
+    std::filesystem::path directory_;
+    bool enabled_ = false;
+    mutable Stats stats_;
+};
@@ -231,6 +231,15 @@ void BarrierManager::insertBarrierBatch(const NodeBarrierInfo& batch, VkCommandB
 }
 
 VkAccessFlags BarrierManager::convertAccess(ResourceAccess access, PipelineStage stage) const {
+    if (stage == PipelineStage::Transfer) {
+        switch (access) {
+            case ResourceAccess::Read: return VK_ACCESS_TRANSFER_READ_BIT;
+            case ResourceAccess::Write: return VK_ACCESS_TRANSFER_WRITE_BIT;
+            case ResourceAccess::ReadWrite: return VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+            default: return 0;
+        }
+    }
+    
     switch (access) {
         case ResourceAccess::Read: 
             if (stage == PipelineStage::VertexShader) {
@@ -267,6 +276,16 @@ VkPipelineStageFlags BarrierManager::convertPipelineStage(PipelineStage stage) c
 
 // Synchronization2 conversion methods with enhanced pipeline stage flags
 VkAccessFlags2 BarrierManager::convertAccess2(ResourceAccess access, PipelineStage stage) const {
+    // Copy commands only accept transfer access bits
+    if (stage == PipelineStage::Transfer) {
+        switch (access) {
+            case ResourceAccess::Read: return VK_ACCESS_2_TRANSFER_READ_BIT;
+            case ResourceAccess::Write: return VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            case ResourceAccess::ReadWrite: return VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+            default: return VK_ACCESS_2_NONE;
+        }
+    }
+    
     switch (access) {
         case ResourceAccess::Read: 
             if (stage == PipelineStage::VertexShader) {
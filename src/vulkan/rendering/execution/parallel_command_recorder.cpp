@@ -0,0 +1,86 @@
+#include "parallel_command_recorder.h"
+#include <algorithm>
+
+namespace FrameGraphExecution {
+
+ParallelCommandRecorder::~ParallelCommandRecorder() {
+    shutdown();
+}
+
+void ParallelCommandRecorder::initialize(uint32_t workerCount) {
+    shutdown();
+
+    stopping_ = false;
+    workers_.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back([this, i]() { workerLoop(i + 1); });
+    }
+}
+
+void ParallelCommandRecorder::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    jobAvailable_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+    jobs_.clear();
+    pendingJobs_ = 0;
+}
+
+void ParallelCommandRecorder::submit(RecordJob job) {
+    if (workers_.empty()) {
+        // No workers: record inline on the main thread slot
+        job(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+        ++pendingJobs_;
+    }
+    jobAvailable_.notify_one();
+}
+
+void ParallelCommandRecorder::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    jobsDrained_.wait(lock, [this]() { return pendingJobs_ == 0; });
+}
+
+uint32_t ParallelCommandRecorder::defaultWorkerCount() {
+    uint32_t hardwareThreads = std::thread::hardware_concurrency();
+    if (hardwareThreads <= 1) return 0;
+    return std::min(hardwareThreads - 1, 4u);
+}
+
+void ParallelCommandRecorder::workerLoop(uint32_t threadIndex) {
+    while (true) {
+        RecordJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobAvailable_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+            if (stopping_ && jobs_.empty()) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        job(threadIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --pendingJobs_;
+        }
+        jobsDrained_.notify_all();
+    }
+}
+
+} // namespace FrameGraphExecution
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+
+namespace FrameGraphExecution {
+
+/**
+ * Persistent worker pool used to record frame graph nodes into secondary command buffers.
+ *
+ * Worker N always passes threadIndex N + 1 to its jobs; index 0 is reserved for the
+ * calling (main) thread. The index selects a QueueManager secondary command pool,
+ * so no two threads ever record from the same pool.
+ */
+class ParallelCommandRecorder {
+public:
+    using RecordJob = std::function<void(uint32_t threadIndex)>;
+
+    ParallelCommandRecorder() = default;
+    ~ParallelCommandRecorder();
+
+    ParallelCommandRecorder(const ParallelCommandRecorder&) = delete;
+    ParallelCommandRecorder& operator=(const ParallelCommandRecorder&) = delete;
+
+    void initialize(uint32_t workerCount);
+    void shutdown();
+
+    // Queue a job for any worker thread
+    void submit(RecordJob job);
+
+    // Block until every submitted job has finished
+    void waitIdle();
+
+    uint32_t getWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+    // Recording threads including the main thread (slot 0)
+    uint32_t getThreadSlotCount() const { return getWorkerCount() + 1; }
+
+    // Default worker count: leave one core for the main thread, cap to keep pools small
+    static uint32_t defaultWorkerCount();
+
+private:
+    void workerLoop(uint32_t threadIndex);
+
+    std::vector<std::thread> workers_;
+    std::deque<RecordJob> jobs_;
+    std::mutex mutex_;
+    std::condition_variable jobAvailable_;
+    std::condition_variable jobsDrained_;
+    uint32_t pendingJobs_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace FrameGraphExecution
@@ -59,9 +59,33 @@ void FrameGraph::cleanup() {
 }
 
 void FrameGraph::cleanupBeforeContextDestruction() {
+    disableParallelRecording();
     resourceManager_.cleanupBeforeContextDestruction();
 }
 
+bool FrameGraph::enableParallelRecording(uint32_t workerCount) {
+    if (!initialized_ || !queueManager_) {
+        std::cerr << "FrameGraph: Cannot enable parallel recording before initialization" << std::endl;
+        return false;
+    }
+    
+    parallelRecorder_.initialize(workerCount);
+    if (!queueManager_->initializeSecondaryCommandPools(parallelRecorder_.getThreadSlotCount())) {
+        std::cerr << "FrameGraph: Failed to create secondary command pools, using serial recording" << std::endl;
+        parallelRecorder_.shutdown();
+        return false;
+    }
+    
+    parallelRecordingEnabled_ = true;
+    std::cout << "FrameGraph: Parallel recording enabled with " << workerCount << " worker threads" << std::endl;
+    return true;
+}
+
+void FrameGraph::disableParallelRecording() {
+    parallelRecorder_.shutdown();
+    parallelRecordingEnabled_ = false;
+}
+
 void FrameGraph::setMemoryMonitor(GPUMemoryMonitor* monitor) {
     resourceManager_.setMemoryMonitor(monitor);
 }
@@ -256,14 +280,19 @@ FrameGraph::ExecutionResult FrameGraph::execute(uint32_t frameIndex, float time,
     
     // Analyze which command buffers we'll need
     auto [computeNeeded, graphicsNeeded] = analyzeQueueRequirements();
+    bool computeExecuted = false;
     result.computeCommandBufferUsed = computeNeeded;
     result.graphicsCommandBufferUsed = graphicsNeeded;
     
     // Begin only the command buffers that will be used
     beginCommandBuffers(computeNeeded, graphicsNeeded, frameIndex);
     
+    // Extra fixed steps go first; the graph below records the last one
+    if (computeNeeded) {
+        recordSimulationSubsteps(frameIndex, globalFrame, computeExecuted);
+    }
+    
     // Execute nodes with timeout monitoring if available
-    bool computeExecuted = false;
     if (timeoutDetector_) {
         if (!executeWithTimeoutMonitoring(frameIndex, time, deltaTime, globalFrame, computeExecuted)) {
             // Timeout occurred, end command buffers and return early
@@ -271,6 +300,8 @@ FrameGraph::ExecutionResult FrameGraph::execute(uint32_t frameIndex, float time,
             handleExecutionTimeout();
             return result;
         }
+    } else if (parallelRecordingEnabled_) {
+        executeNodesParallel(frameIndex, time, deltaTime, computeExecuted);
     } else {
         executeNodesInOrder(frameIndex, time, deltaTime, globalFrame, computeExecuted);
     }
@@ -344,6 +375,44 @@ void FrameGraph::endCommandBuffers(bool useCompute, bool useGraphics, uint32_t f
     }
 }
 
+void FrameGraph::recordSimulationSubsteps(uint32_t frameIndex, uint32_t globalFrame, bool& computeExecuted) {
+    const SimulationSteps& steps = simulationSteps_;
+    if (steps.count > 1) {
+        const auto& vk = context_->getLoader();
+        VkCommandBuffer computeCmd = queueManager_->getComputeCommandBuffer(frameIndex);
+        
+        // Each step reads what the previous simulation node wrote
+        VkMemoryBarrier2 stepBarrier{};
+        stepBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        stepBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        stepBarrier.srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT;
+        stepBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        stepBarrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+        
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.memoryBarrierCount = 1;
+        dependencyInfo.pMemoryBarriers = &stepBarrier;
+        
+        for (uint32_t step = 0; step + 1 < steps.count; ++step) {
+            currentGlobalFrame_ = steps.fixedStep ? steps.firstStepIndex + step : globalFrame;
+            float stepTime = steps.firstStepTime + static_cast<float>(step) * steps.stepDelta;
+            
+            for (auto nodeId : executionOrder_) {
+                auto it = nodes_.find(nodeId);
+                if (it == nodes_.end() || !it->second->advancesSimulation()) continue;
+                
+                it->second->execute(computeCmd, *this, stepTime, steps.stepDelta);
+                vk.vkCmdPipelineBarrier2(computeCmd, &dependencyInfo);
+                computeExecuted = true;
+            }
+        }
+    }
+    
+    // With no step this frame, nodes after the simulation see the last completed step
+    currentGlobalFrame_ = steps.fixedStep ? steps.firstStepIndex + steps.count - 1 : globalFrame;
+}
+
 void FrameGraph::executeNodesInOrder(uint32_t frameIndex, float time, float deltaTime, uint32_t globalFrame, bool& computeExecuted) {
     VkCommandBuffer currentComputeCmd = queueManager_->getComputeCommandBuffer(frameIndex);
     VkCommandBuffer currentGraphicsCmd = queueManager_->getGraphicsCommandBuffer(frameIndex);
@@ -353,6 +422,7 @@ void FrameGraph::executeNodesInOrder(uint32_t frameIndex, float time, float delt
         if (it == nodes_.end()) continue;
         
         auto& node = it->second;
+        if (skipsThisFrame(*node)) continue;
         
         // Insert barriers for this node using the barrier manager
         barrierManager_.insertBarriersForNode(nodeId, currentGraphicsCmd, computeExecuted, node->needsGraphicsQueue());
@@ -367,6 +437,95 @@ void FrameGraph::executeNodesInOrder(uint32_t frameIndex, float time, float delt
     }
 }
 
+void FrameGraph::executeNodesParallel(uint32_t frameIndex, float time, float deltaTime, bool& computeExecuted) {
+    const auto& vk = context_->getLoader();
+    VkCommandBuffer primaryComputeCmd = queueManager_->getComputeCommandBuffer(frameIndex);
+    VkCommandBuffer primaryGraphicsCmd = queueManager_->getGraphicsCommandBuffer(frameIndex);
+    
+    // Safe to reset: the frame's fence was waited on before the frame graph runs
+    queueManager_->resetSecondaryCommandPools(frameIndex);
+    
+    // One secondary per node, filled in by whichever thread records it
+    std::vector<VkCommandBuffer> secondaries(executionOrder_.size(), VK_NULL_HANDLE);
+    
+    // Nodes resolve shared caches on the main thread before any worker starts
+    for (auto nodeId : executionOrder_) {
+        auto it = nodes_.find(nodeId);
+        if (it != nodes_.end()) {
+            it->second->prepareRecording(*this, time, deltaTime);
+        }
+    }
+    
+    auto recordNode = [this, frameIndex, time, deltaTime, &secondaries, &vk](size_t orderIndex, uint32_t threadIndex) {
+        auto& node = nodes_.find(executionOrder_[orderIndex])->second;
+        if (skipsThisFrame(*node)) {
+            return;
+        }
+        CommandPoolType poolType = node->needsComputeQueue() ? CommandPoolType::Compute : CommandPoolType::Graphics;
+        
+        VkCommandBuffer secondary = queueManager_->acquireSecondaryCommandBuffer(threadIndex, frameIndex, poolType);
+        if (secondary == VK_NULL_HANDLE) {
+            return;
+        }
+        
+        // Nodes own complete dynamic rendering instances, so nothing is inherited from the primary
+        VkCommandBufferInheritanceInfo inheritanceInfo{};
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+        
+        vk.vkBeginCommandBuffer(secondary, &beginInfo);
+        node->execute(secondary, *this, time, deltaTime);
+        vk.vkEndCommandBuffer(secondary);
+        
+        secondaries[orderIndex] = secondary;
+    };
+    
+    // Decided once, before any worker starts: recording consumes the prepared state the answer depends on
+    std::vector<bool> recordsInParallel(executionOrder_.size(), false);
+    for (size_t i = 0; i < executionOrder_.size(); ++i) {
+        auto it = nodes_.find(executionOrder_[i]);
+        recordsInParallel[i] = it != nodes_.end() && it->second->supportsParallelRecording();
+    }
+    
+    // Thread-safe nodes go to workers; the rest are recorded here while workers run
+    for (size_t i = 0; i < executionOrder_.size(); ++i) {
+        if (recordsInParallel[i]) {
+            parallelRecorder_.submit([&recordNode, i](uint32_t threadIndex) { recordNode(i, threadIndex); });
+        }
+    }
+    for (size_t i = 0; i < executionOrder_.size(); ++i) {
+        auto it = nodes_.find(executionOrder_[i]);
+        if (it != nodes_.end() && !recordsInParallel[i]) {
+            recordNode(i, 0);
+        }
+    }
+    parallelRecorder_.waitIdle();
+    
+    // Stitch secondaries into the primaries in compiled order, barriers stay on the primary
+    for (size_t i = 0; i < executionOrder_.size(); ++i) {
+        auto nodeId = executionOrder_[i];
+        auto it = nodes_.find(nodeId);
+        if (it == nodes_.end()) continue;
+        
+        auto& node = it->second;
+        if (skipsThisFrame(*node)) continue;
+        barrierManager_.insertBarriersForNode(nodeId, primaryGraphicsCmd, computeExecuted, node->needsGraphicsQueue());
+        
+        if (node->needsComputeQueue()) {
+            computeExecuted = true;
+        }
+        
+        if (secondaries[i] != VK_NULL_HANDLE) {
+            VkCommandBuffer primary = node->needsComputeQueue() ? primaryComputeCmd : primaryGraphicsCmd;
+            vk.vkCmdExecuteCommands(primary, 1, &secondaries[i]);
+        }
+    }
+}
+
 bool FrameGraph::executeWithTimeoutMonitoring(uint32_t frameIndex, float time, float deltaTime, uint32_t globalFrame, bool& computeExecuted) {
     VkCommandBuffer currentComputeCmd = queueManager_->getComputeCommandBuffer(frameIndex);
     VkCommandBuffer currentGraphicsCmd = queueManager_->getGraphicsCommandBuffer(frameIndex);
@@ -376,6 +535,7 @@ bool FrameGraph::executeWithTimeoutMonitoring(uint32_t frameIndex, float time, f
         if (it == nodes_.end()) continue;
         
         auto& node = it->second;
+        if (skipsThisFrame(*node)) continue;
         
         // Check GPU health before executing
         if (!timeoutDetector_->isGPUHealthy()) {
@@ -13,6 +13,7 @@
 #include "resources/resource_manager.h"
 #include "compilation/frame_graph_compiler.h"
 #include "execution/barrier_manager.h"
+#include "execution/parallel_command_recorder.h"
 
 // Forward declarations
 class VulkanContext;
@@ -41,6 +42,12 @@ public:
     void setMemoryMonitor(GPUMemoryMonitor* monitor);
     void setTimeoutDetector(GPUTimeoutDetector* detector) { timeoutDetector_ = detector; }
     
+    // Parallel command recording - nodes are recorded into per-thread secondary command
+    // buffers and stitched into the primaries in compiled order (disabled under timeout monitoring)
+    bool enableParallelRecording(uint32_t workerCount = FrameGraphExecution::ParallelCommandRecorder::defaultWorkerCount());
+    void disableParallelRecording();
+    bool isParallelRecordingEnabled() const { return parallelRecordingEnabled_; }
+    
     // Resource management (delegated to ResourceManager)
     FrameGraphTypes::ResourceId createBuffer(const std::string& name, VkDeviceSize size, VkBufferUsageFlags usage);
     FrameGraphTypes::ResourceId createImage(const std::string& name, VkFormat format, VkExtent2D extent, VkImageUsageFlags usage);
@@ -77,6 +84,22 @@ public:
         bool graphicsCommandBufferUsed = false;
     };
     ExecutionResult execute(uint32_t frameIndex, float time, float deltaTime, uint32_t globalFrame);
+    
+    // Simulation steps for the next execute(). Nodes that advance the simulation run count times,
+    // the first count - 1 on their own ahead of the graph, the last in compiled order with the
+    // time and deltaTime passed to execute(). With fixedStep the frame counter nodes see is the
+    // step index instead of the global frame
+    struct SimulationSteps {
+        uint32_t count = 1;
+        float stepDelta = 0.0f;
+        float firstStepTime = 0.0f;
+        uint32_t firstStepIndex = 0;
+        uint32_t seed = 0;
+        bool fixedStep = false;
+    };
+    void setSimulationSteps(const SimulationSteps& steps) { simulationSteps_ = steps; }
+    const SimulationSteps& getSimulationSteps() const { return simulationSteps_; }
+    uint32_t getSimulationSeed() const { return simulationSteps_.seed; }
     void reset(); // Clear for next frame
     void removeSwapchainResources(); // Remove swapchain images during recreation
     
@@ -114,6 +137,8 @@ private:
     FrameGraphCompilation::FrameGraphCompiler compiler_;
     FrameGraphExecution::BarrierManager barrierManager_;
     FrameGraphResources::ResourceManager resourceManager_;
+    FrameGraphExecution::ParallelCommandRecorder parallelRecorder_;
+    bool parallelRecordingEnabled_ = false;
     
     // Node storage
     std::unordered_map<FrameGraphTypes::NodeId, std::unique_ptr<FrameGraphNode>> nodes_;
@@ -126,11 +151,16 @@ private:
     // Current global frame counter (set during execution for node access)
     mutable uint32_t currentGlobalFrame_ = 0;
     
+    SimulationSteps simulationSteps_;
+    bool skipsThisFrame(const FrameGraphNode& node) const { return node.advancesSimulation() && simulationSteps_.count == 0; }
+    void recordSimulationSubsteps(uint32_t frameIndex, uint32_t globalFrame, bool& computeExecuted);
+    
     // Execution helpers
     std::pair<bool, bool> analyzeQueueRequirements() const;
     void beginCommandBuffers(bool useCompute, bool useGraphics, uint32_t frameIndex);
     void endCommandBuffers(bool useCompute, bool useGraphics, uint32_t frameIndex);
     void executeNodesInOrder(uint32_t frameIndex, float time, float deltaTime, uint32_t globalFrame, bool& computeExecuted);
+    void executeNodesParallel(uint32_t frameIndex, float time, float deltaTime, bool& computeExecuted);
     
     // Timeout-aware execution
     bool executeWithTimeoutMonitoring(uint32_t frameIndex, float time, float deltaTime, uint32_t globalFrame, bool& computeExecuted);
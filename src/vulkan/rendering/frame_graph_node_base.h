@@ -29,6 +29,17 @@ public:
     virtual void onFirstUse(const FrameGraph& frameGraph) {} // Replaces initializeNode - rarely needed
     virtual void cleanup() {} // Keep this as some nodes do need cleanup
     
+    // Parallel recording - called on the main thread before execute() so nodes can resolve
+    // shared state (pipeline caches, uniform uploads) that is not safe to touch from workers
+    virtual void prepareRecording(const FrameGraph& frameGraph, float time, float deltaTime) {}
+    
+    // Opt in when execute() only touches node-local state after prepareRecording(). Asked once per
+    // frame right after prepareRecording(), so nodes can decline for a frame they could not prepare
+    virtual bool supportsParallelRecording() const { return false; }
+    
+    // Nodes that advance the simulation by one step; the frame graph records them once per
+    // fixed step (possibly zero times) instead of once per frame
+    virtual bool advancesSimulation() const { return false; }
     
     // Synchronization hints
     virtual bool needsComputeQueue() const { return false; }
@@ -48,6 +48,6 @@ struct NodePushConstants {
     uint32_t entityCount;
     uint32_t frame;
     uint32_t param1;        // Flexible parameter - entityOffset for physics, globalFrame for entity
-    uint32_t param2;        // Future expansion
+    uint32_t seed;          // SimulationClock shader seed, 0 when unseeded
     uint32_t padding[2];    // Ensure 16-byte alignment
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "../../core/vulkan_utils.h"
 #include "../../core/vulkan_function_loader.h"
 #include "../../monitoring/gpu_memory_monitor.h"
+#include "../../monitoring/memory_accounting.h"
 #include <iostream>
 #include <algorithm>
 #include <cassert>
@@ -455,6 +456,8 @@ bool ResourceManager::tryAllocateWithStrategy(FrameGraphBuffer& buffer, Resource
                 VkResult allocResult = vk.vkAllocateMemory(device, &allocInfo, nullptr, &vkMemory);
                 if (allocResult == VK_SUCCESS) {
                     buffer.memory = vulkan_raii::DeviceMemory(vkMemory, context_);
+                    MemoryAccounting::getInstance().trackDeviceAllocation(vkMemory, allocInfo.allocationSize, memoryTypeIndex,
+                                                                          GpuMemoryCategory::FrameGraph);
                     
                     VkResult bindResult = vk.vkBindBufferMemory(device, buffer.buffer.get(), buffer.memory.get(), 0);
                     if (bindResult == VK_SUCCESS) {
@@ -547,6 +550,8 @@ bool ResourceManager::tryAllocateWithStrategy(FrameGraphImage& image, ResourceCr
         VkResult allocResult = vk.vkAllocateMemory(device, &allocInfo, nullptr, &vkMemory);
         if (allocResult == VK_SUCCESS) {
             image.memory = vulkan_raii::DeviceMemory(vkMemory, context_);
+            MemoryAccounting::getInstance().trackDeviceAllocation(vkMemory, allocInfo.allocationSize, memoryTypeIndex,
+                                                                  GpuMemoryCategory::FrameGraph);
             
             VkResult bindResult = vk.vkBindImageMemory(device, image.image.get(), image.memory.get(), 0);
             if (bindResult == VK_SUCCESS) {
@@ -606,6 +611,12 @@ void ResourceManager::performResourceCleanup() {
 }
 
 bool ResourceManager::isMemoryPressureCritical() const {
+    // Prefer the device-local heap budgets published by MemoryAllocator::updateMemoryAccounting
+    const MemoryAccounting& accounting = MemoryAccounting::getInstance();
+    if (accounting.hasHeapBudgets()) {
+        return accounting.getDeviceLocalPressure() > 0.85f;
+    }
+    
     if (!memoryMonitor_) return false;
     
     float memoryPressure = memoryMonitor_->getMemoryPressure();
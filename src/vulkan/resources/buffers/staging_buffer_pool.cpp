@@ -2,6 +2,7 @@
 #include "../../core/vulkan_context.h"
 #include "../../core/vulkan_function_loader.h"
 #include "../../core/vulkan_raii.h"
+#include "../../monitoring/memory_accounting.h"
 #include <iostream>
 #include <algorithm>
 
@@ -78,6 +79,8 @@ bool StagingBufferPool::initialize(const VulkanContext& context, VkDeviceSize si
         return false;
     }
     
+    MemoryAccounting::getInstance().trackDeviceAllocation(memory, allocInfo.allocationSize, memoryType,
+                                                          GpuMemoryCategory::Staging);
     ringBuffer.buffer = vulkan_raii::make_buffer(bufferHandle, &context);
     ringBuffer.memory = vulkan_raii::make_device_memory(memory, &context);
     ringBuffer.size = size;
@@ -85,6 +85,45 @@ void CommandExecutor::copyBufferToBuffer(VkBuffer src, VkBuffer dst, VkDeviceSiz
     );
 }
 
+bool CommandExecutor::copyBuffers(const std::vector<BufferCopy>& copies) {
+    if (!context || !queueManager) {
+        std::cerr << "CommandExecutor: Not properly initialized!" << std::endl;
+        return false;
+    }
+    
+    if (copies.empty()) {
+        return true;
+    }
+    
+    VkCommandPool commandPool = queueManager->getCommandPool(CommandPoolType::Graphics);
+    if (commandPool == VK_NULL_HANDLE) {
+        std::cerr << "CommandExecutor: No valid graphics command pool available!" << std::endl;
+        return false;
+    }
+    
+    VkCommandBuffer commandBuffer = VulkanUtils::beginSingleTimeCommands(
+        context->getDevice(), 
+        context->getLoader(), 
+        commandPool
+    );
+    
+    for (const BufferCopy& copy : copies) {
+        if (copy.src == VK_NULL_HANDLE || copy.dst == VK_NULL_HANDLE || copy.region.size == 0) {
+            continue;
+        }
+        context->getLoader().vkCmdCopyBuffer(commandBuffer, copy.src, copy.dst, 1, &copy.region);
+    }
+    
+    VulkanUtils::endSingleTimeCommands(
+        context->getDevice(),
+        context->getLoader(),
+        queueManager->getGraphicsQueue(),
+        commandPool,
+        commandBuffer
+    );
+    return true;
+}
+
 CommandExecutor::AsyncTransfer CommandExecutor::copyBufferToBufferAsync(VkBuffer src, VkBuffer dst, VkDeviceSize size,
                                                                         VkDeviceSize srcOffset, VkDeviceSize dstOffset) {
     if (!context || !queueManager) {
@@ -4,6 +4,7 @@
 #include <vulkan/vulkan.h>
 #include "../../core/vulkan_raii.h"
 #include "../../core/queue_manager.h"
+#include <vector>
 
 class VulkanContext;
 
@@ -25,6 +26,14 @@ public:
     void copyBufferToBuffer(VkBuffer src, VkBuffer dst, VkDeviceSize size, 
                            VkDeviceSize srcOffset = 0, VkDeviceSize dstOffset = 0);
     
+    // Synchronous batch: every copy recorded into one command buffer with a single submit
+    struct BufferCopy {
+        VkBuffer src = VK_NULL_HANDLE;
+        VkBuffer dst = VK_NULL_HANDLE;
+        VkBufferCopy region{};
+    };
+    bool copyBuffers(const std::vector<BufferCopy>& copies);
+    
     // Async transfer with optimal queue selection
     using AsyncTransfer = QueueManager::TransferCommand;
     
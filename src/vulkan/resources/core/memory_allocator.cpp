@@ -3,6 +3,7 @@
 #include "validation_utils.h"
 #include "../../core/vulkan_context.h"
 #include "../../core/vulkan_function_loader.h"
+#include "../../monitoring/memory_accounting.h"
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
@@ -84,6 +85,8 @@ MemoryAllocator::AllocationInfo MemoryAllocator::allocateMemory(VkMemoryRequirem
     
     allocation.size = requirements.size;
     allocation.memoryTypeIndex = memoryType;
+    MemoryAccounting::getInstance().trackDeviceAllocation(allocation.memory, requirements.size, memoryType,
+                                                          GpuMemoryCategory::RenderResources);
     
     // Track allocation in VMA wrapper for proper cleanup
     if (allocator) {
@@ -128,6 +131,7 @@ void MemoryAllocator::freeMemory(const AllocationInfo& allocation) {
         );
     }
     
+    MemoryAccounting::getInstance().trackDeviceFree(allocation.memory);
     context->getLoader().vkFreeMemory(context->getDevice(), allocation.memory, nullptr);
     
     // Update stats
@@ -257,13 +261,10 @@ bool MemoryAllocator::initializeVMA() {
 bool MemoryAllocator::isUnderMemoryPressure() const {
     if (!context || !allocator) return false;
     
-    VkPhysicalDeviceMemoryProperties memProps;
-    context->getLoader().vkGetPhysicalDeviceMemoryProperties(context->getPhysicalDevice(), &memProps);
-    
-    // Check each heap for pressure (>80% usage indicates pressure)
-    for (uint32_t i = 0; i < memProps.memoryHeapCount; i++) {
-        DeviceMemoryBudget budget = getMemoryBudget(i);
-        if (budget.pressureRatio > 0.8f) {
+    // Check each device-local heap for pressure (>80% of budget indicates pressure);
+    // host heaps are shared with the whole system and their size says little
+    for (const DeviceMemoryBudget& budget : getMemoryBudgets()) {
+        if (budget.deviceLocal && budget.pressureRatio > 0.8f) {
             return true;
         }
     }
@@ -272,29 +273,66 @@ bool MemoryAllocator::isUnderMemoryPressure() const {
 }
 
 MemoryAllocator::DeviceMemoryBudget MemoryAllocator::getMemoryBudget(uint32_t heapIndex) const {
-    DeviceMemoryBudget budget{};
-    
-    if (!context) return budget;
-    
-    VkPhysicalDeviceMemoryProperties memProps;
-    context->getLoader().vkGetPhysicalDeviceMemoryProperties(context->getPhysicalDevice(), &memProps);
-    
-    if (heapIndex >= memProps.memoryHeapCount) return budget;
-    
-    budget.heapSize = memProps.memoryHeaps[heapIndex].size;
-    
-    // Estimate used bytes from our allocations (simplified)
-    VkDeviceSize usedInHeap = 0;
-    for (const auto& alloc : allocator->allocations) {
-        // Simple heuristic: assume allocation is in this heap if it's device-local
-        usedInHeap += alloc.size;
+    std::vector<DeviceMemoryBudget> budgets = getMemoryBudgets();
+    return heapIndex < budgets.size() ? budgets[heapIndex] : DeviceMemoryBudget{};
+}
+
+std::vector<MemoryAllocator::DeviceMemoryBudget> MemoryAllocator::getMemoryBudgets() const {
+    std::vector<DeviceMemoryBudget> budgets;
+    if (!context) return budgets;
+    
+    const auto& vk = context->getLoader();
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProps{};
+    budgetProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    VkPhysicalDeviceMemoryProperties2 memProps2{};
+    memProps2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    
+    bool driverBudget = context->hasMemoryBudget() && vk.vkGetPhysicalDeviceMemoryProperties2;
+    if (driverBudget) {
+        memProps2.pNext = &budgetProps;
+        vk.vkGetPhysicalDeviceMemoryProperties2(context->getPhysicalDevice(), &memProps2);
+    } else {
+        vk.vkGetPhysicalDeviceMemoryProperties(context->getPhysicalDevice(), &memProps2.memoryProperties);
+    }
+    const VkPhysicalDeviceMemoryProperties& memProps = memProps2.memoryProperties;
+    
+    // Without the extension, attribute tracked allocations to heaps through their memory types
+    std::vector<VkDeviceSize> trackedPerHeap(memProps.memoryHeapCount, 0);
+    if (!driverBudget) {
+        for (uint32_t type = 0; type < memProps.memoryTypeCount; type++) {
+            trackedPerHeap[memProps.memoryTypes[type].heapIndex] +=
+                MemoryAccounting::getInstance().getDeviceBytesForMemoryType(type);
+        }
     }
     
-    budget.usedBytes = usedInHeap;
-    budget.availableBytes = budget.heapSize > budget.usedBytes ? budget.heapSize - budget.usedBytes : 0;
-    budget.pressureRatio = budget.heapSize > 0 ? (float)budget.usedBytes / budget.heapSize : 1.0f;
+    budgets.resize(memProps.memoryHeapCount);
+    for (uint32_t i = 0; i < memProps.memoryHeapCount; i++) {
+        DeviceMemoryBudget& budget = budgets[i];
+        budget.heapSize = memProps.memoryHeaps[i].size;
+        budget.deviceLocal = (memProps.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+        budget.budgetBytes = driverBudget ? budgetProps.heapBudget[i] : budget.heapSize;
+        budget.usedBytes = driverBudget ? budgetProps.heapUsage[i] : trackedPerHeap[i];
+        budget.availableBytes = budget.budgetBytes > budget.usedBytes ? budget.budgetBytes - budget.usedBytes : 0;
+        budget.pressureRatio = budget.budgetBytes > 0 ?
+            std::min(1.0f, (float)budget.usedBytes / budget.budgetBytes) : 1.0f;
+    }
     
-    return budget;
+    return budgets;
+}
+
+void MemoryAllocator::updateMemoryAccounting() const {
+    if (!context) return;
+    
+    std::vector<MemoryAccounting::HeapBudget> heaps;
+    for (const DeviceMemoryBudget& budget : getMemoryBudgets()) {
+        MemoryAccounting::HeapBudget heap;
+        heap.size = budget.heapSize;
+        heap.budget = budget.budgetBytes;
+        heap.usage = budget.usedBytes;
+        heap.deviceLocal = budget.deviceLocal;
+        heaps.push_back(heap);
+    }
+    MemoryAccounting::getInstance().updateHeapBudgets(heaps, context->hasMemoryBudget());
 }
 
 bool MemoryAllocator::attemptMemoryRecovery() {
@@ -317,6 +355,7 @@ void MemoryAllocator::cleanupVMA() {
             if (alloc.mappedData) {
                 allocator->loader->vkUnmapMemory(allocator->device, alloc.memory);
             }
+            MemoryAccounting::getInstance().trackDeviceFree(alloc.memory);
             allocator->loader->vkFreeMemory(allocator->device, alloc.memory, nullptr);
         }
         
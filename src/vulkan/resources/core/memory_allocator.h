@@ -55,13 +55,19 @@ public:
     // Memory pressure detection and management
     struct DeviceMemoryBudget {
         VkDeviceSize heapSize = 0;
-        VkDeviceSize usedBytes = 0;
+        VkDeviceSize budgetBytes = 0;    // VK_EXT_memory_budget heapBudget, heap size without it
+        VkDeviceSize usedBytes = 0;      // Driver heapUsage, or tracked allocations in this heap
         VkDeviceSize availableBytes = 0;
         float pressureRatio = 0.0f; // 0.0 = no pressure, 1.0 = critical
+        bool deviceLocal = false;
     };
     
     bool isUnderMemoryPressure() const;
     DeviceMemoryBudget getMemoryBudget(uint32_t heapIndex) const;
+    std::vector<DeviceMemoryBudget> getMemoryBudgets() const;
+    
+    // Publishes getMemoryBudgets() to MemoryAccounting for the profiler and eviction
+    void updateMemoryAccounting() const;
     bool attemptMemoryRecovery();
     
     // Statistics with pressure tracking
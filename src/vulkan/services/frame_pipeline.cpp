@@ -0,0 +1,50 @@
+#include "frame_pipeline.h"
+#include <iostream>
+
+FramePipeline::~FramePipeline() {
+    stop();
+}
+
+bool FramePipeline::start(RenderFunction renderFunction) {
+    if (isRunning() || !renderFunction) {
+        std::cerr << "FramePipeline: Render thread already started or no render function" << std::endl;
+        return false;
+    }
+    
+    render = std::move(renderFunction);
+    renderThread = std::thread(&FramePipeline::renderLoop, this);
+    std::cout << "FramePipeline: Render thread started, queue depth " << QUEUE_DEPTH << std::endl;
+    return true;
+}
+
+void FramePipeline::stop() {
+    if (!isRunning()) return;
+    
+    queue.close();
+    renderThread.join();
+    std::cout << "FramePipeline: Render thread stopped" << std::endl;
+}
+
+bool FramePipeline::submit(FramePacket&& packet) {
+    if (!isRunning()) {
+        return false;
+    }
+    return queue.push(std::move(packet));
+}
+
+void FramePipeline::endRecording() {
+    recording.store(false, std::memory_order_release);
+    recording.notify_all();
+}
+
+void FramePipeline::waitWhileRecording() const {
+    // The caller holds the exchange mutex, so the render thread cannot start recording again
+    recording.wait(true, std::memory_order_acquire);
+}
+
+void FramePipeline::renderLoop() {
+    FramePacket packet;
+    while (queue.pop(packet)) {
+        render(packet);
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../../ecs/core/frame_packet.h"
+#include "../../ecs/utilities/spsc_queue.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * Frame Pipeline - records and submits frames on a render thread, so the simulation step of
+ * frame N+1 runs while frame N is recorded and submitted.
+ *
+ * The simulation thread builds one FramePacket per step and hands it over through a lock-free
+ * queue one packet deep; submit() blocks while the render thread is a full packet behind, which
+ * bounds the simulation lead to one frame. State that still crosses threads outside the packets
+ * (GPUEntityManager's row mapping, readback results, spatial query callbacks, snapshots) belongs
+ * to whichever side holds the exchange mutex:
+ *
+ *   simulation thread   for its whole step
+ *   render thread       to apply a packet and decode finished readbacks, released while recording,
+ *                       taken again to submit (the simulation side may also submit GPU work)
+ *
+ * Simulation-side code that rewrites GPU state the recording reads calls waitWhileRecording()
+ * with the exchange mutex held. A pipeline is started once; stop() is final.
+ */
+class FramePipeline {
+public:
+    using RenderFunction = std::function<void(FramePacket&)>;
+
+    FramePipeline() = default;
+    ~FramePipeline();
+
+    bool start(RenderFunction renderFunction);
+    // The render thread finishes the packets already submitted, then exits
+    void stop();
+    bool isRunning() const { return renderThread.joinable(); }
+
+    // Simulation thread, outside the exchange mutex
+    bool submit(FramePacket&& packet);
+
+    std::mutex& getExchangeMutex() { return exchangeMutex; }
+    CameraFeed& getCameraFeed() { return cameraFeed; }
+
+    // Render thread, around the recording that runs without the exchange mutex
+    void beginRecording() { recording.store(true, std::memory_order_release); }
+    void endRecording();
+    void waitWhileRecording() const;
+
+private:
+    static constexpr size_t QUEUE_DEPTH = 1;
+
+    void renderLoop();
+
+    SpscQueue<FramePacket, QUEUE_DEPTH> queue;
+    std::thread renderThread;
+    RenderFunction render;
+    std::mutex exchangeMutex;
+    CameraFeed cameraFeed;
+    std::atomic<bool> recording{false};
+};
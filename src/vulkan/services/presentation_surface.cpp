@@ -88,8 +88,16 @@ bool PresentationSurface::recreateSwapchain() {
     //     return false;
     // }
 
-    // Clear graphics pipeline cache to prevent corruption
-    graphicsManager->clearCache();
+    // CRITICAL FIX FOR SECOND RESIZE CRASH: Recreate pipeline cache before render pass recreation
+    // This addresses VkPipelineCache internal corruption that survives first resize but crashes on second.
+    // Cached pipelines and render passes are retired, not destroyed, so frames in flight keep them;
+    // recreating after createRenderPass would retire the new render pass as well
+    if (!graphicsManager->recreatePipelineCache()) {
+        std::cerr << "PresentationSurface: CRITICAL ERROR - Failed to recreate graphics pipeline cache during swapchain recreation" << std::endl;
+        std::cerr << "  This may cause pipeline creation failures or crashes in subsequent frames" << std::endl;
+        // Continue anyway - this is better than failing entirely
+        graphicsManager->clearCache();
+    }
     
     // Recreate render pass for new swapchain format
     currentRenderPass = graphicsManager->createRenderPass(
@@ -99,23 +107,10 @@ bool PresentationSurface::recreateSwapchain() {
         recreationInProgress = false;
         return false;
     }
-    
-    // CRITICAL FIX FOR SECOND RESIZE CRASH: Recreate pipeline cache after render pass recreation
-    // This addresses VkPipelineCache internal corruption that survives first resize but crashes on second
-    if (!graphicsManager->recreatePipelineCache()) {
-        std::cerr << "PresentationSurface: CRITICAL ERROR - Failed to recreate graphics pipeline cache during swapchain recreation" << std::endl;
-        std::cerr << "  This may cause pipeline creation failures or crashes in subsequent frames" << std::endl;
-        // Continue anyway - this is better than failing entirely
-    }
 
     // Recreate swapchain
-    if (!swapchain->recreate(currentRenderPass)) {
-        recreationInProgress = false;
-        return false;
-    }
-
-    // Recreate framebuffers
-    if (!swapchain->createFramebuffers(currentRenderPass)) {
+    // Entity passes use dynamic rendering against the swapchain's own targets, so no framebuffers
+    if (!swapchain->recreate()) {
         recreationInProgress = false;
         return false;
     }
@@ -8,6 +8,10 @@
 #include "../resources/managers/graphics_resource_manager.h"
 #include "../nodes/entity_compute_node.h"
 #include "../nodes/physics_compute_node.h"
+#include "../nodes/collision_node.h"
+#include "../nodes/position_readback_node.h"
+#include "../nodes/spatial_query_node.h"
+#include "../nodes/spatial_reorder_node.h"
 #include "../nodes/entity_graphics_node.h"
 #include "../nodes/swapchain_present_node.h"
 #include "../../ecs/gpu/gpu_entity_manager.h"
@@ -142,6 +146,40 @@ void RenderFrameDirector::setupFrameGraph(uint32_t imageIndex) {
             gpuEntityManager
         );
         
+        // Broadphase/narrowphase collision over the integrated positions; writes the output positions
+        collisionNodeId = frameGraph->addNode<CollisionNode>(
+            entityBufferId,
+            positionBufferId,
+            currentPositionBufferId,
+            pipelineSystem->getComputeManager(),
+            gpuEntityManager
+        );
+        
+        // Streams CPUObserved positions back to the ECS (no-op while nothing is observed)
+        readbackNodeId = frameGraph->addNode<PositionReadbackNode>(
+            entityBufferId,
+            positionBufferId,
+            gpuEntityManager
+        );
+        
+        // Answers batched spatial queries against the physics output (no-op without queries)
+        spatialQueryNodeId = frameGraph->addNode<SpatialQueryNode>(
+            positionBufferId,
+            pipelineSystem->getComputeManager(),
+            gpuEntityManager
+        );
+        
+        // Periodic Morton/cell reordering of the rows (no-op unless a reorder interval is set)
+        if (gpuPrimitives) {
+            spatialReorderNodeId = frameGraph->addNode<SpatialReorderNode>(
+                entityBufferId,
+                positionBufferId,
+                pipelineSystem->getComputeManager(),
+                gpuPrimitives,
+                gpuEntityManager
+            );
+        }
+        
         // ELEGANT SOLUTION: Pass a dynamic swapchain image reference
         // Nodes will resolve the actual resource ID at execution time
         graphicsNodeId = frameGraph->addNode<EntityGraphicsNode>(
@@ -149,10 +187,16 @@ void RenderFrameDirector::setupFrameGraph(uint32_t imageIndex) {
             positionBufferId,
             0, // Placeholder - will be resolved dynamically
             pipelineSystem->getGraphicsManager(),
+            pipelineSystem->getComputeManager(),
             swapchain,
             resourceCoordinator,
             gpuEntityManager
         );
+        if (auto* graphicsNode = frameGraph->getNode<EntityGraphicsNode>(graphicsNodeId)) {
+            graphicsNode->setDrawPath(entityDrawPath);
+            graphicsNode->setRenderScaleConfig(renderScaleConfig, renderScaleEnabled);
+            graphicsNode->setCameraFeed(cameraFeed);
+        }
         
         presentNodeId = frameGraph->addNode<SwapchainPresentNode>(
             0, // Placeholder - will be resolved dynamically  
@@ -162,7 +206,7 @@ void RenderFrameDirector::setupFrameGraph(uint32_t imageIndex) {
         // Mark as initialized after nodes are added
         frameGraphInitialized = true;
         std::cout << "RenderFrameDirector: Created nodes - Compute:" << computeNodeId 
-                  << " Physics:" << physicsNodeId << " Graphics:" << graphicsNodeId 
+                  << " Physics:" << physicsNodeId << " Collision:" << collisionNodeId << " Readback:" << readbackNodeId << " SpatialQuery:" << spatialQueryNodeId << " SpatialReorder:" << spatialReorderNodeId << " Graphics:" << graphicsNodeId 
                   << " Present:" << presentNodeId << std::endl;
     }
     
@@ -175,6 +219,9 @@ void RenderFrameDirector::configureFrameGraphNodes(uint32_t imageIndex, flecs::w
         graphicsNode->setImageIndex(imageIndex);
         graphicsNode->setCurrentSwapchainImageId(swapchainImageId); // Dynamic resolution
         graphicsNode->setWorld(world);
+        graphicsNode->setLateLatchCamera(lateLatchCamera);
+        graphicsNode->setFrameCamera(frameCamera);
+        graphicsNode->setLodMode(entityLodMode);
     }
     
     if (auto* presentNode = frameGraph->getNode<SwapchainPresentNode>(presentNodeId)) {
@@ -183,6 +230,45 @@ void RenderFrameDirector::configureFrameGraphNodes(uint32_t imageIndex, flecs::w
     }
 }
 
+void RenderFrameDirector::setCameraFeed(const CameraFeed* feed) {
+    cameraFeed = feed;
+    auto* graphicsNode = frameGraph && frameGraphInitialized ? frameGraph->getNode<EntityGraphicsNode>(graphicsNodeId) : nullptr;
+    if (graphicsNode) {
+        graphicsNode->setCameraFeed(feed);
+    }
+}
+
+void RenderFrameDirector::setEntityDrawPath(EntityDrawPath path) {
+    entityDrawPath = path;
+    auto* graphicsNode = frameGraph && frameGraphInitialized ? frameGraph->getNode<EntityGraphicsNode>(graphicsNodeId) : nullptr;
+    if (graphicsNode) {
+        graphicsNode->setDrawPath(path);
+    }
+}
+
+void RenderFrameDirector::setRenderScaleConfig(const RenderScaleController::Config& config, bool enabled) {
+    renderScaleConfig = config;
+    renderScaleEnabled = enabled;
+    auto* graphicsNode = frameGraph && frameGraphInitialized ? frameGraph->getNode<EntityGraphicsNode>(graphicsNodeId) : nullptr;
+    if (graphicsNode) {
+        graphicsNode->setRenderScaleConfig(config, enabled);
+    }
+}
+
+bool RenderFrameDirector::startDrawPathBenchmark(uint32_t framesPerPath) {
+    auto* graphicsNode = frameGraph && frameGraphInitialized ? frameGraph->getNode<EntityGraphicsNode>(graphicsNodeId) : nullptr;
+    if (!graphicsNode) {
+        return false;
+    }
+    graphicsNode->startDrawPathBenchmark(framesPerPath);
+    return graphicsNode->isDrawPathBenchmarkRunning();
+}
+
+uint64_t RenderFrameDirector::getCameraSampleTicksNS() const {
+    auto* graphicsNode = frameGraph ? frameGraph->getNode<EntityGraphicsNode>(graphicsNodeId) : nullptr;
+    return graphicsNode ? graphicsNode->getCameraSampleTicksNS() : 0;
+}
+
 void RenderFrameDirector::configureNodes(
     FrameGraphTypes::NodeId graphicsNodeId, 
     FrameGraphTypes::NodeId presentNodeId, 
@@ -7,6 +7,8 @@
 #include <flecs.h>
 #include "../core/vulkan_constants.h"
 #include "../rendering/frame_graph.h"
+#include "../monitoring/render_scale_controller.h"
+#include "../../ecs/core/camera_feed.h"
 
 // Forward declarations
 class VulkanContext;
@@ -16,6 +18,9 @@ class ResourceCoordinator;
 class GPUEntityManager;
 class PipelineSystemManager;
 class PresentationSurface;
+class GpuPrimitives;
+enum class EntityLodMode : uint32_t;
+enum class EntityDrawPath : uint32_t;
 
 struct RenderFrameResult {
     bool success = false;
@@ -59,6 +64,30 @@ public:
     
     // Swapchain recreation support
     void resetSwapchainCache();
+    
+    // Camera late latch (applied to the graphics node each frame) and when it last sampled the camera
+    void setLateLatchCamera(bool enabled) { lateLatchCamera = enabled; }
+    uint64_t getCameraSampleTicksNS() const;
+    
+    // Pipelined rendering: the frame packet's camera (applied to the graphics node each frame) and
+    // the simulation thread's newest camera for the late latch (applied when set and when it is created)
+    void setFrameCamera(const CameraSnapshot& camera) { frameCamera = camera; }
+    void setCameraFeed(const CameraFeed* feed);
+    
+    // Enables the spatial reorder node; must be set before the first frame builds the graph
+    void setGpuPrimitives(GpuPrimitives* primitives) { gpuPrimitives = primitives; }
+    
+    // Zoomed-out density LOD of the entity draw (applied to the graphics node each frame)
+    void setEntityLodMode(EntityLodMode mode) { entityLodMode = mode; }
+    
+    // Triangle draw path, applied to the graphics node when set and when it is created
+    void setEntityDrawPath(EntityDrawPath path);
+    
+    // Starts the graphics node's GPU-timed draw path A/B; false until the graph is built
+    bool startDrawPathBenchmark(uint32_t framesPerPath);
+    
+    // Dynamic resolution and MSAA budget, applied to the graphics node when set and when it is created
+    void setRenderScaleConfig(const RenderScaleController::Config& config, bool enabled);
 
 private:
     // Dependencies
@@ -70,6 +99,7 @@ private:
     GPUEntityManager* gpuEntityManager = nullptr;
     FrameGraph* frameGraph = nullptr;
     PresentationSurface* presentationSurface = nullptr;
+    GpuPrimitives* gpuPrimitives = nullptr;
 
     // Resource IDs
     FrameGraphTypes::ResourceId entityBufferId = 0;
@@ -80,6 +110,13 @@ private:
     
     // State management
     bool frameGraphInitialized = false;
+    bool lateLatchCamera = true;
+    CameraSnapshot frameCamera;
+    const CameraFeed* cameraFeed = nullptr;
+    EntityLodMode entityLodMode{};
+    EntityDrawPath entityDrawPath{};
+    RenderScaleController::Config renderScaleConfig;
+    bool renderScaleEnabled = false;
     std::vector<FrameGraphTypes::ResourceId> swapchainImageIds; // Cached per swapchain image
     
     // Global frame counter for compute shader consistency
@@ -88,6 +125,10 @@ private:
     // Node IDs for configuration
     FrameGraphTypes::NodeId computeNodeId = 0;
     FrameGraphTypes::NodeId physicsNodeId = 0;
+    FrameGraphTypes::NodeId collisionNodeId = 0;
+    FrameGraphTypes::NodeId readbackNodeId = 0;
+    FrameGraphTypes::NodeId spatialQueryNodeId = 0;
+    FrameGraphTypes::NodeId spatialReorderNodeId = 0;
     FrameGraphTypes::NodeId graphicsNodeId = 0;
     FrameGraphTypes::NodeId presentNodeId = 0;
 
@@ -3,8 +3,10 @@
 #include "vulkan/core/vulkan_context.h"
 #include "vulkan/core/vulkan_swapchain.h"
 #include "vulkan/core/vulkan_sync.h"
+#include "vulkan/core/vulkan_utils.h"
 #include "vulkan/core/queue_manager.h"
 #include "vulkan/resources/core/resource_coordinator.h"
+#include "vulkan/resources/core/memory_allocator.h"
 #include "vulkan/resources/managers/graphics_resource_manager.h"
 #include "vulkan/rendering/frame_graph.h"
 #include "vulkan/nodes/entity_compute_node.h"
@@ -17,7 +19,11 @@
 #include "vulkan/services/presentation_surface.h"
 #include "vulkan/services/frame_state_manager.h"
 #include "vulkan/services/error_recovery_service.h"
+#include "vulkan/services/frame_pipeline.h"
 #include "vulkan/pipelines/pipeline_system_manager.h"
+#include "vulkan/pipelines/gpu_primitives.h"
+#include "vulkan/monitoring/compute_autotuner.h"
+#include "vulkan/monitoring/memory_accounting.h"
 #include "ecs/gpu/gpu_entity_manager.h"
 #include "ecs/components/component.h"
 #include "ecs/components/camera_component.h"
@@ -98,12 +104,6 @@ bool VulkanRenderer::initialize(SDL_Window* window) {
         return false;
     }
     
-    if (!swapchain->createFramebuffers(renderPass)) {
-        std::cerr << "Failed to create framebuffers" << std::endl;
-        cleanup();
-        return false;
-    }
-    
     // Phase 4: Resource management (depends on context, queue manager)
     resourceCoordinator = std::make_unique<ResourceCoordinator>();
     if (!resourceCoordinator || !resourceCoordinator->initialize(*context, queueManager.get())) {
@@ -147,7 +147,7 @@ bool VulkanRenderer::initialize(SDL_Window* window) {
     
     // Phase 6: Entity management (depends on context, sync, resource context)
     gpuEntityManager = std::make_unique<GPUEntityManager>();
-    if (!gpuEntityManager || !gpuEntityManager->initialize(*context, sync.get(), resourceCoordinator.get())) {
+    if (!gpuEntityManager || !gpuEntityManager->initialize(*context, sync.get(), resourceCoordinator.get(), pipelineSystem->getEntitySchema())) {
         std::cerr << "Failed to initialize GPU entity manager" << std::endl;
         cleanup();
         return false;
@@ -192,6 +192,14 @@ bool VulkanRenderer::initialize(SDL_Window* window) {
         return false;
     }
     
+    gpuPrimitives = std::make_unique<GpuPrimitives>();
+    if (!gpuPrimitives->initialize(*context, pipelineSystem->getComputeManager(), resourceCoordinator.get(),
+                                    gpuEntityManager->getMaxEntities())) {
+        std::cerr << "Failed to initialize GPU primitives" << std::endl;
+        cleanup();
+        return false;
+    }
+    
     // Phase 7: Modular architecture (depends on all previous components)
     if (!initializeModularArchitecture()) {
         std::cerr << "Failed to initialize modular architecture" << std::endl;
@@ -208,6 +216,14 @@ bool VulkanRenderer::initialize(SDL_Window* window) {
     
     pipelineSystem->warmupCommonPipelines();
     
+    // Per-device workgroup/chunk tuning - runs before any entity upload, which rewrites the buffers it touches
+    ComputeAutotuner autotuner(context.get(), pipelineSystem->getComputeManager());
+    const auto& entityBuffers = gpuEntityManager->getBufferManager();
+    autotuner.setCollisionBuffers(entityBuffers.getSpatialMapBuffer(), entityBuffers.getCollisionPairBuffer());
+    autotuner.loadOrTune("compute_tuning.cfg",
+                         gpuEntityManager->getDescriptorManager().getIndexedDescriptorSet(),
+                         gpuEntityManager->getMaxEntities());
+    
     std::cout << "VulkanRenderer: AAA Pipeline System initialization complete" << std::endl;
     
     initialized = true;
@@ -215,6 +231,9 @@ bool VulkanRenderer::initialize(SDL_Window* window) {
 }
 
 void VulkanRenderer::cleanup() {
+    // The render thread drains its queue first, nothing may record or submit past this point
+    stopRenderThread();
+    
     // Wait for device to be idle before cleanup - but only if context is valid
     if (context && context->getDevice() != VK_NULL_HANDLE) {
         try {
@@ -224,11 +243,17 @@ void VulkanRenderer::cleanup() {
         } catch (const std::exception& e) {
             std::cerr << "Exception during device wait idle: " << e.what() << std::endl;
         }
+        context->getDeferredDestruction().flush();
     }
     
     // Cleanup modular architecture first (higher-level components)
     cleanupModularArchitecture();
     
+    // Scratch buffers and descriptor pool go back before the resource coordinator tears down
+    if (gpuPrimitives) {
+        gpuPrimitives.reset();
+    }
+    
     // Cleanup RAII resources before destroying their dependencies
     if (sync) {
         try {
@@ -293,6 +318,69 @@ void VulkanRenderer::drawFrame() {
     drawFrameModular();
 }
 
+bool VulkanRenderer::startRenderThread() {
+    if (!initialized || !frameDirector || isRenderThreadRunning()) {
+        return false;
+    }
+    
+    // Staged rows now travel in frame packets, and the render thread never reads CameraService
+    framePipeline = std::make_unique<FramePipeline>();
+    gpuEntityManager->setDeferredUploads(true);
+    frameDirector->setCameraFeed(&framePipeline->getCameraFeed());
+    if (!framePipeline->start([this](FramePacket& packet) { renderFramePacket(packet); })) {
+        gpuEntityManager->setDeferredUploads(false);
+        frameDirector->setCameraFeed(nullptr);
+        framePipeline.reset();
+        return false;
+    }
+    return true;
+}
+
+void VulkanRenderer::stopRenderThread() {
+    if (!framePipeline) return;
+    
+    framePipeline->stop();
+    if (frameDirector) {
+        frameDirector->setCameraFeed(nullptr);
+    }
+    if (gpuEntityManager) {
+        gpuEntityManager->setDeferredUploads(false);
+    }
+    framePipeline.reset();
+}
+
+bool VulkanRenderer::isRenderThreadRunning() const {
+    return framePipeline && framePipeline->isRunning();
+}
+
+std::unique_lock<std::mutex> VulkanRenderer::lockFrameExchange() {
+    if (!isRenderThreadRunning()) {
+        return {};
+    }
+    return std::unique_lock<std::mutex>(framePipeline->getExchangeMutex());
+}
+
+void VulkanRenderer::publishCamera(const CameraSnapshot& camera) {
+    if (isRenderThreadRunning()) {
+        framePipeline->getCameraFeed().publish(camera);
+    }
+}
+
+void VulkanRenderer::submitFramePacket(FramePacket&& packet) {
+    if (isRenderThreadRunning()) {
+        framePipeline->submit(std::move(packet));
+        return;
+    }
+    applyFramePacket(packet);
+    drawFrameModular();
+}
+
+void VulkanRenderer::quiesceRenderThread() {
+    if (isRenderThreadRunning()) {
+        framePipeline->waitWhileRecording();
+    }
+}
+
 
 bool VulkanRenderer::initializeModularArchitecture() {
     frameGraph = std::make_unique<FrameGraph>();
@@ -301,6 +389,9 @@ bool VulkanRenderer::initializeModularArchitecture() {
         return false;
     }
     
+    // Record nodes into per-thread secondary command buffers; serial recording remains the fallback
+    frameGraph->enableParallelRecording();
+    
     resourceRegistry = std::make_unique<FrameGraphResourceRegistry>();
     if (!resourceRegistry->initialize(frameGraph.get(), gpuEntityManager.get())) {
         std::cerr << "Failed to initialize resource importer" << std::endl;
@@ -327,6 +418,11 @@ bool VulkanRenderer::initializeModularArchitecture() {
         frameGraph.get(),
         presentationSurface.get()
     );
+    frameDirector->setLateLatchCamera(lateLatchCamera);
+    frameDirector->setGpuPrimitives(gpuPrimitives.get());
+    frameDirector->setEntityLodMode(entityLodMode);
+    frameDirector->setEntityDrawPath(entityDrawPath);
+    frameDirector->setRenderScaleConfig(renderScaleConfig, renderScaleEnabled);
     
     frameDirector->updateResourceIds(
         resourceRegistry->getEntityBufferId(),
@@ -362,6 +458,50 @@ void VulkanRenderer::cleanupModularArchitecture() {
 }
 
 void VulkanRenderer::drawFrameModular() {
+    if (!waitForFrameSlot()) {
+        return;
+    }
+    beginFrameExchange();
+    RenderFrameResult frameResult = recordFrame();
+    finishFrame(frameResult);
+}
+
+void VulkanRenderer::renderFramePacket(FramePacket& packet) {
+    const bool slotReady = waitForFrameSlot();
+    
+    std::unique_lock<std::mutex> exchangeLock(framePipeline->getExchangeMutex());
+    // Spawns are uploaded even when the frame is dropped; their rows are already registered
+    applyFramePacket(packet);
+    if (!slotReady) {
+        return;
+    }
+    beginFrameExchange();
+    
+    // Recording reads only render-side state, so the simulation thread runs its next step meanwhile
+    framePipeline->beginRecording();
+    exchangeLock.unlock();
+    RenderFrameResult frameResult = recordFrame();
+    framePipeline->endRecording();
+    
+    exchangeLock.lock();
+    finishFrame(frameResult);
+}
+
+void VulkanRenderer::applyFramePacket(FramePacket& packet) {
+    setDeltaTime(packet.deltaTime);
+    markInputTimestamp(packet.inputTimestampNS);
+    if (packet.framebufferResized) {
+        setFramebufferResized(true);
+    }
+    if (frameDirector) {
+        frameDirector->setFrameCamera(packet.camera);
+    }
+    if (gpuEntityManager) {
+        gpuEntityManager->uploadStagedBatch(packet.spawns, packet.spawnEpoch);
+    }
+}
+
+bool VulkanRenderer::waitForFrameSlot() {
     // Wait for previous frame GPU work to complete using FrameStateManager
     if (frameStateManager && frameStateManager->hasActiveFences(currentFrame)) {
         auto fencesToWait = frameStateManager->getFencesToWait(currentFrame, sync.get());
@@ -374,29 +514,63 @@ void VulkanRenderer::drawFrameModular() {
                                                     fencesToWait.data(), VK_TRUE, UINT64_MAX);
             if (waitResult != VK_SUCCESS) {
                 std::cerr << "VulkanRenderer: Failed to wait for GPU fences: " << waitResult << std::endl;
-                return;
+                return false;
             }
         }
     }
     
+    // The slot's previous frame has completed, so objects retired up to that frame can go
+    if (context) {
+        context->getDeferredDestruction().beginFrame(frameCounter);
+    }
+    return true;
+}
+
+void VulkanRenderer::beginFrameExchange() {
     // Upload pending GPU entities
     if (gpuEntityManager && gpuEntityManager->hasPendingUploads()) {
         gpuEntityManager->uploadPendingEntities();
     }
     
-    // Orchestrate the frame
-    auto frameResult = frameDirector->directFrame(
+    // This frame slot's fence has been waited on, so its position readback copy is complete
+    if (gpuEntityManager) {
+        gpuEntityManager->beginReadbackFrame(currentFrame);
+    }
+    
+    // Poll shader sources for edits (no-op unless hot reload is enabled)
+    if (frameCounter % 30 == 0) {
+        pipelineSystem->getShaderManager()->checkForShaderReloads();
+    }
+    
+    // Steps to simulate this frame; nodes see the last one, earlier ones are recorded ahead of the graph
+    SimulationClock::Steps steps = simulationClock.advance(deltaTime);
+    FrameGraph::SimulationSteps graphSteps;
+    graphSteps.count = steps.count;
+    graphSteps.stepDelta = steps.stepDelta;
+    graphSteps.firstStepTime = steps.firstStepTime;
+    graphSteps.firstStepIndex = steps.firstStepIndex;
+    graphSteps.seed = simulationClock.getSeed(SimulationClock::SeedStream::Shader);
+    graphSteps.fixedStep = simulationClock.isFixedStep();
+    frameGraph->setSimulationSteps(graphSteps);
+    totalTime = steps.lastStepTime();
+    frameStepDelta = steps.stepDelta;
+}
+
+RenderFrameResult VulkanRenderer::recordFrame() {
+    return frameDirector->directFrame(
         currentFrame,
         totalTime,
-        deltaTime, 
+        frameStepDelta,
         frameCounter,
         world
     );
-    
+}
+
+void VulkanRenderer::finishFrame(RenderFrameResult& frameResult) {
     if (!frameResult.success) {
         RenderFrameResult retryResult = {};
         if (errorRecoveryService && errorRecoveryService->handleFrameFailure(
-            frameResult, frameDirector.get(), currentFrame, totalTime, deltaTime, frameCounter, world, retryResult)) {
+            frameResult, frameDirector.get(), currentFrame, totalTime, frameStepDelta, frameCounter, world, retryResult)) {
             frameResult = retryResult;
         } else {
             return;
@@ -408,6 +582,7 @@ void VulkanRenderer::drawFrameModular() {
     // Note: Frame graph nodes already configured in directFrame() - no need to configure again
     
     // Submit frame work
+    const uint64_t submitTicksNS = SDL_GetTicksNS();
     auto submissionResult = submissionService->submitFrame(
         currentFrame,
         frameResult.imageIndex,
@@ -421,6 +596,7 @@ void VulkanRenderer::drawFrameModular() {
         return;
     } else {
         logFrameSuccessIfNeeded("Frame submission completed successfully");
+        recordSubmitLatency(submitTicksNS);
     }
     
     if (submissionResult.swapchainRecreationNeeded || framebufferResized) {
@@ -435,15 +611,21 @@ void VulkanRenderer::drawFrameModular() {
     }
     
     // Periodic memory pressure monitoring (every 60 frames to avoid performance impact)
+    // Also refreshes the heap budgets that the profiler report and frame graph eviction read
     if (frameCounter % 60 == 0 && resourceCoordinator) {
+        if (MemoryAllocator* memoryAllocator = resourceCoordinator->getMemoryAllocator()) {
+            memoryAllocator->updateMemoryAccounting();
+        }
         bool memoryPressure = resourceCoordinator->isUnderMemoryPressure();
         if (memoryPressure) {
-            VkDeviceSize totalAllocated = resourceCoordinator->getTotalAllocatedMemory();
-            VkDeviceSize available = resourceCoordinator->getAvailableMemory();
+            const MemoryAccounting& accounting = MemoryAccounting::getInstance();
+            uint64_t used = accounting.getDeviceLocalUsage();
+            uint64_t budget = accounting.getDeviceLocalBudget();
             uint32_t allocCount = resourceCoordinator->getAllocationCount();
             std::cout << "VulkanRenderer: Frame " << frameCounter << " - Memory pressure status: HIGH" 
-                      << ", Total allocated: " << (totalAllocated / (1024 * 1024)) << "MB"
-                      << ", Available: " << (available / (1024 * 1024)) << "MB"
+                      << ", Device-local used: " << (used / (1024 * 1024)) << "MB"
+                      << ", Budget: " << (budget / (1024 * 1024)) << "MB"
+                      << ", Tracked: " << (accounting.getTrackedDeviceBytes() / (1024 * 1024)) << "MB"
                       << ", Active allocations: " << allocCount << std::endl;
         }
     }
@@ -458,7 +640,6 @@ void VulkanRenderer::drawFrameModular() {
         );
     }
     
-    totalTime += deltaTime;
     frameCounter++;
     currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 }
@@ -476,6 +657,88 @@ void VulkanRenderer::setFramebufferResized(bool resized) {
     }
 }
 
+void VulkanRenderer::setLateLatchCamera(bool enabled) {
+    lateLatchCamera = enabled;
+    if (frameDirector) {
+        frameDirector->setLateLatchCamera(enabled);
+    }
+}
+
+void VulkanRenderer::setEntityLodMode(EntityLodMode mode) {
+    entityLodMode = mode;
+    if (frameDirector) {
+        frameDirector->setEntityLodMode(mode);
+    }
+}
+
+void VulkanRenderer::setEntityDrawPath(EntityDrawPath path) {
+    entityDrawPath = path;
+    if (frameDirector) {
+        frameDirector->setEntityDrawPath(path);
+    }
+}
+
+void VulkanRenderer::setRenderScaleConfig(const RenderScaleController::Config& config, bool enabled) {
+    renderScaleConfig = config;
+    renderScaleEnabled = enabled;
+    if (frameDirector) {
+        frameDirector->setRenderScaleConfig(config, enabled);
+    }
+}
+
+bool VulkanRenderer::submitImmediateCompute(const std::function<void(VkCommandBuffer)>& record) {
+    if (!context || !queueManager || !record) {
+        return false;
+    }
+    
+    quiesceRenderThread();
+    const auto& vk = context->getLoader();
+    const VkDevice device = context->getDevice();
+    vk.vkDeviceWaitIdle(device);
+    
+    VkCommandPool commandPool = queueManager->getCommandPool(CommandPoolType::Compute);
+    VkCommandBuffer commandBuffer = VulkanUtils::beginSingleTimeCommands(device, vk, commandPool);
+    record(commandBuffer);
+    VulkanUtils::endSingleTimeCommands(device, vk, queueManager->getComputeQueue(), commandPool, commandBuffer);
+    vk.vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+    return true;
+}
+
+bool VulkanRenderer::benchmarkEntityDrawPaths(uint32_t framesPerPath) {
+    quiesceRenderThread();
+    return frameDirector && frameDirector->startDrawPathBenchmark(framesPerPath);
+}
+
+void VulkanRenderer::markInputTimestamp(uint64_t sdlTicksNS) {
+    // Frames that fail to submit keep the oldest pending input for the next successful one
+    if (sdlTicksNS != 0 && (pendingInputTimestampNS == 0 || sdlTicksNS < pendingInputTimestampNS)) {
+        pendingInputTimestampNS = sdlTicksNS;
+    }
+}
+
+void VulkanRenderer::recordSubmitLatency(uint64_t submitTicksNS) {
+    constexpr float NS_TO_MS = 1.0e-6f;
+    constexpr float AVERAGE_WEIGHT = 0.1f;
+    
+    uint64_t cameraTicksNS = frameDirector ? frameDirector->getCameraSampleTicksNS() : 0;
+    if (cameraTicksNS != 0 && cameraTicksNS <= submitTicksNS) {
+        latencyStats.cameraAgeAtSubmitMs = static_cast<float>(submitTicksNS - cameraTicksNS) * NS_TO_MS;
+    }
+    
+    if (pendingInputTimestampNS == 0 || pendingInputTimestampNS > submitTicksNS) {
+        return;
+    }
+    float latencyMs = static_cast<float>(submitTicksNS - pendingInputTimestampNS) * NS_TO_MS;
+    pendingInputTimestampNS = 0;
+    
+    latencyStats.lastInputToSubmitMs = latencyMs;
+    latencyStats.maxInputToSubmitMs = std::max(latencyStats.maxInputToSubmitMs, latencyMs);
+    latencyStats.averageInputToSubmitMs = latencyStats.samples == 0
+        ? latencyMs
+        : latencyStats.averageInputToSubmitMs + (latencyMs - latencyStats.averageInputToSubmitMs) * AVERAGE_WEIGHT;
+    latencyStats.samples++;
+}
+
 void VulkanRenderer::logFrameSuccessIfNeeded(const char* operation) {
     // Monitor first few frames after resize with consolidated logging
     static uint32_t lastRecreationFrame = 0;
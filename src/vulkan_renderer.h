@@ -3,7 +3,9 @@
 #define VK_NO_PROTOTYPES
 #include <vulkan/vulkan.h>
 #include <SDL3/SDL.h>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -11,6 +13,8 @@
 #include "vulkan/core/vulkan_constants.h"
 #include "vulkan/rendering/frame_graph.h"
 #include "vulkan/pipelines/pipeline_system_manager.h"
+#include "vulkan/monitoring/render_scale_controller.h"
+#include "ecs/core/simulation_clock.h"
 
 // Forward declarations for modules
 class VulkanContext;
@@ -19,10 +23,13 @@ class VulkanSync;
 class QueueManager;
 class ResourceCoordinator;
 class GPUEntityManager;
+class GpuPrimitives;
 class FrameGraph;
 class EntityComputeNode;
 class EntityGraphicsNode;
 class SwapchainPresentNode;
+enum class EntityLodMode : uint32_t;
+enum class EntityDrawPath : uint32_t;
 
 // New modular architecture
 class RenderFrameDirector;
@@ -32,6 +39,10 @@ class GPUSynchronizationService;
 class PresentationSurface;
 class FrameStateManager;
 class ErrorRecoveryService;
+class FramePipeline;
+struct FramePacket;
+struct CameraSnapshot;
+struct RenderFrameResult;
 
 class VulkanRenderer {
 public:
@@ -43,14 +54,48 @@ public:
     void cleanup();
     void drawFrame();
     
+    // Pipelined rendering: frames are recorded and submitted on a render thread fed with frame
+    // packets, so the next simulation step overlaps them (see FramePipeline)
+    bool startRenderThread();
+    void stopRenderThread();
+    bool isRenderThreadRunning() const;
+    
+    // Simulation thread: hold the lock for the whole step (it is empty without a render thread),
+    // publish the camera once it is updated, then submit the step's packet after releasing the lock.
+    // Without a render thread the packet is applied and drawn on the calling thread
+    std::unique_lock<std::mutex> lockFrameExchange();
+    void publishCamera(const CameraSnapshot& camera);
+    void submitFramePacket(FramePacket&& packet);
+    
+    // Blocks until the render thread is not recording. Call with the frame exchange lock held before
+    // rewriting GPU state from the simulation thread
+    void quiesceRenderThread();
+    
     
     // GPU entity management
     GPUEntityManager* getGPUEntityManager() { return gpuEntityManager.get(); }
+    
+    // Scan, compaction and radix sort over GPU buffers, sized for the entity capacity
+    GpuPrimitives* getGpuPrimitives() { return gpuPrimitives.get(); }
+    ResourceCoordinator* getResourceCoordinator() { return resourceCoordinator.get(); }
+    PipelineSystemManager* getPipelineSystem() { return pipelineSystem.get(); }
+    
+    // One-off compute work outside the frame graph (self-tests): quiesces the render thread, waits for
+    // the device to go idle, then records into a single-use compute command buffer and blocks until it
+    // completes. Call with the frame exchange lock held, like any other simulation-thread GPU rewrite
+    bool submitImmediateCompute(const std::function<void(VkCommandBuffer)>& record);
     void setDeltaTime(float deltaTime) { 
         this->deltaTime = deltaTime; 
         clampedDeltaTime = deltaTime;  // Update static member for global access
     }
     
+    // Simulation clock: variable (one step per frame) or fixed-step with a seed for reproducible runs.
+    // setSimulationTime() resumes from a restored snapshot's time and step
+    void configureSimulationClock(const SimulationClock::Config& config) { simulationClock.configure(config); }
+    const SimulationClock& getSimulationClock() const { return simulationClock; }
+    float getSimulationTime() const { return simulationClock.getTime(); }
+    void setSimulationTime(float time, uint32_t stepIndex) { simulationClock.setTime(time, stepIndex); }
+    
     // Camera integration
     void setWorld(flecs::world* world) { this->world = world; }
     void updateAspectRatio(int windowWidth, int windowHeight);
@@ -59,6 +104,32 @@ public:
     // Static access to clamped deltaTime for global use
     static float getClampedDelta() { return clampedDeltaTime; }
     
+    // Camera late latch: matrices sampled while recording the draw instead of before the frame graph runs
+    void setLateLatchCamera(bool enabled);
+    
+    // Entity LOD: Auto picks triangles or the density splat by on-screen entity size
+    void setEntityLodMode(EntityLodMode mode);
+    
+    // Entity triangles by vertex pulling (default) or the indexed instanced draw
+    void setEntityDrawPath(EntityDrawPath path);
+    
+    // GPU-timed comparison of both draw paths over the next frames, reported on stdout when done
+    bool benchmarkEntityDrawPaths(uint32_t framesPerPath);
+    
+    // Dynamic resolution: render scale and MSAA follow the entity pass GPU time within the config bounds
+    void setRenderScaleConfig(const RenderScaleController::Config& config, bool enabled);
+    
+    // Input-to-submit latency; the main loop hands over the oldest input event timestamp each frame
+    struct LatencyStats {
+        float lastInputToSubmitMs = 0.0f;
+        float averageInputToSubmitMs = 0.0f;   // Exponential moving average
+        float maxInputToSubmitMs = 0.0f;
+        float cameraAgeAtSubmitMs = 0.0f;      // Camera sample to submit, last frame
+        uint64_t samples = 0;
+    };
+    void markInputTimestamp(uint64_t sdlTicksNS);
+    const LatencyStats& getLatencyStats() const { return latencyStats; }
+    
     bool isInitialized() const { return initialized; }
 
 private:
@@ -77,6 +148,7 @@ private:
     std::unique_ptr<QueueManager> queueManager;
     std::unique_ptr<ResourceCoordinator> resourceCoordinator;
     std::unique_ptr<GPUEntityManager> gpuEntityManager;
+    std::unique_ptr<GpuPrimitives> gpuPrimitives;
     
     // AAA Pipeline System
     std::unique_ptr<class PipelineSystemManager> pipelineSystem;
@@ -99,12 +171,34 @@ private:
     void cleanupModularArchitecture();
     void drawFrameModular();
     
+    // Frame phases, shared by drawFrameModular() and the render thread's renderFramePacket().
+    // beginFrameExchange() touches simulation-side state and needs the exchange lock when pipelined
+    bool waitForFrameSlot();
+    void beginFrameExchange();
+    RenderFrameResult recordFrame();
+    void finishFrame(RenderFrameResult& frameResult);
+    void applyFramePacket(FramePacket& packet);
+    void renderFramePacket(FramePacket& packet);
+    std::unique_ptr<FramePipeline> framePipeline;
+    
     // Logging helpers
     void logFrameSuccessIfNeeded(const char* operation);
     
+    // Latency tracking
+    void recordSubmitLatency(uint64_t submitTicksNS);
+    uint64_t pendingInputTimestampNS = 0;
+    LatencyStats latencyStats;
+    bool lateLatchCamera = true;
+    EntityLodMode entityLodMode{};
+    EntityDrawPath entityDrawPath{};
+    RenderScaleController::Config renderScaleConfig;
+    bool renderScaleEnabled = false;
+    
     // GPU compute state
     float deltaTime = 0.0f;
-    float totalTime = 0.0f; // Accumulated simulation time
+    float totalTime = 0.0f; // Time of the last simulation step recorded this frame
+    float frameStepDelta = 0.0f;
+    SimulationClock simulationClock;
     
     // Static member for global access to clamped deltaTime
     static float clampedDeltaTime;